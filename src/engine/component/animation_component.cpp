@@ -2,10 +2,27 @@
 #include "sprite_component.h"
 #include "../object/game_object.h"
 #include "../render/animation.h"
+#include "../render/animation_system.h"
 #include <spdlog/spdlog.h>
 
 namespace engine::component {
-void AnimationComponent::addAnimation(std::unique_ptr<engine::render::Animation> animation) {
+AnimationComponent::AnimationComponent(engine::render::AnimationSystem* animationSystem)
+	: mAnimationSystem(animationSystem)
+{
+	if (!mAnimationSystem) {
+		spdlog::critical("{} : 创建 AnimationComponent 时 AnimationSystem 为空! 此组件无效.", mLogTag.data());
+	}
+}
+
+AnimationComponent::~AnimationComponent() {
+	// 未经过clean()直接销毁时(如场景销毁时仍在待添加列表中的对象), 确保不在系统中留下悬空指针
+	if (isRegistered()) {
+		mAnimationSystem->unregisterComponent(mStateIndex);
+		mStateIndex = engine::render::AnimationSystem::mInvalidIndex;
+	}
+}
+
+void AnimationComponent::addAnimation(std::shared_ptr<const engine::render::Animation> animation) {
 	if (!animation) {
 		return;
 	}
@@ -21,30 +38,41 @@ void AnimationComponent::playAnimation(std::string_view name) {
 		spdlog::warn("{} : 未找到游戏对象 '{}' 的动画 '{}'", mLogTag.data(), (mOwner ? mOwner->getName() : "unknown"), name.data());
 		return;
 	}
+	if (!isRegistered()) {
+		spdlog::warn("{} : 游戏对象 '{}' 的动画组件未注册到动画系统, 无法播放动画 '{}'", mLogTag.data(), (mOwner ? mOwner->getName() : "unknown"), name.data());
+		return;
+	}
 
+	auto& state = mAnimationSystem->getState(mStateIndex);
 	// 如果已经在播放相同的动画, 不重新开始 (注释这一段则重新开始播放)
-	if (mCurrentAnimation == iter->second.get() && mIsPlaying) {
+	if (mCurrentAnimation == iter->second.get() && state.mIsPlaying) {
 		return;
 	}
 
 	mCurrentAnimation = iter->second.get();
-	mAnimationTimer = 0.f;
-	mIsPlaying = true;
+	state.mClip = mCurrentAnimation;
+	state.mTimer = 0.f;
+	state.mFrameIndex = 0;
+	state.mIsPlaying = true;
 
 	// 立即将精灵更新到第一帧
 	if (mSpriteComponent && !mCurrentAnimation->getIsEmpty()) {
-		const auto& firstFrame = mCurrentAnimation->getFrame(0.f);
+		const auto& firstFrame = mCurrentAnimation->getFrames().front();
 		mSpriteComponent->setSourceRect(firstFrame.mSourceRect);
 		spdlog::debug("{} : 游戏对象 '{}' 播放动画 '{}'", mLogTag.data(), (mOwner ? mOwner->getName() : "unknown"), name.data());
 	}
 }
 
 void AnimationComponent::stopAnimation() {
-	mIsPlaying = false;
+	if (isRegistered()) {
+		mAnimationSystem->getState(mStateIndex).mIsPlaying = false;
+	}
 }
 
 void AnimationComponent::resumeAnimation() {
-	mIsPlaying = true;
+	if (isRegistered()) {
+		mAnimationSystem->getState(mStateIndex).mIsPlaying = true;
+	}
 }
 
 std::string_view AnimationComponent::getCurrentAnimationName() const {
@@ -55,15 +83,15 @@ std::string_view AnimationComponent::getCurrentAnimationName() const {
 }
 
 bool AnimationComponent::getIsPlaying() const {
-	return mIsPlaying;
+	return isRegistered() && mAnimationSystem->getState(mStateIndex).mIsPlaying;
 }
 
 bool AnimationComponent::getIsAnimationFinished() const {
 	// 如果没有当前动画 (说明从未调用过playAnimation), 或者当前动画是循环的, 则返回 false
-	if (!mCurrentAnimation || mCurrentAnimation->getIsLooping()) {
+	if (!mCurrentAnimation || mCurrentAnimation->getIsLooping() || !isRegistered()) {
 		return false;
 	}
-	return mAnimationTimer >= mCurrentAnimation->getTotalDuration();
+	return mAnimationSystem->getState(mStateIndex).mTimer >= mCurrentAnimation->getTotalDuration();
 }
 
 bool AnimationComponent::getIsOneShotRemoval() const {
@@ -85,30 +113,28 @@ void AnimationComponent::init() {
 		spdlog::error("{} : 游戏对象 '{}' 需要精灵组件, 但未找到", mLogTag.data(), mOwner->getName());
 		return;
 	}
-}
 
-void AnimationComponent::update(float delta, engine::core::Context&) {
-	// 如果没有正在播放的动画, 或者没有当前动画, 或者没有精灵组件, 或者当前动画没有帧, 则直接返回
-	if (!mIsPlaying || !mCurrentAnimation || !mSpriteComponent || mCurrentAnimation->getIsEmpty()) {
-		spdlog::trace("{} : 游戏对象动画组件更新时没有正在播放的动画或者精灵组件为空", mLogTag.data());
-		return;
+	// 注册到AnimationSystem
+	if (mAnimationSystem && !isRegistered()) {
+		mStateIndex = mAnimationSystem->registerComponent(this, mSpriteComponent);
 	}
+}
 
-	// 推进计时器
-	mAnimationTimer += delta;
-	// 根据时间获取当前帧
-	const auto& currentFrame = mCurrentAnimation->getFrame(mAnimationTimer);
-	// 更新精灵组件的源矩阵 (使用 SpriteComponent 的新方法)
-	mSpriteComponent->setSourceRect(currentFrame.mSourceRect);
+void AnimationComponent::clean() {
+	if (isRegistered()) {
+		mAnimationSystem->unregisterComponent(mStateIndex);
+		mStateIndex = engine::render::AnimationSystem::mInvalidIndex;
+	}
+	spdlog::trace("{} : 动画组件清理完成.", mLogTag.data());
+}
 
-	// 检查非循环动画是否已结束
-	if (!mCurrentAnimation->getIsLooping() && mAnimationTimer >= mCurrentAnimation->getTotalDuration()) {
-		mIsPlaying = false;
-		// 将时间限制在结束点
-		mAnimationTimer = mCurrentAnimation->getTotalDuration();
-		if (mIsOneShotRemoval) {
-			mOwner->setNeedRemove(true);
-		}
+void AnimationComponent::onAnimationFinished() {
+	if (mIsOneShotRemoval && mOwner) {
+		mOwner->setNeedRemove(true);
 	}
 }
+
+bool AnimationComponent::isRegistered() const {
+	return mAnimationSystem && mStateIndex != engine::render::AnimationSystem::mInvalidIndex;
+}
 } // namespace engine::component
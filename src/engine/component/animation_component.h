@@ -17,7 +17,10 @@
 #include <memory>
 #include "component.h"
 
-namespace engine::render { class Animation; }
+namespace engine::render {
+	class Animation;
+	class AnimationSystem;
+}
 namespace engine::component { class SpriteComponent; }
 
 namespace engine::component {
@@ -25,14 +28,20 @@ namespace engine::component {
 /**
  * @brief GameObject 的动画组件.
  * 
- * 持有一组Animation对象并控制其播放.
- * 根据当前帧更新关联的SpriteComponent
+ * 持有一组共享的Animation片段并控制其播放.
+ * 播放状态存放在场景的AnimationSystem中, 由系统统一推进并更新关联的SpriteComponent
  */
 class AnimationComponent final : public Component {
 	friend class engine::object::GameObject;
+	friend class engine::render::AnimationSystem;
 public:
-	AnimationComponent() = default;																///< @brief 构造函数
-	~AnimationComponent() override = default;													///< @brief 析构函数
+	/**
+	 * @brief 构造函数.
+	 *
+	 * @param animationSystem 所属场景的动画系统, 初始化时注册, 清理时注销
+	 */
+	explicit AnimationComponent(engine::render::AnimationSystem* animationSystem);
+	~AnimationComponent() override;																///< @brief 析构函数, 未注销时自动注销
 
 	// 禁用拷贝和移动语义
 	AnimationComponent(const AnimationComponent&) = delete;										///< @brief 删除拷贝构造
@@ -40,7 +49,7 @@ public:
 	AnimationComponent(AnimationComponent&&) = delete;											///< @brief 删除移动构造
 	AnimationComponent& operator=(AnimationComponent&&) = delete;								///< @brief 删除移动赋值构造
 
-	void addAnimation(std::unique_ptr<engine::render::Animation> animation);					///< @brief 添加一个动画
+	void addAnimation(std::shared_ptr<const engine::render::Animation> animation);				///< @brief 添加一个动画(共享的不可变片段)
 	void playAnimation(std::string_view name);													///< @brief 播放指定名称的动画	
 	void stopAnimation();																		///< @brief 停止当前动画播放
 	void resumeAnimation();																		///< @brief 恢复当前动画播放
@@ -53,17 +62,21 @@ public:
 
 protected:
 	// 核心循环方法
-	void init() override;																		///< @brief 初始化
-	void update(float, engine::core::Context&) override;										///< @brief 更新
+	void init() override;																		///< @brief 初始化, 注册到动画系统
+	void update(float, engine::core::Context&) override {}										///< @brief 更新由AnimationSystem统一完成
+	void clean() override;																		///< @brief 清理, 从动画系统注销
+
+private:
+	void onAnimationFinished();																	///< @brief 非循环动画播放结束时由AnimationSystem调用
+	bool isRegistered() const;																	///< @brief 是否已注册到动画系统
 
 private:
 	static constexpr std::string_view mLogTag = "AnimationComponent";							///< @brief 日志标识
-	std::unordered_map<std::string, std::unique_ptr<engine::render::Animation>> mAnimations;	///< @brief 动画名称到Animation对象的映射
+	std::unordered_map<std::string, std::shared_ptr<const engine::render::Animation>> mAnimations;	///< @brief 动画名称到共享片段的映射
+	engine::render::AnimationSystem* mAnimationSystem = nullptr;								///< @brief 所属场景的动画系统
 	SpriteComponent* mSpriteComponent = nullptr;												///< @brief 指向必需的SpriteComponent的指针
-	engine::render::Animation* mCurrentAnimation = nullptr;										///< @brief 指向当前播放动画的原始指针
-																								
-	float mAnimationTimer = 0.f;																///< @brief 动画播放中的计时器
-	bool mIsPlaying = false;																	///< @brief 当前是否有动画正在播放
+	const engine::render::Animation* mCurrentAnimation = nullptr;								///< @brief 指向当前播放动画的原始指针
+	size_t mStateIndex = static_cast<size_t>(-1);												///< @brief 在动画系统中的状态索引
 	bool mIsOneShotRemoval = false;																///< @brief 是否在动画结束后删除整个 GameObject
 };																								
 }
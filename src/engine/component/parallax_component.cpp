@@ -6,6 +6,8 @@
 #include "../render/sprite.h"
 #include "../object/game_object.h"
 #include "../core/context.h"
+#include "../resource/resource_manager.h"
+#include "../resource/texture_region.h"
 #include <spdlog/spdlog.h>
 
 namespace engine::component {
@@ -18,6 +20,7 @@ ParallaxComponent::ParallaxComponent(std::string_view textureId, const glm::vec2
 }
 void ParallaxComponent::setSprite(const engine::render::Sprite& sprite) {
 	mSprite = sprite;
+	mHasTextureSize = false;
 }
 
 void ParallaxComponent::setScrollFactor(const glm::vec2& scrollFactor) {
@@ -68,6 +71,18 @@ void ParallaxComponent::render(engine::core::Context& context) {
 		return;
 	}
 
+	// 没有指定源矩形时整张纹理作为源矩形, 首次绘制时查询一次纹理尺寸并缓存; 纹理尚未加载时(异步加载中)留到之后的帧
+	if (!mHasTextureSize) {
+		if (!mSprite.getSourceRect().has_value()) {
+			auto region = context.getResourceManager().requestTextureRegion(mSprite.getTextureId());
+			if (!region.mTexture || region.mRect.w <= 0.f || region.mRect.h <= 0.f) {
+				return;
+			}
+			mSprite.setSourceRect(SDL_FRect{ 0.f, 0.f, region.mRect.w, region.mRect.h });
+		}
+		mHasTextureSize = true;
+	}
+
 	// 直接调用视差滚动绘制函数
 	context.getRenderer().drawParallax(context.getCamera(), mSprite, mTransform->getPosition(), mScrollFactor, mRepeat, mTransform->getScale());
 }
@@ -61,6 +61,7 @@ private:
 	glm::vec2 mScrollFactor;												///< @brief 滚动速度因子
 	glm::bvec2 mRepeat;														///< @brief 是否沿着X和Y轴周期性重复
 	bool mIsHidden = false;													///< @brief 是否隐藏
+	bool mHasTextureSize = false;											///< @brief 是否已缓存纹理尺寸(缓存后写入精灵的源矩形, 绘制时无需再查询纹理尺寸)
 };
 
 } // engine::component
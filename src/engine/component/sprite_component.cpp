@@ -5,6 +5,8 @@
 #include "../render/renderer.h"
 #include "../resource/resource_manager.h"
 #include "../render/camera.h"
+#include "../scene/spatial_grid.h"
+#include <cmath>
 #include <stdexcept>
 #include <spdlog/spdlog.h>
 
@@ -33,6 +35,7 @@ SpriteComponent::SpriteComponent(engine::render::Sprite&& sprite, engine::resour
 void SpriteComponent::updateOffset() {
 	if (mSpriteSize.x <= 0 || mSpriteSize.y <= 0) {
 		mOffset = { 0.f, 0.f };
+		updateRenderBounds();
 		return;
 	}
 
@@ -70,6 +73,13 @@ void SpriteComponent::updateOffset() {
 	default:
 		break;
 	}
+	updateRenderBounds();
+}
+
+void SpriteComponent::updateRenderBounds() {
+	if (mSpatialGrid && mTransform) {
+		mSpatialGrid->update(mSpatialProxy, getRenderBounds());
+	}
 }
 
 const engine::render::Sprite& SpriteComponent::getSprite() const {
@@ -100,24 +110,56 @@ engine::utils::Alignment SpriteComponent::getAlignment() const {
 	return mAlignment;
 }
 
+engine::utils::Rect SpriteComponent::getRenderBounds() const {
+	if (!mTransform) {
+		return engine::utils::Rect{ glm::vec2(0.f), glm::vec2(0.f) };
+	}
+
+	// 与drawSprite一致: 左上角为位置加偏移量, 尺寸为精灵尺寸乘缩放(缩放为负时翻转方向)
+	glm::vec2 position = mTransform->getPosition() + mOffset;
+	glm::vec2 size = mSpriteSize * mTransform->getScale();
+	glm::vec2 minPoint = glm::min(position, position + size);
+	glm::vec2 extent = glm::abs(size);
+
+	// 绕中心旋转时, 取以对角线为边长的正方形作为保守包围盒
+	if (std::fmod(mTransform->getRotation(), 360.f) != 0.f) {
+		glm::vec2 center = minPoint + extent * 0.5f;
+		float diagonal = glm::length(extent);
+		return engine::utils::Rect{ center - glm::vec2(diagonal * 0.5f), glm::vec2(diagonal) };
+	}
+	return engine::utils::Rect{ minPoint, extent };
+}
+
 void SpriteComponent::setSpriteById(std::string_view textureId, const std::optional<SDL_FRect>& sourceRectOptional) {
 	mSprite.setTextureId(textureId);
 	mSprite.setSourceRect(sourceRectOptional);
 
 	updateSpriteSize();
 	updateOffset();
+	notifyRenderChanged();
 }
 
 void SpriteComponent::setFlipped(bool flipped) {
-	mSprite.setFlipped(flipped);
+	if (mSprite.isFlipped() != flipped) {
+		mSprite.setFlipped(flipped);
+		notifyRenderChanged();
+	}
 }
 
 void SpriteComponent::setHidden(bool hidden) {
-	mIsHidden = hidden;
+	if (mIsHidden != hidden) {
+		mIsHidden = hidden;
+		notifyRenderChanged();
+	}
 }
 
 void SpriteComponent::setSourceRect(const std::optional<SDL_FRect>& sourceRectOptional) {
 	mSprite.setSourceRect(sourceRectOptional);
+	notifyRenderChanged();
+	// 动画切帧时尺寸通常不变, 此时偏移量也不变(缩放变化时由TransformComponent负责更新)
+	if (sourceRectOptional.has_value() && sourceRectOptional->w == mSpriteSize.x && sourceRectOptional->h == mSpriteSize.y) {
+		return;
+	}
 	updateSpriteSize();
 	updateOffset();
 }
@@ -127,6 +169,17 @@ void SpriteComponent::setAlignment(engine::utils::Alignment anchor) {
 	updateOffset();
 }
 
+void SpriteComponent::setSpatialProxy(engine::scene::SpatialGrid* spatialGrid, std::size_t proxy) {
+	mSpatialGrid = spatialGrid;
+	mSpatialProxy = proxy;
+}
+
+void SpriteComponent::notifyRenderChanged() {
+	if (mSpatialGrid) {
+		mSpatialGrid->markChanged();
+	}
+}
+
 void SpriteComponent::updateSpriteSize() {
 	if (!mResourceManager) {
 		spdlog::error("{} ResourceManager 为空! 无法获取纹理尺寸.", mLogTag.data());
@@ -151,6 +204,8 @@ void SpriteComponent::init() {
 		spdlog::warn("{} GameObject '{}' 上的 SpriteComponent 需要一个 TransformComponent, 但未找到.", mLogTag.data(), mOwner->getName());
 		return;
 	}
+	// 变换组件的位置和旋转变化时通知精灵更新渲染包围盒
+	mTransform->mSpriteComponent = this;
 	// 获取大小及偏移
 	updateSpriteSize();
 	updateOffset();
@@ -169,4 +224,11 @@ void SpriteComponent::render(engine::core::Context& context) {
 	// 执行绘制
 	context.getRenderer().drawSprite(context.getCamera(), mSprite, position, scale, rotation);
 }
+
+void SpriteComponent::clean() {
+	if (mTransform && mTransform->mSpriteComponent == this) {
+		mTransform->mSpriteComponent = nullptr;
+	}
+	mSpatialGrid = nullptr;
+}
 }
@@ -11,6 +11,7 @@
 #ifndef SPRITE_COMPONENT_H
 #define SPRITE_COMPONENT_H
 
+#include <cstddef>
 #include <string>
 #include <string_view>
 #include <optional>
@@ -21,6 +22,7 @@
 #include "../render/sprite.h"
 #include "component.h"
 #include "../utils/alignment.h"
+#include "../utils/math.h"
 
 namespace engine::core {
 	class Context;
@@ -30,6 +32,10 @@ namespace engine::resource {
 	class ResourceManager;
 }
 
+namespace engine::scene {
+	class SpatialGrid;
+}
+
 namespace engine::component {
 class TransformComponent;
 /**
@@ -72,6 +78,7 @@ public:
 	SpriteComponent& operator=(SpriteComponent&&) = delete;						///< @brief 删除移动赋值构造
 
 	void updateOffset();														///< @brief 更新偏移量
+	void updateRenderBounds();													///< @brief 变换或尺寸变化后, 同步渲染包围盒到场景的空间网格
 
 	const engine::render::Sprite& getSprite() const;							///< @brief 获取精灵对象
 	std::string_view getTextureId() const;										///< @brief 获取纹理ID
@@ -80,6 +87,7 @@ public:
 	const glm::vec2& getSpriteSize() const;										///< @brief 获取精灵尺寸
 	const glm::vec2& getOffset() const;											///< @brief 获取偏移量
 	engine::utils::Alignment getAlignment() const;								///< @brief 获取对齐方式
+	engine::utils::Rect getRenderBounds() const;								///< @brief 获取渲染包围盒(世界坐标, 已考虑偏移, 缩放和旋转)
 
 	/**
 	 * @brief 通过纹理ID设置精灵对象.
@@ -90,13 +98,23 @@ public:
 	void setSourceRect(const std::optional<SDL_FRect>& sourceRectOptional);		///< @brief 设置源矩阵
 	void setAlignment(engine::utils::Alignment anchor);							///< @brief 设置对齐方式
 
+	/**
+	 * @brief 设置精灵在场景空间网格中的代理, 由场景在加入/移除游戏对象时调用.
+	 *
+	 * @param spatialGrid 空间网格, 为空表示不在网格中
+	 * @param proxy 代理ID
+	 */
+	void setSpatialProxy(engine::scene::SpatialGrid* spatialGrid, std::size_t proxy);
+
 private:
 	void updateSpriteSize();													///< @brief 辅助函数, 根据mSprite的sourceRect更新spriteSize
+	void notifyRenderChanged();													///< @brief 外观变化时递增空间网格的版本号(帧缓存据此重绘)
 
 	// Component 虚函数覆盖
 	void init() override;														///< @brief 初始化函数需要覆盖
 	void update(float, engine::core::Context&) override {}						///< @brief 更新函数留空
 	void render(engine::core::Context& context) override;						///< @brief 渲染函数需要覆盖
+	void clean() override;														///< @brief 清理, 断开与变换组件和空间网格的关联
 private:
 	static constexpr std::string_view mLogTag = "SpriteComponent";
 
@@ -108,6 +126,8 @@ private:
 	glm::vec2 mSpriteSize = { 0.f, 0.f };										///< @brief 精灵尺寸
 	glm::vec2 mOffset = { 0.f, 0.f };											///< @brief 偏移量
 	bool mIsHidden = false;														///< @brief 是否隐藏(不渲染)
+	engine::scene::SpatialGrid* mSpatialGrid = nullptr;							///< @brief 所在场景的空间网格(非必须)
+	std::size_t mSpatialProxy = 0;												///< @brief 在空间网格中的代理ID
 };
 } // engine::component
 #endif
@@ -4,6 +4,9 @@
 #include "../render/renderer.h"
 #include "../render/camera.h"
 #include "../physics/physics_engine.h"
+#include <algorithm>
+#include <cmath>
+#include <glm/common.hpp>
 #include <spdlog/spdlog.h>
 
 namespace engine::component {
@@ -17,15 +20,69 @@ engine::component::TileLayerComponent::TileLayerComponent(glm::ivec2 tileSize, g
 		mTiles.clear();
 		mMapSize = { 0, 0 };
 	}
+
+	updateMaxOverhang(mTiles);
 	spdlog::trace("{} 构造完成", mLogTag.data());
 }
 
+TileLayerComponent::TileLayerComponent(glm::ivec2 tileSize, glm::ivec2 mapSize, int chunkSize)
+	: mTileSize(tileSize)
+	, mMapSize(mapSize)
+	, mChunkSize(std::max(1, chunkSize))
+{
+	spdlog::trace("{} 构造完成(按块存储, 块边长 {})", mLogTag.data(), mChunkSize);
+}
+
+void TileLayerComponent::setChunk(glm::ivec2 chunk, std::vector<TileInfo>&& tiles) {
+	if (mChunkSize <= 0) {
+		spdlog::error("{} : 瓦片层不是按块存储的, 无法加入块.", mLogTag.data());
+		return;
+	}
+	glm::ivec2 extent = getChunkExtent(chunk);
+	if (extent.x <= 0 || extent.y <= 0 || tiles.size() != static_cast<std::size_t>(extent.x) * extent.y) {
+		spdlog::error("{} : 块 ({}, {}) 越界或瓦片数量不匹配.", mLogTag.data(), chunk.x, chunk.y);
+		return;
+	}
+	updateMaxOverhang(tiles);
+	mChunks[getChunkKey(chunk)] = std::move(tiles);
+}
+
+void TileLayerComponent::removeChunk(glm::ivec2 chunk) {
+	mChunks.erase(getChunkKey(chunk));
+}
+
+glm::ivec2 TileLayerComponent::getChunkExtent(glm::ivec2 chunk) const {
+	if (mChunkSize <= 0 || chunk.x < 0 || chunk.y < 0) {
+		return glm::ivec2(0);
+	}
+	return glm::clamp(mMapSize - chunk * mChunkSize, glm::ivec2(0), glm::ivec2(mChunkSize));
+}
+
+int TileLayerComponent::getChunkSize() const {
+	return mChunkSize;
+}
+
+std::size_t TileLayerComponent::getLoadedChunkCount() const {
+	return mChunks.size();
+}
+
 const TileInfo* TileLayerComponent::getTileInfoAt(glm::ivec2 position) const {
 	if (position.x < 0 || position.x >= mMapSize.x || position.y < 0 || position.y >= mMapSize.y) {
 		spdlog::warn("{} : 瓦片坐标越界: ({}, {})", mLogTag.data(), position.x, position.y);
 		return nullptr;
 	}
 
+	// 按块存储: 未加载的块返回nullptr(视为空瓦片), 不输出警告
+	if (mChunkSize > 0) {
+		glm::ivec2 chunk = position / mChunkSize;
+		auto iter = mChunks.find(getChunkKey(chunk));
+		if (iter == mChunks.end()) {
+			return nullptr;
+		}
+		glm::ivec2 local = position - chunk * mChunkSize;
+		return &iter->second[static_cast<size_t>(local.y) * getChunkExtent(chunk).x + local.x];
+	}
+
 	size_t index = static_cast<size_t>(position.y * mMapSize.x + position.x);
 
 	// 瓦片索引不能越界
@@ -98,30 +155,87 @@ void TileLayerComponent::render(engine::core::Context& context) {
 	if (mTileSize.x <= 0 || mTileSize.y <= 0) {
 		return;
 	}
-	for (int y = 0; y < mMapSize.y; ++y) {
-		for (int x = 0; x < mMapSize.x; ++x) {
+
+	// 只遍历与相机视口相交的瓦片范围, 超出瓦片尺寸的图片向上延伸, 所以下方多取若干行
+	const auto& camera = context.getCamera();
+	glm::vec2 viewMin = camera.getPosition() - mOffset;
+	glm::vec2 viewMax = viewMin + camera.getViewPortSize();
+	int startX = std::max(0, static_cast<int>(std::floor((viewMin.x - mMaxOverhang.x) / mTileSize.x)));
+	int startY = std::max(0, static_cast<int>(std::floor(viewMin.y / mTileSize.y)));
+	int endX = std::min(mMapSize.x - 1, static_cast<int>(std::floor(viewMax.x / mTileSize.x)));
+	int endY = std::min(mMapSize.y - 1, static_cast<int>(std::floor((viewMax.y + mMaxOverhang.y) / mTileSize.y)));
+
+	// 按块存储: 逐个遍历与可见范围相交的已加载块, 每个块只查找一次
+	if (mChunkSize > 0) {
+		if (startX > endX || startY > endY) {
+			return;
+		}
+		for (int chunkY = startY / mChunkSize; chunkY <= endY / mChunkSize; ++chunkY) {
+			for (int chunkX = startX / mChunkSize; chunkX <= endX / mChunkSize; ++chunkX) {
+				glm::ivec2 chunk(chunkX, chunkY);
+				auto iter = mChunks.find(getChunkKey(chunk));
+				if (iter == mChunks.end()) {
+					continue;
+				}
+				glm::ivec2 origin = chunk * mChunkSize;
+				glm::ivec2 extent = getChunkExtent(chunk);
+				for (int y = std::max(startY, origin.y); y <= std::min(endY, origin.y + extent.y - 1); ++y) {
+					for (int x = std::max(startX, origin.x); x <= std::min(endX, origin.x + extent.x - 1); ++x) {
+						const auto& tileInfo = iter->second[static_cast<size_t>(y - origin.y) * extent.x + (x - origin.x)];
+						if (tileInfo.mType != TileType::EMPTY) {
+							renderTile(context, tileInfo, x, y);
+						}
+					}
+				}
+			}
+		}
+		return;
+	}
+
+	for (int y = startY; y <= endY; ++y) {
+		for (int x = startX; x <= endX; ++x) {
 			size_t index = static_cast<size_t>(y) * mMapSize.x + x;
 			// 检查索引有效性以及瓦片是否需要渲染
 			if (index < mTiles.size() && mTiles[index].mType != TileType::EMPTY) {
-				const auto& tileInfo = mTiles[index];
-				glm::vec2 tileLeftTopPosition = {
-					mOffset.x + static_cast<float>(x) * mTileSize.x,
-					mOffset.y + static_cast<float>(y) * mTileSize.y,
-				};
-
-				// 如果图片大小与瓦片大小不一致, 需要调整y坐标(瓦片层的对齐点时左下角)
-				// 绘制起始点为左上角, y 轴向反方向移动源矩阵和瓦片大小的y 轴差值
-				if (static_cast<int>(tileInfo.mSprite.getSourceRect()->h) != mTileSize.y) {
-					tileLeftTopPosition.y -= (tileInfo.mSprite.getSourceRect()->h - static_cast<float>(mTileSize.y));
-				}
-
-				// 执行绘制
-				context.getRenderer().drawSprite(context.getCamera(), tileInfo.mSprite, tileLeftTopPosition);
+				renderTile(context, mTiles[index], x, y);
 			}
 		}
 	}
 }
 
+void TileLayerComponent::renderTile(engine::core::Context& context, const TileInfo& tileInfo, int x, int y) {
+	glm::vec2 tileLeftTopPosition = {
+		mOffset.x + static_cast<float>(x) * mTileSize.x,
+		mOffset.y + static_cast<float>(y) * mTileSize.y,
+	};
+
+	// 如果图片大小与瓦片大小不一致, 需要调整y坐标(瓦片层的对齐点时左下角)
+	// 绘制起始点为左上角, y 轴向反方向移动源矩阵和瓦片大小的y 轴差值
+	if (static_cast<int>(tileInfo.mSprite.getSourceRect()->h) != mTileSize.y) {
+		tileLeftTopPosition.y -= (tileInfo.mSprite.getSourceRect()->h - static_cast<float>(mTileSize.y));
+	}
+
+	// 执行绘制
+	context.getRenderer().drawSprite(context.getCamera(), tileInfo.mSprite, tileLeftTopPosition);
+}
+
+void TileLayerComponent::updateMaxOverhang(const std::vector<TileInfo>& tiles) {
+	// 图片比瓦片大的瓦片向右上方延伸, 记录最大延伸量, 渲染时据此扩展可见范围
+	for (const auto& tile : tiles) {
+		if (tile.mType == TileType::EMPTY || !tile.mSprite.getSourceRect().has_value()) {
+			continue;
+		}
+		const auto& srcRect = tile.mSprite.getSourceRect().value();
+		mMaxOverhang.x = std::max(mMaxOverhang.x, static_cast<int>(srcRect.w) - mTileSize.x);
+		mMaxOverhang.y = std::max(mMaxOverhang.y, static_cast<int>(srcRect.h) - mTileSize.y);
+	}
+}
+
+std::int64_t TileLayerComponent::getChunkKey(glm::ivec2 chunk) const {
+	std::int64_t chunkCountX = (mMapSize.x + mChunkSize - 1) / std::max(1, mChunkSize);
+	return static_cast<std::int64_t>(chunk.y) * chunkCountX + chunk.x;
+}
+
 void TileLayerComponent::clean() {
 	if (mPhysicsEngine) {
 		mPhysicsEngine->unregisterCollisionLayer(this);
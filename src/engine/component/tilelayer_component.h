@@ -13,6 +13,9 @@
 
 #include "../render/sprite.h"
 #include "component.h"
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
 #include <vector>
 #include <glm/vec2.hpp>
 
@@ -51,6 +54,9 @@ struct TileInfo {
 
 /**
  * @brief 管理和渲染瓦片地图层.
+ *
+ * 瓦片可以整体存储, 也可以按正方形的块存储(流式关卡): 块由LevelStreamer按相机位置加入和移除,
+ * 未加载的块中的瓦片视为空瓦片.
  */
 class TileLayerComponent final : public Component {
 	friend class engine::object::GameObject;
@@ -66,11 +72,32 @@ public:
 	 */
 	TileLayerComponent(glm::ivec2 tileSize, glm::ivec2 mapSize, std::vector<TileInfo>&& tiles);
 
+	/**
+	 * @brief 构造按块存储的瓦片层, 初始没有加载任何块.
+	 *
+	 * @param tileSize 单个瓦片尺寸(像素)
+	 * @param mapSize 地图尺寸(瓦片数)
+	 * @param chunkSize 块的边长(瓦片数)
+	 */
+	TileLayerComponent(glm::ivec2 tileSize, glm::ivec2 mapSize, int chunkSize);
+
+	/**
+	 * @brief 加入或替换一个块(只适用于按块存储的瓦片层).
+	 *
+	 * @param chunk 块坐标
+	 * @param tiles 块内的瓦片(行主序), 数量必须等于getChunkExtent(chunk)的面积
+	 */
+	void setChunk(glm::ivec2 chunk, std::vector<TileInfo>&& tiles);
+	void removeChunk(glm::ivec2 chunk);										///< @brief 移除一个块, 其中的瓦片视为空瓦片
+	glm::ivec2 getChunkExtent(glm::ivec2 chunk) const;						///< @brief 获取块的实际尺寸(瓦片数, 地图边缘的块可能不完整)
+	int getChunkSize() const;												///< @brief 获取块的边长, 0表示整体存储
+	std::size_t getLoadedChunkCount() const;								///< @brief 获取已加载的块数量
+
 	/**
 	 * @brief 根据瓦片坐标获取瓦片信息.
 	 * 
 	 * @param position 瓦片坐标 (0 <= x <= mapSize.x, 0 <= y <= mapSize.y)
-	 * @return const TileInfo* 指向瓦片信息的指针, 如果坐标无效则返回nullptr
+	 * @return const TileInfo* 指向瓦片信息的指针, 如果坐标无效或所在的块未加载则返回nullptr
 	 */
 	const TileInfo* getTileInfoAt(glm::ivec2 position) const;					
 
@@ -93,7 +120,7 @@ public:
 	glm::ivec2 getTileSize() const;											///< @brief 获取单个瓦片尺寸
 	glm::ivec2 getMapSize() const;											///< @brief 获取地图尺寸
 	glm::vec2 getWorldSize() const;											///< @brief 获取世界尺寸
-	const std::vector<TileInfo>& getTiles() const;							///< @brief 获取瓦片容器
+	const std::vector<TileInfo>& getTiles() const;							///< @brief 获取瓦片容器(按块存储时为空)
 	const glm::vec2& getOffset() const;										///< @brief 瓦片偏移
 	bool getIsHidden() const;												///< @brief 获取是否隐藏
 
@@ -107,13 +134,21 @@ protected:
 	void render(engine::core::Context& context) override;					///< @brief 渲染
 	void clean() override;													///< @brief 清理
 
+private:
+	void renderTile(engine::core::Context& context, const TileInfo& tileInfo, int x, int y);	///< @brief 绘制一个瓦片(瓦片坐标)
+	void updateMaxOverhang(const std::vector<TileInfo>& tiles);				///< @brief 根据瓦片图片尺寸更新最大延伸量
+	std::int64_t getChunkKey(glm::ivec2 chunk) const;						///< @brief 块坐标对应的键
+
 private:
 	static constexpr std::string_view mLogTag = "TileLayerComponent";		///< @brief 日志标识
 
 	glm::ivec2 mTileSize;													///< @brief 单个瓦片的尺寸(像素)
 	glm::ivec2 mMapSize;													///< @brief 地图尺寸(瓦片数)
 	std::vector<TileInfo> mTiles;											///< @brief 存储所有瓦片信息(行主序, index = y * mMapWidth + x)
+	int mChunkSize = 0;														///< @brief 块的边长(瓦片数), 0表示整体存储在mTiles中
+	std::unordered_map<std::int64_t, std::vector<TileInfo>> mChunks;		///< @brief 已加载的块(块坐标的键 -> 块内行主序的瓦片)
 	glm::vec2 mOffset = glm::vec2(0.f);										///< @brief 瓦片层在世界中的偏移量(瓦片层无需缩放和旋转, 所以不需要Transform组件)
+	glm::ivec2 mMaxOverhang = glm::ivec2(0);								///< @brief 瓦片图片超出瓦片尺寸的最大值(向右, 向上), 用于视口裁剪时扩展范围
 	bool mIsHidden = false;													///< @brief 是否隐藏(不渲染)
 	engine::physics::PhysicsEngine* mPhysicsEngine = nullptr;				///< @brief 物理引擎指针, clean 函数要取消注册
 };
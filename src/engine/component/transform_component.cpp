@@ -23,10 +23,12 @@ const glm::vec2& TransformComponent::getScale() const {
 
 void TransformComponent::setPosition(const glm::vec2& position) {
 	mPosition = position;
+	notifyTransformChanged();
 }
 
 void TransformComponent::setRotation(float rotation) {
 	mRotation = rotation;
+	notifyTransformChanged();
 }
 
 void TransformComponent::setScale(const glm::vec2& scale) {
@@ -46,5 +48,12 @@ void TransformComponent::setScale(const glm::vec2& scale) {
 
 void TransformComponent::translate(const glm::vec2& offset) {
 	mPosition += offset;
+	notifyTransformChanged();
+}
+
+void TransformComponent::notifyTransformChanged() {
+	if (mSpriteComponent) {
+		mSpriteComponent->updateRenderBounds();
+	}
 }
 } // engine::component
@@ -15,12 +15,14 @@
 #include "component.h"
 
 namespace engine::component {
+class SpriteComponent;
 /**
  * @class TransformComponent.
  * @brief 管理GameObject的位置,旋转和缩放.
  */
 class TransformComponent final : public Component {
 	friend class engine::object::GameObject;
+	friend class SpriteComponent;
 public:
 	/**
 	* @brief 构造函数.
@@ -48,6 +50,9 @@ public:
 
 private:
 	void update(float, engine::core::Context&) override {};						///< @brief 覆盖纯虚函数, 无需实现
+	void notifyTransformChanged();												///< @brief 位置或旋转变化后通知精灵组件更新渲染包围盒
+
+	SpriteComponent* mSpriteComponent = nullptr;								///< @brief 同一对象上的精灵组件(由其初始化时设置), 避免每次移动都查找组件
 public:
 	glm::vec2 mPosition = { 0.f, 0.f };											///< @brief 位置
 	glm::vec2 mScale = { 1.f, 1.f };											///< @brief 缩放
@@ -1,6 +1,7 @@
 #include "config.h"
 #include <fstream>
 #include <filesystem>
+#include <algorithm>
 #include <nlohmann/json.hpp>
 #include <spdlog/spdlog.h>
 
@@ -59,6 +60,78 @@ bool Config::saveToFile(std::string_view filePath) {
 	return false;
 }
 
+void Config::applyCommandLine(const std::vector<std::string>& args) {
+	for (const auto& arg : args) {
+		if (arg == "--headless") {
+			mHeadless = true;
+		}
+		else if (arg.starts_with("--headless=")) {
+			mHeadless = true;
+			mHeadlessBackend = arg.substr(std::string_view("--headless=").size());
+		}
+		else if (arg.starts_with("--frames=")) {
+			try {
+				mBenchmarkFrames = std::max(0, std::stoi(arg.substr(std::string_view("--frames=").size())));
+			}
+			catch (const std::exception& e) {
+				spdlog::warn("{} 无法解析命令行参数 '{}': {}", mLogTag.data(), arg, e.what());
+			}
+		}
+		else if (arg.starts_with("--text=")) {
+			mTextBackend = arg.substr(std::string_view("--text=").size());
+		}
+		else if (arg.starts_with("--atlas=")) {
+			mTextureAtlasEnabled = arg.substr(std::string_view("--atlas=").size()) != "off";
+		}
+		else if (arg.starts_with("--frame-cache=")) {
+			mFrameCacheEnabled = arg.substr(std::string_view("--frame-cache=").size()) != "off";
+		}
+		else if (arg.starts_with("--frame-cache-verify=")) {
+			mFrameCacheVerifyEnabled = arg.substr(std::string_view("--frame-cache-verify=").size()) != "off";
+		}
+		else if (arg.starts_with("--dynamic-res=")) {
+			mDynamicResolutionEnabled = arg.substr(std::string_view("--dynamic-res=").size()) != "off";
+		}
+		else if (arg.starts_with("--dirty-rects=")) {
+			mDirtyRectsEnabled = arg.substr(std::string_view("--dirty-rects=").size()) != "off";
+		}
+		else if (arg.starts_with("--streaming=")) {
+			mLevelStreamingEnabled = arg.substr(std::string_view("--streaming=").size()) != "off";
+		}
+		else if (arg.starts_with("--hud-labels=")) {
+			try {
+				mBenchmarkHudLabels = std::max(0, std::stoi(arg.substr(std::string_view("--hud-labels=").size())));
+			}
+			catch (const std::exception& e) {
+				spdlog::warn("{} 无法解析命令行参数 '{}': {}", mLogTag.data(), arg, e.what());
+			}
+		}
+		else if (arg.starts_with("--pack=")) {
+			mAssetPackPath = arg.substr(std::string_view("--pack=").size());
+			if (mAssetPackPath == "off") {
+				mAssetPackPath.clear();
+			}
+		}
+		else if (arg.starts_with("--pack-loose-check=")) {
+			mAssetPackLooseCheck = arg.substr(std::string_view("--pack-loose-check=").size()) != "off";
+		}
+		else {
+			spdlog::warn("{} 未知的命令行参数 '{}', 已忽略", mLogTag.data(), arg);
+			continue;
+		}
+		spdlog::info("{} 命令行参数覆盖配置: {}", mLogTag.data(), arg);
+	}
+
+	if (mHeadless && mHeadlessBackend != "software" && mHeadlessBackend != "null") {
+		spdlog::warn("{} 未知的无头模式后端 '{}', 使用 'software'", mLogTag.data(), mHeadlessBackend);
+		mHeadlessBackend = "software";
+	}
+	if (mTextBackend != "atlas" && mTextBackend != "ttf") {
+		spdlog::warn("{} 未知的文字绘制方式 '{}', 使用 'atlas'", mLogTag.data(), mTextBackend);
+		mTextBackend = "atlas";
+	}
+}
+
 void Config::fromJson(const nlohmann::json& data) {
 	// 窗口设置
 	if (data.contains("window")) {
@@ -73,6 +146,22 @@ void Config::fromJson(const nlohmann::json& data) {
 	if (data.contains("graphics")) {
 		const auto& graphicsConifg = data["graphics"];
 		mVsyncEnabled = graphicsConifg.value("vsync", mVsyncEnabled);
+		mRenderThreadEnabled = graphicsConifg.value("render_thread", mRenderThreadEnabled);
+		mHeadless = graphicsConifg.value("headless", mHeadless);
+		mHeadlessBackend = graphicsConifg.value("headless_backend", mHeadlessBackend);
+		mTextBackend = graphicsConifg.value("text_backend", mTextBackend);
+		mTextureAtlasEnabled = graphicsConifg.value("texture_atlas", mTextureAtlasEnabled);
+		mFrameCacheEnabled = graphicsConifg.value("frame_cache", mFrameCacheEnabled);
+		mFrameCacheVerifyEnabled = graphicsConifg.value("frame_cache_verify", mFrameCacheVerifyEnabled);
+		mDynamicResolutionEnabled = graphicsConifg.value("dynamic_resolution", mDynamicResolutionEnabled);
+		mDynamicResolutionMinScale = graphicsConifg.value("dynamic_resolution_min_scale", mDynamicResolutionMinScale);
+		mDynamicResolutionMaxScale = graphicsConifg.value("dynamic_resolution_max_scale", mDynamicResolutionMaxScale);
+		mDirtyRectsEnabled = graphicsConifg.value("dirty_rects", mDirtyRectsEnabled);
+		mDirtyRectThreshold = graphicsConifg.value("dirty_rect_threshold", mDirtyRectThreshold);
+		if (mDynamicResolutionMinScale > mDynamicResolutionMaxScale) {
+			spdlog::warn("{} 动态分辨率的最小缩放大于最大缩放, 交换两者.", mLogTag.data());
+			std::swap(mDynamicResolutionMinScale, mDynamicResolutionMaxScale);
+		}
 	}
 
 	// 帧率设置
@@ -83,6 +172,33 @@ void Config::fromJson(const nlohmann::json& data) {
 			spdlog::warn("{} 目标FPS不能为负数. 设置为0为无限制.", mLogTag.data());
 			mTargetFps = 0;
 		}
+		mBenchmarkFrames = performanceConfig.value("benchmark_frames", mBenchmarkFrames);
+		mBenchmarkHudLabels = performanceConfig.value("benchmark_hud_labels", mBenchmarkHudLabels);
+		mLoaderThreads = performanceConfig.value("loader_threads", mLoaderThreads);
+		if (mLoaderThreads < 1) {
+			spdlog::warn("{} 异步加载线程数量至少为1.", mLogTag.data());
+			mLoaderThreads = 1;
+		}
+		mUploadBudgetMs = performanceConfig.value("upload_budget_ms", mUploadBudgetMs);
+		mPreloadParallel = performanceConfig.value("preload_parallel", mPreloadParallel);
+		mResourcePoolBudgetMb = performanceConfig.value("resource_pool_budget_mb", mResourcePoolBudgetMb);
+		mAssetPackPath = performanceConfig.value("asset_pack", mAssetPackPath);
+		mAssetPackLooseCheck = performanceConfig.value("asset_pack_loose_check", mAssetPackLooseCheck);
+		if (mResourcePoolBudgetMb < 0) {
+			spdlog::warn("{} 资源池预算不能为负数.", mLogTag.data());
+			mResourcePoolBudgetMb = 0;
+		}
+		mLevelStreamingEnabled = performanceConfig.value("level_streaming", mLevelStreamingEnabled);
+		mLevelChunkSize = performanceConfig.value("level_chunk_size", mLevelChunkSize);
+		if (mLevelChunkSize < 1) {
+			spdlog::warn("{} 流式关卡的块边长至少为1.", mLogTag.data());
+			mLevelChunkSize = 1;
+		}
+		mLevelStreamingRadius = performanceConfig.value("level_streaming_radius", mLevelStreamingRadius);
+		if (mLevelStreamingRadius < 0) {
+			spdlog::warn("{} 流式关卡的加载半径不能为负数.", mLogTag.data());
+			mLevelStreamingRadius = 0;
+		}
 	}
 
 	// 音频设置
@@ -123,12 +239,35 @@ nlohmann::ordered_json Config::toJson() const {
 		},
 		{
 			"graphics", {
-				{ "vsync", mVsyncEnabled }
+				{ "vsync", mVsyncEnabled },
+				{ "render_thread", mRenderThreadEnabled },
+				{ "headless", mHeadless },
+				{ "headless_backend", mHeadlessBackend },
+				{ "text_backend", mTextBackend },
+				{ "texture_atlas", mTextureAtlasEnabled },
+				{ "frame_cache", mFrameCacheEnabled },
+				{ "frame_cache_verify", mFrameCacheVerifyEnabled },
+				{ "dynamic_resolution", mDynamicResolutionEnabled },
+				{ "dynamic_resolution_min_scale", mDynamicResolutionMinScale },
+				{ "dynamic_resolution_max_scale", mDynamicResolutionMaxScale },
+				{ "dirty_rects", mDirtyRectsEnabled },
+				{ "dirty_rect_threshold", mDirtyRectThreshold }
 			}
 		},
 		{
 			"performance", {
-				{ "target_fps", mTargetFps }
+				{ "target_fps", mTargetFps },
+				{ "benchmark_frames", mBenchmarkFrames },
+				{ "benchmark_hud_labels", mBenchmarkHudLabels },
+				{ "loader_threads", mLoaderThreads },
+				{ "upload_budget_ms", mUploadBudgetMs },
+				{ "preload_parallel", mPreloadParallel },
+				{ "resource_pool_budget_mb", mResourcePoolBudgetMb },
+				{ "asset_pack", mAssetPackPath },
+				{ "asset_pack_loose_check", mAssetPackLooseCheck },
+				{ "level_streaming", mLevelStreamingEnabled },
+				{ "level_chunk_size", mLevelChunkSize },
+				{ "level_streaming_radius", mLevelStreamingRadius }
 			}
 		},
 		{
@@ -30,6 +30,14 @@ public:
 	[[nodiscard]] bool loadFromFile(std::string_view filePath);			///< @brief 从指定的JSON文件读取配置; 不可忽略返回值
 	[[nodiscard]] bool saveToFile(std::string_view filePath);			///< @brief 将当前配置保存到指定的JSON文件; 不可忽略返回值
 
+	/**
+	 * @brief 用命令行参数覆盖配置项(优先级高于配置文件, 不会写回文件).
+	 *
+	 * 支持: --headless[=software|null], --frames=N, --text=atlas|ttf, --hud-labels=N, --atlas=on|off, --frame-cache=on|off, --dynamic-res=on|off, --dirty-rects=on|off, --streaming=on|off
+	 * @param args 命令行参数(不含程序名)
+	 */
+	void applyCommandLine(const std::vector<std::string>& args);
+
 private:
 	void fromJson(const nlohmann::json& data);							///< @brief 删除拷贝构造
 	nlohmann::ordered_json toJson() const;								///< @brief 删除拷贝赋值构
@@ -48,7 +56,30 @@ public:
 	int mWindowHeight = 720;											///< @brief 窗口高度
 	bool mWindowResizable = true;										///< @brief 窗口是否可以调整尺寸
 	bool mVsyncEnabled = true;											///< @brief 是否启动垂直同步
+	bool mRenderThreadEnabled = false;									///< @brief 是否启用独立渲染线程(主线程提交渲染, 游戏逻辑在单独线程运行)
+	bool mHeadless = false;												///< @brief 无头模式: 不创建窗口, 渲染到离屏表面(用于CI和基准测试)
+	std::string mHeadlessBackend = "software";							///< @brief 无头模式后端: "software"为离屏软件渲染, "null"只统计渲染命令
+	std::string mTextBackend = "atlas";									///< @brief 文字绘制方式: "atlas"优先使用字形图集, "ttf"始终使用SDL_ttf排版
+	bool mTextureAtlasEnabled = true;									///< @brief 是否在加载关卡时把用到的图片打包进纹理图集
+	bool mFrameCacheEnabled = true;										///< @brief 帧缓存模式: 场景没有任何脏信号时(静态菜单)跳过录制, 提交和呈现
+	bool mFrameCacheVerifyEnabled = false;								///< @brief 帧缓存校验(调试用): 没有脏信号的帧仍然录制, 与上一次提交的帧比较命令哈希, 漏掉脏信号时输出警告
+	bool mDynamicResolutionEnabled = false;								///< @brief 动态分辨率: 根据帧耗时调整世界层的渲染分辨率, UI保持逻辑分辨率
+	float mDynamicResolutionMinScale = 0.5f;							///< @brief 动态分辨率的最小缩放
+	float mDynamicResolutionMaxScale = 1.f;								///< @brief 动态分辨率的最大缩放
+	bool mDirtyRectsEnabled = true;										///< @brief 脏矩形模式: 软件渲染器下只重绘内容变化的区域
+	float mDirtyRectThreshold = 0.5f;									///< @brief 脏区域面积占屏幕的比例超过该值时完整重绘
 	int mTargetFps = 144;												///< @brief 性能设置: 目标FPS, 设置0表示不限制
+	int mBenchmarkFrames = 0;											///< @brief 性能设置: 运行指定帧数后退出并输出统计(不限帧率), 0表示不启用
+	int mBenchmarkHudLabels = 0;										///< @brief 性能设置: 基准测试时每帧额外绘制的HUD文字行数(内容每帧变化), 0表示不绘制
+	int mLoaderThreads = 2;												///< @brief 性能设置: 异步加载资源的工作线程数量
+	float mUploadBudgetMs = 2.f;										///< @brief 性能设置: 每帧用于上传异步加载资源(创建纹理等)的时间预算(毫秒)
+	bool mPreloadParallel = true;										///< @brief 性能设置: 场景初始化时是否用工作线程并行预加载资源清单
+	std::string mAssetPackPath = "assets.pak";							///< @brief 性能设置: 资源包路径, 不存在时从散装文件加载, 为空表示不使用资源包
+	bool mAssetPackLooseCheck = false;									///< @brief 性能设置(开发选项): 比资源包新的散装文件优先, 每个条目第一次读取时检查一次修改时间
+	int mResourcePoolBudgetMb = 64;										///< @brief 性能设置: 不再被场景引用的资源保留在缓存中的预算(MB), 超出时淘汰最久未使用的
+	bool mLevelStreamingEnabled = false;								///< @brief 性能设置: 流式关卡, 只创建相机附近的块中的瓦片和对象(用于超大地图)
+	int mLevelChunkSize = 32;											///< @brief 性能设置: 流式关卡的块边长(瓦片数)
+	int mLevelStreamingRadius = 1;										///< @brief 性能设置: 流式关卡在相机视野之外额外保持加载的块数(每个方向)
 	float mMusicVolume = 0.5f;											///< @brief 音频设置: 音乐大小
 	float mSoundVolume = 0.5f;											///< @brief 音频设置: 音效大小
 
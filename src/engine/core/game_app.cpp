@@ -1,3 +1,7 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <thread>
 #include <SDL3/SDL.h>
 #include <spdlog/spdlog.h>
 
@@ -11,9 +15,12 @@
 #include "../render/renderer.h"
 #include "../render/camera.h"
 #include "../render/text_renderer.h"
+#include "../render/render_task_queue.h"
+#include "../render/dynamic_resolution.h"
 #include "../input/input_manager.h"
 #include "../physics/physics_engine.h"
 #include "../scene/scene_manager.h"
+#include "../scene/level_streamer.h"
 
 engine::core::GameApp::GameApp() = default;
 
@@ -30,18 +37,18 @@ void engine::core::GameApp::run() {
 		return;
 	}
 
-
-	while (mIsRunning) {
-		mTime->update();
-		float delta = mTime->getDeltaTime(); // 每帧的时间间隔
-		mInputManager->update();
-		handleEvents();
-		update(delta);
-		render();
-
-		// spdlog::info("Delta Time: {}", delta);
+	if (mConfig->mRenderThreadEnabled) {
+		runWithRenderThread();
+	}
+	else {
+		while (mIsRunning) {
+			runFrame();
+		}
 	}
 
+	if (mConfig->mBenchmarkFrames > 0) {
+		reportBenchmark();
+	}
 	close();
 }
 
@@ -50,6 +57,13 @@ void engine::core::GameApp::registerSceneSetup(std::function<void(engine::scene:
 	spdlog::trace("GameApp 已注册场景设置函数");
 }
 
+void engine::core::GameApp::setCommandLineArgs(int argc, char* argv[]) {
+	mCommandLineArgs.clear();
+	for (int i = 1; i < argc; ++i) {
+		mCommandLineArgs.emplace_back(argv[i]);
+	}
+}
+
 bool engine::core::GameApp::init() {
 	spdlog::trace("{} 初始化...", mLogTag.data());
 
@@ -80,6 +94,115 @@ bool engine::core::GameApp::init() {
 	return true;
 }
 
+void engine::core::GameApp::runFrame() {
+	mTime->update();
+	mFrameStartTimeNs = SDL_GetTicksNS();
+	float delta = mTime->getDeltaTime(); // 每帧的时间间隔
+	mInputManager->update();
+	// 完成工作线程已解码资源的上传, 超出预算的留到下一帧
+	mResourceManager->processPendingLoads(mConfig->mUploadBudgetMs);
+	handleEvents();
+	update(delta);
+	render();
+
+	if (mConfig->mBenchmarkFrames > 0) {
+		recordBenchmarkFrame();
+	}
+	// spdlog::info("Delta Time: {}", delta);
+}
+
+void engine::core::GameApp::recordBenchmarkFrame() {
+	// 第一帧包含场景初始化和资源加载, 作为预热帧不计入统计
+	if (mBenchmarkStats.mStartTimeNs == 0) {
+		mBenchmarkStats.mStartTimeNs = SDL_GetTicksNS();
+		return;
+	}
+
+	const auto& frameStats = mRenderer->getFrameStats();
+	mBenchmarkStats.mCommandCount += frameStats.mCommandCount;
+	mBenchmarkStats.mTextureCount += frameStats.mTextureCount;
+	mBenchmarkStats.mFilledRectCount += frameStats.mFilledRectCount;
+	mBenchmarkStats.mTextCount += frameStats.mTextCount;
+	mBenchmarkStats.mGeometryCount += frameStats.mGeometryCount;
+	mBenchmarkStats.mVisibleObjectCount += frameStats.mVisibleObjectCount;
+	mBenchmarkStats.mCulledObjectCount += frameStats.mCulledObjectCount;
+	mBenchmarkStats.mSkippedPresentCount += frameStats.mIsPresentSkipped ? 1 : 0;
+	if (++mBenchmarkStats.mFrameCount >= mConfig->mBenchmarkFrames) {
+		mIsRunning = false;
+	}
+}
+
+void engine::core::GameApp::reportBenchmark() const {
+	const auto& stats = mBenchmarkStats;
+	if (stats.mFrameCount == 0) {
+		spdlog::warn("{} 基准测试没有记录到任何帧", mLogTag.data());
+		return;
+	}
+
+	double elapsedMs = static_cast<double>(SDL_GetTicksNS() - stats.mStartTimeNs) / 1e6;
+	double frames = static_cast<double>(stats.mFrameCount);
+	spdlog::info("{} 基准测试完成: {} 帧, 总耗时 {:.2f} ms, 平均帧时间 {:.3f} ms ({:.1f} FPS)",
+		mLogTag.data(), stats.mFrameCount, elapsedMs, elapsedMs / frames, frames * 1000.0 / elapsedMs);
+	spdlog::info("{} 平均每帧命令: 总计 {:.1f}, 纹理 {:.1f}, 填充矩形 {:.1f}, 文字 {:.1f}, 几何 {:.1f}",
+		mLogTag.data(), stats.mCommandCount / frames, stats.mTextureCount / frames, stats.mFilledRectCount / frames, stats.mTextCount / frames, stats.mGeometryCount / frames);
+	spdlog::info("{} 平均每帧游戏对象: 提交渲染 {:.1f}, 视口裁剪 {:.1f}",
+		mLogTag.data(), stats.mVisibleObjectCount / frames, stats.mCulledObjectCount / frames);
+	spdlog::info("{} 帧缓存跳过提交: {} 帧 ({:.1f}%)", mLogTag.data(), stats.mSkippedPresentCount, stats.mSkippedPresentCount * 100.0 / frames);
+	spdlog::info("{} 文字绘制方式: {}, 额外HUD文字: {} 行, 纹理图集: {}", mLogTag.data(), mConfig->mTextBackend, mConfig->mBenchmarkHudLabels, mConfig->mTextureAtlasEnabled ? "开启" : "关闭");
+	spdlog::info("{} 脏矩形局部重绘: {} 帧", mLogTag.data(), mRenderer->getPartialRedrawCount());
+	auto cacheStats = mResourceManager->getCacheStats();
+	spdlog::info("{} 资源缓存: 常驻 {} 项 {:.2f} MB (LRU池 {:.2f} MB), 命中 {}, 未命中 {}, 淘汰 {}",
+		mLogTag.data(), cacheStats.mResidentCount, cacheStats.mResidentBytes / (1024.0 * 1024.0), cacheStats.mPooledBytes / (1024.0 * 1024.0),
+		cacheStats.mHits, cacheStats.mMisses, cacheStats.mEvictions);
+	if (mDynamicResolution) {
+		spdlog::info("{} 动态分辨率: 结束时世界层缩放 {:.2f}, 平滑帧时间 {:.3f} ms", mLogTag.data(), mDynamicResolution->getScale(), mDynamicResolution->getSmoothedFrameTime());
+	}
+}
+
+void engine::core::GameApp::renderBenchmarkHud() {
+	// 模拟HUD较多的场景: 每行文字的内容每帧都在变化(如分数, 计时), 用于对比字形图集与SDL_ttf两种绘制方式
+	constexpr std::string_view fontId = "assets/fonts/VonwaonBitmap-16px.ttf";
+	constexpr int fontSize = 16;
+	constexpr int rowsPerColumn = 20;
+	for (int i = 0; i < mConfig->mBenchmarkHudLabels; ++i) {
+		std::string text = "HUD " + std::to_string(i) + " : " + std::to_string(mBenchmarkStats.mFrameCount + i);
+		glm::vec2 position(10.0f + (i / rowsPerColumn) * 160.0f, 10.0f + (i % rowsPerColumn) * 18.0f);
+		mTextRenderer->drawUIText(text, fontId, fontSize, position);
+	}
+}
+
+void engine::core::GameApp::runWithRenderThread() {
+	spdlog::info("{} 启用独立渲染线程: 游戏逻辑在游戏线程运行, 主线程负责事件, 资源上传和提交渲染", mLogTag.data());
+	mRenderer->setThreaded(true);
+	mInputManager->setEventQueueEnabled(true);
+
+	// 游戏线程: 更新逻辑并录制每一帧的渲染命令
+	std::atomic<bool> isGameThreadFinished = false;
+	std::thread gameThread([this, &isGameThreadFinished] {
+		while (mIsRunning) {
+			runFrame();
+		}
+		isGameThreadFinished = true;
+		mRenderTaskQueue->notify();
+	});
+
+	// 主线程即渲染线程(SDL要求事件和渲染器在创建它们的线程上使用)
+	// 必须一直处理任务直到游戏线程退出, 否则等待资源加载的游戏线程会死锁
+	while (!isGameThreadFinished) {
+		mInputManager->pumpEvents();
+		mRenderTaskQueue->processTasks();
+		if (!mRenderer->presentPublishedFrame()) {
+			// 没有新帧时短暂等待, 新帧发布或任务入队会立即唤醒
+			mRenderTaskQueue->waitForWork(std::chrono::milliseconds(1));
+		}
+	}
+	gameThread.join();
+
+	mInputManager->setEventQueueEnabled(false);
+	mRenderer->setThreaded(false);
+	spdlog::trace("{} 游戏线程已退出", mLogTag.data());
+}
+
 void engine::core::GameApp::handleEvents() {
 	if (mInputManager->shouldQuit()) {
 		spdlog::trace("{} 收到来自 InputManager 的退出请求.", mLogTag.data());
@@ -96,12 +219,37 @@ void engine::core::GameApp::update(float delta) {
 }
 
 void engine::core::GameApp::render() {
+	// 窗口重新显示或尺寸变化后屏幕内容可能已失效, 即使画面没有变化也要完整重绘
+	if (mInputManager->isWindowInvalidated()) {
+		mRenderer->invalidateFrame();
+	}
+	// 帧缓存模式: 场景没有任何脏信号时不遍历场景也不录制命令, 屏幕保持显示上一帧(基准测试的HUD每帧都在变化)
+	if (!mRenderer->beginFrame(mConfig->mBenchmarkHudLabels > 0 || mSceneManager->isRenderDirty())) {
+		return;
+	}
 	//1. 清除屏幕
 	mRenderer->clearScreen();
 	//2. 具体渲染代码
 	mSceneManager->render();
+	if (mConfig->mBenchmarkHudLabels > 0) {
+		renderBenchmarkHud();
+	}
 	//3. 更新屏幕显示
+	float recordTimeMs = static_cast<float>(SDL_GetTicksNS() - mFrameStartTimeNs) / 1e6f;
 	mRenderer->present();
+	if (mDynamicResolution) {
+		updateDynamicResolution(recordTimeMs);
+	}
+}
+
+void engine::core::GameApp::updateDynamicResolution(float recordTimeMs) {
+	// 单线程模式下录制和提交串行执行; 渲染线程模式下两者并行, 取较慢的一方(提交时间为渲染线程最近完成的一帧)
+	// 提交时间不含SDL_RenderPresent, 避免把垂直同步的等待误判为负载
+	float submitTimeMs = mRenderer->getSubmitTime();
+	float frameTimeMs = mRenderer->isThreaded() ? std::max(recordTimeMs, submitTimeMs) : recordTimeMs + submitTimeMs;
+	if (mDynamicResolution->update(frameTimeMs)) {
+		mRenderer->setWorldScale(mDynamicResolution->getScale());
+	}
 }
 
 void engine::core::GameApp::close() {
@@ -111,12 +259,21 @@ void engine::core::GameApp::close() {
 	mSceneManager->clean();
 
 	// 为了确保正确的销毁顺序, 有些智能指针对象需要手动管理
+	// 缓存的 TTF_Text 引用了字体, 必须在字体关闭之前销毁
+	mTextRenderer->clearTextCache();
+	// 冻结场景的缓存纹理和动态分辨率的世界层纹理同样必须在销毁SDL_Renderer之前释放(交给资源管理器, 在它析构时销毁)
+	mRenderer->releaseFrameCapture();
+	mRenderer->releaseWorldLayer();
 	mResourceManager.reset();
 
 	if (mSDLRenderer != nullptr) {
 		SDL_DestroyRenderer(mSDLRenderer);
 		mSDLRenderer = nullptr;
 	}
+	if (mOffscreenSurface != nullptr) {
+		SDL_DestroySurface(mOffscreenSurface);
+		mOffscreenSurface = nullptr;
+	}
 	if (mWindow != nullptr) {
 		SDL_DestroyWindow(mWindow);
 		mWindow = nullptr;
@@ -128,6 +285,7 @@ void engine::core::GameApp::close() {
 bool engine::core::GameApp::initConfig() {
 	try {
 		mConfig = std::make_unique<engine::core::Config>("assets/config.json");
+		mConfig->applyCommandLine(mCommandLineArgs);
 	}
 	catch (const std::exception& e) {
 		spdlog::error("{} 初始化配置失败: {}", mLogTag.data(), e.what());
@@ -138,6 +296,10 @@ bool engine::core::GameApp::initConfig() {
 }
 
 bool engine::core::GameApp::initSDL() {
+	if (mConfig->mHeadless) {
+		return initHeadlessSDL();
+	}
+
 	if (!SDL_Init(SDL_INIT_VIDEO | SDL_INIT_AUDIO)) {
 		spdlog::error("{} 无法创建窗口! SDL错误: {}", mLogTag.data(), SDL_GetError());
 		return false;
@@ -158,6 +320,9 @@ bool engine::core::GameApp::initSDL() {
 	// 设置渲染器支持透明色
 	SDL_SetRenderDrawBlendMode(mSDLRenderer, SDL_BLENDMODE_BLEND);
 
+	// 创建渲染器的线程即渲染线程, 其他线程对渲染器的访问都通过该任务队列转交
+	mRenderTaskQueue = std::make_unique<engine::render::RenderTaskQueue>();
+
 	// 设置VSync(注意:VSync开启时, 驱动程序会尝试将帧率限制到显示器刷新率, 有可能会覆盖手动设置的mTargetFps)
 	int vsyncMode = mConfig->mVsyncEnabled ? SDL_RENDERER_VSYNC_ADAPTIVE : SDL_RENDERER_VSYNC_DISABLED;
 	SDL_SetRenderVSync(mSDLRenderer, vsyncMode);
@@ -169,6 +334,37 @@ bool engine::core::GameApp::initSDL() {
 	return true;
 }
 
+bool engine::core::GameApp::initHeadlessSDL() {
+	// 无显示/声卡的构建机上使用SDL内置的哑驱动, 事件和音频接口依然可用
+	SDL_SetHint(SDL_HINT_VIDEO_DRIVER, "dummy");
+	SDL_SetHint(SDL_HINT_AUDIO_DRIVER, "dummy");
+	if (!SDL_Init(SDL_INIT_VIDEO | SDL_INIT_AUDIO)) {
+		spdlog::error("{} 无头模式初始化SDL失败! SDL错误: {}", mLogTag.data(), SDL_GetError());
+		return false;
+	}
+
+	// 不创建窗口, 软件渲染器直接绘制到离屏表面
+	mOffscreenSurface = SDL_CreateSurface(mConfig->mWindowWidth, mConfig->mWindowHeight, SDL_PIXELFORMAT_RGBA8888);
+	if (mOffscreenSurface == nullptr) {
+		spdlog::error("{} 无法创建离屏表面! SDL错误: {}", mLogTag.data(), SDL_GetError());
+		return false;
+	}
+
+	mSDLRenderer = SDL_CreateSoftwareRenderer(mOffscreenSurface);
+	if (mSDLRenderer == nullptr) {
+		spdlog::error("{} 无法创建软件渲染器! SDL错误: {}", mLogTag.data(), SDL_GetError());
+		return false;
+	}
+
+	SDL_SetRenderDrawBlendMode(mSDLRenderer, SDL_BLENDMODE_BLEND);
+	mRenderTaskQueue = std::make_unique<engine::render::RenderTaskQueue>();
+
+	// 与窗口模式保持相同的逻辑分辨率, 保证场景布局一致
+	SDL_SetRenderLogicalPresentation(mSDLRenderer, mConfig->mWindowWidth / 2, mConfig->mWindowHeight / 2, SDL_LOGICAL_PRESENTATION_LETTERBOX);
+	spdlog::info("{} 以无头模式运行, 后端: {}, 离屏表面 {}x{}", mLogTag.data(), mConfig->mHeadlessBackend, mConfig->mWindowWidth, mConfig->mWindowHeight);
+	return true;
+}
+
 bool engine::core::GameApp::initTime() {
 	try {
 		mTime = std::make_unique<Time>();
@@ -177,19 +373,26 @@ bool engine::core::GameApp::initTime() {
 		spdlog::error("{} 初始化时间管理器失败: {}", mLogTag.data(), e.what());
 		return false;
 	}
-	mTime->setTargetFps(mConfig->mTargetFps);
+	// 基准测试需要测量吞吐量, 不限制帧率
+	mTime->setTargetFps(mConfig->mBenchmarkFrames > 0 ? 0 : mConfig->mTargetFps);
 	spdlog::trace("{} 时间管理初始化成功", mLogTag.data());
 	return true;
 }
 
 bool engine::core::GameApp::initResourceManager() {
 	try {
-		mResourceManager = std::make_unique<engine::resource::ResourceManager>(mSDLRenderer);
+		mResourceManager = std::make_unique<engine::resource::ResourceManager>(mSDLRenderer, mRenderTaskQueue.get(), mConfig->mLoaderThreads);
 	}
 	catch (const std::exception& e) {
 		spdlog::error("{} 初始化资源管理器失败: {}", mLogTag.data(), e.what());
 		return false;
 	}
+	if (!mConfig->mAssetPackPath.empty()) {
+		mResourceManager->mountAssetPack(mConfig->mAssetPackPath, mConfig->mAssetPackLooseCheck);
+	}
+	mResourceManager->setTextureAtlasEnabled(mConfig->mTextureAtlasEnabled);
+	mResourceManager->setPreloadParallel(mConfig->mPreloadParallel);
+	mResourceManager->setPoolBudget(static_cast<std::size_t>(mConfig->mResourcePoolBudgetMb) * 1024 * 1024);
 	spdlog::trace("{} 资源管理器成功", mLogTag.data());
 	return true;
 }
@@ -210,7 +413,18 @@ bool engine::core::GameApp::initAudioPlayer() {
 
 bool engine::core::GameApp::initRenderer() {
 	try {
-		mRenderer = std::make_unique<engine::render::Renderer>(mSDLRenderer, mResourceManager.get());
+		mRenderer = std::make_unique<engine::render::Renderer>(mSDLRenderer, mResourceManager.get(), mRenderTaskQueue.get());
+		mRenderer->setNullBackend(mConfig->mHeadless && mConfig->mHeadlessBackend == "null");
+		mRenderer->setFrameCacheEnabled(mConfig->mFrameCacheEnabled);
+		mRenderer->setFrameCacheVerifyEnabled(mConfig->mFrameCacheVerifyEnabled);
+		mRenderer->setDirtyRectsEnabled(mConfig->mDirtyRectsEnabled, mConfig->mDirtyRectThreshold);
+		if (mConfig->mDynamicResolutionEnabled) {
+			int targetFps = mConfig->mTargetFps > 0 ? mConfig->mTargetFps : 60;
+			mDynamicResolution = std::make_unique<engine::render::DynamicResolution>(
+				mConfig->mDynamicResolutionMinScale, mConfig->mDynamicResolutionMaxScale, 1000.f / static_cast<float>(targetFps));
+			mRenderer->setDynamicResolutionEnabled(true);
+			mRenderer->setWorldScale(mDynamicResolution->getScale());
+		}
 	}
 	catch (const std::exception& e) {
 		spdlog::error("{} 初始化渲染器失败: {}", mLogTag.data(), e.what());
@@ -222,7 +436,9 @@ bool engine::core::GameApp::initRenderer() {
 
 bool engine::core::GameApp::initTextRenderer() {
 	try {
-		mTextRenderer = std::make_unique<engine::render::TextRenderer>(mSDLRenderer, mResourceManager.get());
+		mTextRenderer = std::make_unique<engine::render::TextRenderer>(mRenderer.get(), mResourceManager.get());
+		mRenderer->setTextRenderer(mTextRenderer.get());
+		mTextRenderer->setGlyphAtlasEnabled(mConfig->mTextBackend == "atlas");
 	}
 	catch (const std::exception& e) {
 		spdlog::error("初始化文字渲染引擎失败: {}", e.what());
@@ -298,6 +514,7 @@ bool engine::core::GameApp::initSceneManager() {
 		spdlog::error("{} 初始化场景管理器失败: {}", mLogTag.data(), e.what());
 		return false;
 	}
+	mSceneManager->setLevelStreamingSettings({ mConfig->mLevelStreamingEnabled, mConfig->mLevelChunkSize, mConfig->mLevelStreamingRadius });
 	spdlog::trace("{} 场景管理器初始化成功.", mLogTag.data());
 	return true;
 }
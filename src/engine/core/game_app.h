@@ -5,10 +5,14 @@
 
 #include <memory>
 #include <functional>
+#include <string>
+#include <vector>
+#include <cstdint>
 
 // 前向声明, 减少头文件依赖, 增加编译速度
 struct SDL_Window;
 struct SDL_Renderer;
+struct SDL_Surface;
 
 namespace engine::resource {
 class ResourceManager;
@@ -18,6 +22,8 @@ namespace engine::render {
 class Renderer;
 class Camera;
 class TextRenderer;
+class RenderTaskQueue;
+class DynamicResolution;
 }
 
 namespace engine::input {
@@ -61,6 +67,14 @@ public:
 	 */
 	void registerSceneSetup(std::function<void(engine::scene::SceneManager&)> func);
 
+	/**
+	 * @brief 设置命令行参数, 在init()中加载配置后覆盖对应的配置项.
+	 *
+	 * @param argc 参数个数
+	 * @param argv 参数列表(argv[0]为程序名, 会被忽略)
+	 */
+	void setCommandLineArgs(int argc, char* argv[]);
+
 	// 禁止拷贝和移动构造
 	GameApp(const GameApp&) = delete;
 	GameApp& operator=(const GameApp&) = delete;
@@ -69,6 +83,12 @@ public:
 
 private:
 	[[nodiscard]] bool init();	// nodiscard 表示函数返回值不应该被忽略
+	void runFrame();
+	void runWithRenderThread();
+	void recordBenchmarkFrame();
+	void reportBenchmark() const;
+	void renderBenchmarkHud();
+	void updateDynamicResolution(float recordTimeMs);
 	void handleEvents();
 	void update(float delta);
 	void render();
@@ -77,6 +97,7 @@ private:
 	// 各模块的初始化/创建函数, 在init()中调用
 	[[nodiscard]] bool initConfig();
 	[[nodiscard]] bool initSDL();
+	[[nodiscard]] bool initHeadlessSDL();
 	[[nodiscard]] bool initTime();
 	[[nodiscard]] bool initResourceManager();
 	[[nodiscard]] bool initAudioPlayer();
@@ -101,17 +122,36 @@ private:
 
 	SDL_Window* mWindow = nullptr;
 	SDL_Renderer* mSDLRenderer = nullptr;
+	SDL_Surface* mOffscreenSurface = nullptr;		// 无头模式下软件渲染器的目标表面
 	bool mIsRunning = false;
+	std::vector<std::string> mCommandLineArgs;
+	std::uint64_t mFrameStartTimeNs = 0;			// 本帧逻辑开始的时间戳(不含帧率限制的等待), 用于动态分辨率测量帧耗时
+
+	// 基准测试统计(Config::mBenchmarkFrames > 0时启用)
+	struct BenchmarkStats {
+		int mFrameCount = 0;
+		std::uint64_t mStartTimeNs = 0;
+		long long mCommandCount = 0;
+		long long mTextureCount = 0;
+		long long mFilledRectCount = 0;
+		long long mTextCount = 0;
+		long long mGeometryCount = 0;
+		long long mVisibleObjectCount = 0;
+		long long mCulledObjectCount = 0;
+		long long mSkippedPresentCount = 0;
+	} mBenchmarkStats;
 
 	// 游戏场景设置函数, 用于在运行游戏前设置初始化场景(GameApp不再决定初始场景)
 	// engine 模块作为底层不应该引用game中的文件, 应遵循上层引用下层的原则
 	std::function<void(engine::scene::SceneManager&)> mSceneSetupFunc;
 
 	// 引擎组件
+	std::unique_ptr<engine::render::RenderTaskQueue> mRenderTaskQueue;
 	std::unique_ptr<engine::core::Time> mTime;
 	std::unique_ptr<engine::core::Config> mConfig;
 	std::unique_ptr<engine::resource::ResourceManager> mResourceManager;
 	std::unique_ptr<engine::render::Renderer> mRenderer;
+	std::unique_ptr<engine::render::DynamicResolution> mDynamicResolution;	// 未启用动态分辨率时为空
 	std::unique_ptr<engine::render::Camera> mCamera;
 	std::unique_ptr<engine::render::TextRenderer> mTextRenderer;
 	std::unique_ptr<engine::input::InputManager> mInputManager;
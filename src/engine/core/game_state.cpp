@@ -5,9 +5,12 @@
 namespace engine::core {
 GameState::GameState(SDL_Window* window, SDL_Renderer* renderer, State initialState)
 	: mWindow(window), mRenderer(renderer), mCurrentState(initialState) {
-	if (mWindow == nullptr || mRenderer == nullptr) {
-		spdlog::error("窗口或渲染器为空");
-		throw std::runtime_error("窗口或渲染器不能为空");
+	if (mRenderer == nullptr) {
+		spdlog::error("渲染器为空");
+		throw std::runtime_error("渲染器不能为空");
+	}
+	if (mWindow == nullptr) {
+		spdlog::info("未提供窗口, 以无头模式运行");
 	}
 	spdlog::trace("游戏状态初始化完成");
 }
@@ -24,12 +27,21 @@ void GameState::setState(State newState) {
 
 glm::vec2 GameState::getWindowSize() const {
 	int width, height;
+	if (mWindow == nullptr) {
+		// 无头模式没有窗口, 离屏表面的尺寸即输出尺寸
+		SDL_GetRenderOutputSize(mRenderer, &width, &height);
+		return glm::vec2(width, height);
+	}
 	// SDL3获取窗口大小的方法
 	SDL_GetWindowSize(mWindow, &width, &height);
 	return glm::vec2(width, height);
 }
 
 void GameState::setWindowSize(glm::vec2 newSize) {
+	if (mWindow == nullptr) {
+		spdlog::warn("无头模式下无法设置窗口大小");
+		return;
+	}
 	SDL_SetWindowSize(mWindow, static_cast<int>(newSize.x), static_cast<int>(newSize.y));
 }
 
@@ -41,7 +41,7 @@ class GameState final {
 public:
     /**
 	* @brief 构造函数，初始化游戏状态。
-	* @param window SDL窗口，必须传入有效值。
+	* @param window SDL窗口，无头模式下可以为空（此时窗口大小取渲染输出大小）。
 	* @param renderer SDL渲染器，必须传入有效值。
 	* @param initial_state 游戏的初始状态，默认为 Title
 	*/
@@ -61,7 +61,7 @@ public:
     bool isGameOver() const { return mCurrentState == State::GameOver; }
 
 private:
-	SDL_Window* mWindow = nullptr;              ///< @brief SDL窗口，用于获取窗口大小
+	SDL_Window* mWindow = nullptr;              ///< @brief SDL窗口，用于获取窗口大小（无头模式下为空）
 	SDL_Renderer* mRenderer = nullptr;          ///< @brief SDL渲染器，用于获取逻辑分辨率
 	State mCurrentState = State::Title;        ///< @brief 当前游戏状态
 };
@@ -19,6 +19,9 @@ InputManager::InputManager(SDL_Renderer* renderer, const engine::core::Config* c
 	float x, y;
 	SDL_GetMouseState(&x, &y);
 	mMousePosition = { x, y };
+	mPumpedMousePosition = mMousePosition;
+	SDL_RenderCoordinatesFromWindow(mSDLRenderer, x, y, &mLogicalMousePosition.x, &mLogicalMousePosition.y);
+	mPumpedLogicalMousePosition = mLogicalMousePosition;
 	spdlog::trace("{} 初始鼠标位置: ({}, {})", mLogTag.data(), mMousePosition.x, mMousePosition.y);
 }
 
@@ -33,11 +36,51 @@ void InputManager::update() {
 		}
 	}
 
+	mIsWindowInvalidated = false;
+	mHasMouseChanged = false;
+
 	// 2.处理所有待处理的SDL事件(设定ActionStates的值)
+	if (mIsEventQueueEnabled) {
+		{
+			std::lock_guard<std::mutex> lock(mEventMutex);
+			mProcessingEvents.swap(mPendingEvents);
+			mLogicalMousePosition = mPumpedLogicalMousePosition;
+		}
+		for (const auto& event : mProcessingEvents) {
+			processEvent(event);
+		}
+		mProcessingEvents.clear();
+		return;
+	}
+
 	SDL_Event event;
 	while (SDL_PollEvent(&event)) {
 		processEvent(event);
 	}
+
+	// 3.每帧只换算一次逻辑坐标, UI状态机可以多次查询
+	SDL_RenderCoordinatesFromWindow(mSDLRenderer, mMousePosition.x, mMousePosition.y, &mLogicalMousePosition.x, &mLogicalMousePosition.y);
+}
+
+void InputManager::pumpEvents() {
+	std::lock_guard<std::mutex> lock(mEventMutex);
+	SDL_Event event;
+	while (SDL_PollEvent(&event)) {
+		if (event.type == SDL_EVENT_MOUSE_MOTION) {
+			mPumpedMousePosition = { event.motion.x, event.motion.y };
+		}
+		else if (event.type == SDL_EVENT_MOUSE_BUTTON_DOWN || event.type == SDL_EVENT_MOUSE_BUTTON_UP) {
+			mPumpedMousePosition = { event.button.x, event.button.y };
+		}
+		mPendingEvents.push_back(event);
+	}
+
+	// 逻辑坐标换算依赖渲染器状态, 必须在拥有渲染器的主线程上完成
+	SDL_RenderCoordinatesFromWindow(mSDLRenderer, mPumpedMousePosition.x, mPumpedMousePosition.y, &mPumpedLogicalMousePosition.x, &mPumpedLogicalMousePosition.y);
+}
+
+void InputManager::setEventQueueEnabled(bool enabled) {
+	mIsEventQueueEnabled = enabled;
 }
 
 bool InputManager::isActionDown(std::string_view actionName) const {
@@ -66,6 +109,14 @@ bool InputManager::shouldQuit() const {
 	return mShouldQuit;
 }
 
+bool InputManager::isWindowInvalidated() const {
+	return mIsWindowInvalidated;
+}
+
+bool InputManager::hasMouseChanged() const {
+	return mHasMouseChanged;
+}
+
 void InputManager::setShouldQuit(bool shouldQuit) {
 	mShouldQuit = shouldQuit;
 }
@@ -75,9 +126,7 @@ glm::vec2 InputManager::getMousePosition() const {
 }
 
 glm::vec2 InputManager::getLogicalMousePosition() const {
-	glm::vec2 logicPosition;
-	SDL_RenderCoordinatesFromWindow(mSDLRenderer, mMousePosition.x, mMousePosition.y, &logicPosition.x, &logicPosition.y);
-	return logicPosition;
+	return mLogicalMousePosition;
 }
 
 void InputManager::processEvent(const SDL_Event& event) {
@@ -112,14 +161,27 @@ void InputManager::processEvent(const SDL_Event& event) {
 		}
 		// 在点击时更新鼠标位置
 		mMousePosition = { event.button.x, event.button.y };
+		mHasMouseChanged = true;
 		break;
 	}
 	case SDL_EVENT_MOUSE_MOTION:
 		mMousePosition = { event.motion.x, event.motion.y };
+		mHasMouseChanged = true;
 		break;
 	case SDL_EVENT_QUIT:
 		mShouldQuit = true;
 		break;
+	case SDL_EVENT_RENDER_TARGETS_RESET:
+	case SDL_EVENT_RENDER_DEVICE_RESET:
+		mIsWindowInvalidated = true;
+		break;
+	default:
+		// 窗口显示, 遮挡, 尺寸变化等事件后屏幕上的内容可能已失效
+		if (event.type >= SDL_EVENT_WINDOW_FIRST && event.type <= SDL_EVENT_WINDOW_LAST) {
+			mIsWindowInvalidated = true;
+			mHasMouseChanged = true;
+		}
+		break;
 	}
 }
 
@@ -16,6 +16,7 @@
 #include <unordered_map>
 #include <vector>
 #include <variant>
+#include <mutex>
 #include <SDL3/SDL_render.h>
 #include <glm/vec2.hpp>
 
@@ -51,6 +52,8 @@ public:
 	InputManager(SDL_Renderer* renderer, const engine::core::Config* config);
 
 	void update();																								///< @brief 更新输入状态, 每轮循环最先调用
+	void pumpEvents();																							///< @brief 渲染线程模式下由主线程调用: 取出SDL事件并缓存, 等待游戏线程在update()中处理
+	void setEventQueueEnabled(bool enabled);																	///< @brief 设置是否从pumpEvents()缓存的事件队列中读取事件(渲染线程模式)
 
 	bool isActionDown(std::string_view actionName) const;														///< @brief 动作当前是否触发 (持续按下或本帧按下)
 	bool isActionPressed(std::string_view actionName) const;													///< @brief 动作是否在本帧刚刚按下
@@ -59,9 +62,11 @@ public:
 	bool shouldQuit() const;																					///< @brief 查询退出状态
 
 	void setShouldQuit(bool shouldQuit);																		///< @brief 设置退出状态
+	bool isWindowInvalidated() const;																			///< @brief 本帧是否收到窗口/渲染设备事件(窗口被遮挡后重新显示, 尺寸变化等), 需要完整重绘
+	bool hasMouseChanged() const;																				///< @brief 本帧鼠标是否移动, 按键是否变化(或窗口变化导致逻辑坐标可能改变), 用于决定UI是否需要重新命中测试
 
 	glm::vec2 getMousePosition() const;																			///< @brief 获取鼠标位置(屏幕坐标)
-	glm::vec2 getLogicalMousePosition() const;																	///< @brief 获取鼠标位置(逻辑坐标)
+	glm::vec2 getLogicalMousePosition() const;																	///< @brief 获取鼠标位置(逻辑坐标), 每帧在update()中计算一次
 
 private:
 	void processEvent(const SDL_Event& event);																	///< @brief 处理SDL事件, 将按键转换为动作状态
@@ -78,7 +83,18 @@ private:
 	std::unordered_map<std::variant<SDL_Scancode, Uint32>, std::vector<std::string>> mInputToActionsMappings;	///< @brief 从键盘(Scancode)到关联的动作名称列表
 	std::unordered_map<std::string, ActionState> mActionStates;													///< @brief 存储每个动作的当前状态
 	bool mShouldQuit = false;																					///< @brief 推出标志
+	bool mIsWindowInvalidated = false;																			///< @brief 本帧是否收到需要完整重绘的窗口事件
+	bool mHasMouseChanged = false;																				///< @brief 本帧鼠标是否移动或按键变化
 	glm::vec2 mMousePosition;																					///< @brief 鼠标位置(针对屏幕坐标)
+	glm::vec2 mLogicalMousePosition;																			///< @brief 鼠标位置(针对逻辑坐标)
+
+	// 渲染线程模式: SDL事件只能在主线程获取, 由pumpEvents()缓存后交给游戏线程处理
+	bool mIsEventQueueEnabled = false;																			///< @brief 是否从事件队列读取事件
+	std::mutex mEventMutex;																						///< @brief 保护事件队列和待同步的逻辑鼠标位置
+	std::vector<SDL_Event> mPendingEvents;																		///< @brief 主线程缓存的待处理事件
+	std::vector<SDL_Event> mProcessingEvents;																	///< @brief 游戏线程正在处理的事件(与mPendingEvents交换以复用内存)
+	glm::vec2 mPumpedMousePosition;																				///< @brief 主线程看到的最新鼠标位置(屏幕坐标)
+	glm::vec2 mPumpedLogicalMousePosition;																		///< @brief 主线程换算好的最新鼠标位置(逻辑坐标)
 };
 } // engine::input
 
@@ -1,4 +1,5 @@
 #include "animation.h"
+#include <algorithm>
 #include <glm/common.hpp>
 #include <spdlog/spdlog.h>
 
@@ -14,8 +15,12 @@ void Animation::addFrame(const SDL_FRect& sourceRect, float duration) {
 		return;
 	}
 
+	if (!mFrames.empty() && duration != mFrames.front().mDuration) {
+		mIsUniform = false;
+	}
 	mFrames.push_back(AnimationFrame(sourceRect, duration));
 	mTotalDuration += duration;
+	mFrameEndTimes.push_back(mTotalDuration);
 }
 
 const AnimationFrame& Animation::getFrame(float time) const {
@@ -23,31 +28,39 @@ const AnimationFrame& Animation::getFrame(float time) const {
 		spdlog::error("{} : 动画 '{}' 没有帧, 无法获取帧", mLogTag.data(), mName);
 		return mFrames.back();
 	}
+	return mFrames[getFrameIndex(time)];
+}
+
+size_t Animation::getFrameIndex(float time) const {
+	if (mFrames.empty()) {
+		return 0;
+	}
 
 	float currentTime = time;
 	if (mLoop && mTotalDuration > 0.f) {
 		// 对循环动画使用模运算获取有效时间
 		currentTime = glm::mod(time, mTotalDuration);
 	}
-	else {
+	else if (currentTime >= mTotalDuration) {
 		// 对于非循环动画, 如果时间超过总时长, 则停留在最后一帧
-		if (currentTime >= mTotalDuration) {
-			return mFrames.back();
-		}
+		return mFrames.size() - 1;
+	}
+	if (currentTime <= 0.f) {
+		return 0;
 	}
 
-	// 遍历帧以找到正确的帧
-	float accumulatedTime = 0.f;
-	for (const auto& frame : mFrames) {
-		accumulatedTime += frame.mDuration;
-		if (currentTime < accumulatedTime) {
-			return frame;
-		}
+	size_t index = 0;
+	if (mIsUniform) {
+		// 等时长动画: 直接计算索引
+		index = static_cast<size_t>(currentTime / mFrames.front().mDuration);
+	}
+	else {
+		// 找到第一个结束时间大于当前时间的帧
+		auto iter = std::upper_bound(mFrameEndTimes.begin(), mFrameEndTimes.end(), currentTime);
+		index = static_cast<size_t>(iter - mFrameEndTimes.begin());
 	}
-	
-	// 理论上在不应到达这里, 但为了安全起见, 返回最后一帧
-	spdlog::warn("{} : 动画 '{}' 在获取帧信息时出现错误.", mLogTag.data(), mName);
-	return mFrames.back();
+	// 浮点误差可能导致索引越界, 限制在最后一帧
+	return std::min(index, mFrames.size() - 1);
 }
 
 std::string_view Animation::getName() const {
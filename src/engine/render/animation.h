@@ -32,6 +32,8 @@ struct AnimationFrame {
  * @brief 管理一系列动画帧.
  * 
  * 存储动画的帧, 总时长, 名称和循环行为
+ * 添加帧时预先计算每帧的累计结束时间, 采样时二分查找;
+ * 所有帧时长相同时直接用 时间/帧时长 得到帧索引
  */
 class Animation final {
 public:
@@ -46,6 +48,7 @@ public:
 
 	void addFrame(const SDL_FRect& sourceRect, float duration);					///< @brief 向动画添加一帧
 	const AnimationFrame& getFrame(float time) const;							///< @brief 获取给定时间点应该显示的动画帧
+	size_t getFrameIndex(float time) const;										///< @brief 获取给定时间点应该显示的帧索引, 动画没有帧时返回0
 
 	std::string_view getName() const;											///< @brief 获取动画名称
 	void setName(std::string_view name);										///< @brief 设置动画名称
@@ -60,6 +63,8 @@ private:
 	static constexpr std::string_view mLogTag = "Animation";					///< @brief 日志标识
 	std::string mName;															///< @brief 动画名称, 例如walk, idle	
 	std::vector<AnimationFrame> mFrames;										///< @brief 动画帧列表
+	std::vector<float> mFrameEndTimes;											///< @brief 每帧的累计结束时间, 与mFrames一一对应
+	bool mIsUniform = true;														///< @brief 所有帧的持续时间是否相同
 	float mTotalDuration = 0.f;													///< @brief 动画的总持续时间 (秒)
 	bool mLoop = true;															///< @brief 默认动画是循环的
 };
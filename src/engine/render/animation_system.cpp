@@ -0,0 +1,71 @@
+#include "animation_system.h"
+#include "animation.h"
+#include "../component/animation_component.h"
+#include "../component/sprite_component.h"
+#include <spdlog/spdlog.h>
+
+namespace engine::render {
+std::size_t AnimationSystem::registerComponent(engine::component::AnimationComponent* component, engine::component::SpriteComponent* sprite) {
+	AnimatorState state;
+	state.mComponent = component;
+	state.mSprite = sprite;
+	mStates.push_back(state);
+	spdlog::trace("{} : 注册动画组件, 当前数量 {}", mLogTag.data(), mStates.size());
+	return mStates.size() - 1;
+}
+
+void AnimationSystem::unregisterComponent(std::size_t index) {
+	if (index >= mStates.size()) {
+		spdlog::warn("{} : 尝试注销无效的索引 {}", mLogTag.data(), index);
+		return;
+	}
+
+	// 将末尾元素移到空位, 保持数组连续
+	if (index != mStates.size() - 1) {
+		mStates[index] = mStates.back();
+		mStates[index].mComponent->mStateIndex = index;
+	}
+	mStates.pop_back();
+}
+
+AnimationSystem::AnimatorState& AnimationSystem::getState(std::size_t index) {
+	return mStates[index];
+}
+
+const AnimationSystem::AnimatorState& AnimationSystem::getState(std::size_t index) const {
+	return mStates[index];
+}
+
+std::size_t AnimationSystem::getAnimatorCount() const {
+	return mStates.size();
+}
+
+std::uint64_t AnimationSystem::getFrameChangeCount() const {
+	return mFrameChangeCount;
+}
+
+void AnimationSystem::update(float delta) {
+	for (auto& state : mStates) {
+		if (!state.mIsPlaying || !state.mClip || !state.mSprite || state.mClip->getIsEmpty()) {
+			continue;
+		}
+
+		// 推进计时器, 只有帧索引变化时才更新精灵组件的源矩阵
+		state.mTimer += delta;
+		std::size_t frameIndex = state.mClip->getFrameIndex(state.mTimer);
+		if (frameIndex != state.mFrameIndex) {
+			state.mFrameIndex = frameIndex;
+			state.mSprite->setSourceRect(state.mClip->getFrames()[frameIndex].mSourceRect);
+			++mFrameChangeCount;
+		}
+
+		// 检查非循环动画是否已结束
+		if (!state.mClip->getIsLooping() && state.mTimer >= state.mClip->getTotalDuration()) {
+			state.mIsPlaying = false;
+			// 将时间限制在结束点
+			state.mTimer = state.mClip->getTotalDuration();
+			state.mComponent->onAnimationFinished();
+		}
+	}
+}
+} // namespace engine::render
@@ -0,0 +1,74 @@
+/*****************************************************************//**
+ * @file   animation_system.h
+ * @brief  动画系统
+ * @version 1.0
+ *
+ * @author Shallowshades
+ * @date   2026.10.18
+ *********************************************************************/
+
+#pragma once
+#ifndef ANIMATION_SYSTEM_H
+#define ANIMATION_SYSTEM_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+namespace engine::component {
+	class AnimationComponent;
+	class SpriteComponent;
+}
+
+namespace engine::render {
+class Animation;
+
+/**
+ * @brief 集中推进场景中所有动画组件的播放状态.
+ *
+ * 每个AnimationComponent在初始化时注册, 播放状态(片段, 计时器, 帧索引)存放在连续的数组中,
+ * 每帧由场景调用一次update()遍历推进, 而不是每个对象各自在虚函数update中处理.
+ * 注销时将末尾元素移到空位, 并通知被移动的组件更新索引.
+ */
+class AnimationSystem final {
+public:
+	/**
+	 * @brief 单个动画组件的播放状态.
+	 */
+	struct AnimatorState {
+		const Animation* mClip = nullptr;										///< @brief 当前播放的片段(由组件持有所有权)
+		engine::component::SpriteComponent* mSprite = nullptr;					///< @brief 需要更新源矩形的精灵组件
+		engine::component::AnimationComponent* mComponent = nullptr;			///< @brief 所属的动画组件
+		float mTimer = 0.f;														///< @brief 动画播放中的计时器
+		std::size_t mFrameIndex = 0;											///< @brief 当前显示的帧索引, 只有变化时才更新精灵
+		bool mIsPlaying = false;												///< @brief 当前是否正在播放
+	};
+
+	static constexpr std::size_t mInvalidIndex = static_cast<std::size_t>(-1);	///< @brief 未注册时的索引
+
+	AnimationSystem() = default;
+
+	// 禁用拷贝和移动语义
+	AnimationSystem(const AnimationSystem&) = delete;							///< @brief 删除拷贝构造
+	AnimationSystem& operator=(const AnimationSystem&) = delete;				///< @brief 删除拷贝赋值构造
+	AnimationSystem(AnimationSystem&&) = delete;								///< @brief 删除移动构造
+	AnimationSystem& operator=(AnimationSystem&&) = delete;						///< @brief 删除移动赋值构造
+
+	std::size_t registerComponent(engine::component::AnimationComponent* component, engine::component::SpriteComponent* sprite);	///< @brief 注册组件, 返回其状态索引
+	void unregisterComponent(std::size_t index);								///< @brief 注销组件
+	AnimatorState& getState(std::size_t index);									///< @brief 获取指定索引的播放状态
+	const AnimatorState& getState(std::size_t index) const;						///< @brief 获取指定索引的播放状态
+	std::size_t getAnimatorCount() const;										///< @brief 获取已注册的组件数量
+	std::uint64_t getFrameChangeCount() const;									///< @brief 获取累计的切帧次数, 帧缓存据此判断动画是否需要重绘
+
+	void update(float delta);													///< @brief 推进所有正在播放的动画
+
+private:
+	static constexpr std::string_view mLogTag = "AnimationSystem";				///< @brief 日志标识
+	std::vector<AnimatorState> mStates;											///< @brief 连续存放的播放状态
+	std::uint64_t mFrameChangeCount = 0;										///< @brief 累计的切帧次数
+};
+} // namespace engine::render
+
+#endif // !ANIMATION_SYSTEM_H
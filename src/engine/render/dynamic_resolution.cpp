@@ -0,0 +1,62 @@
+#include "dynamic_resolution.h"
+#include <algorithm>
+#include <cmath>
+#include <spdlog/spdlog.h>
+
+namespace engine::render {
+DynamicResolution::DynamicResolution(float minScale, float maxScale, float targetFrameTimeMs)
+	: mMinScale(std::clamp(minScale, 0.25f, 1.f))
+	, mTargetFrameTimeMs(targetFrameTimeMs > 0.f ? targetFrameTimeMs : 1000.f / 60.f)
+{
+	mMaxScale = std::clamp(maxScale, mMinScale, 1.f);
+	mScale = mMaxScale;
+	spdlog::info("{} : 缩放范围 [{:.2f}, {:.2f}], 目标帧时间 {:.2f} ms", mLogTag.data(), mMinScale, mMaxScale, mTargetFrameTimeMs);
+}
+
+bool DynamicResolution::update(float frameTimeMs) {
+	if (frameTimeMs <= 0.f) {
+		return false;
+	}
+
+	mSmoothedFrameTimeMs = mSmoothedFrameTimeMs > 0.f
+		? mSmoothedFrameTimeMs + (frameTimeMs - mSmoothedFrameTimeMs) * mSmoothing
+		: frameTimeMs;
+
+	if (mCooldown > 0) {
+		--mCooldown;
+		return false;
+	}
+
+	float ratio = mSmoothedFrameTimeMs / mTargetFrameTimeMs;
+	if (ratio <= mUpperRatio && ratio >= mLowerRatio) {
+		return false;
+	}
+
+	// 以目标帧时间的中间值为目标估算新的缩放, 再对齐到档位; 至少移动一档, 避免卡在边界附近
+	float desired = mScale * std::sqrt((mUpperRatio + mLowerRatio) * 0.5f / ratio);
+	float newScale = std::round(desired / mScaleStep) * mScaleStep;
+	if (ratio > mUpperRatio) {
+		newScale = std::min(newScale, mScale - mScaleStep);
+	}
+	else {
+		newScale = std::max(newScale, mScale + mScaleStep);
+	}
+	newScale = std::clamp(newScale, mMinScale, mMaxScale);
+	if (std::abs(newScale - mScale) < 0.001f) {
+		return false;
+	}
+
+	spdlog::debug("{} : 平滑帧时间 {:.2f} ms, 缩放 {:.2f} -> {:.2f}", mLogTag.data(), mSmoothedFrameTimeMs, mScale, newScale);
+	mScale = newScale;
+	mCooldown = mCooldownFrames;
+	return true;
+}
+
+float DynamicResolution::getScale() const {
+	return mScale;
+}
+
+float DynamicResolution::getSmoothedFrameTime() const {
+	return mSmoothedFrameTimeMs;
+}
+} // namespace engine::render
@@ -0,0 +1,70 @@
+/*****************************************************************//**
+ * @file   dynamic_resolution.h
+ * @brief  动态分辨率控制器
+ * @version 1.0
+ *
+ * @author Shallowshades
+ * @date   2026.10.18
+ *********************************************************************/
+
+#pragma once
+#ifndef DYNAMIC_RESOLUTION_H
+#define DYNAMIC_RESOLUTION_H
+
+#include <string_view>
+
+namespace engine::render {
+/**
+ * @brief 根据平滑后的帧时间调整世界层的渲染缩放.
+ *
+ * 每帧输入一次测得的帧耗时(录制 + 提交, 不含帧率限制和垂直同步的等待), 使用指数滑动平均平滑.
+ * 平滑帧时间超过目标帧时间的上限比例时降低缩放, 低于下限比例时提高缩放;
+ * 每次调整后冷却若干帧, 避免缩放在两个档位之间来回抖动.
+ * 缩放作用于宽和高, 像素数量与缩放的平方成正比, 因此按帧时间比值的平方根估算新的缩放.
+ */
+class DynamicResolution final {
+public:
+	/**
+	 * @brief 构造函数.
+	 *
+	 * @param minScale 最小缩放, 会被限制在[0.25, 1]之间
+	 * @param maxScale 最大缩放, 会被限制在[minScale, 1]之间
+	 * @param targetFrameTimeMs 目标帧时间(毫秒), 非正数时按60FPS计算
+	 */
+	DynamicResolution(float minScale, float maxScale, float targetFrameTimeMs);
+
+	// 禁用拷贝和移动语义
+	DynamicResolution(const DynamicResolution&) = delete;						///< @brief 删除拷贝构造
+	DynamicResolution& operator=(const DynamicResolution&) = delete;			///< @brief 删除拷贝赋值构造
+	DynamicResolution(DynamicResolution&&) = delete;							///< @brief 删除移动构造
+	DynamicResolution& operator=(DynamicResolution&&) = delete;					///< @brief 删除移动赋值构造
+
+	/**
+	 * @brief 输入一帧的耗时并更新缩放.
+	 *
+	 * @param frameTimeMs 本帧耗时(毫秒)
+	 * @return 缩放是否发生了变化
+	 */
+	bool update(float frameTimeMs);
+
+	float getScale() const;														///< @brief 获取当前缩放
+	float getSmoothedFrameTime() const;											///< @brief 获取平滑后的帧时间(毫秒)
+
+private:
+	static constexpr std::string_view mLogTag = "DynamicResolution";			///< @brief 日志标识
+	static constexpr float mSmoothing = 0.1f;									///< @brief 指数滑动平均中新样本的权重
+	static constexpr float mUpperRatio = 0.95f;									///< @brief 平滑帧时间超过目标的该比例时降低缩放
+	static constexpr float mLowerRatio = 0.75f;									///< @brief 平滑帧时间低于目标的该比例时提高缩放
+	static constexpr float mScaleStep = 0.05f;									///< @brief 缩放的最小档位
+	static constexpr int mCooldownFrames = 30;									///< @brief 每次调整后的冷却帧数
+
+	float mMinScale = 0.5f;														///< @brief 最小缩放
+	float mMaxScale = 1.f;														///< @brief 最大缩放
+	float mTargetFrameTimeMs = 1000.f / 60.f;									///< @brief 目标帧时间(毫秒)
+	float mScale = 1.f;															///< @brief 当前缩放
+	float mSmoothedFrameTimeMs = 0.f;											///< @brief 平滑后的帧时间(毫秒), 0表示还没有样本
+	int mCooldown = 0;															///< @brief 剩余冷却帧数
+};
+} // namespace engine::render
+
+#endif // !DYNAMIC_RESOLUTION_H
@@ -0,0 +1,151 @@
+#include "glyph_atlas.h"
+#include <SDL3/SDL.h>
+#include <SDL3_ttf/SDL_ttf.h>
+#include <spdlog/spdlog.h>
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+namespace engine::render {
+GlyphAtlas::GlyphAtlas(SDL_Renderer* renderer, TTF_Font* font) {
+	if (!renderer || !font) {
+		throw std::runtime_error(mLogTag.data() + std::string(" 构造失败: SDL_Renderer或TTF_Font指针为空"));
+	}
+	mLineHeight = static_cast<float>(TTF_GetFontHeight(font));
+
+	// 1. 逐个光栅化字形(白色, 绘制时通过顶点颜色着色), 同时按行排布位置
+	std::array<SDL_Surface*, mLastChar - mFirstChar + 1> surfaces = {};
+	std::array<SDL_Rect, mLastChar - mFirstChar + 1> placements = {};
+	int penX = mPadding;
+	int penY = mPadding;
+	int rowHeight = 0;
+	int atlasWidth = 0;
+	for (char c = mFirstChar; c <= mLastChar; ++c) {
+		const std::size_t index = static_cast<std::size_t>(c - mFirstChar);
+		const Uint32 codepoint = static_cast<Uint32>(c);
+		if (!TTF_FontHasGlyph(font, codepoint)) {
+			continue;
+		}
+
+		int advance = 0;
+		TTF_GetGlyphMetrics(font, codepoint, nullptr, nullptr, nullptr, nullptr, &advance);
+		mGlyphs[index].mAdvance = static_cast<float>(advance);
+		mGlyphs[index].mIsValid = true;
+
+		SDL_Surface* surface = TTF_RenderGlyph_Blended(font, codepoint, SDL_Color{ 255, 255, 255, 255 });
+		if (!surface || surface->w <= 0 || surface->h <= 0) {
+			// 空格等没有可见像素的字形只记录步进宽度
+			SDL_DestroySurface(surface);
+			continue;
+		}
+
+		if (penX + surface->w + mPadding > mMaxAtlasWidth) {
+			penX = mPadding;
+			penY += rowHeight + mPadding;
+			rowHeight = 0;
+		}
+		surfaces[index] = surface;
+		placements[index] = { penX, penY, surface->w, surface->h };
+		penX += surface->w + mPadding;
+		rowHeight = std::max(rowHeight, surface->h);
+		atlasWidth = std::max(atlasWidth, penX);
+	}
+	const int atlasHeight = penY + rowHeight + mPadding;
+
+	auto destroySurfaces = [&surfaces]() {
+		for (SDL_Surface* surface : surfaces) {
+			SDL_DestroySurface(surface);
+		}
+	};
+
+	// 2. 拷贝到同一张透明表面上(不混合, 保留字形的alpha)
+	SDL_Surface* atlasSurface = SDL_CreateSurface(std::max(atlasWidth, 1), std::max(atlasHeight, 1), SDL_PIXELFORMAT_RGBA32);
+	if (!atlasSurface) {
+		destroySurfaces();
+		throw std::runtime_error(mLogTag.data() + std::string(" 创建图集表面失败: ") + SDL_GetError());
+	}
+	SDL_FillSurfaceRect(atlasSurface, nullptr, 0);
+	for (std::size_t index = 0; index < surfaces.size(); ++index) {
+		if (!surfaces[index]) {
+			continue;
+		}
+		SDL_SetSurfaceBlendMode(surfaces[index], SDL_BLENDMODE_NONE);
+		SDL_BlitSurface(surfaces[index], nullptr, atlasSurface, &placements[index]);
+		const SDL_Rect& rect = placements[index];
+		mGlyphs[index].mSourceRect = { static_cast<float>(rect.x), static_cast<float>(rect.y), static_cast<float>(rect.w), static_cast<float>(rect.h) };
+	}
+	destroySurfaces();
+
+	// 3. 上传为纹理. 像素字体使用最近邻采样, 放大时保持清晰
+	mTexture = SDL_CreateTextureFromSurface(renderer, atlasSurface);
+	mTextureWidth = static_cast<float>(atlasSurface->w);
+	mTextureHeight = static_cast<float>(atlasSurface->h);
+	SDL_DestroySurface(atlasSurface);
+	if (!mTexture) {
+		throw std::runtime_error(mLogTag.data() + std::string(" 创建图集纹理失败: ") + SDL_GetError());
+	}
+	SDL_SetTextureScaleMode(mTexture, SDL_SCALEMODE_NEAREST);
+	SDL_SetTextureBlendMode(mTexture, SDL_BLENDMODE_BLEND);
+
+	spdlog::debug("{} 图集构建完成: {}x{}", mLogTag.data(), mTextureWidth, mTextureHeight);
+}
+
+GlyphAtlas::~GlyphAtlas() {
+	if (mTexture) {
+		SDL_DestroyTexture(mTexture);
+		mTexture = nullptr;
+	}
+}
+
+bool GlyphAtlas::canRender(std::string_view text) const {
+	return std::all_of(text.begin(), text.end(), [this](char c) { return findGlyph(c) != nullptr; });
+}
+
+glm::vec2 GlyphAtlas::measure(std::string_view text) const {
+	float width = 0.f;
+	for (char c : text) {
+		if (const Glyph* glyph = findGlyph(c)) {
+			width += glyph->mAdvance;
+		}
+	}
+	return glm::vec2(width, mLineHeight);
+}
+
+void GlyphAtlas::appendQuads(std::string_view text, const glm::vec2& position, const engine::utils::FColor& color, std::vector<SDL_Vertex>& vertices) const {
+	const SDL_FColor vertexColor = { color.r, color.g, color.b, color.a };
+	float penX = position.x;
+	for (char c : text) {
+		const Glyph* glyph = findGlyph(c);
+		if (!glyph) {
+			continue;
+		}
+		const SDL_FRect& src = glyph->mSourceRect;
+		if (src.w > 0.f && src.h > 0.f) {
+			// 字形表面与TTF排版的行框对齐, 直接放在笔位置即可
+			const float x0 = penX;
+			const float y0 = position.y;
+			const float x1 = x0 + src.w;
+			const float y1 = y0 + src.h;
+			const float u0 = src.x / mTextureWidth;
+			const float v0 = src.y / mTextureHeight;
+			const float u1 = (src.x + src.w) / mTextureWidth;
+			const float v1 = (src.y + src.h) / mTextureHeight;
+
+			const SDL_Vertex topLeft = { { x0, y0 }, vertexColor, { u0, v0 } };
+			const SDL_Vertex topRight = { { x1, y0 }, vertexColor, { u1, v0 } };
+			const SDL_Vertex bottomLeft = { { x0, y1 }, vertexColor, { u0, v1 } };
+			const SDL_Vertex bottomRight = { { x1, y1 }, vertexColor, { u1, v1 } };
+			vertices.insert(vertices.end(), { topLeft, topRight, bottomRight, topLeft, bottomRight, bottomLeft });
+		}
+		penX += glyph->mAdvance;
+	}
+}
+
+const GlyphAtlas::Glyph* GlyphAtlas::findGlyph(char c) const {
+	if (c < mFirstChar || c > mLastChar) {
+		return nullptr;
+	}
+	const Glyph& glyph = mGlyphs[static_cast<std::size_t>(c - mFirstChar)];
+	return glyph.mIsValid ? &glyph : nullptr;
+}
+} // namespace engine::render
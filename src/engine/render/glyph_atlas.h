@@ -0,0 +1,94 @@
+/*****************************************************************//**
+ * @file   glyph_atlas.h
+ * @brief  位图字体的字形图集
+ * @version 1.0
+ *
+ * @author Shallowshades
+ * @date   2026.10.18
+ *********************************************************************/
+
+#pragma once
+#ifndef GLYPH_ATLAS_H
+#define GLYPH_ATLAS_H
+
+#include <array>
+#include <string_view>
+#include <vector>
+#include <SDL3/SDL_rect.h>
+#include <SDL3/SDL_render.h>
+#include <glm/glm.hpp>
+
+#include "../utils/math.h"
+
+struct TTF_Font;
+
+namespace engine::render {
+/**
+ * @brief 把一个(字体, 字号)的可打印ASCII字形一次性光栅化到同一张纹理上.
+ *
+ * 适用于像素位图字体这类固定字号的HUD文字: 绘制时不再经过SDL_ttf排版,
+ * 而是按缓存的步进宽度直接生成四边形, 整串文字(含阴影)只需一次SDL_RenderGeometry.
+ * 构造只能在渲染线程上进行(需要创建纹理); 构造完成后字形数据只读, 可以在任意线程上生成顶点.
+ * 构造失败会抛出异常.
+ */
+class GlyphAtlas final {
+public:
+	/**
+	 * @brief 单个字形在图集中的信息.
+	 */
+	struct Glyph {
+		SDL_FRect mSourceRect = { 0.f, 0.f, 0.f, 0.f };						///< @brief 图集中的源矩形, 宽高为0表示没有可见像素(如空格)
+		float mAdvance = 0.f;												///< @brief 水平步进宽度
+		bool mIsValid = false;												///< @brief 字体是否包含该字形
+	};
+
+	/**
+	 * @brief 构造函数, 光栅化字形并创建图集纹理.
+	 *
+	 * @param renderer 用于创建纹理的SDL_Renderer, 不能为空
+	 * @param font 字体, 不能为空
+	 * @throws 光栅化或创建纹理失败时抛出std::runtime_error
+	 */
+	GlyphAtlas(SDL_Renderer* renderer, TTF_Font* font);
+	~GlyphAtlas();
+
+	bool canRender(std::string_view text) const;							///< @brief 字符串中的字符是否全部在图集中
+	glm::vec2 measure(std::string_view text) const;							///< @brief 计算字符串的尺寸, 与TTF_GetTextSize的结果一致
+
+	/**
+	 * @brief 为字符串生成四边形并追加到顶点数组中(每个可见字形6个顶点).
+	 *
+	 * @param text 字符串, 调用前应通过canRender()检查
+	 * @param position 左上角的屏幕坐标
+	 * @param color 顶点颜色, 与白色字形相乘
+	 * @param vertices 输出: 追加顶点的数组
+	 */
+	void appendQuads(std::string_view text, const glm::vec2& position, const engine::utils::FColor& color, std::vector<SDL_Vertex>& vertices) const;
+
+	SDL_Texture* getTexture() const { return mTexture; }					///< @brief 获取图集纹理
+
+	// 禁用拷贝和移动语义
+	GlyphAtlas(const GlyphAtlas&) = delete;									///< @brief 删除拷贝构造
+	GlyphAtlas& operator=(const GlyphAtlas&) = delete;						///< @brief 删除拷贝赋值构造
+	GlyphAtlas(GlyphAtlas&&) = delete;										///< @brief 删除移动构造
+	GlyphAtlas& operator=(GlyphAtlas&&) = delete;							///< @brief 删除移动赋值构造
+
+private:
+	const Glyph* findGlyph(char c) const;									///< @brief 查找字符对应的字形, 不在图集中时返回nullptr
+
+private:
+	static constexpr std::string_view mLogTag = "GlyphAtlas";
+	static constexpr char mFirstChar = ' ';									///< @brief 图集包含的第一个字符
+	static constexpr char mLastChar = '~';									///< @brief 图集包含的最后一个字符
+	static constexpr int mMaxAtlasWidth = 512;								///< @brief 图集的最大宽度, 超出后换行
+	static constexpr int mPadding = 1;										///< @brief 字形之间的间隔, 避免采样到相邻字形
+
+	std::array<Glyph, mLastChar - mFirstChar + 1> mGlyphs;					///< @brief 按字符编码排列的字形信息
+	SDL_Texture* mTexture = nullptr;										///< @brief 图集纹理(拥有)
+	float mLineHeight = 0.f;												///< @brief 行高
+	float mTextureWidth = 0.f;												///< @brief 纹理宽度, 用于计算纹理坐标
+	float mTextureHeight = 0.f;												///< @brief 纹理高度, 用于计算纹理坐标
+};
+} // namespace engine::render
+
+#endif // !GLYPH_ATLAS_H
@@ -0,0 +1,75 @@
+/*****************************************************************//**
+ * @file   render_command.h
+ * @brief  渲染命令
+ * @version 1.0
+ *
+ * @author Shallowshades
+ * @date   2026.10.18
+ *********************************************************************/
+
+#pragma once
+#ifndef RENDER_COMMAND_H
+#define RENDER_COMMAND_H
+
+#include <string>
+#include <cstdint>
+#include <vector>
+#include <SDL3/SDL_rect.h>
+#include <SDL3/SDL_render.h>
+
+#include "../utils/math.h"
+
+struct SDL_Texture;
+struct TTF_Font;
+
+namespace engine::render {
+/**
+ * @brief 渲染命令类型.
+ */
+enum class RenderCommandType {
+	Clear,				///< @brief 以绘制颜色清屏
+	Texture,			///< @brief 绘制纹理(可旋转/翻转)
+	FilledRect,			///< @brief 绘制填充矩形
+	Text,				///< @brief 绘制文字(由TextRenderer提交)
+	Geometry,			///< @brief 绘制帧顶点缓冲中的一段三角形(字形图集文字)
+	TiledTexture,		///< @brief 在目标矩形内平铺纹理(视差背景)
+	SetRenderTarget,	///< @brief 切换渲染目标(纹理为空表示切回窗口), 用于捕获下层场景和动态分辨率的世界层
+};
+
+/**
+ * @brief 一条已经解析完毕的绘制命令.
+ *
+ * 录制时已完成纹理查找, 相机变换和视口裁剪, 提交时只需要调用对应的SDL函数,
+ * 因此可以在录制线程之外的渲染线程上执行.
+ */
+struct RenderCommand {
+	RenderCommandType mType = RenderCommandType::Texture;					///< @brief 命令类型
+	SDL_Texture* mTexture = nullptr;										///< @brief 纹理(Texture, TiledTexture, Geometry, SetRenderTarget)
+	TTF_Font* mFont = nullptr;												///< @brief 字体(Text)
+	std::string mFontId;													///< @brief 字体ID(Text), 与字号一起作为文字缓存的键
+	int mFontSize = 0;														///< @brief 字号(Text)
+	SDL_FRect mSourceRect = { 0.f, 0.f, 0.f, 0.f };							///< @brief 源矩形(Texture, TiledTexture)
+	SDL_FRect mDestRect = { 0.f, 0.f, 0.f, 0.f };							///< @brief 目标矩形, Text只使用x和y
+	double mAngle = 0.0;													///< @brief 旋转角度(Texture)
+	float mTileScale = 1.f;													///< @brief 平铺时每块纹理的缩放(TiledTexture)
+	float mRenderScale = 1.f;												///< @brief 切换到纹理后的渲染缩放(SetRenderTarget)
+	bool mIsFlipped = false;												///< @brief 是否水平翻转(Texture)
+	engine::utils::FColor mColor = { 1.f, 1.f, 1.f, 1.f };					///< @brief 颜色(Clear, FilledRect, Text)
+	std::string mText;														///< @brief UTF-8文本(Text)
+	int mFirstVertex = 0;													///< @brief 在帧顶点缓冲中的起始位置(Geometry)
+	int mVertexCount = 0;													///< @brief 顶点数量, 每3个顶点构成一个三角形(Geometry)
+	std::uint64_t mCaptureId = 0;											///< @brief 帧捕获序号, 切回窗口时标记该次捕获已完成(SetRenderTarget)
+};
+
+/**
+ * @brief 一帧的渲染命令列表.
+ */
+struct RenderFrame {
+	std::vector<RenderCommand> mCommands;									///< @brief 按提交顺序排列的命令
+	std::vector<SDL_Vertex> mVertices;										///< @brief Geometry命令共享的顶点缓冲
+
+	void clear() { mCommands.clear(); mVertices.clear(); }					///< @brief 清空命令和顶点, 保留容量以便复用
+};
+} // namespace engine::render
+
+#endif // !RENDER_COMMAND_H
@@ -0,0 +1,52 @@
+#include "render_task_queue.h"
+#include <spdlog/spdlog.h>
+
+namespace engine::render {
+RenderTaskQueue::RenderTaskQueue()
+	: mRenderThreadId(std::this_thread::get_id())
+{
+	spdlog::trace("{} 构造成功", mLogTag.data());
+}
+
+bool RenderTaskQueue::isRenderThread() const {
+	return std::this_thread::get_id() == mRenderThreadId;
+}
+
+void RenderTaskQueue::processTasks() {
+	{
+		std::lock_guard<std::mutex> lock(mMutex);
+		if (mTasks.empty()) {
+			return;
+		}
+		mRunningTasks.swap(mTasks);
+	}
+
+	// 在锁外执行, 任务执行期间其他线程仍可入队
+	for (auto& task : mRunningTasks) {
+		task();
+	}
+	mRunningTasks.clear();
+}
+
+void RenderTaskQueue::notify() {
+	{
+		std::lock_guard<std::mutex> lock(mMutex);
+		mIsSignaled = true;
+	}
+	mCondition.notify_one();
+}
+
+void RenderTaskQueue::waitForWork(std::chrono::milliseconds timeout) {
+	std::unique_lock<std::mutex> lock(mMutex);
+	mCondition.wait_for(lock, timeout, [this] { return mIsSignaled || !mTasks.empty(); });
+	mIsSignaled = false;
+}
+
+void RenderTaskQueue::enqueue(std::function<void()> task) {
+	{
+		std::lock_guard<std::mutex> lock(mMutex);
+		mTasks.push_back(std::move(task));
+	}
+	mCondition.notify_one();
+}
+} // namespace engine::render
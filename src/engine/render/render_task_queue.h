@@ -0,0 +1,85 @@
+/*****************************************************************//**
+ * @file   render_task_queue.h
+ * @brief  渲染线程任务队列
+ * @version 1.0
+ *
+ * @author Shallowshades
+ * @date   2026.10.18
+ *********************************************************************/
+
+#pragma once
+#ifndef RENDER_TASK_QUEUE_H
+#define RENDER_TASK_QUEUE_H
+
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace engine::render {
+/**
+ * @brief 把需要访问SDL_Renderer/SDL_ttf的工作转交给渲染线程执行.
+ *
+ * 构造时所在的线程即为渲染线程(拥有SDL_Renderer的线程). 在渲染线程上调用runSync()会直接执行,
+ * 在其他线程上调用则会把任务入队并阻塞等待, 直到渲染线程在processTasks()中执行完毕.
+ * 单线程运行时所有调用都发生在渲染线程上, 行为与直接调用完全一致.
+ */
+class RenderTaskQueue final {
+public:
+	RenderTaskQueue();															///< @brief 构造函数, 将当前线程绑定为渲染线程
+
+	bool isRenderThread() const;												///< @brief 当前线程是否为渲染线程
+
+	/**
+	 * @brief 在渲染线程上同步执行任务并返回结果.
+	 *
+	 * @param func 无参可调用对象
+	 * @return func 的返回值; func 抛出的异常会在调用线程上重新抛出
+	 */
+	template<typename Func>
+	auto runSync(Func&& func) -> std::invoke_result_t<Func&>;
+
+	void processTasks();														///< @brief 执行所有待处理任务(仅渲染线程调用)
+	void notify();																///< @brief 唤醒在waitForWork()中等待的渲染线程(例如新帧已发布)
+	void waitForWork(std::chrono::milliseconds timeout);						///< @brief 等待新任务或notify(), 最多等待timeout
+
+	// 禁用拷贝和移动语义
+	RenderTaskQueue(const RenderTaskQueue&) = delete;							///< @brief 删除拷贝构造
+	RenderTaskQueue& operator=(const RenderTaskQueue&) = delete;				///< @brief 删除拷贝赋值构造
+	RenderTaskQueue(RenderTaskQueue&&) = delete;								///< @brief 删除移动构造
+	RenderTaskQueue& operator=(RenderTaskQueue&&) = delete;						///< @brief 删除移动赋值构造
+
+private:
+	void enqueue(std::function<void()> task);									///< @brief 入队并唤醒渲染线程
+
+private:
+	static constexpr std::string_view mLogTag = "RenderTaskQueue";
+	std::thread::id mRenderThreadId;											///< @brief 渲染线程ID
+	std::mutex mMutex;															///< @brief 保护任务列表和唤醒标记
+	std::condition_variable mCondition;											///< @brief 用于唤醒渲染线程
+	std::vector<std::function<void()>> mTasks;									///< @brief 待执行的任务
+	std::vector<std::function<void()>> mRunningTasks;							///< @brief 正在执行的任务(与mTasks交换以复用内存)
+	bool mIsSignaled = false;													///< @brief notify()是否已被调用且尚未被消费
+};
+
+template<typename Func>
+auto RenderTaskQueue::runSync(Func&& func) -> std::invoke_result_t<Func&> {
+	if (isRenderThread()) {
+		return func();
+	}
+
+	// 任务对象在当前线程的栈上, 调用线程会一直阻塞到任务执行完毕, 因此可以安全地按引用捕获
+	std::packaged_task<std::invoke_result_t<Func&>()> task(std::forward<Func>(func));
+	auto future = task.get_future();
+	enqueue([&task] { task(); });
+	return future.get();
+}
+} // namespace engine::render
+
+#endif // !RENDER_TASK_QUEUE_H
@@ -1,14 +1,128 @@
 #include "renderer.h"
 #include "../resource/resource_manager.h"
+#include "../resource/texture_region.h"
 #include "camera.h"
 #include "sprite.h"
+#include "text_renderer.h"
+#include "render_task_queue.h"
 #include <SDL3/SDL.h>
+#include <SDL3_ttf/SDL_ttf.h>
+#include <algorithm>
+#include <cmath>
+#include <iterator>
 #include <stdexcept>
+#include <utility>
 #include <spdlog/spdlog.h>
 
 namespace engine::render {
-Renderer::Renderer(SDL_Renderer* renderer, engine::resource::ResourceManager* resourceManager)
-	: mRenderer(renderer), mResourceManager(resourceManager)
+namespace {
+	/**
+	 * @brief FNV-1a哈希, 把一段字节累加到已有的哈希值上.
+	 */
+	std::uint64_t hashBytes(std::uint64_t hash, const void* data, std::size_t size) {
+		const auto* bytes = static_cast<const unsigned char*>(data);
+		for (std::size_t i = 0; i < size; ++i) {
+			hash ^= bytes[i];
+			hash *= 1099511628211ull;
+		}
+		return hash;
+	}
+
+	template<typename T>
+	std::uint64_t hashValue(std::uint64_t hash, const T& value) {
+		return hashBytes(hash, &value, sizeof(T));
+	}
+
+	/**
+	 * @brief 逐字段累加命令的哈希(结构体含填充字节, 不能整体按字节计算).
+	 *
+	 * 纹理和字体使用SDL为每个对象创建的属性集ID而不是指针: 对象销毁后新对象可能分配在同一地址上,
+	 * 按指针比较会把内容不同的两帧视为相同.
+	 */
+	std::uint64_t hashCommand(std::uint64_t hash, const RenderCommand& command) {
+		hash = hashValue(hash, command.mType);
+		hash = hashValue(hash, command.mTexture ? SDL_GetTextureProperties(command.mTexture) : SDL_PropertiesID{ 0 });
+		hash = hashValue(hash, command.mFont ? TTF_GetFontProperties(command.mFont) : SDL_PropertiesID{ 0 });
+		hash = hashValue(hash, command.mSourceRect);
+		hash = hashValue(hash, command.mDestRect);
+		hash = hashValue(hash, command.mAngle);
+		hash = hashValue(hash, command.mTileScale);
+		hash = hashValue(hash, command.mRenderScale);
+		hash = hashValue(hash, command.mIsFlipped);
+		hash = hashValue(hash, command.mColor);
+		hash = hashBytes(hash, command.mText.data(), command.mText.size());
+		hash = hashValue(hash, command.mText.size());
+		hash = hashValue(hash, command.mFirstVertex);
+		hash = hashValue(hash, command.mVertexCount);
+		return hashValue(hash, command.mCaptureId);
+	}
+
+	/**
+	 * @brief 两个矩形是否相交.
+	 */
+	bool isRectIntersected(const SDL_FRect& lhs, const SDL_FRect& rhs) {
+		return lhs.x < rhs.x + rhs.w && rhs.x < lhs.x + lhs.w && lhs.y < rhs.y + rhs.h && rhs.y < lhs.y + lhs.h;
+	}
+
+	/**
+	 * @brief 包含两个矩形的最小矩形.
+	 */
+	SDL_FRect getRectUnion(const SDL_FRect& lhs, const SDL_FRect& rhs) {
+		float left = std::min(lhs.x, rhs.x);
+		float top = std::min(lhs.y, rhs.y);
+		float right = std::max(lhs.x + lhs.w, rhs.x + rhs.w);
+		float bottom = std::max(lhs.y + lhs.h, rhs.y + rhs.h);
+		return { left, top, right - left, bottom - top };
+	}
+
+	/**
+	 * @brief 命令在屏幕上影响的区域; 无法确定时(文字, 切换渲染目标)返回std::nullopt.
+	 */
+	std::optional<SDL_FRect> getCommandBounds(const RenderFrame& frame, const RenderCommand& command, const SDL_FRect& screenRect) {
+		switch (command.mType) {
+		case RenderCommandType::Clear:
+			return screenRect;
+		case RenderCommandType::Texture: {
+			if (command.mAngle == 0.0) {
+				return command.mDestRect;
+			}
+			// 绕目标矩形中心旋转后的包围盒
+			float radians = static_cast<float>(command.mAngle) * 3.14159265f / 180.f;
+			float halfW = command.mDestRect.w * 0.5f;
+			float halfH = command.mDestRect.h * 0.5f;
+			float extentX = std::abs(halfW * std::cos(radians)) + std::abs(halfH * std::sin(radians));
+			float extentY = std::abs(halfW * std::sin(radians)) + std::abs(halfH * std::cos(radians));
+			float centerX = command.mDestRect.x + halfW;
+			float centerY = command.mDestRect.y + halfH;
+			return SDL_FRect{ centerX - extentX, centerY - extentY, extentX * 2.f, extentY * 2.f };
+		}
+		case RenderCommandType::TiledTexture:
+		case RenderCommandType::FilledRect:
+			return command.mDestRect;
+		case RenderCommandType::Geometry: {
+			if (command.mVertexCount <= 0) {
+				return SDL_FRect{ 0.f, 0.f, 0.f, 0.f };
+			}
+			const SDL_Vertex* vertices = frame.mVertices.data() + command.mFirstVertex;
+			glm::vec2 minPoint(vertices[0].position.x, vertices[0].position.y);
+			glm::vec2 maxPoint = minPoint;
+			for (int i = 1; i < command.mVertexCount; ++i) {
+				glm::vec2 point(vertices[i].position.x, vertices[i].position.y);
+				minPoint = glm::min(minPoint, point);
+				maxPoint = glm::max(maxPoint, point);
+			}
+			return SDL_FRect{ minPoint.x, minPoint.y, maxPoint.x - minPoint.x, maxPoint.y - minPoint.y };
+		}
+		case RenderCommandType::Text:
+		case RenderCommandType::SetRenderTarget:
+			return std::nullopt;
+		}
+		return std::nullopt;
+	}
+}
+
+Renderer::Renderer(SDL_Renderer* renderer, engine::resource::ResourceManager* resourceManager, RenderTaskQueue* taskQueue)
+	: mRenderer(renderer), mResourceManager(resourceManager), mTaskQueue(taskQueue)
 {
 	spdlog::trace("{} 构造Renderer...", mLogTag.data());
 	if (!mRenderer) {
@@ -18,17 +132,21 @@ Renderer::Renderer(SDL_Renderer* renderer, engine::resource::ResourceManager* re
 		// ResourceManager是drawSprite所必需的
 		throw std::runtime_error(mLogTag.data() + std::string(" 构造失败: 提供mResourceManager指针为空"));
 	}
+	if (!mTaskQueue) {
+		throw std::runtime_error(mLogTag.data() + std::string(" 构造失败: 提供的RenderTaskQueue指针为空"));
+	}
 	setDrawColor(0, 0, 0, 255);
 	spdlog::trace("{} 构造成功", mLogTag.data());
 }
 void Renderer::drawSprite(const Camera& camera, const Sprite& sprite, const glm::vec2& positioin, const glm::vec2& scale, double angle) {
-	auto texture = mResourceManager->getTexture(sprite.getTextureId());
+	// 绘制时不阻塞在磁盘上: 未加载的纹理已提交异步加载(资源管理器输出警告), 上传完成前跳过
+	auto region = mResourceManager->requestTextureRegion(sprite.getTextureId());
+	auto texture = region.mTexture;
 	if (!texture) {
-		spdlog::error("{} 无法为ID: {} 获取纹理.", mLogTag.data(), sprite.getTextureId());
 		return;
 	}
 
-	auto srcRect = getSpriteSourceRect(sprite);
+	auto srcRect = getSpriteSourceRect(sprite, region);
 	if (!srcRect.has_value()) {
 		spdlog::error("{} 无法获取精灵的源矩阵, ID: {}", mLogTag.data(), sprite.getTextureId());
 		return;
@@ -52,20 +170,26 @@ void Renderer::drawSprite(const Camera& camera, const Sprite& sprite, const glm:
 		return;
 	}
 
-	// 执行绘制(默认旋转中心为精灵的中心点)
-	if (!SDL_RenderTextureRotated(mRenderer, texture, &srcRect.value(), &destRect, angle, nullptr, sprite.isFlipped() ? SDL_FLIP_HORIZONTAL : SDL_FLIP_NONE)) {
-		spdlog::error("{} 渲染旋转纹理失败(ID: {}) : {}", mLogTag.data(), sprite.getTextureId(), SDL_GetError());
-	}
+	// 录制绘制命令(默认旋转中心为精灵的中心点)
+	RenderCommand command;
+	command.mType = RenderCommandType::Texture;
+	command.mTexture = texture;
+	command.mSourceRect = srcRect.value();
+	command.mDestRect = destRect;
+	command.mAngle = angle;
+	command.mIsFlipped = sprite.isFlipped();
+	pushCommand(std::move(command));
 }
 
 void Renderer::drawParallax(const Camera& camera, const Sprite& sprite, const glm::vec2& position, const glm::vec2& scrollFactor, const glm::bvec2& repeat, const glm::vec2& scale) {
-	auto texture = mResourceManager->getTexture(sprite.getTextureId());
+	// 绘制时不阻塞在磁盘上: 未加载的纹理已提交异步加载(资源管理器输出警告), 上传完成前跳过
+	auto region = mResourceManager->requestTextureRegion(sprite.getTextureId());
+	auto texture = region.mTexture;
 	if (!texture) {
-		spdlog::error("{} 无法为ID: {} 获取纹理", mLogTag.data(), sprite.getTextureId());
 		return;
 	}
 
-	auto srcRect = getSpriteSourceRect(sprite);
+	auto srcRect = getSpriteSourceRect(sprite, region);
 	if (!srcRect.has_value()) {
 		spdlog::error("{} 无法获取精灵图的源矩阵, ID: {}", mLogTag.data(), sprite.getTextureId());
 		return;
@@ -99,25 +223,48 @@ void Renderer::drawParallax(const Camera& camera, const Sprite& sprite, const gl
 		stop.y = glm::min(positionScreen.y + scaledH, viewPortSize.y);
 	}
 
+	if (scaledW <= 0.f || scaledH <= 0.f || start.x >= stop.x || start.y >= stop.y) {
+		return;
+	}
+
+	// 平铺从目标矩形的左上角开始, 不重复的轴向上只画一块
+	if (scale.x == scale.y) {
+		RenderCommand command;
+		command.mType = RenderCommandType::TiledTexture;
+		command.mTexture = texture;
+		command.mSourceRect = srcRect.value();
+		command.mDestRect = {
+			start.x,
+			start.y,
+			repeat.x ? stop.x - start.x : scaledW,
+			repeat.y ? stop.y - start.y : scaledH
+		};
+		command.mTileScale = scale.x;
+		pushCommand(std::move(command));
+		return;
+	}
+
 	for (float y = start.y; y < stop.y; y += scaledH) {
 		for (float x = start.x; x < stop.x; x += scaledW) {
-			SDL_FRect dstRect = { x, y, scaledW, scaledH };
-			if (!SDL_RenderTexture(mRenderer, texture, nullptr, &dstRect)) {
-				spdlog::error("{} 渲染视差纹理失败 (ID: {}) : {}", mLogTag.data(), sprite.getTextureId(), SDL_GetError());
-				return;
-			}
+			RenderCommand command;
+			command.mType = RenderCommandType::Texture;
+			command.mTexture = texture;
+			command.mSourceRect = srcRect.value();
+			command.mDestRect = { x, y, scaledW, scaledH };
+			pushCommand(std::move(command));
 		}
 	}
 }
 
 void Renderer::drawUISprite(const Sprite& sprite, const glm::vec2& position, const std::optional<glm::vec2>& size) {
-	auto texture = mResourceManager->getTexture(sprite.getTextureId());
+	// 绘制时不阻塞在磁盘上: 未加载的纹理已提交异步加载(资源管理器输出警告), 上传完成前跳过
+	auto region = mResourceManager->requestTextureRegion(sprite.getTextureId());
+	auto texture = region.mTexture;
 	if (!texture) {
-		spdlog::error("{} 无法为ID: {} 获取纹理", mLogTag.data(), sprite.getTextureId());
 		return;
 	}
 
-	auto srcRect = getSpriteSourceRect(sprite);
+	auto srcRect = getSpriteSourceRect(sprite, region);
 	if (!srcRect.has_value()) {
 		spdlog::error("{} 无法获取精灵图的源矩阵, ID: {}", mLogTag.data(), sprite.getTextureId());
 		return;
@@ -133,69 +280,417 @@ void Renderer::drawUISprite(const Sprite& sprite, const glm::vec2& position, con
 		dstRect.h = srcRect.value().h;
 	}
 
-	// 执行绘制(未考虑UI旋转)
-	if (!SDL_RenderTextureRotated(mRenderer, texture, &srcRect.value(), &dstRect, 0.0, nullptr, sprite.isFlipped() ? SDL_FLIP_HORIZONTAL : SDL_FLIP_NONE)) {
-		spdlog::error("{} 渲染 UI Sprite 失败 (ID: {}): {}", mLogTag.data(), sprite.getTextureId(), SDL_GetError());
+	// UI不考虑旋转, 每个精灵是一个轴对齐的四边形, 转为两个三角形; 连续使用同一纹理的UI精灵合并为一条几何命令
+	const SDL_FRect& src = srcRect.value();
+	float u0 = src.x / region.mTextureSize.x;
+	float u1 = (src.x + src.w) / region.mTextureSize.x;
+	float v0 = src.y / region.mTextureSize.y;
+	float v1 = (src.y + src.h) / region.mTextureSize.y;
+	if (sprite.isFlipped()) {
+		std::swap(u0, u1);
+	}
+	const SDL_FColor white = { 1.f, 1.f, 1.f, 1.f };
+	const SDL_Vertex topLeft = { { dstRect.x, dstRect.y }, white, { u0, v0 } };
+	const SDL_Vertex topRight = { { dstRect.x + dstRect.w, dstRect.y }, white, { u1, v0 } };
+	const SDL_Vertex bottomLeft = { { dstRect.x, dstRect.y + dstRect.h }, white, { u0, v1 } };
+	const SDL_Vertex bottomRight = { { dstRect.x + dstRect.w, dstRect.y + dstRect.h }, white, { u1, v1 } };
+	const SDL_Vertex quad[6] = { topLeft, topRight, bottomLeft, topRight, bottomRight, bottomLeft };
+
+	// 上一条命令就是同一纹理的UI批次时直接追加顶点(其顶点位于顶点缓冲末尾)
+	RenderFrame& frame = mFrames.getWriteBuffer();
+	if (mUIBatchIndex != mNoUIBatch && mUIBatchIndex + 1 == frame.mCommands.size() && frame.mCommands[mUIBatchIndex].mTexture == texture) {
+		frame.mVertices.insert(frame.mVertices.end(), std::begin(quad), std::end(quad));
+		frame.mCommands[mUIBatchIndex].mVertexCount += 6;
+		if (mIsFrameVerifyEnabled) {
+			mRecordingHash = hashBytes(mRecordingHash, quad, sizeof(quad));
+		}
+		return;
 	}
+
+	pushGeometry(texture, std::vector<SDL_Vertex>(std::begin(quad), std::end(quad)));
+	mUIBatchIndex = frame.mCommands.size() - 1;
 }
 
 void Renderer::drawUIFilledRect(const engine::utils::Rect& rect, const engine::utils::FColor& color) {
-	setDrawColorFloat(color.r, color.g, color.b, color.a);
-	SDL_FRect sdlRect = { rect.position.x, rect.position.y, rect.size.x, rect.size.y };
-	if (!SDL_RenderFillRect(mRenderer, &sdlRect)) {
-		spdlog::error("{} 绘制填充矩形失败: {}", mLogTag.data(), SDL_GetError());
+	RenderCommand command;
+	command.mType = RenderCommandType::FilledRect;
+	command.mDestRect = { rect.position.x, rect.position.y, rect.size.x, rect.size.y };
+	command.mColor = color;
+	pushCommand(std::move(command));
+}
+
+void Renderer::pushCommand(RenderCommand&& command) {
+	++mRecordingStats.mCommandCount;
+	switch (command.mType) {
+	case RenderCommandType::Texture:	++mRecordingStats.mTextureCount; break;
+	case RenderCommandType::TiledTexture:	++mRecordingStats.mTextureCount; break;
+	case RenderCommandType::FilledRect:	++mRecordingStats.mFilledRectCount; break;
+	case RenderCommandType::Text:		++mRecordingStats.mTextCount; break;
+	case RenderCommandType::Geometry:	++mRecordingStats.mGeometryCount; break;
+	default: break;
+	}
+	if (mIsFrameVerifyEnabled) {
+		mRecordingHash = hashCommand(mRecordingHash, command);
+	}
+	mFrames.getWriteBuffer().mCommands.push_back(std::move(command));
+}
+
+void Renderer::pushGeometry(SDL_Texture* texture, const std::vector<SDL_Vertex>& vertices) {
+	if (vertices.empty()) {
+		return;
+	}
+
+	auto& frameVertices = mFrames.getWriteBuffer().mVertices;
+	RenderCommand command;
+	command.mType = RenderCommandType::Geometry;
+	command.mTexture = texture;
+	command.mFirstVertex = static_cast<int>(frameVertices.size());
+	command.mVertexCount = static_cast<int>(vertices.size());
+	frameVertices.insert(frameVertices.end(), vertices.begin(), vertices.end());
+	if (mIsFrameVerifyEnabled) {
+		mRecordingHash = hashBytes(mRecordingHash, vertices.data(), vertices.size() * sizeof(SDL_Vertex));
+	}
+	pushCommand(std::move(command));
+}
+
+void Renderer::recordCulling(int visibleCount, int culledCount) {
+	mRecordingStats.mVisibleObjectCount += visibleCount;
+	mRecordingStats.mCulledObjectCount += culledCount;
+}
+
+bool Renderer::beginFrame(bool isContentChanged) {
+	mIsFrameUnchanged = mIsFrameCacheEnabled && !mIsFrameInvalidated && !mIsNullBackend && !isContentChanged;
+	if (mIsFrameUnchanged && !mIsFrameVerifyEnabled) {
+		// 屏幕上的内容仍然有效, 不录制任何命令
+		mIsFrameUnchanged = false;
+		mFrameStats = RenderStats();
+		mFrameStats.mIsPresentSkipped = true;
+		return false;
 	}
-	setDrawColorFloat(0.f, 0.f, 0.f, 1.f);
+	return true;
 }
 
 void Renderer::present() {
+	mFrameStats = mRecordingStats;
+	mRecordingStats = RenderStats();
+	const std::uint64_t frameHash = mRecordingHash;
+	mRecordingHash = 0;
+	mUIBatchIndex = mNoUIBatch;
+
+	if (mIsNullBackend) {
+		// 空后端只保留统计, 直接丢弃命令
+		mFrames.getWriteBuffer().clear();
+		return;
+	}
+
+	// 帧缓存校验: 没有脏信号的帧应与上一次提交的帧完全相同, 不同说明漏掉了某个脏信号, 仍然提交该帧
+	if (std::exchange(mIsFrameUnchanged, false)) {
+		if (frameHash == mPresentedHash) {
+			mFrameStats.mIsPresentSkipped = true;
+			mFrames.getWriteBuffer().clear();
+			return;
+		}
+		spdlog::warn("{} 帧缓存校验失败: 没有脏信号的帧与上一次提交的帧不同", mLogTag.data());
+	}
+	mIsFrameInvalidated = false;
+	mPresentedHash = frameHash;
+
+	if (mIsThreaded) {
+		// 发布当前帧并换得一块空闲缓冲, 由渲染线程负责提交
+		mFrames.publish();
+		mFrames.getWriteBuffer().clear();
+		mTaskQueue->notify();
+		return;
+	}
+
+	RenderFrame& frame = mFrames.getWriteBuffer();
+	submit(frame);
+	frame.clear();
 	SDL_RenderPresent(mRenderer);
 }
 
 void Renderer::clearScreen() {
-	if (!SDL_RenderClear(mRenderer)) {
-		spdlog::error("{} 清除渲染器失败: {}", mLogTag.data(), SDL_GetError());
+	RenderCommand command;
+	command.mType = RenderCommandType::Clear;
+	command.mColor = mDrawColor;
+	pushCommand(std::move(command));
+}
+
+bool Renderer::presentPublishedFrame() {
+	if (!mFrames.consume()) {
+		return false;
 	}
+	submit(mFrames.getReadBuffer());
+	SDL_RenderPresent(mRenderer);
+	return true;
 }
 
 void Renderer::setDrawColor(Uint8 r, Uint8 g, Uint8 b, Uint8 a) {
-	if (!SDL_SetRenderDrawColor(mRenderer, r, g, b, a)) {
-		spdlog::error("{} 设置渲染器绘制颜色失败: {}", mLogTag.data(), SDL_GetError());
-	}
+	mDrawColor = { r / 255.f, g / 255.f, b / 255.f, a / 255.f };
 }
 
 void Renderer::setDrawColorFloat(float r, float g, float b, float a) {
-	if (!SDL_SetRenderDrawColorFloat(mRenderer, r, g, b, a)) {
-		spdlog::error("{} 设置渲染器绘制颜色失败: {}", mLogTag.data(), SDL_GetError());
+	mDrawColor = { r, g, b, a };
+}
+
+void Renderer::setThreaded(bool isThreaded) {
+	mIsThreaded = isThreaded;
+	spdlog::trace("{} 渲染线程模式: {}", mLogTag.data(), mIsThreaded ? "Enable" : "Disable");
+}
+
+bool Renderer::isThreaded() const {
+	return mIsThreaded;
+}
+
+void Renderer::setNullBackend(bool isNullBackend) {
+	mIsNullBackend = isNullBackend;
+	spdlog::trace("{} 空后端: {}", mLogTag.data(), mIsNullBackend ? "Enable" : "Disable");
+}
+
+void Renderer::setFrameCacheEnabled(bool isEnabled) {
+	mIsFrameCacheEnabled = isEnabled;
+	mIsFrameInvalidated = true;
+	spdlog::trace("{} 帧缓存模式: {}", mLogTag.data(), mIsFrameCacheEnabled ? "Enable" : "Disable");
+}
+
+void Renderer::setFrameCacheVerifyEnabled(bool isEnabled) {
+	mIsFrameVerifyEnabled = isEnabled;
+	mIsFrameInvalidated = true;
+	spdlog::trace("{} 帧缓存校验: {}", mLogTag.data(), mIsFrameVerifyEnabled ? "Enable" : "Disable");
+}
+
+void Renderer::invalidateFrame() {
+	mIsFrameInvalidated = true;
+	mIsDirtyHistoryValid = false;
+	// 渲染目标重置等事件后缓存纹理的内容也可能丢失
+	invalidateFrameCapture();
+}
+
+bool Renderer::beginFrameCapture() {
+	if (mIsNullBackend) {
+		return false;
+	}
+
+	// 缓存纹理与逻辑分辨率一致, 这样录制的命令坐标无需转换; 逻辑分辨率变化时重新创建
+	SDL_Texture* retiredTexture = nullptr;
+	bool isCreated = mTaskQueue->runSync([this, &retiredTexture] {
+		int width = 0;
+		int height = 0;
+		if (!SDL_GetRenderLogicalPresentation(mRenderer, &width, &height, nullptr) || width <= 0 || height <= 0) {
+			SDL_GetCurrentRenderOutputSize(mRenderer, &width, &height);
+		}
+		glm::vec2 size(static_cast<float>(width), static_cast<float>(height));
+		if (mCaptureTexture && size == mCaptureSize) {
+			return true;
+		}
+		// 已录制但尚未提交的帧可能仍以旧纹理为目标, 交给资源管理器延迟销毁
+		retiredTexture = std::exchange(mCaptureTexture, nullptr);
+		mCaptureTexture = SDL_CreateTexture(mRenderer, SDL_PIXELFORMAT_RGBA32, SDL_TEXTUREACCESS_TARGET, width, height);
+		if (!mCaptureTexture) {
+			spdlog::error("{} 创建帧捕获纹理失败: {}", mLogTag.data(), SDL_GetError());
+			return false;
+		}
+		SDL_SetTextureScaleMode(mCaptureTexture, SDL_SCALEMODE_NEAREST);
+		SDL_SetTextureBlendMode(mCaptureTexture, SDL_BLENDMODE_BLEND);
+		mCaptureSize = size;
+		mRequestedCaptureId = 0;
+		return true;
+	});
+	mResourceManager->retireTexture(retiredTexture);
+	if (!isCreated) {
+		return false;
+	}
+
+	// 渲染线程模式下中间帧可能被丢弃, 因此失效后执行完成的任意一次捕获都可以使用
+	mCurrentCaptureId = ++mCaptureCounter;
+	if (mRequestedCaptureId == 0) {
+		mRequestedCaptureId = mCurrentCaptureId;
+	}
+
+	RenderCommand command;
+	command.mType = RenderCommandType::SetRenderTarget;
+	command.mTexture = mCaptureTexture;
+	command.mCaptureId = mCurrentCaptureId;
+	pushCommand(std::move(command));
+	clearScreen();
+	mActiveTarget = mCaptureTexture;
+	return true;
+}
+
+void Renderer::endFrameCapture() {
+	RenderCommand command;
+	command.mType = RenderCommandType::SetRenderTarget;
+	command.mCaptureId = mCurrentCaptureId;
+	pushCommand(std::move(command));
+	mActiveTarget = nullptr;
+}
+
+void Renderer::drawFrameCapture() {
+	if (!mCaptureTexture) {
+		return;
+	}
+	RenderCommand command;
+	command.mType = RenderCommandType::Texture;
+	command.mTexture = mCaptureTexture;
+	command.mSourceRect = { 0.f, 0.f, mCaptureSize.x, mCaptureSize.y };
+	command.mDestRect = command.mSourceRect;
+	pushCommand(std::move(command));
+}
+
+bool Renderer::isFrameCaptureReady() const {
+	return mRequestedCaptureId != 0 && mExecutedCaptureId.load() >= mRequestedCaptureId;
+}
+
+void Renderer::invalidateFrameCapture() {
+	mRequestedCaptureId = 0;
+}
+
+void Renderer::releaseFrameCapture() {
+	mResourceManager->retireTexture(std::exchange(mCaptureTexture, nullptr));
+	mCaptureSize = glm::vec2(0.f);
+	mRequestedCaptureId = 0;
+}
+
+bool Renderer::beginWorldLayer(const Camera& camera) {
+	if (!mIsDynamicResolutionEnabled || mIsNullBackend || mIsInWorldLayer) {
+		return false;
+	}
+
+	// 纹理按最大缩放(视口尺寸)创建, 缩放变化时只使用左上角的一部分, 只有视口尺寸变化时才重新创建
+	glm::vec2 size = glm::max(glm::round(camera.getViewPortSize()), glm::vec2(1.f));
+	if (!mWorldTexture || size != mWorldSize) {
+		// 已录制但尚未提交的帧可能仍以旧纹理为目标, 交给资源管理器延迟销毁
+		mResourceManager->retireTexture(std::exchange(mWorldTexture, nullptr));
+		bool isCreated = mTaskQueue->runSync([this, size] {
+			mWorldTexture = SDL_CreateTexture(mRenderer, SDL_PIXELFORMAT_RGBA32, SDL_TEXTUREACCESS_TARGET, static_cast<int>(size.x), static_cast<int>(size.y));
+			if (!mWorldTexture) {
+				spdlog::error("{} 创建世界层纹理失败: {}", mLogTag.data(), SDL_GetError());
+				return false;
+			}
+			SDL_SetTextureScaleMode(mWorldTexture, SDL_SCALEMODE_NEAREST);
+			SDL_SetTextureBlendMode(mWorldTexture, SDL_BLENDMODE_BLEND);
+			return true;
+		});
+		if (!isCreated) {
+			mWorldSize = glm::vec2(0.f);
+			return false;
+		}
+		mWorldSize = size;
+	}
+
+	RenderCommand command;
+	command.mType = RenderCommandType::SetRenderTarget;
+	command.mTexture = mWorldTexture;
+	command.mRenderScale = mWorldScale;
+	pushCommand(std::move(command));
+
+	// 清为透明, 叠加在下层场景之上的场景不会遮住下层
+	RenderCommand clear;
+	clear.mType = RenderCommandType::Clear;
+	clear.mColor = { 0.f, 0.f, 0.f, 0.f };
+	pushCommand(std::move(clear));
+
+	mIsInWorldLayer = true;
+	return true;
+}
+
+void Renderer::endWorldLayer() {
+	if (!mIsInWorldLayer) {
+		return;
+	}
+	mIsInWorldLayer = false;
+
+	RenderCommand command;
+	command.mType = RenderCommandType::SetRenderTarget;
+	command.mTexture = mActiveTarget;
+	pushCommand(std::move(command));
+
+	RenderCommand blit;
+	blit.mType = RenderCommandType::Texture;
+	blit.mTexture = mWorldTexture;
+	blit.mSourceRect = { 0.f, 0.f, mWorldSize.x * mWorldScale, mWorldSize.y * mWorldScale };
+	blit.mDestRect = { 0.f, 0.f, mWorldSize.x, mWorldSize.y };
+	pushCommand(std::move(blit));
+}
+
+void Renderer::setDynamicResolutionEnabled(bool isEnabled) {
+	mIsDynamicResolutionEnabled = isEnabled;
+	spdlog::trace("{} 动态分辨率: {}", mLogTag.data(), mIsDynamicResolutionEnabled ? "Enable" : "Disable");
+}
+
+void Renderer::setWorldScale(float scale) {
+	float worldScale = std::clamp(scale, 0.25f, 1.f);
+	if (worldScale != mWorldScale) {
+		mWorldScale = worldScale;
+		// 世界层的分辨率变化后画面不同, 帧缓存模式下不能沿用上一帧
+		mIsFrameInvalidated = true;
+	}
+}
+
+float Renderer::getWorldScale() const {
+	return mWorldScale;
+}
+
+void Renderer::releaseWorldLayer() {
+	mResourceManager->retireTexture(std::exchange(mWorldTexture, nullptr));
+	mWorldSize = glm::vec2(0.f);
+}
+
+void Renderer::setDirtyRectsEnabled(bool isEnabled, float threshold) {
+	mDirtyRectThreshold = std::clamp(threshold, 0.f, 1.f);
+	mIsDirtyHistoryValid = false;
+	if (!isEnabled || mIsNullBackend) {
+		mIsDirtyRectsEnabled = false;
+		return;
 	}
+
+	// 硬件渲染器每帧重绘的代价很低, 且呈现后后台缓冲的内容不保证保留, 因此只对软件渲染器启用
+	const char* name = mTaskQueue->runSync([this] { return SDL_GetRendererName(mRenderer); });
+	mIsDirtyRectsEnabled = name && std::string_view(name) == SDL_SOFTWARE_RENDERER;
+	spdlog::info("{} 脏矩形模式: {} (渲染器: {})", mLogTag.data(), mIsDirtyRectsEnabled ? "Enable" : "Disable", name ? name : "unknown");
+}
+
+std::uint64_t Renderer::getPartialRedrawCount() const {
+	return mPartialRedrawCount.load();
+}
+
+float Renderer::getSubmitTime() const {
+	return static_cast<float>(mSubmitTimeNs.load()) / 1e6f;
+}
+
+const RenderStats& Renderer::getFrameStats() const {
+	return mFrameStats;
+}
+
+void Renderer::setTextRenderer(TextRenderer* textRenderer) {
+	mTextRenderer = textRenderer;
 }
 
 SDL_Renderer* Renderer::getSDLRenderer() const {
 	return mRenderer;
 }
 
-std::optional<SDL_FRect> Renderer::getSpriteSourceRect(const Sprite& sprite) {
-	SDL_Texture* texture = mResourceManager->getTexture(sprite.getTextureId());
-	if (!texture) {
-		spdlog::error("{} 无法为 ID {} 获取纹理", mLogTag.data(), sprite.getTextureId());
-		return std::nullopt;
-	}
+RenderTaskQueue& Renderer::getTaskQueue() const {
+	return *mTaskQueue;
+}
 
+std::optional<SDL_FRect> Renderer::getSpriteSourceRect(const Sprite& sprite, const engine::resource::TextureRegion& region) {
 	auto srcRect = sprite.getSourceRect();
 	if (srcRect.has_value()) {
 		if (srcRect.value().w <= 0 || srcRect.value().h <= 0) {
 			spdlog::error("{} 源矩阵尺寸无效, ID: {}", mLogTag.data(), sprite.getTextureId());
 			return std::nullopt;
 		}
-		return srcRect;
+		// 精灵的源矩形相对于原图片, 图片打包进图集时需要加上其在图集页中的偏移
+		return SDL_FRect{ srcRect->x + region.mRect.x, srcRect->y + region.mRect.y, srcRect->w, srcRect->h };
 	}
 	else {
-		SDL_FRect result = { 0, 0, 0, 0 };
-		if (!SDL_GetTextureSize(texture, &result.w, &result.h)) {
+		// 没有源矩形时使用整张图片(尺寸在加载时已缓存)
+		if (region.mRect.w <= 0 || region.mRect.h <= 0) {
 			spdlog::error("{} 无法获取纹理尺寸, ID: {}", mLogTag.data(), sprite.getTextureId());
 			return std::nullopt;
 		}
-		return result;
+		return region.mRect;
 	}
 }
 
@@ -204,4 +699,200 @@ bool Renderer::isRectInViewPort(const Camera& camera, const SDL_FRect& rect) {
 	// 相当于AABB碰撞检测
 	return rect.x + rect.w >= 0 && rect.x <= viewPortSize.x && rect.y + rect.h >= 0 && rect.y <= viewPortSize.y;
 }
+
+void Renderer::submit(const RenderFrame& frame) {
+	Uint64 startTime = SDL_GetTicksNS();
+	if (mIsDirtyRectsEnabled && collectDirtyRects(frame)) {
+		submitDirtyRects(frame);
+		mPartialRedrawCount.fetch_add(1);
+	}
+	else {
+		for (const auto& command : frame.mCommands) {
+			executeCommand(frame, command);
+		}
+	}
+	mSubmitTimeNs.store(SDL_GetTicksNS() - startTime);
+}
+
+bool Renderer::collectDirtyRects(const RenderFrame& frame) {
+	int width = 0;
+	int height = 0;
+	if (!SDL_GetRenderLogicalPresentation(mRenderer, &width, &height, nullptr) || width <= 0 || height <= 0) {
+		SDL_GetCurrentRenderOutputSize(mRenderer, &width, &height);
+	}
+	SDL_FRect screenRect = { 0.f, 0.f, static_cast<float>(width), static_cast<float>(height) };
+	bool isHistoryValid = mIsDirtyHistoryValid.exchange(true) && screenRect.w == mScreenRect.w && screenRect.h == mScreenRect.h;
+	mScreenRect = screenRect;
+
+	// 计算本帧每条命令的哈希和影响区域; 含有无法确定范围的命令时本帧和下一帧都完整重绘
+	mCommandHashes.clear();
+	mCommandBounds.clear();
+	bool isTrackable = !frame.mCommands.empty() && frame.mCommands.front().mType == RenderCommandType::Clear;
+	for (const auto& command : frame.mCommands) {
+		auto bounds = getCommandBounds(frame, command, screenRect);
+		if (!bounds.has_value()) {
+			isTrackable = false;
+			break;
+		}
+		std::uint64_t hash = hashCommand(14695981039346656037ull, command);
+		if (command.mType == RenderCommandType::Geometry && command.mVertexCount > 0) {
+			hash = hashBytes(hash, frame.mVertices.data() + command.mFirstVertex, sizeof(SDL_Vertex) * command.mVertexCount);
+		}
+		mCommandHashes.push_back(hash);
+		mCommandBounds.push_back(bounds.value());
+	}
+	if (!isTrackable) {
+		mIsDirtyHistoryValid = false;
+		return false;
+	}
+
+	// 逐条寻找上一帧中相同的命令; 找不到的命令(新增, 移动, 换帧)以及上一帧中没有被匹配的命令所在区域都需要重绘.
+	// 相同的命令绘制顺序发生了交换时, 重叠部分的结果也会变化, 同样按脏区域处理
+	mDirtyRects.clear();
+	float dirtyArea = 0.f;
+	const float maxDirtyArea = screenRect.w * screenRect.h * mDirtyRectThreshold;
+	auto addDirtyRect = [this, &dirtyArea](const SDL_FRect& rect) {
+		if (rect.w <= 0.f || rect.h <= 0.f) {
+			return;
+		}
+		// 与已有脏矩形相交时合并, 合并后可能与其他矩形相交, 继续合并直到稳定
+		SDL_FRect merged = rect;
+		for (std::size_t i = 0; i < mDirtyRects.size();) {
+			if (isRectIntersected(mDirtyRects[i], merged)) {
+				merged = getRectUnion(mDirtyRects[i], merged);
+				mDirtyRects[i] = mDirtyRects.back();
+				mDirtyRects.pop_back();
+				i = 0;
+			}
+			else {
+				++i;
+			}
+		}
+		mDirtyRects.push_back(merged);
+		dirtyArea = 0.f;
+		for (const auto& dirty : mDirtyRects) {
+			dirtyArea += dirty.w * dirty.h;
+		}
+	};
+
+	if (isHistoryValid) {
+		mIsLastCommandMatched.assign(mLastCommands.size(), false);
+		std::size_t lastMatchedIndex = 0;
+		for (std::size_t i = 0; i < mCommandHashes.size() && dirtyArea <= maxDirtyArea; ++i) {
+			auto iter = std::lower_bound(mLastCommands.begin(), mLastCommands.end(), std::make_pair(mCommandHashes[i], std::size_t(0)));
+			while (iter != mLastCommands.end() && iter->first == mCommandHashes[i] && mIsLastCommandMatched[iter - mLastCommands.begin()]) {
+				++iter;
+			}
+			if (iter == mLastCommands.end() || iter->first != mCommandHashes[i]) {
+				addDirtyRect(mCommandBounds[i]);
+				continue;
+			}
+			mIsLastCommandMatched[iter - mLastCommands.begin()] = true;
+			if (iter->second < lastMatchedIndex) {
+				addDirtyRect(mCommandBounds[i]);
+			}
+			lastMatchedIndex = std::max(lastMatchedIndex, iter->second);
+		}
+		for (std::size_t i = 0; i < mLastCommands.size() && dirtyArea <= maxDirtyArea; ++i) {
+			if (!mIsLastCommandMatched[i]) {
+				addDirtyRect(mLastCommandBounds[mLastCommands[i].second]);
+			}
+		}
+	}
+
+	// 记录本帧, 供下一帧比较
+	mLastCommands.clear();
+	for (std::size_t i = 0; i < mCommandHashes.size(); ++i) {
+		mLastCommands.emplace_back(mCommandHashes[i], i);
+	}
+	std::sort(mLastCommands.begin(), mLastCommands.end());
+	std::swap(mLastCommandBounds, mCommandBounds);
+
+	return isHistoryValid && dirtyArea <= maxDirtyArea;
+}
+
+void Renderer::submitDirtyRects(const RenderFrame& frame) {
+	const auto& clear = frame.mCommands.front();
+	for (const auto& dirty : mDirtyRects) {
+		// 对齐到整像素, 保证裁剪区域完整覆盖脏矩形
+		SDL_Rect clipRect = {
+			static_cast<int>(std::floor(dirty.x)),
+			static_cast<int>(std::floor(dirty.y)),
+			static_cast<int>(std::ceil(dirty.x + dirty.w) - std::floor(dirty.x)),
+			static_cast<int>(std::ceil(dirty.y + dirty.h) - std::floor(dirty.y))
+		};
+		SDL_FRect clipBounds = {
+			static_cast<float>(clipRect.x), static_cast<float>(clipRect.y),
+			static_cast<float>(clipRect.w), static_cast<float>(clipRect.h)
+		};
+		SDL_SetRenderClipRect(mRenderer, &clipRect);
+
+		// SDL_RenderClear会忽略裁剪区域, 以不混合的填充矩形代替
+		SDL_SetRenderDrawBlendMode(mRenderer, SDL_BLENDMODE_NONE);
+		SDL_SetRenderDrawColorFloat(mRenderer, clear.mColor.r, clear.mColor.g, clear.mColor.b, clear.mColor.a);
+		SDL_RenderFillRect(mRenderer, &clipBounds);
+		SDL_SetRenderDrawBlendMode(mRenderer, SDL_BLENDMODE_BLEND);
+
+		// collectDirtyRects()结束时已把本帧的命令区域记录到mLastCommandBounds
+		for (std::size_t i = 1; i < frame.mCommands.size(); ++i) {
+			if (isRectIntersected(mLastCommandBounds[i], clipBounds)) {
+				executeCommand(frame, frame.mCommands[i]);
+			}
+		}
+	}
+	SDL_SetRenderClipRect(mRenderer, nullptr);
+}
+
+void Renderer::executeCommand(const RenderFrame& frame, const RenderCommand& command) {
+	switch (command.mType) {
+	case RenderCommandType::Clear:
+		SDL_SetRenderDrawColorFloat(mRenderer, command.mColor.r, command.mColor.g, command.mColor.b, command.mColor.a);
+		if (!SDL_RenderClear(mRenderer)) {
+			spdlog::error("{} 清除渲染器失败: {}", mLogTag.data(), SDL_GetError());
+		}
+		break;
+	case RenderCommandType::Texture:
+		if (!SDL_RenderTextureRotated(mRenderer, command.mTexture, &command.mSourceRect, &command.mDestRect, command.mAngle, nullptr, command.mIsFlipped ? SDL_FLIP_HORIZONTAL : SDL_FLIP_NONE)) {
+			spdlog::error("{} 渲染纹理失败: {}", mLogTag.data(), SDL_GetError());
+		}
+		break;
+	case RenderCommandType::SetRenderTarget:
+		if (!SDL_SetRenderTarget(mRenderer, command.mTexture)) {
+			spdlog::error("{} 切换渲染目标失败: {}", mLogTag.data(), SDL_GetError());
+		}
+		else if (command.mTexture && !SDL_SetRenderScale(mRenderer, command.mRenderScale, command.mRenderScale)) {
+			// 每个渲染目标有各自的缩放, 窗口的缩放由逻辑分辨率负责, 不需要设置
+			spdlog::error("{} 设置渲染缩放失败: {}", mLogTag.data(), SDL_GetError());
+		}
+		else if (!command.mTexture && command.mCaptureId != 0) {
+			// 切回窗口说明这次捕获的命令已全部执行, 之后的帧可以直接使用缓存纹理
+			mExecutedCaptureId.store(command.mCaptureId);
+		}
+		break;
+	case RenderCommandType::TiledTexture:
+		if (!SDL_RenderTextureTiled(mRenderer, command.mTexture, &command.mSourceRect, command.mTileScale, &command.mDestRect)) {
+			spdlog::error("{} 平铺纹理失败: {}", mLogTag.data(), SDL_GetError());
+		}
+		break;
+	case RenderCommandType::FilledRect:
+		SDL_SetRenderDrawColorFloat(mRenderer, command.mColor.r, command.mColor.g, command.mColor.b, command.mColor.a);
+		if (!SDL_RenderFillRect(mRenderer, &command.mDestRect)) {
+			spdlog::error("{} 绘制填充矩形失败: {}", mLogTag.data(), SDL_GetError());
+		}
+		break;
+	case RenderCommandType::Text:
+		if (mTextRenderer) {
+			mTextRenderer->submitText(command);
+		}
+		else {
+			spdlog::warn("{} 未设置TextRenderer, 跳过文字命令", mLogTag.data());
+		}
+		break;
+	case RenderCommandType::Geometry:
+		if (!SDL_RenderGeometry(mRenderer, command.mTexture, frame.mVertices.data() + command.mFirstVertex, command.mVertexCount, nullptr, 0)) {
+			spdlog::error("{} 绘制几何体失败: {}", mLogTag.data(), SDL_GetError());
+		}
+		break;
+	}
+}
 } // engine::render
@@ -11,25 +11,62 @@
 #ifndef RENDERER_H
 #define RENDERER_H
 
+#include <atomic>
+#include <cstdint>
 #include <string>
 #include <optional>
+#include <utility>
+#include <vector>
 #include <glm/glm.hpp>
 
 #include "sprite.h"
+#include "render_command.h"
 #include "../utils/math.h"
+#include "../utils/triple_buffer.h"
 
 struct SDL_Renderer;
+struct SDL_Texture;
 struct SDL_FRect;
 struct SDL_FColor;
 
 namespace engine::resource {
 	class ResourceManager;
+	struct TextureRegion;
 }
 
 namespace engine::render {
 class Camera;
+class TextRenderer;
+class RenderTaskQueue;
+
+/**
+ * @brief 一帧录制的渲染命令统计.
+ */
+struct RenderStats {
+	int mCommandCount = 0;													///< @brief 命令总数
+	int mTextureCount = 0;													///< @brief 纹理绘制命令数(含平铺纹理)
+	int mFilledRectCount = 0;												///< @brief 填充矩形命令数
+	int mTextCount = 0;														///< @brief 文字命令数
+	int mGeometryCount = 0;													///< @brief 顶点几何命令数
+	int mVisibleObjectCount = 0;											///< @brief 通过视口裁剪提交渲染的游戏对象数
+	int mCulledObjectCount = 0;												///< @brief 被视口裁剪跳过的游戏对象数
+	bool mIsPresentSkipped = false;											///< @brief 本帧是否因没有脏信号而跳过了提交(帧缓存模式)
+};
+
 /**
- * @brief.
+ * @brief 渲染器.
+ *
+ * 所有draw*函数只负责把绘制请求解析为RenderCommand并录制到当前帧, present()时才真正提交给SDL.
+ * 单线程模式下present()直接提交当前帧; 渲染线程模式下present()通过三缓冲发布当前帧,
+ * 由拥有SDL_Renderer的渲染线程调用presentPublishedFrame()提交最新一帧.
+ * 
+ * 帧缓存模式下调用者在每帧开始时通过beginFrame()告知场景是否有脏信号(UI, 相机, 场景栈, 动画, 游戏对象等变化),
+ * 没有时不遍历场景也不录制命令, 跳过提交和SDL_RenderPresent, 屏幕保持显示上一帧(静态的菜单界面);
+ * 窗口事件等导致屏幕内容失效时需要调用invalidateFrame()强制重绘. 命令哈希只用于校验模式: 没有脏信号的帧仍然录制,
+ * 与上一次提交的帧比较, 不同时说明漏掉了某个脏信号, 输出警告并提交该帧.
+ *
+ * 脏矩形模式(仅软件渲染器)下提交时逐条比较本帧与上一次提交的帧的命令, 只在内容变化的区域内清屏,
+ * 并重绘与这些区域相交的命令; 变化面积过大或帧中含有无法确定范围的命令时退回完整重绘.
  */
 class Renderer final {
 public:
@@ -38,9 +75,10 @@ public:
 	 * 
 	 * @param renderer 指向有效的SDL_Renderer的指针, 不能为空
 	 * @param resourceManager 指向有效的ResourceManager的指针, 不能为空
+	 * @param taskQueue 指向渲染线程任务队列的指针, 不能为空
 	 * @throws 如果任一指针为nullptr则抛出std::runtime_error
 	 */
-	Renderer(SDL_Renderer* renderer, engine::resource::ResourceManager* resourceManager);
+	Renderer(SDL_Renderer* renderer, engine::resource::ResourceManager* resourceManager, RenderTaskQueue* taskQueue);
 
 	/**
 	 * @brief 绘制精灵.
@@ -54,6 +92,9 @@ public:
 	
 	/**
 	 * @brief 绘制视差滚动背景.
+	 * 
+	 * 重复的轴向上整条背景带合并为一条平铺命令(SDL_RenderTextureTiled), 而不是每块纹理一条命令;
+	 * 只有x, y缩放不一致时才退回逐块绘制.
 	 *
 	 * @param sprite 包含纹理ID, 源矩阵和翻转状态的Sprite对象
 	 * @param positioin 世界坐标中的坐上角位置
@@ -65,6 +106,8 @@ public:
 	/**
 	 * @brief 在屏幕坐标中直接渲染一个用于UI的Sprite对象.
 	 *
+	 * 精灵被转为两个三角形录制; 紧接着绘制的使用同一纹理的UI精灵(如一排生命值图标)合并为一条几何命令.
+	 *
 	 * @param sprite 包含纹理ID, 源矩阵和翻转状态的Sprite对象
 	 * @param positioin 世界坐标中的坐上角位置
 	 * @param size 可选: 目标矩阵的大小. 如果为std::nullopt, 则使用Sprite的原始大小
@@ -79,13 +122,90 @@ public:
 	 */
 	void drawUIFilledRect(const engine::utils::Rect& rect, const engine::utils::FColor& color);
 
-	void present();															///< @brief 更新屏幕, 包装SDL_RenderPresent函数
-	void clearScreen();														///< @brief 清屏, 包装SDL_RenderClear函数
+	/**
+	 * @brief 录制一条已解析的渲染命令(供TextRenderer等需要自定义提交方式的模块使用).
+	 *
+	 * @param command 渲染命令
+	 */
+	void pushCommand(RenderCommand&& command);
+
+	/**
+	 * @brief 录制一批三角形, 顶点被复制到当前帧的顶点缓冲中, 提交时一次SDL_RenderGeometry绘制完成.
+	 *
+	 * @param texture 纹理, 可以为空(纯色三角形)
+	 * @param vertices 顶点数组, 数量应为3的倍数
+	 */
+	void pushGeometry(SDL_Texture* texture, const std::vector<SDL_Vertex>& vertices);
+
+	/**
+	 * @brief 记录场景视口裁剪的结果, 计入当前帧的统计.
+	 *
+	 * @param visibleCount 提交渲染的游戏对象数
+	 * @param culledCount 被裁剪的游戏对象数
+	 */
+	void recordCulling(int visibleCount, int culledCount);
 
-	void setDrawColor(Uint8 r, Uint8 g, Uint8 b, Uint8 a = 255);			///< @brief 设置绘制颜色, 包装SDL_SetRenderDrawColor函数, 使用Uint8类型
-	void setDrawColorFloat(float r, float g, float b, float a = 1.f);		///< @brief 设置绘制颜色, 包装SDL_SetRenderDrawColorFloat函数, 使用float类型
+	/**
+	 * @brief 开始一帧: 帧缓存模式下决定本帧是否需要录制.
+	 *
+	 * @param isContentChanged 自上一次录制以来是否有任何脏信号
+	 * @return 是否需要录制本帧; 返回false时调用者不应录制任何命令, 也不再调用present(), 屏幕保持显示上一帧
+	 */
+	bool beginFrame(bool isContentChanged);
+	void present();															///< @brief 结束当前帧的录制: 单线程模式下提交并调用SDL_RenderPresent, 渲染线程模式下发布给渲染线程
+	void clearScreen();														///< @brief 清屏, 录制一条以当前绘制颜色清屏的命令
+
+	bool presentPublishedFrame();											///< @brief 渲染线程调用: 提交并显示最新发布的帧, 没有新帧时返回false
+
+	void setDrawColor(Uint8 r, Uint8 g, Uint8 b, Uint8 a = 255);			///< @brief 设置清屏使用的绘制颜色, 使用Uint8类型
+	void setDrawColorFloat(float r, float g, float b, float a = 1.f);		///< @brief 设置清屏使用的绘制颜色, 使用float类型
+
+	void setThreaded(bool isThreaded);										///< @brief 设置是否由独立的渲染线程提交帧
+	void setNullBackend(bool isNullBackend);								///< @brief 设置空后端: 只录制和统计命令, 不提交给SDL(用于无头基准测试)
+	void setFrameCacheEnabled(bool isEnabled);								///< @brief 设置帧缓存模式: 没有脏信号时跳过录制, 提交和呈现
+	void setFrameCacheVerifyEnabled(bool isEnabled);						///< @brief 设置帧缓存校验(调试用): 没有脏信号的帧仍然录制并与上一次提交的帧比较哈希
+	void invalidateFrame();													///< @brief 使缓存的帧和捕获的画面失效, 下一帧无论是否变化都完整提交
+
+	/**
+	 * @brief 开始把之后录制的命令捕获到缓存纹理(逻辑分辨率), 用于冻结被覆盖层遮挡的下层场景.
+	 *
+	 * @return 是否成功开始捕获; 空后端或无法创建纹理时返回false, 调用方应按正常方式渲染
+	 */
+	bool beginFrameCapture();
+	void endFrameCapture();													///< @brief 结束捕获, 切回窗口
+	void drawFrameCapture();												///< @brief 把捕获的画面铺满整个窗口
+	bool isFrameCaptureReady() const;										///< @brief 最近一次捕获是否已经被提交执行(渲染线程模式下可能晚若干帧)
+	void invalidateFrameCapture();											///< @brief 丢弃捕获的画面
+	void releaseFrameCapture();												///< @brief 释放缓存纹理(延迟销毁), 必须在析构资源管理器之前调用
+
+	/**
+	 * @brief 开始录制世界层(游戏对象): 动态分辨率开启时绘制到按当前缩放渲染的离屏纹理.
+	 *
+	 * @param camera 相机, 其视口尺寸即世界层的逻辑尺寸
+	 * @return 是否切换到了离屏纹理; 返回true时必须调用endWorldLayer()
+	 */
+	bool beginWorldLayer(const Camera& camera);
+	void endWorldLayer();													///< @brief 结束世界层: 切回之前的渲染目标, 以最近邻过滤放大到整个视口
+	void setDynamicResolutionEnabled(bool isEnabled);						///< @brief 设置是否启用动态分辨率
+	void setWorldScale(float scale);										///< @brief 设置世界层的渲染缩放(0.25 ~ 1)
+	float getWorldScale() const;											///< @brief 获取世界层的渲染缩放
+	void releaseWorldLayer();												///< @brief 释放世界层纹理(延迟销毁), 必须在析构资源管理器之前调用
+	float getSubmitTime() const;											///< @brief 获取最近一帧提交命令的耗时(毫秒, 不含SDL_RenderPresent)
+
+	/**
+	 * @brief 设置脏矩形模式, 只对软件渲染器生效.
+	 *
+	 * @param isEnabled 是否启用
+	 * @param threshold 脏区域面积占屏幕的比例超过该值时退回完整重绘
+	 */
+	void setDirtyRectsEnabled(bool isEnabled, float threshold);
+	std::uint64_t getPartialRedrawCount() const;							///< @brief 获取以脏矩形方式局部重绘的帧数
+	const RenderStats& getFrameStats() const;								///< @brief 获取上一帧录制的命令统计
+	bool isThreaded() const;												///< @brief 是否由独立的渲染线程提交帧
+	void setTextRenderer(TextRenderer* textRenderer);						///< @brief 设置用于提交文字命令的TextRenderer
 
 	SDL_Renderer* getSDLRenderer() const;									///< @brief 获取底层的SDL_Renderer指针
+	RenderTaskQueue& getTaskQueue() const;									///< @brief 获取渲染线程任务队列
 
 	// 禁用拷贝和移动语义
 	Renderer(const Renderer&) = delete;										///< @brief 删除拷贝构造
@@ -94,12 +214,56 @@ public:
 	Renderer& operator=(Renderer&&) = delete;								///< @brief 删除移动赋值构造
 
 private:
-	std::optional<SDL_FRect> getSpriteSourceRect(const Sprite& sprite);		///< @brief 获取精灵的源矩阵, 用于具体绘制. 出现错误则返回std::nullopt并跳过绘制
+	std::optional<SDL_FRect> getSpriteSourceRect(const Sprite& sprite, const engine::resource::TextureRegion& region);	///< @brief 获取精灵在实际纹理中的源矩阵(已加上图集区域偏移), 用于具体绘制. 出现错误则返回std::nullopt并跳过绘制
 	bool isRectInViewPort(const Camera& camera, const SDL_FRect& rect);		///< @brief 判断矩形是否在视口中, 用于视口裁剪
+	void submit(const RenderFrame& frame);									///< @brief 按顺序执行一帧的所有命令(仅渲染线程调用)
+	void executeCommand(const RenderFrame& frame, const RenderCommand& command);	///< @brief 执行单条命令(仅渲染线程调用)
+	bool collectDirtyRects(const RenderFrame& frame);						///< @brief 与上一次提交的帧比较, 收集需要重绘的区域; 返回false表示需要完整重绘(仅渲染线程调用)
+	void submitDirtyRects(const RenderFrame& frame);						///< @brief 只在脏矩形内清屏并重绘与之相交的命令(仅渲染线程调用)
 private:
 	static constexpr std::string_view mLogTag = "Renderer";
 	SDL_Renderer* mRenderer = nullptr;										///< @brief 指向SDL_Renderer的非拥有指针
 	engine::resource::ResourceManager* mResourceManager = nullptr;			///< @brief 指向ResourceManager的非拥有指针
+	RenderTaskQueue* mTaskQueue = nullptr;									///< @brief 指向渲染线程任务队列的非拥有指针
+	TextRenderer* mTextRenderer = nullptr;									///< @brief 指向TextRenderer的非拥有指针, 用于提交文字命令
+	engine::utils::TripleBuffer<RenderFrame> mFrames;						///< @brief 录制线程与渲染线程之间交换帧命令的三缓冲
+	engine::utils::FColor mDrawColor = { 0.f, 0.f, 0.f, 1.f };				///< @brief 清屏使用的绘制颜色
+	RenderStats mRecordingStats;											///< @brief 正在录制的帧的命令统计
+	RenderStats mFrameStats;												///< @brief 上一帧的命令统计
+	bool mIsThreaded = false;												///< @brief 是否由独立的渲染线程提交帧
+	bool mIsNullBackend = false;											///< @brief 是否为空后端
+	bool mIsFrameCacheEnabled = false;										///< @brief 是否启用帧缓存模式
+	bool mIsFrameInvalidated = true;										///< @brief 缓存的帧是否已失效(需要完整提交)
+	bool mIsFrameVerifyEnabled = false;										///< @brief 是否启用帧缓存校验(录制时计算命令哈希)
+	bool mIsFrameUnchanged = false;											///< @brief 正在录制的帧没有脏信号(只在校验模式下录制), 哈希与上一次提交的帧相同时跳过提交
+	std::uint64_t mRecordingHash = 0;										///< @brief 正在录制的帧的命令哈希(校验模式)
+	std::uint64_t mPresentedHash = 0;										///< @brief 上一次提交的帧的命令哈希(校验模式)
+	SDL_Texture* mCaptureTexture = nullptr;									///< @brief 捕获下层场景的缓存纹理(渲染目标)
+	glm::vec2 mCaptureSize = glm::vec2(0.f);								///< @brief 缓存纹理的尺寸(与逻辑分辨率一致)
+	std::uint64_t mCaptureCounter = 0;										///< @brief 已发起的捕获次数, 用作捕获序号
+	std::uint64_t mCurrentCaptureId = 0;									///< @brief 正在录制的捕获序号
+	std::uint64_t mRequestedCaptureId = 0;									///< @brief 失效后发起的第一次捕获序号, 不小于它的捕获都有效; 0表示没有
+	std::atomic<std::uint64_t> mExecutedCaptureId = 0;						///< @brief 渲染线程最近执行完成的捕获序号
+	SDL_Texture* mActiveTarget = nullptr;									///< @brief 录制中当前的渲染目标(正在捕获时为缓存纹理)
+	SDL_Texture* mWorldTexture = nullptr;									///< @brief 动态分辨率的世界层纹理
+	glm::vec2 mWorldSize = glm::vec2(0.f);									///< @brief 世界层纹理的尺寸(与相机视口一致)
+	float mWorldScale = 1.f;												///< @brief 世界层的渲染缩放
+	bool mIsDynamicResolutionEnabled = false;								///< @brief 是否启用动态分辨率
+	bool mIsInWorldLayer = false;											///< @brief 是否正在录制世界层
+	std::atomic<std::uint64_t> mSubmitTimeNs = 0;							///< @brief 最近一帧提交命令的耗时(纳秒)
+	bool mIsDirtyRectsEnabled = false;										///< @brief 是否启用脏矩形模式(仅软件渲染器)
+	float mDirtyRectThreshold = 0.5f;										///< @brief 脏区域面积占屏幕的比例超过该值时完整重绘
+	std::atomic<bool> mIsDirtyHistoryValid = false;							///< @brief 上一次提交的帧的记录是否仍然有效(屏幕内容失效时置为false)
+	SDL_FRect mScreenRect = { 0.f, 0.f, 0.f, 0.f };							///< @brief 屏幕的逻辑区域
+	std::vector<std::uint64_t> mCommandHashes;								///< @brief 本帧每条命令的哈希
+	std::vector<SDL_FRect> mCommandBounds;									///< @brief 本帧每条命令影响的屏幕区域
+	std::vector<std::pair<std::uint64_t, std::size_t>> mLastCommands;		///< @brief 上一次提交的帧的(命令哈希, 序号), 按哈希排序便于查找
+	std::vector<SDL_FRect> mLastCommandBounds;								///< @brief 上一次提交的帧每条命令影响的屏幕区域
+	std::vector<bool> mIsLastCommandMatched;								///< @brief 上一次提交的帧的命令是否已在本帧找到相同的命令
+	std::vector<SDL_FRect> mDirtyRects;										///< @brief 本帧合并后的脏矩形
+	std::atomic<std::uint64_t> mPartialRedrawCount = 0;						///< @brief 以脏矩形方式局部重绘的帧数
+	static constexpr std::size_t mNoUIBatch = static_cast<std::size_t>(-1);	///< @brief 没有可追加的UI批次
+	std::size_t mUIBatchIndex = mNoUIBatch;									///< @brief 当前帧中最近一条UI批次几何命令的序号
 };
 }
 
@@ -1,18 +1,24 @@
 #include "text_renderer.h"
 #include "camera.h"
+#include "renderer.h"
+#include "render_command.h"
+#include "render_task_queue.h"
+#include "glyph_atlas.h"
 #include "../resource/resource_manager.h"
 #include <SDL3_ttf/SDL_ttf.h>
 #include <spdlog/spdlog.h>
+#include <functional>
 #include <stdexcept>
 
 namespace engine::render {
-TextRenderer::TextRenderer(SDL_Renderer* sdl_renderer, engine::resource::ResourceManager* resource_manager)
-	: mSdlRenderer(sdl_renderer)
+TextRenderer::TextRenderer(Renderer* renderer, engine::resource::ResourceManager* resource_manager)
+	: mRenderer(renderer)
 	, mResourceManager(resource_manager)
 {
-	if (!mSdlRenderer || !mResourceManager) {
-		throw std::runtime_error("TextRenderer 需要一个有效的 SDL_Renderer 和 ResourceManager。");
+	if (!mRenderer || !mResourceManager) {
+		throw std::runtime_error("TextRenderer 需要一个有效的 Renderer 和 ResourceManager。");
 	}
+	mSdlRenderer = mRenderer->getSDLRenderer();
 	// 初始化 SDL_ttf
 	if (!TTF_WasInit() && TTF_Init() == false) {
 		throw std::runtime_error("初始化 SDL_ttf 失败: " + std::string(SDL_GetError()));
@@ -23,6 +29,10 @@ TextRenderer::TextRenderer(SDL_Renderer* sdl_renderer, engine::resource::Resourc
 		spdlog::error("创建 TTF_TextEngine 失败: {}", SDL_GetError());
 		throw std::runtime_error("创建 TTF_TextEngine 失败。");
 	}
+	// 字体卸载之前移除引用它的 TTF_Text（ResourceManager 先于 TextRenderer 销毁）
+	mResourceManager->setFontReleaseCallback([this](std::string_view fontId, int fontSize) {
+		purgeFont(fontId, fontSize);
+	});
 	spdlog::trace("TextRenderer 初始化成功.");
 }
 
@@ -33,6 +43,7 @@ TextRenderer::~TextRenderer() {
 }
 
 void TextRenderer::close() {
+	clearTextCache();
 	if (mTextEngine) {
 		TTF_DestroyRendererTextEngine(mTextEngine);
 		mTextEngine = nullptr;
@@ -41,35 +52,72 @@ void TextRenderer::close() {
 	TTF_Quit();     // 一定要确保在ResourceManager销毁之后调用
 }
 
-void TextRenderer::drawUIText(std::string_view text, std::string_view font_id, int font_size, const glm::vec2& position, const engine::utils::FColor& color) {
-	/* 构造函数已经保证了必要指针不会为空，这里不需要再检查 */
-	TTF_Font* font = mResourceManager->getFont(font_id, font_size);
-	if (!font) {
-		spdlog::warn("drawUIText 获取字体失败: {} 大小 {}", font_id.data(), font_size);
-		return;
+void TextRenderer::clearTextCache() {
+	for (auto& entry : mTextCache) {
+		TTF_DestroyText(entry.mText);
 	}
+	if (!mTextCache.empty()) {
+		spdlog::trace("清空 TTF_Text 缓存, 共 {} 个。", mTextCache.size());
+	}
+	mTextCache.clear();
+	mTextCacheIndex.clear();
+}
 
-	// 创建临时 TTF_Text 对象   (目前效率不高，未来可以考虑使用缓存优化)
-	TTF_Text* temp_text_object = TTF_CreateText(mTextEngine, font, text.data(), 0);
-	if (!temp_text_object) {
-		spdlog::error("drawUIText 创建临时 TTF_Text 失败: {}", SDL_GetError());
+void TextRenderer::purgeFont(std::string_view fontId, int fontSize) {
+	if (fontId.empty()) {
+		clearTextCache();
 		return;
 	}
+	for (auto entry = mTextCache.begin(); entry != mTextCache.end();) {
+		if (entry->mFontId != fontId || entry->mFontSize != fontSize) {
+			++entry;
+			continue;
+		}
+		TTF_DestroyText(entry->mText);
+		mTextCacheIndex.erase(hashText(entry->mFontId, entry->mFontSize, entry->mString));
+		entry = mTextCache.erase(entry);
+	}
+}
 
-	// 先渲染一次黑色文字模拟阴影
-	TTF_SetTextColorFloat(temp_text_object, 0.0f, 0.0f, 0.0f, 1.0f);
-	if (!TTF_DrawRendererText(temp_text_object, position.x + 2, position.y + 2)) {
-		spdlog::error("drawUIText 绘制临时 TTF_Text 失败: {}", SDL_GetError());
+void TextRenderer::setGlyphAtlasEnabled(bool enabled) {
+	mGlyphAtlasEnabled = enabled;
+	spdlog::trace("字形图集文字: {}", mGlyphAtlasEnabled ? "Enable" : "Disable");
+}
+
+bool TextRenderer::isGlyphAtlasEnabled() const {
+	return mGlyphAtlasEnabled;
+}
+
+void TextRenderer::drawUIText(std::string_view text, std::string_view font_id, int font_size, const glm::vec2& position, const engine::utils::FColor& color) {
+	/* 构造函数已经保证了必要指针不会为空，这里不需要再检查 */
+	if (mGlyphAtlasEnabled) {
+		const GlyphAtlas* atlas = mResourceManager->getGlyphAtlas(font_id, font_size);
+		if (atlas && atlas->canRender(text)) {
+			// 阴影和正文合并为一批四边形，一次 SDL_RenderGeometry 完成
+			mGlyphVertices.clear();
+			atlas->appendQuads(text, position + glm::vec2(2.0f, 2.0f), { 0.0f, 0.0f, 0.0f, 1.0f }, mGlyphVertices);
+			atlas->appendQuads(text, position, color, mGlyphVertices);
+			mRenderer->pushGeometry(atlas->getTexture(), mGlyphVertices);
+			return;
+		}
 	}
 
-	// 然后正常绘制
-	TTF_SetTextColorFloat(temp_text_object, color.r, color.g, color.b, color.a);
-	if (!TTF_DrawRendererText(temp_text_object, position.x, position.y)) {
-		spdlog::error("drawUIText 绘制临时 TTF_Text 失败: {}", SDL_GetError());
+	TTF_Font* font = mResourceManager->getFont(font_id, font_size);
+	if (!font) {
+		spdlog::warn("drawUIText 获取字体失败: {} 大小 {}", font_id.data(), font_size);
+		return;
 	}
 
-	// 销毁临时 TTF_Text 对象
-	TTF_DestroyText(temp_text_object);
+	// 录制文字命令，真正的绘制在 submitText() 中完成
+	RenderCommand command;
+	command.mType = RenderCommandType::Text;
+	command.mFont = font;
+	command.mFontId = font_id;
+	command.mFontSize = font_size;
+	command.mDestRect = { position.x, position.y, 0.0f, 0.0f };
+	command.mColor = color;
+	command.mText = text;
+	mRenderer->pushCommand(std::move(command));
 }
 
 void TextRenderer::drawText(const Camera& camera, std::string_view text, std::string_view font_id, int font_size, const glm::vec2& position, const engine::utils::FColor& color) {
@@ -82,25 +130,91 @@ void TextRenderer::drawText(const Camera& camera, std::string_view text, std::st
 
 glm::vec2 TextRenderer::getTextSize(std::string_view text, std::string_view font_id, int font_size) {
 	/* 构造函数已经保证了必要指针不会为空，这里不需要再检查 */
+	if (mGlyphAtlasEnabled) {
+		const GlyphAtlas* atlas = mResourceManager->getGlyphAtlas(font_id, font_size);
+		if (atlas && atlas->canRender(text)) {
+			return atlas->measure(text);
+		}
+	}
+
 	TTF_Font* font = mResourceManager->getFont(font_id, font_size);
 	if (!font) {
 		spdlog::warn("getTextSize 获取字体失败: {} 大小 {}", font_id.data(), font_size);
 		return glm::vec2(0.0f, 0.0f);
 	}
 
-	// 创建临时 TTF_Text 对象
-	TTF_Text* temp_text_object = TTF_CreateText(mTextEngine, font, text.data(), 0);
-	if (!temp_text_object) {
-		spdlog::error("getTextSize 创建临时 TTF_Text 失败: {}", SDL_GetError());
-		return glm::vec2(0.0f, 0.0f);
+	// TTF_Text 依赖文字引擎，只能在渲染线程上创建
+	return mRenderer->getTaskQueue().runSync([&]() {
+		// 从缓存中获取，后续绘制同一字符串时直接复用排版结果
+		TTF_Text* text_object = acquireText(font, font_id, font_size, text);
+		if (!text_object) {
+			return glm::vec2(0.0f, 0.0f);
+		}
+
+		int width, height;
+		TTF_GetTextSize(text_object, &width, &height);
+		return glm::vec2(static_cast<float>(width), static_cast<float>(height));
+	});
+}
+
+void TextRenderer::submitText(const RenderCommand& command) {
+	TTF_Text* text_object = acquireText(command.mFont, command.mFontId, command.mFontSize, command.mText);
+	if (!text_object) {
+		return;
+	}
+
+	// 先渲染一次黑色文字模拟阴影
+	TTF_SetTextColorFloat(text_object, 0.0f, 0.0f, 0.0f, 1.0f);
+	if (!TTF_DrawRendererText(text_object, command.mDestRect.x + 2, command.mDestRect.y + 2)) {
+		spdlog::error("drawUIText 绘制 TTF_Text 失败: {}", SDL_GetError());
 	}
 
-	int width, height;
-	TTF_GetTextSize(temp_text_object, &width, &height);
+	// 然后正常绘制
+	TTF_SetTextColorFloat(text_object, command.mColor.r, command.mColor.g, command.mColor.b, command.mColor.a);
+	if (!TTF_DrawRendererText(text_object, command.mDestRect.x, command.mDestRect.y)) {
+		spdlog::error("drawUIText 绘制 TTF_Text 失败: {}", SDL_GetError());
+	}
+}
+
+TTF_Text* TextRenderer::acquireText(TTF_Font* font, std::string_view fontId, int fontSize, std::string_view text) {
+	std::size_t key = hashText(fontId, fontSize, text);
+	auto iter = mTextCacheIndex.find(key);
+	if (iter != mTextCacheIndex.end()) {
+		auto entry = iter->second;
+		if (entry->mFontId == fontId && entry->mFontSize == fontSize && entry->mString == text) {
+			// 命中: 移到链表头部
+			mTextCache.splice(mTextCache.begin(), mTextCache, entry);
+			return entry->mText;
+		}
+		// 哈希冲突: 丢弃旧条目，用新字符串替换
+		TTF_DestroyText(entry->mText);
+		mTextCache.erase(entry);
+		mTextCacheIndex.erase(iter);
+	}
 
-	// 销毁临时 TTF_Text 对象
-	TTF_DestroyText(temp_text_object);
+	TTF_Text* text_object = TTF_CreateText(mTextEngine, font, text.data(), text.size());
+	if (!text_object) {
+		spdlog::error("创建 TTF_Text 失败: {}", SDL_GetError());
+		return nullptr;
+	}
+
+	mTextCache.push_front({ std::string(fontId), fontSize, std::string(text), text_object });
+	mTextCacheIndex.emplace(key, mTextCache.begin());
+
+	// 超出容量时淘汰最久未使用的条目
+	if (mTextCache.size() > mTextCacheCapacity) {
+		auto& oldest = mTextCache.back();
+		TTF_DestroyText(oldest.mText);
+		mTextCacheIndex.erase(hashText(oldest.mFontId, oldest.mFontSize, oldest.mString));
+		mTextCache.pop_back();
+	}
+	return text_object;
+}
 
-	return glm::vec2(static_cast<float>(width), static_cast<float>(height));
+std::size_t TextRenderer::hashText(std::string_view fontId, int fontSize, std::string_view text) {
+	std::size_t seed = std::hash<std::string_view>{}(text);
+	seed ^= std::hash<std::string_view>{}(fontId) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+	seed ^= std::hash<int>{}(fontSize) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+	return seed;
 }
 } // namespace engine::render
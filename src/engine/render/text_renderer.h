@@ -12,12 +12,18 @@
 #define TEXT_RENDERER_H
 
 #include <SDL3/SDL_render.h>
+#include <cstddef>
+#include <list>
 #include <string>
 #include <string_view>
+#include <unordered_map>
+#include <vector>
 #include <glm/vec2.hpp>
 #include "../utils/math.h"
 
 struct TTF_TextEngine;
+struct TTF_Text;
+struct TTF_Font;
 
 namespace engine::resource {
     class ResourceManager;
@@ -25,26 +31,40 @@ namespace engine::resource {
 
 namespace engine::render {
 class Camera;
+class Renderer;
+struct RenderCommand;
 /**
 * @brief 使用 SDL_ttf 和 TTF_Text 对象处理文本渲染。
 *
 * 封装 TTF_TextEngine 并提供创建和绘制 TTF_Text 对象的方法，
-* 管理字体加载和颜色设置。
+* 管理字体加载和颜色设置。绘制请求先录制为 Renderer 的文字命令，
+* 由 Renderer 在提交帧时回调 submitText() 真正绘制。
+* 
+* TTF_Text 按 (字体 ID, 字号, 字符串) 缓存在 LRU 中，同一字符串只排版一次，
+* 后续的绘制和尺寸查询都复用同一个对象。缓存只在渲染线程上访问，
+* 字体被卸载之前 ResourceManager 通过回调移除引用它的条目。
+* 
+* 启用字形图集时，字体的图集能覆盖的字符串直接生成四边形录制为 Geometry 命令，
+* 不再经过 SDL_ttf 排版；图集无法覆盖时回退到 TTF_Text 路径。
 */
 class TextRenderer final {
 public:
     /**
 	* @brief 构造 TextRenderer。
 	*
-	* @param sdlRenderer 有效的 SDL_Renderer 指针。
+	* @param renderer 有效的 Renderer 指针（用于录制文字命令）。
 	* @param resourceManager 有效的 ResourceManager 指针（用于字体加载）。
 	* @throws std::runtime_error 如果初始化失败。
 	*/
-    TextRenderer(SDL_Renderer* sdlRenderer, engine::resource::ResourceManager* resourceManager);
+    TextRenderer(Renderer* renderer, engine::resource::ResourceManager* resourceManager);
 
 	~TextRenderer();															///< @brief 析构函数，按需调用close()。
 
 	void close();																///< @brief 显式关闭。清理 TTF_TextEngine 并关闭SDL_ttf。
+	void clearTextCache();														///< @brief 销毁所有缓存的 TTF_Text，必须在字体被关闭之前调用。
+	void purgeFont(std::string_view fontId, int fontSize);						///< @brief 销毁使用指定字体的缓存 TTF_Text（仅渲染线程调用），fontId 为空时销毁全部。
+	void setGlyphAtlasEnabled(bool enabled);									///< @brief 设置是否优先使用字形图集绘制文字。
+	bool isGlyphAtlasEnabled() const;											///< @brief 是否优先使用字形图集绘制文字。
 
     /**
 	* @brief 绘制UI上的字符串。
@@ -79,15 +99,53 @@ public:
 	*/
     glm::vec2 getTextSize(std::string_view text, std::string_view fontId, int fontSize);
 
+    /**
+	* @brief 执行一条文字命令（仅渲染线程调用，由 Renderer 提交帧时回调）。
+	*
+	* @param command 类型为 RenderCommandType::Text 的命令。
+	*/
+    void submitText(const RenderCommand& command);
+
     // 禁用拷贝和移动语义
     TextRenderer(const TextRenderer&) = delete;
     TextRenderer& operator=(const TextRenderer&) = delete;
     TextRenderer(TextRenderer&&) = delete;
     TextRenderer& operator=(TextRenderer&&) = delete;
 private:
-	SDL_Renderer* mSdlRenderer = nullptr;														///< @brief 持有渲染器的非拥有指针
+	/**
+	* @brief 缓存条目。按字体 ID 和字号而不是字体指针区分，字体卸载后重新加载到同一地址也不会误用旧条目。
+	*/
+	struct TextCacheEntry {
+		std::string mFontId;																	///< @brief 字体 ID
+		int mFontSize = 0;																		///< @brief 字号
+		std::string mString;																	///< @brief 字符串，用于排除哈希冲突
+		TTF_Text* mText = nullptr;																///< @brief 排版好的文本对象
+	};
+
+	/**
+	* @brief 从缓存中获取文本对象，未命中时创建并在超出容量时淘汰最久未使用的条目（仅渲染线程调用）。
+	*
+	* @param font 字体，未命中时用于创建文本对象。
+	* @param fontId 字体 ID。
+	* @param fontSize 字号。
+	* @param text UTF-8 字符串内容。
+	* @return 文本对象，失败时返回 nullptr。
+	*/
+	TTF_Text* acquireText(TTF_Font* font, std::string_view fontId, int fontSize, std::string_view text);
+
+	static std::size_t hashText(std::string_view fontId, int fontSize, std::string_view text);	///< @brief 计算 (字体 ID, 字号, 字符串) 的哈希值，作为缓存键
+
+private:
+	static constexpr std::size_t mTextCacheCapacity = 128;										///< @brief 最多缓存的 TTF_Text 数量
+
+	Renderer* mRenderer = nullptr;																///< @brief 持有渲染器的非拥有指针
+	SDL_Renderer* mSdlRenderer = nullptr;														///< @brief 持有SDL渲染器的非拥有指针
 	engine::resource::ResourceManager* mResourceManager = nullptr;								///< @brief 持有资源管理器的非拥有指针
 	TTF_TextEngine* mTextEngine = nullptr;														///< @brief 使用SDL3引入的 TTF_TextEngine 来进行绘制
+	std::list<TextCacheEntry> mTextCache;														///< @brief LRU 链表，最近使用的条目在前
+	std::unordered_map<std::size_t, std::list<TextCacheEntry>::iterator> mTextCacheIndex;		///< @brief 哈希值到链表条目的索引
+	std::vector<SDL_Vertex> mGlyphVertices;														///< @brief 生成字形图集四边形时复用的顶点数组（仅录制线程访问）
+	bool mGlyphAtlasEnabled = true;																///< @brief 是否优先使用字形图集
 }; // class TextRenderer
 
 } // namespace engine::render
@@ -0,0 +1,31 @@
+#include "animation_manager.h"
+#include "../render/animation.h"
+#include <spdlog/spdlog.h>
+
+namespace engine::resource {
+	std::shared_ptr<const engine::render::Animation> AnimationManager::addAnimation(std::string_view sheetId, std::shared_ptr<const engine::render::Animation> animation) {
+		if (!animation) {
+			spdlog::warn("{} 尝试添加空的动画片段, 精灵图: {}", mLogTag.data(), sheetId.data());
+			return nullptr;
+		}
+
+		AnimationKey key = std::make_pair(std::string(sheetId), std::string(animation->getName()));
+		auto [iter, inserted] = mAnimations.try_emplace(std::move(key), std::move(animation));
+		if (inserted) {
+			spdlog::debug("{} 缓存动画片段: {} ({})", mLogTag.data(), iter->first.second, sheetId.data());
+		}
+		return iter->second;
+	}
+
+	std::shared_ptr<const engine::render::Animation> AnimationManager::getAnimation(std::string_view sheetId, std::string_view clipName) const {
+		auto iter = mAnimations.find(std::make_pair(std::string(sheetId), std::string(clipName)));
+		return iter != mAnimations.end() ? iter->second : nullptr;
+	}
+
+	void AnimationManager::clearAnimations() {
+		if (!mAnimations.empty()) {
+			spdlog::debug("{} 正在清理所有{}个动画片段.", mLogTag.data(), mAnimations.size());
+			mAnimations.clear();
+		}
+	}
+}
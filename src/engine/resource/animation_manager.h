@@ -0,0 +1,57 @@
+/*****************************************************************//**
+ * @file   animation_manager.h
+ * @brief  动画片段管理类
+ * @version 1.0
+ *
+ * @author Shallowshades
+ * @date   2026.10.18
+ *********************************************************************/
+
+#pragma once
+#ifndef ANIMATION_MANAGER_H
+#define ANIMATION_MANAGER_H
+
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <functional>
+
+namespace engine::render { class Animation; }
+
+namespace engine::resource {
+using AnimationKey = std::pair<std::string, std::string>;
+struct AnimationKeyHash {
+	std::size_t operator()(const AnimationKey& key) const {
+		std::hash<std::string> stringHasher;
+		return stringHasher(key.first) ^ (stringHasher(key.second) << 1);
+	}
+};
+
+/**
+* @class 动画片段管理类.
+* @brief 缓存不可变的动画片段, 供所有使用同一精灵图的对象共享
+*
+* 通过精灵图ID和片段名称来标识. 片段一经加入即不可修改, 以shared_ptr<const Animation>的形式共享
+* 仅供ResourceManager内部使用
+*/
+class AnimationManager final {
+	friend class ResourceManager;
+public:
+	AnimationManager() = default;
+	AnimationManager(const AnimationManager&) = delete;												///< @brief 删除拷贝构造
+	AnimationManager& operator=(const AnimationManager&) = delete;									///< @brief 删除拷贝赋值构造
+	AnimationManager(AnimationManager&&) = delete;													///< @brief 删除移动构造
+	AnimationManager& operator=(AnimationManager&&) = delete;										///< @brief 删除移动赋值构造
+private:
+	///< @brief 加入动画片段, 名称取自片段本身; 已存在同名片段时返回已有的片段
+	std::shared_ptr<const engine::render::Animation> addAnimation(std::string_view sheetId, std::shared_ptr<const engine::render::Animation> animation);
+	std::shared_ptr<const engine::render::Animation> getAnimation(std::string_view sheetId, std::string_view clipName) const;	///< @brief 获取动画片段, 不存在时返回nullptr
+	void clearAnimations();																			///< @brief 清空所有的动画片段
+private:
+	static constexpr std::string_view mLogTag = "AnimationManager";
+	std::unordered_map<AnimationKey, std::shared_ptr<const engine::render::Animation>, AnimationKeyHash> mAnimations;	///< @brief (精灵图ID, 片段名称) -> 动画片段
+};
+} // namespace engine::resource
+#endif // !ANIMATION_MANAGER_H
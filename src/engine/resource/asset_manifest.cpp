@@ -0,0 +1,70 @@
+#include "asset_manifest.h"
+
+namespace engine::resource {
+void AssetManifest::addTexture(std::string_view filePath) {
+	addUnique(mTextures, mSeenTextures, filePath);
+}
+
+void AssetManifest::addSound(std::string_view filePath) {
+	addUnique(mSounds, mSeenSounds, filePath);
+}
+
+void AssetManifest::addMusic(std::string_view filePath) {
+	addUnique(mMusic, mSeenMusic, filePath);
+}
+
+void AssetManifest::addFont(std::string_view filePath, int pointSize) {
+	if (filePath.empty() || pointSize <= 0) {
+		return;
+	}
+	FontEntry entry(std::string(filePath), pointSize);
+	if (mSeenFonts.insert(entry).second) {
+		mFonts.push_back(std::move(entry));
+	}
+}
+
+void AssetManifest::clear() {
+	mTextures.clear();
+	mSounds.clear();
+	mMusic.clear();
+	mFonts.clear();
+	mSeenTextures.clear();
+	mSeenSounds.clear();
+	mSeenMusic.clear();
+	mSeenFonts.clear();
+}
+
+const std::vector<std::string>& AssetManifest::getTextures() const {
+	return mTextures;
+}
+
+const std::vector<std::string>& AssetManifest::getSounds() const {
+	return mSounds;
+}
+
+const std::vector<std::string>& AssetManifest::getMusic() const {
+	return mMusic;
+}
+
+const std::vector<AssetManifest::FontEntry>& AssetManifest::getFonts() const {
+	return mFonts;
+}
+
+std::size_t AssetManifest::size() const {
+	return mTextures.size() + mSounds.size() + mMusic.size() + mFonts.size();
+}
+
+bool AssetManifest::isEmpty() const {
+	return size() == 0;
+}
+
+void AssetManifest::addUnique(std::vector<std::string>& list, std::set<std::string>& seen, std::string_view filePath) {
+	if (filePath.empty()) {
+		return;
+	}
+	auto [iter, isInserted] = seen.emplace(filePath);
+	if (isInserted) {
+		list.push_back(*iter);
+	}
+}
+} // namespace engine::resource
@@ -0,0 +1,59 @@
+/*****************************************************************//**
+ * @file   asset_manifest.h
+ * @brief  资源清单
+ * @version 1.0
+ *
+ * @author Shallowshades
+ * @date   2026.10.18
+ *********************************************************************/
+
+#pragma once
+#ifndef ASSET_MANIFEST_H
+#define ASSET_MANIFEST_H
+
+#include <cstddef>
+#include <set>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace engine::resource {
+/**
+ * @brief 一个场景(关卡)会用到的全部资源, 用于在场景初始化时批量预加载.
+ *
+ * 同一资源重复加入只记录一次, 按加入顺序保存.
+ */
+class AssetManifest final {
+public:
+	using FontEntry = std::pair<std::string, int>;
+
+	void addTexture(std::string_view filePath);								///< @brief 加入纹理
+	void addSound(std::string_view filePath);								///< @brief 加入音效
+	void addMusic(std::string_view filePath);								///< @brief 加入音乐
+	void addFont(std::string_view filePath, int pointSize);					///< @brief 加入字体(路径 + 点大小)
+	void clear();															///< @brief 清空清单
+
+	const std::vector<std::string>& getTextures() const;					///< @brief 获取纹理列表
+	const std::vector<std::string>& getSounds() const;						///< @brief 获取音效列表
+	const std::vector<std::string>& getMusic() const;						///< @brief 获取音乐列表
+	const std::vector<FontEntry>& getFonts() const;							///< @brief 获取字体列表
+	std::size_t size() const;												///< @brief 资源总数
+	bool isEmpty() const;													///< @brief 清单是否为空
+
+private:
+	static void addUnique(std::vector<std::string>& list, std::set<std::string>& seen, std::string_view filePath);	///< @brief 去重后追加
+
+private:
+	std::vector<std::string> mTextures;										///< @brief 纹理路径
+	std::vector<std::string> mSounds;										///< @brief 音效路径
+	std::vector<std::string> mMusic;										///< @brief 音乐路径
+	std::vector<FontEntry> mFonts;											///< @brief 字体路径和点大小
+	std::set<std::string> mSeenTextures;									///< @brief 已加入的纹理, 用于去重
+	std::set<std::string> mSeenSounds;										///< @brief 已加入的音效, 用于去重
+	std::set<std::string> mSeenMusic;										///< @brief 已加入的音乐, 用于去重
+	std::set<FontEntry> mSeenFonts;											///< @brief 已加入的字体, 用于去重
+};
+} // namespace engine::resource
+
+#endif // !ASSET_MANIFEST_H
@@ -0,0 +1,134 @@
+#include "asset_pack.h"
+#include "mapped_file.h"
+#include <SDL3/SDL_iostream.h>
+#include <spdlog/spdlog.h>
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <stdexcept>
+
+namespace engine::resource {
+AssetPack::AssetPack(std::string_view filePath, bool isLooseFileCheckEnabled)
+	: mFile(std::make_unique<MappedFile>(filePath))
+{
+	mData = mFile->getData().data();
+	mSize = mFile->getData().size();
+	validate();
+	std::error_code error;
+	mWriteTime = std::filesystem::last_write_time(mFile->getFilePath(), error);
+	if (isLooseFileCheckEnabled) {
+		// 值初始化为Unchecked
+		mLooseFileStates = std::make_unique<std::atomic<LooseFileState>[]>(mEntries.size());
+	}
+	spdlog::info("{} 已映射资源包 '{}': {} 项, {:.2f} MB{}", mLogTag.data(), filePath, mEntries.size(), mSize / (1024.0 * 1024.0),
+		isLooseFileCheckEnabled ? ", 检查散装文件" : "");
+}
+
+AssetPack::~AssetPack() {
+	spdlog::trace("{} 析构成功", mLogTag.data());
+}
+
+std::span<const std::byte> AssetPack::find(std::string_view filePath) const {
+	const PackEntry* entry = findUsableEntry(filePath);
+	if (!entry) {
+		return {};
+	}
+	return std::span<const std::byte>(mData + entry->mOffset, static_cast<std::size_t>(entry->mSize));
+}
+
+bool AssetPack::contains(std::string_view filePath) const {
+	return findUsableEntry(filePath) != nullptr;
+}
+
+SDL_IOStream* AssetPack::openStream(std::string_view filePath) const {
+	const PackEntry* entry = findUsableEntry(filePath);
+	if (!entry) {
+		return nullptr;
+	}
+	// 空文件也返回有效的流, 与从磁盘打开空文件的行为一致
+	static const std::byte empty{};
+	return SDL_IOFromConstMem(entry->mSize > 0 ? mData + entry->mOffset : &empty, static_cast<std::size_t>(entry->mSize));
+}
+
+std::size_t AssetPack::getEntryCount() const {
+	return mEntries.size();
+}
+
+std::string_view AssetPack::getFilePath() const {
+	return mFile->getFilePath();
+}
+
+const PackEntry* AssetPack::findEntry(std::string_view filePath) const {
+	std::uint64_t hash = hashPackPath(normalizePackPath(filePath));
+	auto iter = std::lower_bound(mEntries.begin(), mEntries.end(), hash, [](const PackEntry& entry, std::uint64_t value) {
+		return entry.mPathHash < value;
+	});
+	return iter != mEntries.end() && iter->mPathHash == hash ? &*iter : nullptr;
+}
+
+std::filesystem::file_time_type AssetPack::getWriteTime() const {
+	return mWriteTime;
+}
+
+const PackEntry* AssetPack::findUsableEntry(std::string_view filePath) const {
+	const PackEntry* entry = findEntry(filePath);
+	if (!entry || !mLooseFileStates) {
+		return entry;
+	}
+	// 开发时编辑过但尚未重新打包的文件优先使用散装文件; 每个条目只检查一次,
+	// 多个线程同时首次查找时可能重复检查, 结果相同
+	auto& state = mLooseFileStates[entry - mEntries.data()];
+	LooseFileState current = state.load(std::memory_order_relaxed);
+	if (current == LooseFileState::Unchecked) {
+		std::error_code error;
+		auto looseTime = std::filesystem::last_write_time(filePath, error);
+		current = !error && looseTime > mWriteTime ? LooseFileState::UseLoose : LooseFileState::UsePack;
+		state.store(current, std::memory_order_relaxed);
+		if (current == LooseFileState::UseLoose) {
+			spdlog::debug("{} 散装文件 '{}' 比资源包新, 使用散装文件", mLogTag.data(), filePath);
+		}
+	}
+	return current == LooseFileState::UsePack ? entry : nullptr;
+}
+
+void AssetPack::validate() {
+	PackHeader header;
+	if (mSize < sizeof(PackHeader)) {
+		throw std::runtime_error(mLogTag.data() + std::string(" 资源包文件头不完整: ") + std::string(getFilePath()));
+	}
+	std::memcpy(&header, mData, sizeof(PackHeader));
+	if (header.mMagic != PackHeader::mMagicValue) {
+		throw std::runtime_error(mLogTag.data() + std::string(" 不是有效的资源包: ") + std::string(getFilePath()));
+	}
+	if (header.mVersion != PackHeader::mCurrentVersion) {
+		throw std::runtime_error(mLogTag.data() + std::string(" 资源包版本不匹配: ") + std::string(getFilePath()) + " (" + std::to_string(header.mVersion) + ")");
+	}
+	std::uint64_t indexBytes = static_cast<std::uint64_t>(header.mEntryCount) * sizeof(PackEntry);
+	if (header.mIndexOffset % alignof(PackEntry) != 0 || header.mIndexOffset > mSize || indexBytes > mSize - header.mIndexOffset) {
+		throw std::runtime_error(mLogTag.data() + std::string(" 资源包索引越界: ") + std::string(getFilePath()));
+	}
+
+	// 映射区域按页对齐, 索引偏移按条目对齐, 可以直接把索引当作数组使用
+	mEntries = std::span<const PackEntry>(reinterpret_cast<const PackEntry*>(mData + header.mIndexOffset), header.mEntryCount);
+	for (std::size_t i = 0; i < mEntries.size(); ++i) {
+		const PackEntry& entry = mEntries[i];
+		if (entry.mOffset > header.mIndexOffset || entry.mSize > header.mIndexOffset - entry.mOffset) {
+			throw std::runtime_error(mLogTag.data() + std::string(" 资源包条目越界: ") + std::string(getFilePath()));
+		}
+		if (i > 0 && mEntries[i - 1].mPathHash >= entry.mPathHash) {
+			throw std::runtime_error(mLogTag.data() + std::string(" 资源包索引未按哈希排序: ") + std::string(getFilePath()));
+		}
+	}
+}
+
+SDL_IOStream* openAssetStream(const AssetPack* pack, std::string_view filePath) {
+	if (pack) {
+		if (SDL_IOStream* stream = pack->openStream(filePath)) {
+			spdlog::debug("AssetPack 从资源包读取 '{}'", filePath);
+			return stream;
+		}
+	}
+	spdlog::debug("AssetPack 从散装文件读取 '{}'", filePath);
+	return SDL_IOFromFile(std::string(filePath).c_str(), "rb");
+}
+} // namespace engine::resource
@@ -0,0 +1,96 @@
+/*****************************************************************//**
+ * @file   asset_pack.h
+ * @brief  内存映射的资源包
+ * @version 1.0
+ *
+ * @author Shallowshades
+ * @date   2026.10.18
+ *********************************************************************/
+
+#pragma once
+#ifndef ASSET_PACK_H
+#define ASSET_PACK_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <span>
+#include <string>
+#include <string_view>
+#include "asset_pack_format.h"
+
+struct SDL_IOStream;
+
+namespace engine::resource {
+class MappedFile;
+
+/**
+ * @brief 只读的资源包, 整个文件映射到内存, 按路径哈希查找条目.
+ *
+ * 条目的数据直接指向映射区域, 通过SDL_IOFromConstMem交给各加载函数, 不需要再打开和寻道单独的文件.
+ * 查找和读取不修改任何状态, 可以在多个线程(如异步加载的工作线程)上同时进行.
+ * 开发时散装文件可能比资源包新(编辑后尚未重新打包): 启用散装文件检查时这样的条目视为不存在, 调用者回退到散装文件.
+ * 每个条目只在第一次查找时检查一次散装文件的修改时间, 发布时关闭检查, 查找不访问文件系统.
+ * 映射在对象析构时解除, 使用条目数据的资源(如流式播放的音乐)必须先于资源包释放.
+ */
+class AssetPack final {
+public:
+	/**
+	 * @brief 构造函数, 映射并校验资源包.
+	 * @param filePath 资源包路径
+	 * @param isLooseFileCheckEnabled 是否检查散装文件比资源包新(开发选项)
+	 * @throws std::runtime_error 文件无法打开, 映射失败或格式不正确
+	 */
+	explicit AssetPack(std::string_view filePath, bool isLooseFileCheckEnabled = false);
+	~AssetPack();															///< @brief 析构函数, 解除映射
+
+	// 禁用拷贝和移动语义
+	AssetPack(const AssetPack&) = delete;									///< @brief 删除拷贝构造
+	AssetPack& operator=(const AssetPack&) = delete;						///< @brief 删除拷贝赋值构造
+	AssetPack(AssetPack&&) = delete;										///< @brief 删除移动构造
+	AssetPack& operator=(AssetPack&&) = delete;								///< @brief 删除移动赋值构造
+
+	std::span<const std::byte> find(std::string_view filePath) const;		///< @brief 查找条目数据, 不存在(或散装文件更新)时返回空
+	bool contains(std::string_view filePath) const;							///< @brief 是否包含指定路径, 散装文件比资源包新时返回false
+	SDL_IOStream* openStream(std::string_view filePath) const;				///< @brief 打开条目的只读内存流, 不存在(或散装文件更新)时返回nullptr
+	std::size_t getEntryCount() const;										///< @brief 条目数量
+	std::string_view getFilePath() const;									///< @brief 资源包路径
+	std::filesystem::file_time_type getWriteTime() const;					///< @brief 资源包文件的修改时间(映射时读取)
+
+private:
+	const PackEntry* findEntry(std::string_view filePath) const;			///< @brief 按路径哈希二分查找条目
+	const PackEntry* findUsableEntry(std::string_view filePath) const;		///< @brief 查找条目, 启用检查且同路径的散装文件比资源包新时返回nullptr
+	void validate();														///< @brief 校验文件头和索引
+
+private:
+	static constexpr std::string_view mLogTag = "AssetPack";
+	std::unique_ptr<MappedFile> mFile;										///< @brief 映射的资源包文件
+	const std::byte* mData = nullptr;										///< @brief 映射区域起始地址
+	std::size_t mSize = 0;													///< @brief 映射区域大小
+	std::span<const PackEntry> mEntries;									///< @brief 索引(指向映射区域, 按哈希升序)
+	std::filesystem::file_time_type mWriteTime{};							///< @brief 资源包文件的修改时间
+
+	/**
+	 * @brief 条目的散装文件检查结果.
+	 */
+	enum class LooseFileState : std::uint8_t {
+		Unchecked,															///< @brief 尚未检查
+		UsePack,															///< @brief 使用资源包
+		UseLoose,															///< @brief 散装文件更新, 使用散装文件
+	};
+	std::unique_ptr<std::atomic<LooseFileState>[]> mLooseFileStates;		///< @brief 每个条目的检查结果(与mEntries一一对应), 未启用检查时为空
+};
+
+/**
+ * @brief 打开资源的只读流: 资源包中存在(且散装文件不比它新)时从内存读取, 否则从磁盘打开.
+ *
+ * @param pack 资源包, 可以为空
+ * @param filePath 资源路径
+ * @return 打开的流, 由调用者关闭(通常交给*_IO加载函数并设置closeio); 失败时返回nullptr
+ */
+SDL_IOStream* openAssetStream(const AssetPack* pack, std::string_view filePath);
+} // namespace engine::resource
+
+#endif // !ASSET_PACK_H
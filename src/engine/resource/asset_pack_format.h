@@ -0,0 +1,111 @@
+/*****************************************************************//**
+ * @file   asset_pack_format.h
+ * @brief  资源包文件格式(游戏和asset_packer共用)
+ * @version 1.0
+ *
+ * @author Shallowshades
+ * @date   2026.10.18
+ *********************************************************************/
+
+#pragma once
+#ifndef ASSET_PACK_FORMAT_H
+#define ASSET_PACK_FORMAT_H
+
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <string_view>
+
+namespace engine::resource {
+/**
+ * @brief 资源包中条目的类型(按扩展名划分, 目前只用于统计和调试).
+ */
+enum class AssetType : std::uint32_t {
+	Unknown = 0,		///< @brief 未知类型
+	Image = 1,			///< @brief 图片(png, jpg, ...)
+	Audio = 2,			///< @brief 音频(wav, mp3, ogg, ...)
+	Font = 3,			///< @brief 字体(ttf, otf)
+	Data = 4,			///< @brief 数据(json, tmj, tsj, ...)
+};
+
+/**
+ * @brief 资源包文件头.
+ *
+ * 文件布局: [PackHeader][数据区, 每项按mDataAlignment对齐][PackEntry * mEntryCount]
+ * 索引按路径哈希升序排列, 运行时二分查找. 所有整数按小端存储.
+ */
+struct PackHeader {
+	static constexpr std::array<char, 4> mMagicValue = { 'S', 'L', 'P', 'K' };
+	static constexpr std::uint32_t mCurrentVersion = 1;
+	static constexpr std::uint64_t mDataAlignment = 16;		///< @brief 数据区中每一项的对齐字节数(同时保证索引对齐)
+
+	std::array<char, 4> mMagic = mMagicValue;				///< @brief 文件标识
+	std::uint32_t mVersion = mCurrentVersion;				///< @brief 格式版本
+	std::uint32_t mEntryCount = 0;							///< @brief 条目数量
+	std::uint32_t mReserved = 0;							///< @brief 保留
+	std::uint64_t mIndexOffset = 0;							///< @brief 索引在文件中的偏移
+};
+
+/**
+ * @brief 资源包索引条目.
+ */
+struct PackEntry {
+	std::uint64_t mPathHash = 0;							///< @brief 规范化路径的哈希
+	std::uint64_t mOffset = 0;								///< @brief 数据在文件中的偏移
+	std::uint64_t mSize = 0;								///< @brief 数据大小(字节)
+	AssetType mType = AssetType::Unknown;					///< @brief 条目类型
+	std::uint32_t mReserved = 0;							///< @brief 保留
+};
+
+static_assert(sizeof(PackHeader) == 24, "PackHeader 的布局必须与资源包文件一致");
+static_assert(sizeof(PackEntry) == 32, "PackEntry 的布局必须与资源包文件一致");
+
+/**
+ * @brief 规范化资源路径: 统一使用'/', 消除'.'和'..', 不访问文件系统.
+ *
+ * 游戏中的路径都相对于工作目录(如 "assets/textures/a.png"), 打包时也按同样的形式记录.
+ */
+inline std::string normalizePackPath(std::string_view filePath) {
+	std::string path(filePath);
+	std::replace(path.begin(), path.end(), '\\', '/');
+	return std::filesystem::path(path).lexically_normal().generic_string();
+}
+
+/**
+ * @brief 计算规范化路径的64位FNV-1a哈希.
+ */
+constexpr std::uint64_t hashPackPath(std::string_view normalizedPath) {
+	std::uint64_t hash = 14695981039346656037ull;
+	for (char c : normalizedPath) {
+		hash ^= static_cast<std::uint8_t>(c);
+		hash *= 1099511628211ull;
+	}
+	return hash;
+}
+
+/**
+ * @brief 按扩展名判断条目类型.
+ */
+inline AssetType getAssetType(std::string_view filePath) {
+	std::string extension = std::filesystem::path(filePath).extension().string();
+	std::transform(extension.begin(), extension.end(), extension.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+	if (extension == ".png" || extension == ".jpg" || extension == ".jpeg" || extension == ".bmp") {
+		return AssetType::Image;
+	}
+	if (extension == ".wav" || extension == ".mp3" || extension == ".ogg" || extension == ".flac") {
+		return AssetType::Audio;
+	}
+	if (extension == ".ttf" || extension == ".otf") {
+		return AssetType::Font;
+	}
+	if (extension == ".json" || extension == ".tmj" || extension == ".tsj") {
+		return AssetType::Data;
+	}
+	return AssetType::Unknown;
+}
+} // namespace engine::resource
+
+#endif // !ASSET_PACK_FORMAT_H
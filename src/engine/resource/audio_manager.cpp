@@ -1,4 +1,5 @@
 #include "audio_manager.h"
+#include "asset_pack.h"
 #include <spdlog/spdlog.h>
 #include <stdexcept>
 
@@ -44,7 +45,7 @@ namespace engine::resource {
 
 		// 加载音效块
 		spdlog::debug("{} 加载音效: {}", mLogTag.data(), filePath);
-		Mix_Chunk* rawChunk = Mix_LoadWAV(filePath.data());
+		Mix_Chunk* rawChunk = Mix_LoadWAV_IO(openAssetStream(mAssetPack, filePath), true);
 		if (!rawChunk) {
 			spdlog::error("{} 加载音效失败: '{}':{}", mLogTag.data(), filePath.data(), SDL_GetError());
 			return nullptr;
@@ -65,6 +66,27 @@ namespace engine::resource {
 		return loadSound(filePath);
 	}
 
+	Mix_Chunk* AudioManager::findSound(std::string_view filePath) const {
+		auto iter = mSounds.find(std::string(filePath));
+		return iter != mSounds.end() ? iter->second.get() : nullptr;
+	}
+
+	Mix_Chunk* AudioManager::addSound(std::string_view filePath, std::unique_ptr<Mix_Chunk, SDLMixChunkDeleter> chunk) {
+		// 解码期间可能已经被同步加载, 此时保留已有的音效(可能正在播放)
+		auto iter = mSounds.find(std::string(filePath));
+		if (iter != mSounds.end()) {
+			return iter->second.get();
+		}
+		if (!chunk) {
+			return nullptr;
+		}
+
+		Mix_Chunk* rawChunk = chunk.get();
+		mSounds.emplace(filePath, std::move(chunk));
+		spdlog::debug("{} 成功缓存异步加载的音效: {}", mLogTag.data(), filePath);
+		return rawChunk;
+	}
+
 	void AudioManager::unloadSound(std::string_view filePath) {
 		auto iter = mSounds.find(std::string(filePath));
 		if (iter != mSounds.end()) {
@@ -76,6 +98,17 @@ namespace engine::resource {
 		}
 	}
 
+	Mix_Chunk* AudioManager::releaseSound(std::string_view filePath) {
+		auto iter = mSounds.find(std::string(filePath));
+		if (iter == mSounds.end()) {
+			return nullptr;
+		}
+		Mix_Chunk* chunk = iter->second.release();
+		mSounds.erase(iter);
+		spdlog::debug("{} 移交音效: {}", mLogTag.data(), filePath.data());
+		return chunk;
+	}
+
 	void AudioManager::clearSounds() {
 		if (!mSounds.empty()) {
 			spdlog::debug("{} 正在清除所有{}个缓存的音效", mLogTag.data(), mSounds.size());
@@ -92,7 +125,7 @@ namespace engine::resource {
 
 		// 加载音乐
 		spdlog::debug("{} 加载音乐: {}", mLogTag.data(), filePath);
-		Mix_Music* rawMusic = Mix_LoadMUS(filePath.data());
+		Mix_Music* rawMusic = Mix_LoadMUS_IO(openAssetStream(mAssetPack, filePath), true);
 		if (!rawMusic) {
 			spdlog::error("{} 加载音乐失败: '{}': {}", mLogTag.data(), filePath.data(), SDL_GetError());
 			return nullptr;
@@ -113,6 +146,26 @@ namespace engine::resource {
 		return loadMusic(filePath);
 	}
 
+	Mix_Music* AudioManager::findMusic(std::string_view filePath) const {
+		auto iter = mMusic.find(std::string(filePath));
+		return iter != mMusic.end() ? iter->second.get() : nullptr;
+	}
+
+	Mix_Music* AudioManager::addMusic(std::string_view filePath, std::unique_ptr<Mix_Music, SDLMixMusicDeleter> music) {
+		auto iter = mMusic.find(std::string(filePath));
+		if (iter != mMusic.end()) {
+			return iter->second.get();
+		}
+		if (!music) {
+			return nullptr;
+		}
+
+		Mix_Music* rawMusic = music.get();
+		mMusic.emplace(filePath, std::move(music));
+		spdlog::debug("{} 成功缓存异步加载的音乐: {}", mLogTag.data(), filePath);
+		return rawMusic;
+	}
+
 	void AudioManager::unloadMusic(std::string_view filePath) {
 		auto iter = mMusic.find(std::string(filePath));
 		if (iter != mMusic.end()) {
@@ -124,6 +177,17 @@ namespace engine::resource {
 		}
 	}
 
+	Mix_Music* AudioManager::releaseMusic(std::string_view filePath) {
+		auto iter = mMusic.find(std::string(filePath));
+		if (iter == mMusic.end()) {
+			return nullptr;
+		}
+		Mix_Music* music = iter->second.release();
+		mMusic.erase(iter);
+		spdlog::debug("{} 移交音乐: {}", mLogTag.data(), filePath.data());
+		return music;
+	}
+
 	void AudioManager::clearMusic() {
 		if (!mMusic.empty()) {
 			spdlog::debug("{} 正在清除所有{}个缓存的音乐曲目", mLogTag.data(), mMusic.size());
@@ -136,4 +200,8 @@ namespace engine::resource {
 		clearMusic();
 	}
 
+	void AudioManager::setAssetPack(const AssetPack* assetPack) {
+		mAssetPack = assetPack;
+	}
+
 } // namespace engine::resource
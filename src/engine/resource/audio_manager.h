@@ -20,6 +20,8 @@
 #include <SDL3_mixer/SDL_mixer.h>
 
 namespace engine::resource {
+	class AssetPack;
+
 	/**
 	 * @class 音效管理类.
 	 * @brief 管理SDL_mixer音效(Mix_Chunk)和音乐(Mix_Music)
@@ -63,19 +65,27 @@ namespace engine::resource {
 	private:
 		Mix_Chunk* loadSound(std::string_view filePath);												///< @brief 载入音效资源
 		Mix_Chunk* getSound(std::string_view filePath);													///< @brief 尝试获取已加载的音效的指针,如果未加载则尝试加载
+		Mix_Chunk* findSound(std::string_view filePath) const;											///< @brief 只查询缓存, 未加载时返回nullptr而不尝试加载
+		Mix_Chunk* addSound(std::string_view filePath, std::unique_ptr<Mix_Chunk, SDLMixChunkDeleter> chunk);	///< @brief 缓存已解码的音效(异步加载的上传步骤), 已加载时丢弃新的并返回已有音效
 		void unloadSound(std::string_view filePath);													///< @brief 卸载指定的音效资源
+		Mix_Chunk* releaseSound(std::string_view filePath);												///< @brief 从缓存中移除音效并交出所有权(用于延迟释放), 不存在时返回nullptr
 		void clearSounds();																				///< @brief 清空所有的音效资源
 
 		Mix_Music* loadMusic(std::string_view filePath);												///< @brief 载入音乐资源
 		Mix_Music* getMusic(std::string_view filePath);													///< @brief 尝试获取已加载的音乐的指针,如果未加载则尝试加载
+		Mix_Music* findMusic(std::string_view filePath) const;											///< @brief 只查询缓存, 未加载时返回nullptr而不尝试加载
+		Mix_Music* addMusic(std::string_view filePath, std::unique_ptr<Mix_Music, SDLMixMusicDeleter> music);	///< @brief 缓存已打开的音乐(异步加载的上传步骤), 已加载时丢弃新的并返回已有音乐
 		void unloadMusic(std::string_view filePath);													///< @brief 卸载指定的音乐资源
+		Mix_Music* releaseMusic(std::string_view filePath);												///< @brief 从缓存中移除音乐并交出所有权(用于延迟释放), 不存在时返回nullptr
 		void clearMusic();																				///< @brief 清空所有的音乐资源
 
 		void clearAudio();																				///< @brief 清空所有音频资源
+		void setAssetPack(const AssetPack* assetPack);													///< @brief 设置资源包, 为空时从散装文件加载
 	private:
 		static constexpr std::string_view mLogTag = "AudioManager";
 		std::unordered_map<std::string, std::unique_ptr<Mix_Chunk, SDLMixChunkDeleter>> mSounds;		///< @brief 音效存储
 		std::unordered_map<std::string, std::unique_ptr<Mix_Music, SDLMixMusicDeleter>> mMusic;			///< @brief 音乐存储
+		const AssetPack* mAssetPack = nullptr;															///< @brief 资源包(非拥有, 流式播放的音乐直接读取映射区域)
 	};
 } // namespace engine::resource
 
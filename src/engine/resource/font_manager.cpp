@@ -1,9 +1,16 @@
 #include "font_manager.h"
+#include "asset_pack.h"
+#include "../render/glyph_atlas.h"
 #include <spdlog/spdlog.h>
 #include <stdexcept>
 
 namespace engine::resource {
-	FontManager::FontManager() {
+	FontManager::FontManager(SDL_Renderer* renderer)
+		: mRenderer(renderer)
+	{
+		if (!mRenderer) {
+			throw std::runtime_error(mLogTag.data() + std::string(" 构造失败: SDL_Renderer指针为空"));
+		}
 		if (!TTF_WasInit() && !TTF_Init()) {
 			throw std::runtime_error(mLogTag.data() + std::string(" 错误: TTF_Init失败: ") + std::string(SDL_GetError()));
 		}
@@ -37,15 +44,51 @@ namespace engine::resource {
 
 		// 不存在则加载字体
 		spdlog::debug("{} 正在加载字体 '{}' ({}pt)", mLogTag.data(), filePath.data(), pointSize);
-		TTF_Font* rawFont = TTF_OpenFont(filePath.data(), static_cast<float>(pointSize));
+		TTF_Font* rawFont = TTF_OpenFontIO(openAssetStream(mAssetPack, filePath), true, static_cast<float>(pointSize));
 		if (!rawFont) {
 			spdlog::error("{} 加载字体 '{}' ({}pt) 失败: {}", mLogTag.data(), filePath.data(), pointSize, SDL_GetError());
 			return nullptr;
 		}
 
+		return cacheFont(key, rawFont);
+	}
+
+	TTF_Font* FontManager::addFont(std::string_view filePath, int pointSize, std::unique_ptr<void, SDLMemoryDeleter> data, std::size_t dataSize) {
+		FontKey key = std::make_pair(std::string(filePath), pointSize);
+		auto iter = mFonts.find(key);
+		if (iter != mFonts.end()) {
+			return iter->second.get();
+		}
+		if (!data || pointSize <= 0) {
+			return nullptr;
+		}
+
+		SDL_IOStream* stream = SDL_IOFromConstMem(data.get(), dataSize);
+		TTF_Font* rawFont = stream ? TTF_OpenFontIO(stream, true, static_cast<float>(pointSize)) : nullptr;
+		if (!rawFont) {
+			spdlog::error("{} 从内存创建字体 '{}' ({}pt) 失败: {}", mLogTag.data(), filePath.data(), pointSize, SDL_GetError());
+			return nullptr;
+		}
+		mFontData.emplace(key, std::move(data));
+		return cacheFont(key, rawFont);
+	}
+
+	void FontManager::setAssetPack(const AssetPack* assetPack) {
+		mAssetPack = assetPack;
+	}
+
+	TTF_Font* FontManager::cacheFont(const FontKey& key, TTF_Font* rawFont) {
 		// 使用unique_ptr存储到缓存中
 		mFonts.emplace(key, std::unique_ptr<TTF_Font, SDLFontDeleter>(rawFont));
-		spdlog::debug("{} 成功加载并缓存字体: {} ({}pt)", mLogTag.data(), filePath.data(), pointSize);
+
+		// 一次性光栅化字形图集, 失败时该字体仍可以通过SDL_ttf正常绘制
+		try {
+			mGlyphAtlases.emplace(key, std::make_unique<engine::render::GlyphAtlas>(mRenderer, rawFont));
+		}
+		catch (const std::exception& e) {
+			spdlog::warn("{} 字体 '{}' ({}pt) 构建字形图集失败, 将使用SDL_ttf绘制: {}", mLogTag.data(), key.first, key.second, e.what());
+		}
+		spdlog::debug("{} 成功加载并缓存字体: {} ({}pt)", mLogTag.data(), key.first, key.second);
 		return rawFont;
 	}
 
@@ -59,12 +102,24 @@ namespace engine::resource {
 		return loadFont(filePath, pointSize);
 	}
 
+	TTF_Font* FontManager::findFont(std::string_view filePath, int pointSize) const {
+		auto iter = mFonts.find(std::make_pair(std::string(filePath), pointSize));
+		return iter != mFonts.end() ? iter->second.get() : nullptr;
+	}
+
+	const engine::render::GlyphAtlas* FontManager::findGlyphAtlas(std::string_view filePath, int pointSize) const {
+		auto iter = mGlyphAtlases.find(std::make_pair(std::string(filePath), pointSize));
+		return iter != mGlyphAtlases.end() ? iter->second.get() : nullptr;
+	}
+
 	void FontManager::unloadFont(std::string_view filePath, int pointSize) {
 		FontKey key = std::make_pair(std::string(filePath), pointSize);
 		auto iter = mFonts.find(key);
 		if (iter != mFonts.find(key)) {
 			spdlog::debug("{} 卸载字体: {} ({}pt)", mLogTag.data(), filePath.data(), pointSize);
+			mGlyphAtlases.erase(key);
 			mFonts.erase(iter);
+			mFontData.erase(key);
 		}
 		else {
 			spdlog::warn("{} 尝试加载不存在的字体: {} ({}pt)", mLogTag.data(), filePath.data(), pointSize);
@@ -74,7 +129,9 @@ namespace engine::resource {
 	void FontManager::clearFonts() {
 		if (!mFonts.empty()) {
 			spdlog::debug("{} 正在清理所有{}个字体.", mLogTag.data(), mFonts.size());
+			mGlyphAtlases.clear();
 			mFonts.clear();
+			mFontData.clear();
 		}
 	}
 
@@ -11,6 +11,7 @@
 #ifndef FONT_MANAGER_H
 #define FONT_MANAGER_H
 
+#include <cstddef>
 #include <memory>
 #include <stdexcept>
 #include <string>
@@ -21,7 +22,13 @@
 
 #include <SDL3_ttf/SDL_ttf.h>
 
+namespace engine::render {
+class GlyphAtlas;
+}
+
 namespace engine::resource {
+class AssetPack;
+
 using FontKey = std::pair<std::string, int>;
 struct FontKeyHash {
 	std::size_t operator()(const FontKey& key) const {
@@ -37,6 +44,7 @@ struct FontKeyHash {
 * @brief 管理SDL_ttf字体资源TTF_Font
 *
 * 提供字体的加载和缓存功能, 通过文件路径和点大小来标识
+* 加载字体时同时为其构建字形图集(GlyphAtlas), 供HUD文字走批量四边形路径
 * 构造失败会抛出异常;仅供ResourceManager内部使用
 */
 class FontManager final {
@@ -53,12 +61,23 @@ private:
 			}
 		}
 	};
+
+	/**
+	* @brief SDL分配的内存的自定义删除器.
+	* @struct 用于异步加载时读入内存的字体文件数据
+	*/
+	struct SDLMemoryDeleter {
+		void operator()(void* memory) const {
+			SDL_free(memory);
+		}
+	};
 public:
 	/**
 		* @brief 构造函数, 初始化SDL_ttf.
-		* @throw 如果SDL_ttf初始化失败抛出std::runtime_error
+		* @param renderer 用于创建字形图集纹理的SDL_Renderer, 不能为空
+		* @throw 如果renderer为空或SDL_ttf初始化失败抛出std::runtime_error
 		*/
-	FontManager();
+	explicit FontManager(SDL_Renderer* renderer);
 	~FontManager();																					///< @brief 需要手动添加析构函数, 清理资源并关闭.
 	FontManager(const FontManager&) = delete;														///< @brief 删除拷贝构造
 	FontManager& operator=(const FontManager&) = delete;											///< @brief 删除拷贝赋值构造
@@ -67,14 +86,26 @@ public:
 private:
 	TTF_Font* loadFont(std::string_view filePath, int pointSize);									///< @brief 载入字体资源
 	TTF_Font* getFont(std::string_view filePath, int pointSize);									///< @brief 尝试获取已加载的字体
+	///< @brief 从已读入内存的字体文件创建并缓存字体(异步加载的上传步骤), 内存随字体一起释放; 已加载时返回已有字体
+	TTF_Font* addFont(std::string_view filePath, int pointSize, std::unique_ptr<void, SDLMemoryDeleter> data, std::size_t dataSize);
+	TTF_Font* findFont(std::string_view filePath, int pointSize) const;								///< @brief 只查询缓存, 未加载时返回nullptr而不尝试加载
+	const engine::render::GlyphAtlas* findGlyphAtlas(std::string_view filePath, int pointSize) const;	///< @brief 查询字体的字形图集, 字体未加载或图集构建失败时返回nullptr
 	void unloadFont(std::string_view filePath, int pointSize);										///< @brief 卸载指定的字体资源
 	void clearFonts();																				///< @brief 清空所有的字体资源
+	TTF_Font* cacheFont(const FontKey& key, TTF_Font* rawFont);										///< @brief 缓存新打开的字体并构建字形图集
+	void setAssetPack(const AssetPack* assetPack);													///< @brief 设置资源包, 为空时从散装文件加载
 private:
 	static constexpr std::string_view mLogTag = "FontManager";
+	SDL_Renderer* mRenderer = nullptr;																///< @brief 指向主渲染器的非拥有指针, 用于创建字形图集
+	const AssetPack* mAssetPack = nullptr;															///< @brief 资源包(非拥有), 包中没有的文件从磁盘加载
 	// 字体存储（FontKey -> TTF_Font）。  
 	// unordered_map 的键需要能转换为哈希值，对于基础数据类型，系统会自动转换
 	// 但是对于对于自定义类型（系统无法自动转化），则需要提供自定义哈希函数（第三个模版参数）
 	std::unordered_map<FontKey, std::unique_ptr<TTF_Font, SDLFontDeleter>, FontKeyHash> mFonts;
+	// 字形图集（FontKey -> GlyphAtlas），与mFonts同步加载和卸载
+	std::unordered_map<FontKey, std::unique_ptr<engine::render::GlyphAtlas>, FontKeyHash> mGlyphAtlases;
+	// 从内存打开的字体在关闭前会一直读取这块内存, 必须在字体之后释放
+	std::unordered_map<FontKey, std::unique_ptr<void, SDLMemoryDeleter>, FontKeyHash> mFontData;
 };
 } // namespace engine::resource
 #endif // !FONT_MANAGER_H
@@ -0,0 +1,93 @@
+#include "mapped_file.h"
+#include <spdlog/spdlog.h>
+#include <filesystem>
+#include <stdexcept>
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace engine::resource {
+#ifdef _WIN32
+MappedFile::MappedFile(std::string_view filePath)
+	: mFilePath(filePath)
+{
+	std::wstring widePath = std::filesystem::path(mFilePath).wstring();
+	HANDLE file = CreateFileW(widePath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_RANDOM_ACCESS, nullptr);
+	if (file == INVALID_HANDLE_VALUE) {
+		throw std::runtime_error(mLogTag.data() + std::string(" 无法打开文件: ") + mFilePath);
+	}
+	LARGE_INTEGER fileSize;
+	if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0) {
+		CloseHandle(file);
+		throw std::runtime_error(mLogTag.data() + std::string(" 文件为空或无法获取大小: ") + mFilePath);
+	}
+	HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	if (!mapping) {
+		CloseHandle(file);
+		throw std::runtime_error(mLogTag.data() + std::string(" 无法创建文件映射: ") + mFilePath);
+	}
+	void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+	if (!view) {
+		CloseHandle(mapping);
+		CloseHandle(file);
+		throw std::runtime_error(mLogTag.data() + std::string(" 无法映射文件: ") + mFilePath);
+	}
+	mFileHandle = file;
+	mMappingHandle = mapping;
+	mData = static_cast<const std::byte*>(view);
+	mSize = static_cast<std::size_t>(fileSize.QuadPart);
+}
+
+MappedFile::~MappedFile() {
+	UnmapViewOfFile(mData);
+	CloseHandle(mMappingHandle);
+	CloseHandle(mFileHandle);
+}
+#else
+MappedFile::MappedFile(std::string_view filePath)
+	: mFilePath(filePath)
+{
+	int file = ::open(mFilePath.c_str(), O_RDONLY);
+	if (file < 0) {
+		throw std::runtime_error(mLogTag.data() + std::string(" 无法打开文件: ") + mFilePath);
+	}
+	struct stat info;
+	if (::fstat(file, &info) != 0 || info.st_size == 0) {
+		::close(file);
+		throw std::runtime_error(mLogTag.data() + std::string(" 文件为空或无法获取大小: ") + mFilePath);
+	}
+	void* view = ::mmap(nullptr, static_cast<std::size_t>(info.st_size), PROT_READ, MAP_PRIVATE, file, 0);
+	// 映射建立后文件描述符可以立即关闭
+	::close(file);
+	if (view == MAP_FAILED) {
+		throw std::runtime_error(mLogTag.data() + std::string(" 无法映射文件: ") + mFilePath);
+	}
+	mData = static_cast<const std::byte*>(view);
+	mSize = static_cast<std::size_t>(info.st_size);
+}
+
+MappedFile::~MappedFile() {
+	::munmap(const_cast<std::byte*>(mData), mSize);
+}
+#endif
+
+std::span<const std::byte> MappedFile::getData() const {
+	return std::span<const std::byte>(mData, mSize);
+}
+
+std::string_view MappedFile::getFilePath() const {
+	return mFilePath;
+}
+} // namespace engine::resource
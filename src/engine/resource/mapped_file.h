@@ -0,0 +1,56 @@
+/*****************************************************************//**
+ * @file   mapped_file.h
+ * @brief  只读的内存映射文件
+ * @version 1.0
+ *
+ * @author Shallowshades
+ * @date   2026.10.18
+ *********************************************************************/
+
+#pragma once
+#ifndef MAPPED_FILE_H
+#define MAPPED_FILE_H
+
+#include <cstddef>
+#include <span>
+#include <string>
+#include <string_view>
+
+namespace engine::resource {
+/**
+ * @brief 把整个文件只读映射到内存, 对象析构时解除映射.
+ *
+ * 映射区域的起始地址按页对齐. 只读访问不修改任何状态, 可以在多个线程上同时读取.
+ */
+class MappedFile final {
+public:
+	/**
+	 * @brief 构造函数, 映射文件.
+	 * @param filePath 文件路径
+	 * @throws std::runtime_error 文件无法打开, 为空或映射失败
+	 */
+	explicit MappedFile(std::string_view filePath);
+	~MappedFile();															///< @brief 析构函数, 解除映射
+
+	// 禁用拷贝和移动语义
+	MappedFile(const MappedFile&) = delete;									///< @brief 删除拷贝构造
+	MappedFile& operator=(const MappedFile&) = delete;						///< @brief 删除拷贝赋值构造
+	MappedFile(MappedFile&&) = delete;										///< @brief 删除移动构造
+	MappedFile& operator=(MappedFile&&) = delete;							///< @brief 删除移动赋值构造
+
+	std::span<const std::byte> getData() const;								///< @brief 获取映射的全部数据
+	std::string_view getFilePath() const;									///< @brief 获取文件路径
+
+private:
+	static constexpr std::string_view mLogTag = "MappedFile";
+	std::string mFilePath;													///< @brief 文件路径
+	const std::byte* mData = nullptr;										///< @brief 映射区域起始地址
+	std::size_t mSize = 0;													///< @brief 映射区域大小
+#ifdef _WIN32
+	void* mFileHandle = nullptr;											///< @brief 文件句柄
+	void* mMappingHandle = nullptr;											///< @brief 映射句柄
+#endif
+};
+} // namespace engine::resource
+
+#endif // !MAPPED_FILE_H
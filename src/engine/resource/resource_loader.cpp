@@ -0,0 +1,134 @@
+#include "resource_loader.h"
+#include <algorithm>
+#include <spdlog/spdlog.h>
+
+namespace engine::resource {
+ResourceLoader::ResourceLoader(int workerCount) {
+	int count = std::max(workerCount, 1);
+	mWorkers.reserve(static_cast<std::size_t>(count));
+	for (int i = 0; i < count; ++i) {
+		mWorkers.emplace_back([this] { workerLoop(); });
+	}
+	spdlog::trace("{} 构造成功, 工作线程: {}", mLogTag.data(), count);
+}
+
+ResourceLoader::~ResourceLoader() {
+	{
+		std::lock_guard<std::mutex> lock(mMutex);
+		mIsStopping = true;
+		mJobs.clear();
+	}
+	mCondition.notify_all();
+	for (auto& worker : mWorkers) {
+		worker.join();
+	}
+	// 未执行的上传步骤随队列一起析构, 其持有的解码结果由各自的删除器释放
+	mUploads.clear();
+	spdlog::trace("{} 析构成功", mLogTag.data());
+}
+
+void ResourceLoader::submit(std::function<void()> decode, std::function<void()> upload, std::function<void()> fail) {
+	{
+		std::lock_guard<std::mutex> lock(mMutex);
+		mJobs.push_back(Job{ std::move(decode), std::move(upload), std::move(fail) });
+		++mPendingCount;
+	}
+	mCondition.notify_one();
+}
+
+int ResourceLoader::processUploads(std::chrono::nanoseconds budget) {
+	auto start = std::chrono::steady_clock::now();
+	int processed = 0;
+	while (true) {
+		Upload upload;
+		{
+			std::lock_guard<std::mutex> lock(mMutex);
+			if (mUploads.empty()) {
+				break;
+			}
+			upload = std::move(mUploads.front());
+			mUploads.pop_front();
+		}
+
+		// 在锁外执行, 上传期间工作线程仍可以继续交付结果; 上传失败也要完成等待方并减少计数, 否则预加载会一直等待
+		try {
+			upload.mUpload();
+		}
+		catch (const std::exception& e) {
+			spdlog::error("{} 上传任务抛出异常: {}", mLogTag.data(), e.what());
+			runFail(upload.mFail);
+		}
+		catch (...) {
+			spdlog::error("{} 上传任务抛出未知异常", mLogTag.data());
+			runFail(upload.mFail);
+		}
+		++processed;
+		{
+			std::lock_guard<std::mutex> lock(mMutex);
+			--mPendingCount;
+		}
+
+		if (std::chrono::steady_clock::now() - start >= budget) {
+			break;
+		}
+	}
+	return processed;
+}
+
+void ResourceLoader::waitForUploads(std::chrono::milliseconds timeout) {
+	std::unique_lock<std::mutex> lock(mMutex);
+	mUploadCondition.wait_for(lock, timeout, [this] { return !mUploads.empty() || mPendingCount == 0; });
+}
+
+std::size_t ResourceLoader::getPendingCount() const {
+	std::lock_guard<std::mutex> lock(mMutex);
+	return mPendingCount;
+}
+
+void ResourceLoader::runFail(const std::function<void()>& fail) {
+	if (!fail) {
+		return;
+	}
+	try {
+		fail();
+	}
+	catch (const std::exception& e) {
+		spdlog::error("{} 上传失败的清理步骤抛出异常: {}", mLogTag.data(), e.what());
+	}
+	catch (...) {
+		spdlog::error("{} 上传失败的清理步骤抛出未知异常", mLogTag.data());
+	}
+}
+
+void ResourceLoader::workerLoop() {
+	while (true) {
+		Job job;
+		{
+			std::unique_lock<std::mutex> lock(mMutex);
+			mCondition.wait(lock, [this] { return mIsStopping || !mJobs.empty(); });
+			if (mIsStopping) {
+				return;
+			}
+			job = std::move(mJobs.front());
+			mJobs.pop_front();
+		}
+
+		try {
+			job.mDecode();
+		}
+		catch (const std::exception& e) {
+			// 解码失败时仍交付上传步骤, 由上传步骤根据空结果完成等待方
+			spdlog::error("{} 解码任务抛出异常: {}", mLogTag.data(), e.what());
+		}
+		catch (...) {
+			spdlog::error("{} 解码任务抛出未知异常", mLogTag.data());
+		}
+
+		{
+			std::lock_guard<std::mutex> lock(mMutex);
+			mUploads.push_back(Upload{ std::move(job.mUpload), std::move(job.mFail) });
+		}
+		mUploadCondition.notify_all();
+	}
+}
+} // namespace engine::resource
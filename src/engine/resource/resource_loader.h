@@ -0,0 +1,96 @@
+/*****************************************************************//**
+ * @file   resource_loader.h
+ * @brief  资源异步加载的工作线程池
+ * @version 1.0
+ *
+ * @author Shallowshades
+ * @date   2026.10.18
+ *********************************************************************/
+
+#pragma once
+#ifndef RESOURCE_LOADER_H
+#define RESOURCE_LOADER_H
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace engine::resource {
+/**
+ * @brief 在工作线程上读取和解码资源文件, 再把结果交回调用线程完成上传.
+ *
+ * 每个任务分为两步: decode 在工作线程上执行(读盘, 解码图片/音频, 读取字体文件),
+ * upload 在调用processUploads()的线程上执行(创建纹理, 写入各管理器的缓存).
+ * upload 按每帧的时间预算分批执行, 大量资源同时完成时也不会让某一帧卡顿.
+ */
+class ResourceLoader final {
+public:
+	explicit ResourceLoader(int workerCount);									///< @brief 构造函数, 启动指定数量的工作线程(至少1个)
+	~ResourceLoader();															///< @brief 停止并等待所有工作线程, 未执行的任务直接丢弃
+
+	// 禁用拷贝和移动语义
+	ResourceLoader(const ResourceLoader&) = delete;								///< @brief 删除拷贝构造
+	ResourceLoader& operator=(const ResourceLoader&) = delete;					///< @brief 删除拷贝赋值构造
+	ResourceLoader(ResourceLoader&&) = delete;									///< @brief 删除移动构造
+	ResourceLoader& operator=(ResourceLoader&&) = delete;						///< @brief 删除移动赋值构造
+
+	/**
+	 * @brief 提交一个加载任务.
+	 *
+	 * 解码或上传步骤抛出异常时只输出错误日志, 任务仍按完成计数; 上传步骤抛出异常时调用fail, 由它完成等待方.
+	 * @param decode 在工作线程上执行的解码步骤, 不能访问SDL_Renderer和各管理器的缓存
+	 * @param upload 解码完成后在processUploads()中执行的上传步骤
+	 * @param fail 上传步骤抛出异常时在同一线程上执行的清理步骤, 可以为空
+	 */
+	void submit(std::function<void()> decode, std::function<void()> upload, std::function<void()> fail = {});
+
+	/**
+	 * @brief 执行已解码完成的上传步骤, 直到用完时间预算.
+	 *
+	 * 每次调用至少执行一个上传步骤(如果有), 保证预算很小时加载仍能推进.
+	 * @param budget 本次调用的时间预算
+	 * @return 本次执行的上传步骤数量
+	 */
+	int processUploads(std::chrono::nanoseconds budget);
+
+	void waitForUploads(std::chrono::milliseconds timeout);						///< @brief 等待有上传步骤可执行, 最多等待timeout
+	std::size_t getPendingCount() const;										///< @brief 尚未完成上传的任务数量(含排队, 解码中和等待上传)
+
+private:
+	struct Job {
+		std::function<void()> mDecode;											///< @brief 工作线程上执行的解码步骤
+		std::function<void()> mUpload;											///< @brief 调用线程上执行的上传步骤
+		std::function<void()> mFail;											///< @brief 上传步骤抛出异常时执行的清理步骤
+	};
+
+	/**
+	 * @brief 解码完成, 等待上传的步骤.
+	 */
+	struct Upload {
+		std::function<void()> mUpload;											///< @brief 上传步骤
+		std::function<void()> mFail;											///< @brief 上传步骤抛出异常时执行的清理步骤
+	};
+
+	void workerLoop();															///< @brief 工作线程主循环
+	void runFail(const std::function<void()>& fail);							///< @brief 执行上传失败的清理步骤, 吞掉其中的异常
+
+private:
+	static constexpr std::string_view mLogTag = "ResourceLoader";
+	std::vector<std::thread> mWorkers;											///< @brief 工作线程
+	mutable std::mutex mMutex;													///< @brief 保护任务队列, 上传队列和计数
+	std::condition_variable mCondition;											///< @brief 用于唤醒工作线程
+	std::condition_variable mUploadCondition;									///< @brief 用于唤醒等待上传的线程
+	std::deque<Job> mJobs;														///< @brief 等待解码的任务
+	std::deque<Upload> mUploads;												///< @brief 解码完成, 等待上传的步骤
+	std::size_t mPendingCount = 0;												///< @brief 尚未完成上传的任务数量
+	bool mIsStopping = false;													///< @brief 是否正在停止工作线程
+};
+} // namespace engine::resource
+
+#endif // !RESOURCE_LOADER_H
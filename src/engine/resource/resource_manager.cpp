@@ -2,80 +2,1012 @@
 #include "texture_manager.h"
 #include "audio_manager.h"
 #include "font_manager.h"
+#include "animation_manager.h"
+#include "resource_loader.h"
+#include "asset_manifest.h"
+#include "asset_pack.h"
+#include "../render/render_task_queue.h"
+#include "../render/glyph_atlas.h"
+#include <SDL3_image/SDL_image.h>
 #include <spdlog/spdlog.h>
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
 #include <stdexcept>
+#include <unordered_set>
 
 namespace engine::resource {
-ResourceManager::ResourceManager(SDL_Renderer* renderer) {
+namespace {
+struct SDLSurfaceDeleter {
+	void operator()(SDL_Surface* surface) const {
+		SDL_DestroySurface(surface);
+	}
+};
+
+float elapsedMs(std::chrono::steady_clock::time_point start) {
+	return std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+template<typename T>
+bool isFutureReady(const std::shared_future<T>& future) {
+	return future.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+}
+
+template<typename T>
+std::shared_future<T> makeReadyFuture(T value) {
+	std::promise<T> promise;
+	promise.set_value(value);
+	return promise.get_future().share();
+}
+
+std::size_t getFileBytes(const AssetPack* assetPack, std::string_view filePath) {
+	if (assetPack && assetPack->contains(filePath)) {
+		return assetPack->find(filePath).size();
+	}
+	SDL_PathInfo info;
+	if (!SDL_GetPathInfo(std::string(filePath).c_str(), &info)) {
+		return 0;
+	}
+	return static_cast<std::size_t>(info.size);
+}
+} // namespace
+
+ResourceManager::ResourceManager(SDL_Renderer* renderer, engine::render::RenderTaskQueue* renderTaskQueue, int loaderThreadCount)
+	: mRenderTaskQueue(renderTaskQueue)
+{
 	// 初始化各个子系统 (如果出现错误会抛出异常,由上层捕获)
 	mTextureManager = std::make_unique<TextureManager>(renderer);
 	mAudioManager = std::make_unique<AudioManager>();
-	mFontManager = std::make_unique<FontManager>();
+	mFontManager = std::make_unique<FontManager>(renderer);
+	mAnimationManager = std::make_unique<AnimationManager>();
+	mResourceLoader = std::make_unique<ResourceLoader>(loaderThreadCount);
+	mScopes[ResourceScope::mGlobalId].mName = "global";
 
 	spdlog::trace("{} 构造成功", mLogTag);
 	// RAII : 构造成功即代表资源管理器可以正常工作, 无需再初始化, 无需检查指针是否为空
 }
 
-ResourceManager::~ResourceManager() = default;
+ResourceManager::~ResourceManager() {
+	// 先停止工作线程, 之后不会再有上传步骤执行
+	mResourceLoader.reset();
+	destroyRetiredResources(true);
+}
+
+template<typename Func>
+auto ResourceManager::runOnRenderThread(Func&& func) {
+	if (!mRenderTaskQueue) {
+		return func();
+	}
+	return mRenderTaskQueue->runSync(std::forward<Func>(func));
+}
+
+bool ResourceManager::mountAssetPack(std::string_view filePath, bool isLooseFileCheckEnabled) {
+	if (mAssetPack) {
+		spdlog::warn("{} 已映射资源包 '{}', 忽略 '{}'", mLogTag.data(), mAssetPack->getFilePath(), filePath);
+		return false;
+	}
+	if (!std::filesystem::exists(filePath)) {
+		spdlog::info("{} 未找到资源包 '{}', 从散装文件加载资源", mLogTag.data(), filePath);
+		return false;
+	}
+	try {
+		mAssetPack = std::make_unique<AssetPack>(filePath, isLooseFileCheckEnabled);
+	}
+	catch (const std::exception& e) {
+		spdlog::error("{} 资源包不可用, 从散装文件加载资源: {}", mLogTag.data(), e.what());
+		return false;
+	}
+	mTextureManager->setAssetPack(mAssetPack.get());
+	mAudioManager->setAssetPack(mAssetPack.get());
+	mFontManager->setAssetPack(mAssetPack.get());
+	return true;
+}
+
+const AssetPack* ResourceManager::getAssetPack() const {
+	return mAssetPack.get();
+}
 
 void ResourceManager::clear() {
-	mFontManager->clearFonts();
+	mTrackedResources.clear();
+	mPool.clear();
+	mTrackedBytes = 0;
+	mPooledBytes = 0;
+	for (auto& [id, scope] : mScopes) {
+		scope.mKeys.clear();
+	}
+	mAtlasPageKeys.clear();
+	mFailedTextures.clear();
+	destroyRetiredResources(true);
+	runOnRenderThread([this] {
+		releaseFonts({}, 0);
+		mFontManager->clearFonts();
+	});
 	mAudioManager->clearSounds();
 	mAudioManager->clearMusic();
-	mTextureManager->clearTextures();
+	runOnRenderThread([this] { mTextureManager->clearTextures(); });
+	mAnimationManager->clearAnimations();
 	spdlog::trace("{} 清空资源", mLogTag);
 }
 
 SDL_Texture* ResourceManager::loadTexture(std::string_view filePath) {
 	// 构造函数确保了mTextManager不为空, 因此不需要判空, 避免性能浪费
-	return mTextureManager->loadTexture(filePath);
+	if (SDL_Texture* texture = mTextureManager->findTexture(filePath)) {
+		++mStats.mHits;
+		acquire(ResourceType::Texture, filePath, 0, mActiveScope);
+		return texture;
+	}
+	++mStats.mMisses;
+	SDL_Texture* texture = runOnRenderThread([&] { return mTextureManager->loadTexture(filePath); });
+	if (texture) {
+		trackLoaded(ResourceType::Texture, filePath, 0, mTextureManager->getTextureBytes(filePath), mActiveScope);
+	}
+	return texture;
 }
 SDL_Texture* ResourceManager::getTexture(std::string_view filePath) {
-	return mTextureManager->getTexture(filePath);
+	// 命中缓存时直接返回(每帧的绘制都会走这里, 激活范围只在第一次使用时引用), 未命中时才切换到渲染线程加载
+	if (SDL_Texture* texture = mTextureManager->findTexture(filePath)) {
+		++mStats.mHits;
+		acquireActive(ResourceType::Texture, filePath, 0);
+		return texture;
+	}
+	return loadTexture(filePath);
 }
 void ResourceManager::unloadTexture(std::string_view filePath) {
-	mTextureManager->unloadTexture(filePath);
+	untrack(ResourceType::Texture, filePath);
+	runOnRenderThread([&] { mTextureManager->unloadTexture(filePath); });
 }
 glm::vec2 ResourceManager::getTextureSize(std::string_view filePath) {
+	// 先确保纹理已加载, 查询尺寸本身不需要渲染线程
+	getTexture(filePath);
 	return mTextureManager->getTextureSize(filePath);
 }
 void ResourceManager::clearTextures() {
-	mTextureManager->clearTextures();
+	untrackAll(ResourceType::Texture);
+	mFailedTextures.clear();
+	mAtlasPageKeys.clear();
+	destroyRetiredResources(true);
+	runOnRenderThread([this] { mTextureManager->clearTextures(); });
+}
+TextureRegion ResourceManager::getTextureRegion(std::string_view filePath) {
+	// 与getTexture相同: 命中缓存时直接返回, 未命中时才切换到渲染线程加载
+	if (const TextureRegion* region = mTextureManager->findTextureRegion(filePath)) {
+		++mStats.mHits;
+		acquireActive(ResourceType::Texture, filePath, 0);
+		return *region;
+	}
+	loadTexture(filePath);
+	return runOnRenderThread([&] { return mTextureManager->getTextureRegion(filePath); });
+}
+TextureRegion ResourceManager::requestTextureRegion(std::string_view filePath) {
+	if (const TextureRegion* region = mTextureManager->findTextureRegion(filePath)) {
+		++mStats.mHits;
+		acquireActive(ResourceType::Texture, filePath, 0);
+		return *region;
+	}
+	// 已加载但还没有缓存区域(同步加载的独立纹理), 查询尺寸不读取磁盘
+	if (mTextureManager->findTexture(filePath)) {
+		return getTextureRegion(filePath);
+	}
+	std::string key(filePath);
+	if (mPendingTextures.contains(key) || mFailedTextures.contains(key)) {
+		return {};
+	}
+	spdlog::warn("{} 绘制时纹理 '{}' 尚未加载, 已提交异步加载, 加载完成前跳过绘制(应加入场景的资源清单)", mLogTag.data(), filePath);
+	loadTextureAsync(filePath);
+	return {};
+}
+
+std::uint64_t ResourceManager::getAsyncTextureCount() const {
+	return mAsyncTextureCount;
+}
+
+int ResourceManager::packTextures(const std::vector<std::string>& filePaths) {
+	if (!mIsTextureAtlasEnabled) {
+		return 0;
+	}
+	auto start = std::chrono::steady_clock::now();
+	// 1. 跳过重复和已经加载过(独立纹理或已在图集中)的图片
+	std::vector<TextureManager::AtlasImage> images;
+	std::unordered_set<std::string_view> visited;
+	for (const auto& filePath : filePaths) {
+		if (filePath.empty() || !visited.insert(filePath).second || mTextureManager->findTexture(filePath)) {
+			continue;
+		}
+		images.emplace_back().mPath = filePath;
+	}
+	if (images.empty()) {
+		return 0;
+	}
+
+	// 2. 在工作线程上并行解码, 统一转换为RGBA32; 本线程等待全部完成(同时执行其他任务的上传步骤)
+	std::size_t remainingCount = images.size();
+	for (auto& image : images) {
+		mResourceLoader->submit(
+			[&image, assetPack = mAssetPack.get()] {
+				SDL_Surface* loaded = IMG_Load_IO(openAssetStream(assetPack, image.mPath), true);
+				if (!loaded) {
+					spdlog::warn("{} 打包时无法加载图片 '{}': {}", mLogTag.data(), image.mPath, SDL_GetError());
+					return;
+				}
+				image.mSurface.reset(SDL_ConvertSurface(loaded, SDL_PIXELFORMAT_RGBA32));
+				SDL_DestroySurface(loaded);
+				if (!image.mSurface) {
+					spdlog::warn("{} 打包时无法转换图片格式 '{}': {}", mLogTag.data(), image.mPath, SDL_GetError());
+				}
+			},
+			[&remainingCount] { --remainingCount; });
+	}
+	while (remainingCount > 0) {
+		if (mResourceLoader->processUploads(std::chrono::nanoseconds::max()) == 0) {
+			mResourceLoader->waitForUploads(std::chrono::milliseconds(1));
+		}
+	}
+	float decodeMs = elapsedMs(start);
+
+	// 3. 装箱和拼接图集页在本线程完成, 渲染线程只创建图集页纹理
+	auto pageSurfaces = TextureManager::layoutAtlasPages(images);
+	start = std::chrono::steady_clock::now();
+	std::vector<std::string> pageNames;
+	int packedCount = runOnRenderThread([&] { return mTextureManager->addAtlasPages(images, pageSurfaces, pageNames); });
+	spdlog::debug("{} 打包 {} 张图片: 解码 {:.2f} ms, 上传 {:.2f} ms", mLogTag.data(), packedCount, decodeMs, elapsedMs(start));
+	// 图集页按独立纹理跟踪(计入字节预算), 由打包时的激活范围引用; 其他范围使用页中的图片时同样引用图集页
+	for (const auto& pageName : pageNames) {
+		mAtlasPageKeys.emplace(mTextureManager->findAtlasPage(pageName), makeKey(ResourceType::Texture, pageName));
+		trackLoaded(ResourceType::Texture, pageName, 0, mTextureManager->getTextureBytes(pageName), mActiveScope);
+	}
+	return packedCount;
+}
+void ResourceManager::setTextureAtlasEnabled(bool isEnabled) {
+	mIsTextureAtlasEnabled = isEnabled;
 }
 Mix_Chunk* ResourceManager::loadSound(std::string_view filePath) {
-	return mAudioManager->loadSound(filePath);
+	if (Mix_Chunk* chunk = mAudioManager->findSound(filePath)) {
+		++mStats.mHits;
+		acquire(ResourceType::Sound, filePath, 0, mActiveScope);
+		return chunk;
+	}
+	++mStats.mMisses;
+	Mix_Chunk* chunk = mAudioManager->loadSound(filePath);
+	if (chunk) {
+		trackLoaded(ResourceType::Sound, filePath, 0, chunk->alen, mActiveScope);
+	}
+	return chunk;
 }
 Mix_Chunk* ResourceManager::getSound(std::string_view filePath) {
-	return mAudioManager->getSound(filePath);
+	if (Mix_Chunk* chunk = mAudioManager->findSound(filePath)) {
+		++mStats.mHits;
+		acquireActive(ResourceType::Sound, filePath, 0);
+		return chunk;
+	}
+	return loadSound(filePath);
 }
 void ResourceManager::unloadSound(std::string_view filePath) {
+	untrack(ResourceType::Sound, filePath);
 	mAudioManager->unloadSound(filePath);
 }
 void ResourceManager::clearSounds() {
+	untrackAll(ResourceType::Sound);
 	mAudioManager->clearSounds();
 }
 Mix_Music* ResourceManager::loadMusic(std::string_view filePath) {
-	return mAudioManager->loadMusic(filePath);
+	if (Mix_Music* music = mAudioManager->findMusic(filePath)) {
+		++mStats.mHits;
+		acquire(ResourceType::Music, filePath, 0, mActiveScope);
+		return music;
+	}
+	++mStats.mMisses;
+	Mix_Music* music = mAudioManager->loadMusic(filePath);
+	if (music) {
+		// 音乐在播放时流式解码, 以文件大小估算
+		trackLoaded(ResourceType::Music, filePath, 0, getFileBytes(mAssetPack.get(), filePath), mActiveScope);
+	}
+	return music;
 }
 Mix_Music* ResourceManager::getMusic(std::string_view filePath) {
-	return mAudioManager->getMusic(filePath);
+	if (Mix_Music* music = mAudioManager->findMusic(filePath)) {
+		++mStats.mHits;
+		acquireActive(ResourceType::Music, filePath, 0);
+		return music;
+	}
+	return loadMusic(filePath);
 }
 void ResourceManager::unloadMusic(std::string_view filePath) {
+	untrack(ResourceType::Music, filePath);
 	mAudioManager->unloadMusic(filePath);
 }
 void ResourceManager::clearMusic() {
+	untrackAll(ResourceType::Music);
 	mAudioManager->clearMusic();
 }
 TTF_Font* ResourceManager::loadFont(std::string_view filePath, int pointSize) {
-	return mFontManager->loadFont(filePath, pointSize);
+	if (TTF_Font* font = mFontManager->findFont(filePath, pointSize)) {
+		++mStats.mHits;
+		acquire(ResourceType::Font, filePath, pointSize, mActiveScope);
+		return font;
+	}
+	++mStats.mMisses;
+	TTF_Font* font = runOnRenderThread([&] { return mFontManager->loadFont(filePath, pointSize); });
+	if (font) {
+		trackLoaded(ResourceType::Font, filePath, pointSize, getFontBytes(filePath, pointSize), mActiveScope);
+	}
+	return font;
 }
 TTF_Font* ResourceManager::getFont(std::string_view filePath, int pointSize) {
-	return mFontManager->getFont(filePath, pointSize);
+	if (TTF_Font* font = mFontManager->findFont(filePath, pointSize)) {
+		++mStats.mHits;
+		acquireActive(ResourceType::Font, filePath, pointSize);
+		return font;
+	}
+	return loadFont(filePath, pointSize);
+}
+const engine::render::GlyphAtlas* ResourceManager::getGlyphAtlas(std::string_view filePath, int pointSize) {
+	// 图集在加载字体时构建, 确保字体已加载即可
+	if (!getFont(filePath, pointSize)) {
+		return nullptr;
+	}
+	return mFontManager->findGlyphAtlas(filePath, pointSize);
 }
 void ResourceManager::unloadFont(std::string_view filePath, int pointSize) {
-	mFontManager->unloadFont(filePath, pointSize);
+	untrack(ResourceType::Font, filePath, pointSize);
+	runOnRenderThread([&] {
+		releaseFonts(filePath, pointSize);
+		mFontManager->unloadFont(filePath, pointSize);
+	});
 }
 void ResourceManager::clearFonts() {
-	mFontManager->clearFonts();
+	untrackAll(ResourceType::Font);
+	runOnRenderThread([this] {
+		releaseFonts({}, 0);
+		mFontManager->clearFonts();
+	});
+}
+void ResourceManager::setFontReleaseCallback(std::function<void(std::string_view, int)> callback) {
+	mFontReleaseCallback = std::move(callback);
+}
+void ResourceManager::releaseFonts(std::string_view filePath, int pointSize) {
+	if (mFontReleaseCallback) {
+		mFontReleaseCallback(filePath, pointSize);
+	}
+}
+std::shared_ptr<const engine::render::Animation> ResourceManager::addAnimation(std::string_view sheetId, std::shared_ptr<const engine::render::Animation> animation) {
+	// 动画片段只是帧数据, 不涉及SDL资源, 直接在调用线程上处理
+	return mAnimationManager->addAnimation(sheetId, std::move(animation));
+}
+std::shared_ptr<const engine::render::Animation> ResourceManager::getAnimation(std::string_view sheetId, std::string_view clipName) const {
+	return mAnimationManager->getAnimation(sheetId, clipName);
+}
+void ResourceManager::clearAnimations() {
+	mAnimationManager->clearAnimations();
+}
+
+std::shared_future<SDL_Texture*> ResourceManager::loadTextureAsync(std::string_view filePath) {
+	if (SDL_Texture* texture = mTextureManager->findTexture(filePath)) {
+		++mStats.mHits;
+		acquire(ResourceType::Texture, filePath, 0, mActiveScope);
+		return makeReadyFuture(texture);
+	}
+	std::string key(filePath);
+	if (auto iter = mPendingTextures.find(key); iter != mPendingTextures.end()) {
+		return iter->second;
+	}
+
+	struct PendingTexture {
+		std::string mPath;
+		std::unique_ptr<SDL_Surface, SDLSurfaceDeleter> mSurface;
+		std::promise<SDL_Texture*> mPromise;
+		ResourceScopeId mScope = ResourceScope::mGlobalId;
+		float mDecodeMs = 0.f;
+	};
+	auto pending = std::make_shared<PendingTexture>();
+	pending->mScope = mActiveScope;
+	pending->mPath = key;
+	auto future = pending->mPromise.get_future().share();
+	mPendingTextures.emplace(std::move(key), future);
+	++mStats.mMisses;
+
+	mResourceLoader->submit(
+		[pending, assetPack = mAssetPack.get()] {
+			// 工作线程: 读取并解码图片, 统一转换为RGBA32, 上传时不再需要转换格式
+			auto start = std::chrono::steady_clock::now();
+			SDL_Surface* loaded = IMG_Load_IO(openAssetStream(assetPack, pending->mPath), true);
+			if (!loaded) {
+				spdlog::error("{} 异步加载图片失败: '{}' : {}", mLogTag.data(), pending->mPath, SDL_GetError());
+				return;
+			}
+			pending->mSurface.reset(SDL_ConvertSurface(loaded, SDL_PIXELFORMAT_RGBA32));
+			SDL_DestroySurface(loaded);
+			pending->mDecodeMs = elapsedMs(start);
+		},
+		[this, pending] {
+			auto start = std::chrono::steady_clock::now();
+			SDL_Texture* texture = runOnRenderThread([&] { return mTextureManager->addTexture(pending->mPath, pending->mSurface.get()); });
+			pending->mSurface.reset();
+			spdlog::debug("{} 异步加载纹理 '{}': 解码 {:.2f} ms, 上传 {:.2f} ms", mLogTag.data(), pending->mPath, pending->mDecodeMs, elapsedMs(start));
+			mPendingTextures.erase(pending->mPath);
+			if (texture) {
+				trackLoaded(ResourceType::Texture, pending->mPath, 0, mTextureManager->getTextureBytes(pending->mPath), pending->mScope);
+				++mAsyncTextureCount;
+			}
+			else {
+				mFailedTextures.insert(pending->mPath);
+			}
+			pending->mPromise.set_value(texture);
+		},
+		[this, pending] {
+			// 上传抛出异常: 移除正在加载的记录, 以空结果完成等待方
+			mPendingTextures.erase(pending->mPath);
+			mFailedTextures.insert(pending->mPath);
+			pending->mPromise.set_value(nullptr);
+		});
+	return future;
+}
+
+std::shared_future<Mix_Chunk*> ResourceManager::loadSoundAsync(std::string_view filePath) {
+	if (Mix_Chunk* chunk = mAudioManager->findSound(filePath)) {
+		++mStats.mHits;
+		acquire(ResourceType::Sound, filePath, 0, mActiveScope);
+		return makeReadyFuture(chunk);
+	}
+	std::string key(filePath);
+	if (auto iter = mPendingSounds.find(key); iter != mPendingSounds.end()) {
+		return iter->second;
+	}
+
+	struct PendingSound {
+		std::string mPath;
+		std::unique_ptr<Mix_Chunk, AudioManager::SDLMixChunkDeleter> mChunk;
+		std::promise<Mix_Chunk*> mPromise;
+		ResourceScopeId mScope = ResourceScope::mGlobalId;
+		float mDecodeMs = 0.f;
+	};
+	auto pending = std::make_shared<PendingSound>();
+	pending->mScope = mActiveScope;
+	pending->mPath = key;
+	auto future = pending->mPromise.get_future().share();
+	mPendingSounds.emplace(std::move(key), future);
+	++mStats.mMisses;
+
+	mResourceLoader->submit(
+		[pending, assetPack = mAssetPack.get()] {
+			// 工作线程: 音效会被完整解码并转换为音频设备的格式
+			auto start = std::chrono::steady_clock::now();
+			pending->mChunk.reset(Mix_LoadWAV_IO(openAssetStream(assetPack, pending->mPath), true));
+			if (!pending->mChunk) {
+				spdlog::error("{} 异步加载音效失败: '{}' : {}", mLogTag.data(), pending->mPath, SDL_GetError());
+			}
+			pending->mDecodeMs = elapsedMs(start);
+		},
+		[this, pending] {
+			Mix_Chunk* chunk = mAudioManager->addSound(pending->mPath, std::move(pending->mChunk));
+			spdlog::debug("{} 异步加载音效 '{}': 解码 {:.2f} ms", mLogTag.data(), pending->mPath, pending->mDecodeMs);
+			mPendingSounds.erase(pending->mPath);
+			if (chunk) {
+				trackLoaded(ResourceType::Sound, pending->mPath, 0, chunk->alen, pending->mScope);
+			}
+			pending->mPromise.set_value(chunk);
+		},
+		[this, pending] {
+			// 上传抛出异常: 移除正在加载的记录, 以空结果完成等待方
+			mPendingSounds.erase(pending->mPath);
+			pending->mPromise.set_value(nullptr);
+		});
+	return future;
+}
+
+std::shared_future<Mix_Music*> ResourceManager::loadMusicAsync(std::string_view filePath) {
+	if (Mix_Music* music = mAudioManager->findMusic(filePath)) {
+		++mStats.mHits;
+		acquire(ResourceType::Music, filePath, 0, mActiveScope);
+		return makeReadyFuture(music);
+	}
+	std::string key(filePath);
+	if (auto iter = mPendingMusic.find(key); iter != mPendingMusic.end()) {
+		return iter->second;
+	}
+
+	struct PendingMusic {
+		std::string mPath;
+		std::unique_ptr<Mix_Music, AudioManager::SDLMixMusicDeleter> mMusic;
+		std::promise<Mix_Music*> mPromise;
+		ResourceScopeId mScope = ResourceScope::mGlobalId;
+		float mDecodeMs = 0.f;
+	};
+	auto pending = std::make_shared<PendingMusic>();
+	pending->mScope = mActiveScope;
+	pending->mPath = key;
+	auto future = pending->mPromise.get_future().share();
+	mPendingMusic.emplace(std::move(key), future);
+	++mStats.mMisses;
+
+	mResourceLoader->submit(
+		[pending, assetPack = mAssetPack.get()] {
+			// 工作线程: 打开文件并解析格式头, 音乐数据在播放时流式解码
+			auto start = std::chrono::steady_clock::now();
+			pending->mMusic.reset(Mix_LoadMUS_IO(openAssetStream(assetPack, pending->mPath), true));
+			if (!pending->mMusic) {
+				spdlog::error("{} 异步加载音乐失败: '{}' : {}", mLogTag.data(), pending->mPath, SDL_GetError());
+			}
+			pending->mDecodeMs = elapsedMs(start);
+		},
+		[this, pending] {
+			Mix_Music* music = mAudioManager->addMusic(pending->mPath, std::move(pending->mMusic));
+			spdlog::debug("{} 异步加载音乐 '{}': 打开 {:.2f} ms", mLogTag.data(), pending->mPath, pending->mDecodeMs);
+			mPendingMusic.erase(pending->mPath);
+			if (music) {
+				trackLoaded(ResourceType::Music, pending->mPath, 0, getFileBytes(mAssetPack.get(), pending->mPath), pending->mScope);
+			}
+			pending->mPromise.set_value(music);
+		},
+		[this, pending] {
+			// 上传抛出异常: 移除正在加载的记录, 以空结果完成等待方
+			mPendingMusic.erase(pending->mPath);
+			pending->mPromise.set_value(nullptr);
+		});
+	return future;
+}
+
+std::shared_future<TTF_Font*> ResourceManager::loadFontAsync(std::string_view filePath, int pointSize) {
+	if (TTF_Font* font = mFontManager->findFont(filePath, pointSize)) {
+		++mStats.mHits;
+		acquire(ResourceType::Font, filePath, pointSize, mActiveScope);
+		return makeReadyFuture(font);
+	}
+	std::string key = std::string(filePath) + ":" + std::to_string(pointSize);
+	if (auto iter = mPendingFonts.find(key); iter != mPendingFonts.end()) {
+		return iter->second;
+	}
+
+	struct PendingFont {
+		std::string mKey;
+		std::string mPath;
+		int mPointSize = 0;
+		std::unique_ptr<void, FontManager::SDLMemoryDeleter> mData;
+		std::size_t mDataSize = 0;
+		std::promise<TTF_Font*> mPromise;
+		ResourceScopeId mScope = ResourceScope::mGlobalId;
+		float mDecodeMs = 0.f;
+	};
+	auto pending = std::make_shared<PendingFont>();
+	pending->mScope = mActiveScope;
+	pending->mKey = key;
+	pending->mPath = std::string(filePath);
+	pending->mPointSize = pointSize;
+	auto future = pending->mPromise.get_future().share();
+	mPendingFonts.emplace(std::move(key), future);
+	++mStats.mMisses;
+
+	mResourceLoader->submit(
+		[pending, assetPack = mAssetPack.get()] {
+			// 工作线程: 只读取文件, SDL_ttf共享同一个FreeType实例, 打开字体必须在渲染线程上进行
+			auto start = std::chrono::steady_clock::now();
+			pending->mData.reset(SDL_LoadFile_IO(openAssetStream(assetPack, pending->mPath), &pending->mDataSize, true));
+			if (!pending->mData) {
+				spdlog::error("{} 异步读取字体文件失败: '{}' : {}", mLogTag.data(), pending->mPath, SDL_GetError());
+			}
+			pending->mDecodeMs = elapsedMs(start);
+		},
+		[this, pending] {
+			auto start = std::chrono::steady_clock::now();
+			TTF_Font* font = runOnRenderThread([&] {
+				return mFontManager->addFont(pending->mPath, pending->mPointSize, std::move(pending->mData), pending->mDataSize);
+			});
+			spdlog::debug("{} 异步加载字体 '{}' ({}pt): 读取 {:.2f} ms, 创建字体和字形图集 {:.2f} ms", mLogTag.data(), pending->mPath, pending->mPointSize, pending->mDecodeMs, elapsedMs(start));
+			mPendingFonts.erase(pending->mKey);
+			if (font) {
+				trackLoaded(ResourceType::Font, pending->mPath, pending->mPointSize, getFontBytes(pending->mPath, pending->mPointSize), pending->mScope);
+			}
+			pending->mPromise.set_value(font);
+		},
+		[this, pending] {
+			// 上传抛出异常: 移除正在加载的记录, 以空结果完成等待方
+			mPendingFonts.erase(pending->mKey);
+			pending->mPromise.set_value(nullptr);
+		});
+	return future;
+}
+
+int ResourceManager::processPendingLoads(float budgetMs) {
+	// 每帧调用一次, 同时推进淘汰资源的延迟销毁
+	++mFrameIndex;
+	destroyRetiredResources(false);
+	auto budget = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::duration<float, std::milli>(budgetMs));
+	return mResourceLoader->processUploads(budget);
+}
+
+int ResourceManager::preload(const AssetManifest& manifest) {
+	auto start = std::chrono::steady_clock::now();
+	int loaded = 0;
+	int failed = 0;
+	auto countResult = [&](const void* resource) { resource ? ++loaded : ++failed; };
+
+	// 已在缓存中的资源只由当前范围引用, 下面的加载会跳过它们
+	for (const auto& filePath : manifest.getTextures()) acquire(ResourceType::Texture, filePath, 0, mActiveScope);
+	for (const auto& filePath : manifest.getSounds()) acquire(ResourceType::Sound, filePath, 0, mActiveScope);
+	for (const auto& filePath : manifest.getMusic()) acquire(ResourceType::Music, filePath, 0, mActiveScope);
+	for (const auto& [filePath, pointSize] : manifest.getFonts()) acquire(ResourceType::Font, filePath, pointSize, mActiveScope);
+
+	if (!mIsPreloadParallel) {
+		// 逐个同步加载, 已在缓存中的资源直接跳过
+		auto timed = [&](std::string_view kind, std::string_view filePath, auto&& load) {
+			auto assetStart = std::chrono::steady_clock::now();
+			countResult(load());
+			spdlog::debug("{} 预加载{} '{}': {:.2f} ms", mLogTag.data(), kind, filePath, elapsedMs(assetStart));
+		};
+		for (const auto& filePath : manifest.getTextures()) {
+			if (!mTextureManager->findTexture(filePath)) {
+				timed("纹理", filePath, [&] { return loadTexture(filePath); });
+			}
+		}
+		for (const auto& filePath : manifest.getSounds()) {
+			if (!mAudioManager->findSound(filePath)) {
+				timed("音效", filePath, [&] { return loadSound(filePath); });
+			}
+		}
+		for (const auto& filePath : manifest.getMusic()) {
+			if (!mAudioManager->findMusic(filePath)) {
+				timed("音乐", filePath, [&] { return loadMusic(filePath); });
+			}
+		}
+		for (const auto& [filePath, pointSize] : manifest.getFonts()) {
+			if (!mFontManager->findFont(filePath, pointSize)) {
+				timed("字体", filePath, [&] { return loadFont(filePath, pointSize); });
+			}
+		}
+	}
+	else {
+		// 全部提交给工作线程并行解码, 本线程负责上传; 每个资源的耗时在上传步骤中输出
+		std::vector<std::shared_future<SDL_Texture*>> textures;
+		std::vector<std::shared_future<Mix_Chunk*>> sounds;
+		std::vector<std::shared_future<Mix_Music*>> music;
+		std::vector<std::shared_future<TTF_Font*>> fonts;
+		for (const auto& filePath : manifest.getTextures()) {
+			if (!mTextureManager->findTexture(filePath)) {
+				textures.push_back(loadTextureAsync(filePath));
+			}
+		}
+		for (const auto& filePath : manifest.getSounds()) {
+			if (!mAudioManager->findSound(filePath)) {
+				sounds.push_back(loadSoundAsync(filePath));
+			}
+		}
+		for (const auto& filePath : manifest.getMusic()) {
+			if (!mAudioManager->findMusic(filePath)) {
+				music.push_back(loadMusicAsync(filePath));
+			}
+		}
+		for (const auto& [filePath, pointSize] : manifest.getFonts()) {
+			if (!mFontManager->findFont(filePath, pointSize)) {
+				fonts.push_back(loadFontAsync(filePath, pointSize));
+			}
+		}
+
+		auto allReady = [](const auto& futures) {
+			return std::all_of(futures.begin(), futures.end(), [](const auto& future) { return isFutureReady(future); });
+		};
+		while (!allReady(textures) || !allReady(sounds) || !allReady(music) || !allReady(fonts)) {
+			// 加载阶段不受每帧预算限制
+			if (mResourceLoader->processUploads(std::chrono::nanoseconds::max()) == 0) {
+				mResourceLoader->waitForUploads(std::chrono::milliseconds(1));
+			}
+		}
+		for (const auto& future : textures) countResult(future.get());
+		for (const auto& future : sounds) countResult(future.get());
+		for (const auto& future : music) countResult(future.get());
+		for (const auto& future : fonts) countResult(future.get());
+	}
+
+	if (loaded + failed > 0) {
+		spdlog::info("{} 预加载完成({}): 清单 {} 项, 新加载 {} 项, 失败 {} 项, 耗时 {:.2f} ms",
+			mLogTag.data(), mIsPreloadParallel ? "并行" : "串行", manifest.size(), loaded, failed, elapsedMs(start));
+	}
+	return failed;
+}
+
+void ResourceManager::setPreloadParallel(bool isParallel) {
+	mIsPreloadParallel = isParallel;
+}
+
+std::size_t ResourceManager::getPendingLoadCount() const {
+	return mResourceLoader->getPendingCount();
+}
+
+void ResourceManager::submitTask(std::function<void()> decode, std::function<void()> upload) {
+	mResourceLoader->submit(std::move(decode), std::move(upload));
+}
+
+ResourceScopeId ResourceManager::createScope(std::string_view name) {
+	ResourceScopeId id = mNextScopeId++;
+	mScopes[id].mName = std::string(name);
+	spdlog::debug("{} 创建资源范围 {} '{}'", mLogTag.data(), id, name);
+	return id;
+}
+
+void ResourceManager::releaseScope(ResourceScopeId id) {
+	if (id == ResourceScope::mGlobalId) {
+		return;
+	}
+	auto scopeIter = mScopes.find(id);
+	if (scopeIter == mScopes.end()) {
+		return;
+	}
+	for (const auto& key : scopeIter->second.mKeys) {
+		auto iter = mTrackedResources.find(key);
+		if (iter != mTrackedResources.end() && --iter->second.mRefCount == 0) {
+			addToPool(key, iter->second);
+		}
+	}
+	spdlog::debug("{} 释放资源范围 {} '{}': 引用 {} 项, LRU池 {:.2f} MB",
+		mLogTag.data(), id, scopeIter->second.mName, scopeIter->second.mKeys.size(), mPooledBytes / (1024.f * 1024.f));
+	mScopes.erase(scopeIter);
+	if (mActiveScope == id) {
+		mActiveScope = ResourceScope::mGlobalId;
+	}
+	evictToBudget();
+}
+
+ResourceScopeId ResourceManager::setActiveScope(ResourceScopeId id) {
+	ResourceScopeId previous = mActiveScope;
+	mActiveScope = id;
+	return previous;
+}
+
+void ResourceManager::setPoolBudget(std::size_t bytes) {
+	mPoolBudget = bytes;
+	evictToBudget();
+}
+
+ResourceManager::CacheStats ResourceManager::getCacheStats() const {
+	CacheStats stats = mStats;
+	stats.mResidentBytes = mTrackedBytes;
+	stats.mPooledBytes = mPooledBytes;
+	stats.mResidentCount = mTrackedResources.size();
+	return stats;
+}
+
+std::string ResourceManager::makeKey(ResourceType type, std::string_view filePath, int pointSize) {
+	std::string key;
+	buildKey(key, type, filePath, pointSize);
+	return key;
+}
+
+void ResourceManager::buildKey(std::string& key, ResourceType type, std::string_view filePath, int pointSize) {
+	// 不同类型可能使用同一路径(如同一个文件既作为音效又作为音乐), 键以类型开头区分
+	key.clear();
+	key.reserve(filePath.size() + 8);
+	key += static_cast<char>('0' + static_cast<int>(type));
+	key += ':';
+	key += filePath;
+	if (type == ResourceType::Font) {
+		key += ':';
+		key += std::to_string(pointSize);
+	}
+}
+
+void ResourceManager::trackLoaded(ResourceType type, std::string_view filePath, int pointSize, std::size_t bytes, ResourceScopeId scope) {
+	// 图集中的图片没有独立的纹理(字节为0), 由所在的图集页跟踪
+	if (type == ResourceType::Texture && bytes == 0) {
+		return;
+	}
+	std::string key = makeKey(type, filePath, pointSize);
+	auto [iter, isInserted] = mTrackedResources.try_emplace(key);
+	if (isInserted) {
+		TrackedResource& resource = iter->second;
+		resource.mType = type;
+		resource.mPath = std::string(filePath);
+		resource.mPointSize = pointSize;
+		resource.mBytes = bytes;
+		// 缓存的文字对象引用字体, 字体不参与淘汰
+		resource.mIsEvictable = type != ResourceType::Font;
+		mTrackedBytes += bytes;
+	}
+	acquire(type, filePath, pointSize, scope);
+	if (iter->second.mRefCount == 0) {
+		// 请求加载的范围在加载完成前已经释放
+		addToPool(key, iter->second);
+		evictToBudget();
+	}
+}
+
+void ResourceManager::acquire(ResourceType type, std::string_view filePath, int pointSize, ResourceScopeId scope) {
+	if (mTrackedResources.empty()) {
+		return;
+	}
+	if (const std::string* pageKey = type == ResourceType::Texture ? findAtlasPageKey(filePath) : nullptr) {
+		acquireKey(*pageKey, scope);
+		return;
+	}
+	acquireKey(makeKey(type, filePath, pointSize), scope);
+}
+
+void ResourceManager::acquireActive(ResourceType type, std::string_view filePath, int pointSize) {
+	if (mTrackedResources.empty()) {
+		return;
+	}
+	// 图集中的图片没有独立的跟踪记录, 引用所在的图集页
+	if (const std::string* pageKey = type == ResourceType::Texture ? findAtlasPageKey(filePath) : nullptr) {
+		acquireActiveKey(*pageKey);
+		return;
+	}
+	// 键缓冲区复用, 不分配内存
+	buildKey(mKeyBuffer, type, filePath, pointSize);
+	acquireActiveKey(mKeyBuffer);
+}
+
+void ResourceManager::acquireActiveKey(const std::string& key) {
+	// 已被激活范围引用时只做一次集合查找
+	auto scopeIter = mScopes.find(mActiveScope);
+	if (scopeIter == mScopes.end() || scopeIter->second.mKeys.contains(key)) {
+		return;
+	}
+	acquireKey(key, mActiveScope);
+}
+
+const std::string* ResourceManager::findAtlasPageKey(std::string_view filePath) const {
+	if (mAtlasPageKeys.empty()) {
+		return nullptr;
+	}
+	const TextureRegion* region = mTextureManager->findTextureRegion(filePath);
+	if (!region || !region->mIsPacked) {
+		return nullptr;
+	}
+	auto iter = mAtlasPageKeys.find(region->mTexture);
+	return iter != mAtlasPageKeys.end() ? &iter->second : nullptr;
+}
+
+void ResourceManager::acquireKey(const std::string& key, ResourceScopeId scope) {
+	auto iter = mTrackedResources.find(key);
+	auto scopeIter = mScopes.find(scope);
+	if (iter == mTrackedResources.end() || scopeIter == mScopes.end()) {
+		return;
+	}
+	TrackedResource& resource = iter->second;
+	if (!scopeIter->second.mKeys.insert(key).second) {
+		// 同一范围只引用一次; 再次使用时刷新LRU位置
+		if (resource.mIsPooled) {
+			mPool.splice(mPool.end(), mPool, resource.mPoolIter);
+		}
+		return;
+	}
+	if (resource.mRefCount++ == 0 && resource.mIsPooled) {
+		removeFromPool(resource);
+	}
+}
+
+void ResourceManager::untrack(ResourceType type, std::string_view filePath, int pointSize) {
+	std::string key = makeKey(type, filePath, pointSize);
+	auto iter = mTrackedResources.find(key);
+	if (iter == mTrackedResources.end()) {
+		return;
+	}
+	if (iter->second.mIsPooled) {
+		removeFromPool(iter->second);
+	}
+	mTrackedBytes -= iter->second.mBytes;
+	mTrackedResources.erase(iter);
+	// 从各范围中移除, 之后重新加载时引用计数从零开始
+	for (auto& [id, scope] : mScopes) {
+		scope.mKeys.erase(key);
+	}
+}
+
+void ResourceManager::untrackAll(ResourceType type) {
+	std::vector<std::pair<std::string, int>> resources;
+	for (const auto& [key, resource] : mTrackedResources) {
+		if (resource.mType == type) {
+			resources.emplace_back(resource.mPath, resource.mPointSize);
+		}
+	}
+	for (const auto& [filePath, pointSize] : resources) {
+		untrack(type, filePath, pointSize);
+	}
+}
+
+void ResourceManager::addToPool(const std::string& key, TrackedResource& resource) {
+	if (!resource.mIsEvictable || resource.mIsPooled) {
+		return;
+	}
+	resource.mPoolIter = mPool.insert(mPool.end(), key);
+	resource.mIsPooled = true;
+	mPooledBytes += resource.mBytes;
+}
+
+void ResourceManager::removeFromPool(TrackedResource& resource) {
+	mPool.erase(resource.mPoolIter);
+	resource.mIsPooled = false;
+	mPooledBytes -= resource.mBytes;
+}
+
+void ResourceManager::evictToBudget() {
+	while (mPooledBytes > mPoolBudget && !mPool.empty()) {
+		auto iter = mTrackedResources.find(mPool.front());
+		TrackedResource resource = std::move(iter->second);
+		removeFromPool(resource);
+		mTrackedBytes -= resource.mBytes;
+		mTrackedResources.erase(iter);
+		++mStats.mEvictions;
+
+		switch (resource.mType) {
+		case ResourceType::Texture: {
+			// 已录制的帧可能仍引用该纹理, 先移出缓存, 若干帧后再销毁
+			// 图集页连同其中图片的区域一起移除, 这些图片之后按需单独加载
+			SDL_Texture* texture = runOnRenderThread([&] { return mTextureManager->releaseTexture(resource.mPath); });
+			mAtlasPageKeys.erase(texture);
+			retireTexture(texture);
+			break;
+		}
+		case ResourceType::Sound:
+			// 音效可能仍在某个声道上播放, 与纹理一样延迟释放
+			if (Mix_Chunk* chunk = mAudioManager->releaseSound(resource.mPath)) {
+				mRetiredSounds.emplace_back(mFrameIndex, chunk);
+			}
+			break;
+		case ResourceType::Music:
+			if (Mix_Music* music = mAudioManager->releaseMusic(resource.mPath)) {
+				mRetiredMusic.emplace_back(mFrameIndex, music);
+			}
+			break;
+		case ResourceType::Font:
+			break;
+		}
+		spdlog::debug("{} 淘汰资源 '{}' ({:.1f} KB), LRU池剩余 {:.2f} MB",
+			mLogTag.data(), resource.mPath, resource.mBytes / 1024.f, mPooledBytes / (1024.f * 1024.f));
+	}
+}
+
+void ResourceManager::retireTexture(SDL_Texture* texture) {
+	if (texture) {
+		mRetiredTextures.emplace_back(mFrameIndex, texture);
+	}
+}
+
+void ResourceManager::destroyRetiredResources(bool isForced) {
+	auto isKept = [this, isForced](const auto& retired) {
+		return !isForced && mFrameIndex - retired.first < mRetireFrames;
+	};
+
+	if (!mRetiredTextures.empty()) {
+		auto expired = std::partition(mRetiredTextures.begin(), mRetiredTextures.end(), isKept);
+		if (expired != mRetiredTextures.end()) {
+			runOnRenderThread([&] {
+				for (auto iter = expired; iter != mRetiredTextures.end(); ++iter) {
+					SDL_DestroyTexture(iter->second);
+				}
+			});
+			mRetiredTextures.erase(expired, mRetiredTextures.end());
+		}
+	}
+
+	// 音效在播放结束之前一直保留, 避免声音被截断
+	auto expiredSound = std::partition(mRetiredSounds.begin(), mRetiredSounds.end(), [&](const auto& retired) {
+		return isKept(retired) || (!isForced && isSoundPlaying(retired.second));
+	});
+	for (auto iter = expiredSound; iter != mRetiredSounds.end(); ++iter) {
+		Mix_FreeChunk(iter->second);
+	}
+	mRetiredSounds.erase(expiredSound, mRetiredSounds.end());
+
+	auto expiredMusic = std::partition(mRetiredMusic.begin(), mRetiredMusic.end(), isKept);
+	for (auto iter = expiredMusic; iter != mRetiredMusic.end(); ++iter) {
+		Mix_FreeMusic(iter->second);
+	}
+	mRetiredMusic.erase(expiredMusic, mRetiredMusic.end());
+}
+
+bool ResourceManager::isSoundPlaying(Mix_Chunk* chunk) {
+	int channelCount = Mix_AllocateChannels(-1);
+	for (int channel = 0; channel < channelCount; ++channel) {
+		if (Mix_Playing(channel) && Mix_GetChunk(channel) == chunk) {
+			return true;
+		}
+	}
+	return false;
+}
+
+std::size_t ResourceManager::getFontBytes(std::string_view filePath, int pointSize) const {
+	std::size_t bytes = getFileBytes(mAssetPack.get(), filePath);
+	if (const engine::render::GlyphAtlas* atlas = mFontManager->findGlyphAtlas(filePath, pointSize)) {
+		bytes += TextureManager::estimateBytes(atlas->getTexture());
+	}
+	return bytes;
 }
 }
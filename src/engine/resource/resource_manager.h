@@ -10,11 +10,21 @@
 #ifndef RESOURCE_MANAGER_H
 #define RESOURCE_MANAGER_H
 
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <list>
 #include <memory>
 #include <string>
 #include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
 
 #include <glm/glm.hpp>
+#include "resource_scope.h"
 
 struct SDL_Renderer;
 struct SDL_Texture;
@@ -22,6 +32,12 @@ struct Mix_Chunk;
 struct Mix_Music;
 struct TTF_Font;
 
+namespace engine::render {
+class RenderTaskQueue;
+class GlyphAtlas;
+class Animation;
+}
+
 /**
  * @namespace engine::resource.
  */
@@ -32,19 +48,34 @@ namespace engine::resource {
 class TextureManager;
 class AudioManager;
 class FontManager;
+class AnimationManager;
+class ResourceLoader;
+class AssetManifest;
+class AssetPack;
+struct TextureRegion;
 
 /**
  * @class 资源管理类
  * @brief 作为访问各种资源管理器的中央控制点(外观模式Facade).
  * 在构造时初始化其管理的子系统.构造失败会抛出异常
+ *
+ * 除同步接口外还提供异步加载接口: 文件读取和解码在工作线程上进行, 创建纹理和写入缓存在processPendingLoads()中按时间预算分批完成.
+ * 异步接口返回的future在上传完成后就绪; 上传由调用processPendingLoads()的线程执行, 因此该线程不能阻塞等待future,
+ * 应每帧用wait_for(0)轮询或在就绪后再通过同步接口获取(此时必定命中缓存).
+ *
+ * 纹理, 音效, 音乐和字体按归属范围(ResourceScope, 每个场景一个)做引用计数: 激活范围内首次加载的资源,
+ * 以及显式load/预加载的资源会被该范围引用. 范围释放后引用计数归零的资源进入LRU池, 池中字节超出预算时淘汰最久未使用的资源.
+ * 淘汰只影响缓存, 之后再次使用会重新加载. 图集中的图片和字体不会被淘汰(图集页共享, 缓存的文字对象引用字体).
  */
 class ResourceManager final{
 public:
 	/**
 	 * @brief 构造函数, 执行初始化.
 	 * @param renderer SDL_Renderer指针,传递给需要它的子管理器,不能为空
+	 * @param renderTaskQueue 可选: 渲染线程任务队列. 提供时纹理和字体的加载/卸载会被转交到渲染线程执行
+	 * @param loaderThreadCount 异步加载的工作线程数量, 至少为1
 	 */
-	explicit ResourceManager(SDL_Renderer* renderer);
+	explicit ResourceManager(SDL_Renderer* renderer, engine::render::RenderTaskQueue* renderTaskQueue = nullptr, int loaderThreadCount = 2);
 
 	/**
 	 * @brief 显式声明析构函数, 为了让智能指针正确管理仅有前向声明的类.
@@ -64,6 +95,18 @@ public:
 	ResourceManager(ResourceManager&&) = delete;						///< @brief 删除移动构造
 	ResourceManager& operator=(ResourceManager&&) = delete;				///< @brief 删除移动赋值构造
 
+	// -- 资源包 --
+	/**
+	 * @brief 映射资源包, 之后所有资源和关卡文件优先从包中读取, 包中没有的仍从散装文件读取.
+	 *
+	 * 必须在加载任何资源之前调用(流式播放的音乐直接读取映射区域, 资源包不能中途替换).
+	 * @param filePath 资源包路径
+	 * @param isLooseFileCheckEnabled 是否让比资源包新的散装文件优先(开发选项, 每个条目检查一次修改时间)
+	 * @return 是否成功; 文件不存在或无效时返回false, 继续使用散装文件(开发环境)
+	 */
+	bool mountAssetPack(std::string_view filePath, bool isLooseFileCheckEnabled = false);
+	const AssetPack* getAssetPack() const;								///< @brief 获取已映射的资源包, 没有时返回nullptr
+
 	// -- 统一资源访问接口 --
 
 	// Texture
@@ -72,6 +115,26 @@ public:
 	void unloadTexture(std::string_view filePath);						///< @brief 卸载指定的纹理资源
 	glm::vec2 getTextureSize(std::string_view filePath);				///< @brief 获取指定的纹理尺寸
 	void clearTextures();												///< @brief 清空所有的纹理资源
+	TextureRegion getTextureRegion(std::string_view filePath);			///< @brief 获取图片所在的纹理和区域(图集中的图片返回图集页), 未加载时尝试加载
+
+	/**
+	 * @brief 绘制时获取图片所在的纹理和区域, 不阻塞在磁盘上.
+	 *
+	 * 命中缓存时与getTextureRegion相同; 未命中时提交异步加载并返回空区域(mTexture为nullptr), 调用者跳过本帧的绘制,
+	 * 上传完成后的帧正常绘制. 每个未命中的图片只输出一次警告(说明它没有加入场景的资源清单); 加载失败的图片不再重试.
+	 * 同步的getTextureRegion只用于初始化和预加载.
+	 */
+	TextureRegion requestTextureRegion(std::string_view filePath);
+	std::uint64_t getAsyncTextureCount() const;							///< @brief 获取异步加载完成的纹理数量, 帧缓存据此重绘之前因纹理未就绪而跳过的精灵
+
+	/**
+	 * @brief 把尚未加载的图片打包进图集页, 返回打包数量; 未启用图集时不做任何事.
+	 *
+	 * 图片在加载器的工作线程上并行解码, 本线程等待解码完成后装箱并拼接图集页表面,
+	 * 只有创建图集页纹理在渲染线程上执行.
+	 */
+	int packTextures(const std::vector<std::string>& filePaths);
+	void setTextureAtlasEnabled(bool isEnabled);						///< @brief 设置是否启用纹理图集打包
 
 	// Sound Effect (Chunks)
 	Mix_Chunk* loadSound(std::string_view filePath);					///< @brief 载入音效资源
@@ -88,14 +151,160 @@ public:
 	// Fonts
 	TTF_Font* loadFont(std::string_view filePath, int pointSize);		///< @brief 载入字体资源
 	TTF_Font* getFont(std::string_view filePath, int pointSize);		///< @brief 尝试获取已加载的字体的指针,如果未加载则尝试加载
+	const engine::render::GlyphAtlas* getGlyphAtlas(std::string_view filePath, int pointSize);	///< @brief 获取字体的字形图集, 字体未加载时先加载; 没有图集时返回nullptr
 	void unloadFont(std::string_view filePath, int pointSize);			///< @brief 卸载指定的字体资源
 	void clearFonts();													///< @brief 清空所有的字体资源
+	void setFontReleaseCallback(std::function<void(std::string_view, int)> callback);	///< @brief 设置字体关闭之前的回调(路径, 点大小; 路径为空表示全部字体), 在渲染线程上调用
+
+	// Animation Clips
+	///< @brief 加入共享的动画片段(以片段名称为键); 同一精灵图已存在同名片段时返回已有的片段
+	std::shared_ptr<const engine::render::Animation> addAnimation(std::string_view sheetId, std::shared_ptr<const engine::render::Animation> animation);
+	std::shared_ptr<const engine::render::Animation> getAnimation(std::string_view sheetId, std::string_view clipName) const;	///< @brief 获取共享的动画片段, 不存在时返回nullptr
+	void clearAnimations();												///< @brief 清空所有的动画片段
+
+	// -- 异步加载接口 (只能在使用ResourceManager的线程上调用, 即游戏线程) --
+	std::shared_future<SDL_Texture*> loadTextureAsync(std::string_view filePath);		///< @brief 异步载入纹理, 已加载或正在加载时返回对应的future
+	std::shared_future<Mix_Chunk*> loadSoundAsync(std::string_view filePath);			///< @brief 异步载入音效
+	std::shared_future<Mix_Music*> loadMusicAsync(std::string_view filePath);			///< @brief 异步载入音乐
+	std::shared_future<TTF_Font*> loadFontAsync(std::string_view filePath, int pointSize);	///< @brief 异步载入字体(工作线程只读取文件, 字体和字形图集在上传时创建)
+
+	/**
+	 * @brief 完成已解码资源的上传, 每帧调用一次.
+	 *
+	 * @param budgetMs 本次调用的时间预算(毫秒), 超出后剩余的资源留到下一帧; 至少完成一个
+	 * @return 本次完成的资源数量
+	 */
+	int processPendingLoads(float budgetMs);
+	std::size_t getPendingLoadCount() const;							///< @brief 尚未完成的异步加载数量
+	void retireTexture(SDL_Texture* texture);							///< @brief 延迟销毁不再使用的纹理(例如渲染目标), 已录制的帧可能仍引用它; 只在游戏线程上调用
+
+	/**
+	 * @brief 提交一个通用的异步任务(例如流式关卡的块), 与资源加载共用工作线程和每帧的上传预算.
+	 *
+	 * @param decode 在工作线程上执行的步骤, 不能访问SDL_Renderer和各管理器的缓存
+	 * @param upload 在processPendingLoads()中执行的步骤
+	 */
+	void submitTask(std::function<void()> decode, std::function<void()> upload);
+
+	/**
+	 * @brief 批量预加载清单中的资源, 阻塞直到全部完成(用于场景初始化, 避免首次使用时卡顿).
+	 *
+	 * 并行模式下所有资源交给工作线程同时解码, 本线程负责上传; 串行模式下逐个同步加载.
+	 * 已在缓存中的资源直接跳过, 每个新加载的资源都会输出耗时.
+	 * @param manifest 资源清单
+	 * @return 加载失败的资源数量
+	 */
+	int preload(const AssetManifest& manifest);
+	void setPreloadParallel(bool isParallel);							///< @brief 设置预加载是否使用工作线程并行解码
+
+	// -- 归属范围与缓存预算 (只能在游戏线程上调用) --
+	/**
+	 * @brief 资源缓存的统计数据.
+	 */
+	struct CacheStats {
+		std::size_t mResidentBytes = 0;									///< @brief 常驻内存估算(字节), 含图集页
+		std::size_t mPooledBytes = 0;									///< @brief 其中未被任何范围引用, 可以被淘汰的字节
+		std::size_t mResidentCount = 0;									///< @brief 跟踪的资源数量(不含图集中的图片)
+		std::uint64_t mHits = 0;										///< @brief 缓存命中次数
+		std::uint64_t mMisses = 0;										///< @brief 缓存未命中(需要加载)次数
+		std::uint64_t mEvictions = 0;									///< @brief 淘汰次数
+	};
+
+	ResourceScopeId createScope(std::string_view name);					///< @brief 创建新的归属范围(由ResourceScope调用)
+	void releaseScope(ResourceScopeId id);								///< @brief 释放范围持有的全部引用(由ResourceScope调用), 之后按预算淘汰
+	ResourceScopeId setActiveScope(ResourceScopeId id);					///< @brief 设置激活范围, 返回之前的激活范围
+	void setPoolBudget(std::size_t bytes);								///< @brief 设置LRU池(未被引用的资源)的字节预算
+	CacheStats getCacheStats() const;									///< @brief 获取缓存统计
+
+private:
+	/**
+	 * @brief 在渲染线程上执行需要访问SDL_Renderer或SDL_ttf的操作.
+	 * 没有任务队列或当前已在渲染线程时直接执行
+	 */
+	template<typename Func>
+	auto runOnRenderThread(Func&& func);
+
+	enum class ResourceType { Texture, Sound, Music, Font };
+
+	/**
+	 * @brief 被跟踪的资源(引用计数和LRU池中的位置).
+	 */
+	struct TrackedResource {
+		ResourceType mType = ResourceType::Texture;						///< @brief 资源类型
+		std::string mPath;												///< @brief 文件路径
+		int mPointSize = 0;												///< @brief 字体点大小(其他类型为0)
+		std::size_t mBytes = 0;											///< @brief 内存估算(字节)
+		int mRefCount = 0;												///< @brief 引用该资源的范围数量
+		bool mIsEvictable = true;										///< @brief 是否可以被淘汰
+		bool mIsPooled = false;											///< @brief 是否在LRU池中
+		std::list<std::string>::iterator mPoolIter;						///< @brief 在LRU池中的位置
+	};
+
+	/**
+	 * @brief 归属范围.
+	 */
+	struct Scope {
+		std::string mName;												///< @brief 范围名称(场景名称)
+		std::unordered_set<std::string> mKeys;							///< @brief 引用的资源键
+	};
+
+	static std::string makeKey(ResourceType type, std::string_view filePath, int pointSize = 0);	///< @brief 生成资源的跟踪键
+	static void buildKey(std::string& key, ResourceType type, std::string_view filePath, int pointSize);	///< @brief 把跟踪键写入已有的字符串(复用其容量)
+	void trackLoaded(ResourceType type, std::string_view filePath, int pointSize, std::size_t bytes, ResourceScopeId scope);	///< @brief 跟踪新加载的资源并由范围引用
+	void acquire(ResourceType type, std::string_view filePath, int pointSize, ResourceScopeId scope);	///< @brief 范围引用已加载的资源(未跟踪的资源忽略)
+	void acquireActive(ResourceType type, std::string_view filePath, int pointSize);	///< @brief 缓存命中时调用: 激活范围第一次使用该资源时引用它, 之后只做一次查找
+	void acquireKey(const std::string& key, ResourceScopeId scope);	///< @brief 范围按跟踪键引用资源
+	void acquireActiveKey(const std::string& key);						///< @brief 激活范围尚未引用时按跟踪键引用资源
+	const std::string* findAtlasPageKey(std::string_view filePath) const;	///< @brief 图集中的图片所在图集页的跟踪键, 不在图集中时返回nullptr
+	void untrack(ResourceType type, std::string_view filePath, int pointSize = 0);	///< @brief 停止跟踪被显式卸载的资源
+	void untrackAll(ResourceType type);									///< @brief 停止跟踪某一类型的全部资源
+	void addToPool(const std::string& key, TrackedResource& resource);	///< @brief 引用归零的资源放入LRU池尾部
+	void removeFromPool(TrackedResource& resource);						///< @brief 资源被重新引用时移出LRU池
+	void evictToBudget();												///< @brief 从LRU池头部淘汰资源直到不超出预算
+	void destroyRetiredResources(bool isForced);						///< @brief 销毁已淘汰且不再被在途帧引用(音效: 不再播放)的资源
+	static bool isSoundPlaying(Mix_Chunk* chunk);						///< @brief 音效是否仍在某个声道上播放
+	void releaseFonts(std::string_view filePath, int pointSize);			///< @brief 字体关闭之前调用回调(在渲染线程上), 路径为空表示全部字体
+	std::size_t getFontBytes(std::string_view filePath, int pointSize) const;	///< @brief 字体的内存估算: 文件大小 + 字形图集
 
 private:
 	static constexpr std::string_view mLogTag = "ResourceManager";
+	engine::render::RenderTaskQueue* mRenderTaskQueue = nullptr;		///< @brief 渲染线程任务队列的非拥有指针, 可以为空
+	std::unique_ptr<AssetPack> mAssetPack;								///< @brief 资源包(先于各子管理器构造, 最后析构)
+	bool mIsTextureAtlasEnabled = true;									///< @brief 是否启用纹理图集打包
+	bool mIsPreloadParallel = true;										///< @brief 预加载是否并行解码
 	std::unique_ptr<TextureManager> mTextureManager;
 	std::unique_ptr<AudioManager> mAudioManager;
 	std::unique_ptr<FontManager> mFontManager;
+	std::unique_ptr<AnimationManager> mAnimationManager;
+	std::function<void(std::string_view, int)> mFontReleaseCallback;	///< @brief 字体关闭之前的回调(销毁引用字体的文字对象)
+	// 等待中的异步加载(路径 -> future), 重复请求同一资源时复用; 字体的键为"路径:点大小"
+	std::unordered_map<std::string, std::shared_future<SDL_Texture*>> mPendingTextures;
+	std::unordered_map<std::string, std::shared_future<Mix_Chunk*>> mPendingSounds;
+	std::unordered_map<std::string, std::shared_future<Mix_Music*>> mPendingMusic;
+	std::unordered_map<std::string, std::shared_future<TTF_Font*>> mPendingFonts;
+	std::unordered_set<std::string> mFailedTextures;					///< @brief 异步加载失败的纹理, 绘制时不再重新提交
+	std::uint64_t mAsyncTextureCount = 0;								///< @brief 异步加载完成的纹理数量
+	// 归属范围与LRU池 (只在游戏线程上访问)
+	ResourceScopeId mActiveScope = ResourceScope::mGlobalId;			///< @brief 当前激活的范围
+	ResourceScopeId mNextScopeId = ResourceScope::mGlobalId + 1;		///< @brief 下一个范围ID
+	std::unordered_map<ResourceScopeId, Scope> mScopes;					///< @brief 范围ID -> 范围
+	std::unordered_map<std::string, TrackedResource> mTrackedResources;	///< @brief 资源键 -> 被跟踪的资源
+	std::list<std::string> mPool;										///< @brief 未被引用的资源键, 头部为最久未使用
+	std::size_t mPoolBudget = 64 * 1024 * 1024;							///< @brief LRU池的字节预算
+	std::size_t mTrackedBytes = 0;										///< @brief 被跟踪资源的总字节
+	std::size_t mPooledBytes = 0;										///< @brief LRU池中资源的总字节
+	CacheStats mStats;													///< @brief 命中, 未命中和淘汰计数
+	// 淘汰的纹理可能仍被已录制但尚未提交的帧引用, 等待若干帧后再销毁
+	std::vector<std::pair<std::uint64_t, SDL_Texture*>> mRetiredTextures;
+	// 淘汰的音效可能仍在声道上播放, 音乐可能仍在淡出, 同样延迟释放
+	std::vector<std::pair<std::uint64_t, Mix_Chunk*>> mRetiredSounds;
+	std::vector<std::pair<std::uint64_t, Mix_Music*>> mRetiredMusic;
+	std::uint64_t mFrameIndex = 0;										///< @brief 帧计数(每次processPendingLoads加一)
+	static constexpr std::uint64_t mRetireFrames = 3;					///< @brief 淘汰的资源延迟销毁的帧数(三重缓冲)
+	std::string mKeyBuffer;												///< @brief acquireActive复用的键缓冲区
+	std::unordered_map<const SDL_Texture*, std::string> mAtlasPageKeys;	///< @brief 图集页纹理 -> 跟踪键
+	// 放在最后, 保证最先析构: 先停止工作线程并释放未上传的解码结果, 再关闭各子系统
+	std::unique_ptr<ResourceLoader> mResourceLoader;
 };
 
 }
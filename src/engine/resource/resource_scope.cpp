@@ -0,0 +1,32 @@
+#include "resource_scope.h"
+#include "resource_manager.h"
+
+namespace engine::resource {
+ResourceScope::ResourceScope(ResourceManager& resourceManager, std::string_view name)
+	: mResourceManager(resourceManager)
+	, mId(resourceManager.createScope(name))
+{
+}
+
+ResourceScope::~ResourceScope() {
+	mResourceManager.releaseScope(mId);
+}
+
+ResourceScopeId ResourceScope::getId() const {
+	return mId;
+}
+
+ResourceManager& ResourceScope::getResourceManager() const {
+	return mResourceManager;
+}
+
+ActiveResourceScope::ActiveResourceScope(const ResourceScope& scope)
+	: mResourceManager(scope.getResourceManager())
+	, mPreviousId(scope.getResourceManager().setActiveScope(scope.getId()))
+{
+}
+
+ActiveResourceScope::~ActiveResourceScope() {
+	mResourceManager.setActiveScope(mPreviousId);
+}
+} // namespace engine::resource
@@ -0,0 +1,69 @@
+/*****************************************************************//**
+ * @file   resource_scope.h
+ * @brief  资源归属范围
+ * @version 1.0
+ *
+ * @author Shallowshades
+ * @date   2026.10.18
+ *********************************************************************/
+
+#pragma once
+#ifndef RESOURCE_SCOPE_H
+#define RESOURCE_SCOPE_H
+
+#include <cstdint>
+#include <string_view>
+
+namespace engine::resource {
+class ResourceManager;
+
+using ResourceScopeId = std::uint32_t;
+
+/**
+ * @brief 资源归属范围的句柄(通常每个场景一个).
+ *
+ * 范围激活期间加载的资源, 以及预加载清单中的资源, 都会被该范围引用一次(引用计数).
+ * 句柄销毁时释放该范围持有的全部引用, 引用计数归零的资源进入LRU池, 超出字节预算时按最久未使用淘汰.
+ */
+class ResourceScope final {
+public:
+	static constexpr ResourceScopeId mGlobalId = 0;							///< @brief 全局范围ID, 从不释放(没有范围激活时加载的资源归属于它)
+
+	ResourceScope(ResourceManager& resourceManager, std::string_view name);	///< @brief 构造函数, 在资源管理器中创建新的范围
+	~ResourceScope();														///< @brief 析构函数, 释放范围持有的全部引用
+
+	// 禁用拷贝和移动语义
+	ResourceScope(const ResourceScope&) = delete;							///< @brief 删除拷贝构造
+	ResourceScope& operator=(const ResourceScope&) = delete;				///< @brief 删除拷贝赋值构造
+	ResourceScope(ResourceScope&&) = delete;								///< @brief 删除移动构造
+	ResourceScope& operator=(ResourceScope&&) = delete;						///< @brief 删除移动赋值构造
+
+	ResourceScopeId getId() const;											///< @brief 获取范围ID
+	ResourceManager& getResourceManager() const;							///< @brief 获取所属的资源管理器
+
+private:
+	ResourceManager& mResourceManager;										///< @brief 所属的资源管理器
+	ResourceScopeId mId = mGlobalId;										///< @brief 范围ID
+};
+
+/**
+ * @brief 在对象生命周期内把指定范围设为激活范围, 析构时恢复之前的激活范围.
+ */
+class ActiveResourceScope final {
+public:
+	explicit ActiveResourceScope(const ResourceScope& scope);				///< @brief 构造函数, 激活范围
+	~ActiveResourceScope();													///< @brief 析构函数, 恢复之前的激活范围
+
+	// 禁用拷贝和移动语义
+	ActiveResourceScope(const ActiveResourceScope&) = delete;				///< @brief 删除拷贝构造
+	ActiveResourceScope& operator=(const ActiveResourceScope&) = delete;	///< @brief 删除拷贝赋值构造
+	ActiveResourceScope(ActiveResourceScope&&) = delete;					///< @brief 删除移动构造
+	ActiveResourceScope& operator=(ActiveResourceScope&&) = delete;			///< @brief 删除移动赋值构造
+
+private:
+	ResourceManager& mResourceManager;										///< @brief 所属的资源管理器
+	ResourceScopeId mPreviousId = ResourceScope::mGlobalId;					///< @brief 之前的激活范围
+};
+} // namespace engine::resource
+
+#endif // !RESOURCE_SCOPE_H
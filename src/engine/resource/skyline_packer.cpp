@@ -0,0 +1,96 @@
+#include "skyline_packer.h"
+#include <algorithm>
+#include <limits>
+
+namespace engine::resource {
+SkylinePacker::SkylinePacker(int width, int height)
+	: mWidth(std::max(width, 0))
+	, mHeight(std::max(height, 0))
+{
+	mSkyline.push_back(Node{ 0, 0, mWidth });
+}
+
+std::optional<glm::ivec2> SkylinePacker::pack(const glm::ivec2& size) {
+	if (size.x <= 0 || size.y <= 0) {
+		return std::nullopt;
+	}
+
+	// 1. 找到放置后顶部最低的位置, 相同时取最窄的一段
+	std::size_t bestIndex = mSkyline.size();
+	int bestTop = std::numeric_limits<int>::max();
+	int bestWidth = std::numeric_limits<int>::max();
+	for (std::size_t index = 0; index < mSkyline.size(); ++index) {
+		int y = fit(index, size);
+		if (y < 0) {
+			continue;
+		}
+		int top = y + size.y;
+		if (top < bestTop || (top == bestTop && mSkyline[index].mWidth < bestWidth)) {
+			bestIndex = index;
+			bestTop = top;
+			bestWidth = mSkyline[index].mWidth;
+		}
+	}
+	if (bestIndex == mSkyline.size()) {
+		return std::nullopt;
+	}
+
+	// 2. 插入新的一段, 并裁掉被它覆盖的后续区间
+	glm::ivec2 position(mSkyline[bestIndex].mX, bestTop - size.y);
+	mSkyline.insert(mSkyline.begin() + bestIndex, Node{ position.x, bestTop, size.x });
+	for (std::size_t index = bestIndex + 1; index < mSkyline.size();) {
+		const Node& previous = mSkyline[index - 1];
+		Node& node = mSkyline[index];
+		int overlap = previous.mX + previous.mWidth - node.mX;
+		if (overlap <= 0) {
+			break;
+		}
+		node.mX += overlap;
+		node.mWidth -= overlap;
+		if (node.mWidth > 0) {
+			break;
+		}
+		mSkyline.erase(mSkyline.begin() + index);
+	}
+
+	// 3. 合并高度相同的相邻区间
+	for (std::size_t index = 0; index + 1 < mSkyline.size();) {
+		if (mSkyline[index].mY == mSkyline[index + 1].mY) {
+			mSkyline[index].mWidth += mSkyline[index + 1].mWidth;
+			mSkyline.erase(mSkyline.begin() + index + 1);
+		}
+		else {
+			++index;
+		}
+	}
+
+	mUsedHeight = std::max(mUsedHeight, bestTop);
+	return position;
+}
+
+glm::ivec2 SkylinePacker::getSize() const {
+	return glm::ivec2(mWidth, mHeight);
+}
+
+int SkylinePacker::getUsedHeight() const {
+	return mUsedHeight;
+}
+
+int SkylinePacker::fit(std::size_t index, const glm::ivec2& size) const {
+	if (mSkyline[index].mX + size.x > mWidth) {
+		return -1;
+	}
+
+	// 矩形跨过的所有区间中最高的一段决定了放置高度
+	int y = mSkyline[index].mY;
+	int widthLeft = size.x;
+	for (std::size_t i = index; widthLeft > 0 && i < mSkyline.size(); ++i) {
+		y = std::max(y, mSkyline[i].mY);
+		if (y + size.y > mHeight) {
+			return -1;
+		}
+		widthLeft -= mSkyline[i].mWidth;
+	}
+	return y;
+}
+} // namespace engine::resource
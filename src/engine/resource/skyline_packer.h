@@ -0,0 +1,61 @@
+/*****************************************************************//**
+ * @file   skyline_packer.h
+ * @brief  天际线矩形装箱
+ * @version 1.0
+ *
+ * @author Shallowshades
+ * @date   2026.10.18
+ *********************************************************************/
+
+#pragma once
+#ifndef SKYLINE_PACKER_H
+#define SKYLINE_PACKER_H
+
+#include <cstddef>
+#include <optional>
+#include <vector>
+#include <glm/vec2.hpp>
+
+namespace engine::resource {
+/**
+ * @brief 天际线(Skyline Bottom-Left)矩形装箱, 用于把多张小图排布到一张图集页中.
+ *
+ * 天际线记录每一段水平区间当前已占用到的高度, 新矩形放在使其顶部最低的位置(相同时取最窄的一段),
+ * 按高度从大到小依次放入时空间利用率较好.
+ */
+class SkylinePacker final {
+public:
+	SkylinePacker(int width, int height);									///< @brief 构造函数, 指定图集页的尺寸
+
+	/**
+	 * @brief 放入一个矩形.
+	 *
+	 * @param size 矩形尺寸
+	 * @return 放置位置(左上角), 放不下时返回std::nullopt
+	 */
+	std::optional<glm::ivec2> pack(const glm::ivec2& size);
+
+	glm::ivec2 getSize() const;												///< @brief 获取图集页的尺寸
+	int getUsedHeight() const;												///< @brief 获取已使用的高度(用于裁剪图集页)
+
+private:
+	/**
+	 * @brief 天际线上的一段水平区间.
+	 */
+	struct Node {
+		int mX = 0;															///< @brief 起始x坐标
+		int mY = 0;															///< @brief 该区间已占用到的高度
+		int mWidth = 0;														///< @brief 区间宽度
+	};
+
+	int fit(std::size_t index, const glm::ivec2& size) const;				///< @brief 以第index段为左端放置时的y坐标, 放不下返回-1
+
+private:
+	int mWidth = 0;															///< @brief 图集页宽度
+	int mHeight = 0;														///< @brief 图集页高度
+	int mUsedHeight = 0;													///< @brief 已使用的高度
+	std::vector<Node> mSkyline;												///< @brief 从左到右排列的天际线
+};
+} // namespace engine::resource
+
+#endif // !SKYLINE_PACKER_H
@@ -1,6 +1,10 @@
 #include "texture_manager.h"
+#include "skyline_packer.h"
+#include "asset_pack.h"
+#include <SDL3/SDL.h>
 #include <SDL3_image/SDL_image.h>
 #include <spdlog/spdlog.h>
+#include <algorithm>
 #include <stdexcept>
 
 namespace engine::resource {
@@ -13,14 +17,17 @@ namespace engine::resource {
 	}
 
 	SDL_Texture* TextureManager::loadTexture(std::string_view filePath) {
-		// 检查是否已经被加载
+		// 检查是否已经被加载(打包进图集的图片返回图集页)
+		if (const TextureRegion* region = findTextureRegion(filePath)) {
+			return region->mTexture;
+		}
 		auto iter = mTextures.find(std::string(filePath));
 		if (iter != mTextures.end()) {
 			return iter->second.get();
 		}
 
 		// 如果没有加载则尝试加载纹理
-		SDL_Texture* rawTexture = IMG_LoadTexture(mRenderer, filePath.data());
+		SDL_Texture* rawTexture = IMG_LoadTexture_IO(mRenderer, openAssetStream(mAssetPack, filePath), true);
 		if (!SDL_SetTextureScaleMode(rawTexture, SDL_SCALEMODE_NEAREST)) {
 			spdlog::warn("{} 无法设置纹理缩放模式为最临近插值", mLogTag.data());
 		}
@@ -35,11 +42,39 @@ namespace engine::resource {
 		return rawTexture;
 	}
 
+	SDL_Texture* TextureManager::addTexture(std::string_view filePath, SDL_Surface* surface) {
+		// 解码期间可能已经被同步加载或打包进图集
+		if (SDL_Texture* texture = findTexture(filePath)) {
+			return texture;
+		}
+		if (!surface) {
+			return nullptr;
+		}
+
+		SDL_Texture* rawTexture = SDL_CreateTextureFromSurface(mRenderer, surface);
+		if (!rawTexture) {
+			spdlog::error("{} 上传纹理失败: '{}' : {}", mLogTag.data(), filePath.data(), SDL_GetError());
+			return nullptr;
+		}
+		if (!SDL_SetTextureScaleMode(rawTexture, SDL_SCALEMODE_NEAREST)) {
+			spdlog::warn("{} 无法设置纹理缩放模式为最临近插值", mLogTag.data());
+		}
+
+		mTextures.emplace(filePath, std::unique_ptr<SDL_Texture, SDLTextureDeleter>(rawTexture));
+		// 尺寸取自表面, 同时缓存区域, 绘制时只需查找区域(不需要切换到渲染线程)
+		TextureRegion region;
+		region.mTexture = rawTexture;
+		region.mRect = { 0.f, 0.f, static_cast<float>(surface->w), static_cast<float>(surface->h) };
+		region.mTextureSize = { region.mRect.w, region.mRect.h };
+		mRegions.emplace(filePath, region);
+		spdlog::debug("{} 成功上传并缓存异步加载的纹理: {}", mLogTag.data(), filePath.data());
+		return rawTexture;
+	}
+
 	SDL_Texture* TextureManager::getTexture(std::string_view filePath) {
 		// 查找现有纹理
-		auto iter = mTextures.find(std::string(filePath));
-		if (iter != mTextures.end()) {
-			return iter->second.get();
+		if (SDL_Texture* texture = findTexture(filePath)) {
+			return texture;
 		}
 
 		// 如果未找到, 尝试加载它
@@ -47,39 +82,215 @@ namespace engine::resource {
 		return loadTexture(filePath);
 	}
 
+	SDL_Texture* TextureManager::findTexture(std::string_view filePath) const {
+		if (const TextureRegion* region = findTextureRegion(filePath)) {
+			return region->mTexture;
+		}
+		auto iter = mTextures.find(std::string(filePath));
+		return iter != mTextures.end() ? iter->second.get() : nullptr;
+	}
+
+	SDL_Texture* TextureManager::findAtlasPage(std::string_view pageName) const {
+		auto iter = mAtlasPages.find(std::string(pageName));
+		return iter != mAtlasPages.end() ? iter->second.mTexture.get() : nullptr;
+	}
+
 	glm::vec2 TextureManager::getTextureSize(std::string_view filePath) {
-		// 获取纹理
-		SDL_Texture* texture = getTexture(std::string(filePath));
-		if (!texture) {
+		// 图集中的图片返回其区域尺寸而不是图集页尺寸
+		TextureRegion region = getTextureRegion(filePath);
+		if (!region.mTexture) {
 			spdlog::error("{} 无法获取纹理: {}", mLogTag.data(), filePath.data());
 			return glm::vec2(0);
 		}
+		return glm::vec2(region.mRect.w, region.mRect.h);
+	}
+
+	TextureRegion TextureManager::getTextureRegion(std::string_view filePath) {
+		if (const TextureRegion* region = findTextureRegion(filePath)) {
+			return *region;
+		}
 
-		// 获取纹理尺寸
-		glm::vec2 size;
-		if (!SDL_GetTextureSize(texture, &size.x, &size.y)) {
+		// 独立纹理占据整张纹理, 查询一次尺寸后缓存, 之后绘制时不再调用SDL_GetTextureSize
+		SDL_Texture* texture = getTexture(filePath);
+		if (!texture) {
+			return TextureRegion{};
+		}
+		TextureRegion region;
+		region.mTexture = texture;
+		if (!SDL_GetTextureSize(texture, &region.mRect.w, &region.mRect.h)) {
 			spdlog::error("{} 无法查询纹理尺寸: {}", mLogTag.data(), filePath.data());
-			return glm::vec2(0);
+			return TextureRegion{};
 		}
-		return size;
+		region.mTextureSize = { region.mRect.w, region.mRect.h };
+		mRegions.emplace(filePath, region);
+		return region;
+	}
+
+	const TextureRegion* TextureManager::findTextureRegion(std::string_view filePath) const {
+		auto iter = mRegions.find(std::string(filePath));
+		return iter != mRegions.end() ? &iter->second : nullptr;
+	}
+
+	std::vector<TextureManager::AtlasPageSurface> TextureManager::layoutAtlasPages(std::vector<AtlasImage>& images) {
+		// 1. 移除解码失败的图片, 过大的图片保持独立纹理
+		std::erase_if(images, [](const AtlasImage& image) {
+			return !image.mSurface || image.mSurface->w + mAtlasPadding > mAtlasPageSize || image.mSurface->h + mAtlasPadding > mAtlasPageSize;
+		});
+		for (auto& image : images) {
+			image.mRect = { 0, 0, image.mSurface->w, image.mSurface->h };
+		}
+
+		// 2. 按高度从大到小装箱, 当前图集页放不下时放入新的一页
+		std::sort(images.begin(), images.end(), [](const AtlasImage& lhs, const AtlasImage& rhs) {
+			return lhs.mRect.h != rhs.mRect.h ? lhs.mRect.h > rhs.mRect.h : lhs.mRect.w > rhs.mRect.w;
+		});
+		std::vector<SkylinePacker> packers;
+		for (auto& image : images) {
+			const glm::ivec2 paddedSize(image.mRect.w + mAtlasPadding, image.mRect.h + mAtlasPadding);
+			std::optional<glm::ivec2> position;
+			for (std::size_t page = 0; page < packers.size() && !position; ++page) {
+				position = packers[page].pack(paddedSize);
+				image.mPage = page;
+			}
+			if (!position) {
+				packers.emplace_back(mAtlasPageSize, mAtlasPageSize);
+				position = packers.back().pack(paddedSize);
+				image.mPage = packers.size() - 1;
+			}
+			image.mRect.x = position->x;
+			image.mRect.y = position->y;
+		}
+
+		// 3. 每一页拷贝到一张透明表面上(不混合, 保留alpha), 高度裁剪到实际使用的部分
+		std::vector<AtlasPageSurface> pageSurfaces(packers.size());
+		for (std::size_t page = 0; page < packers.size(); ++page) {
+			pageSurfaces[page].reset(SDL_CreateSurface(mAtlasPageSize, std::max(packers[page].getUsedHeight(), 1), SDL_PIXELFORMAT_RGBA32));
+			if (!pageSurfaces[page]) {
+				spdlog::error("{} 创建图集页表面失败: {}", mLogTag.data(), SDL_GetError());
+				continue;
+			}
+			SDL_FillSurfaceRect(pageSurfaces[page].get(), nullptr, 0);
+		}
+		for (auto& image : images) {
+			if (SDL_Surface* pageSurface = pageSurfaces[image.mPage].get()) {
+				SDL_SetSurfaceBlendMode(image.mSurface.get(), SDL_BLENDMODE_NONE);
+				SDL_BlitSurface(image.mSurface.get(), nullptr, pageSurface, &image.mRect);
+			}
+		}
+		return pageSurfaces;
+	}
+
+	int TextureManager::addAtlasPages(const std::vector<AtlasImage>& images, const std::vector<AtlasPageSurface>& pageSurfaces, std::vector<std::string>& pageNames) {
+		int packedCount = 0;
+		for (std::size_t page = 0; page < pageSurfaces.size(); ++page) {
+			SDL_Surface* pageSurface = pageSurfaces[page].get();
+			if (!pageSurface) {
+				continue;
+			}
+			SDL_Texture* pageTexture = SDL_CreateTextureFromSurface(mRenderer, pageSurface);
+			if (!pageTexture) {
+				spdlog::error("{} 创建图集页纹理失败: {}", mLogTag.data(), SDL_GetError());
+				continue;
+			}
+			if (!SDL_SetTextureScaleMode(pageTexture, SDL_SCALEMODE_NEAREST)) {
+				spdlog::warn("{} 无法设置纹理缩放模式为最临近插值", mLogTag.data());
+			}
+			// 名称不会与文件路径冲突, 资源管理器用它跟踪图集页
+			std::string pageName = "<atlas>/page_" + std::to_string(mNextAtlasPage++);
+			AtlasPage& atlasPage = mAtlasPages[pageName];
+			atlasPage.mTexture.reset(pageTexture);
+			pageNames.push_back(std::move(pageName));
+
+			for (const auto& image : images) {
+				if (image.mPage != page || mTextures.contains(image.mPath)) {
+					continue;
+				}
+				TextureRegion region;
+				region.mTexture = pageTexture;
+				region.mRect = { static_cast<float>(image.mRect.x), static_cast<float>(image.mRect.y), static_cast<float>(image.mRect.w), static_cast<float>(image.mRect.h) };
+				region.mTextureSize = { static_cast<float>(pageSurface->w), static_cast<float>(pageSurface->h) };
+				region.mIsPacked = true;
+				if (mRegions.emplace(image.mPath, region).second) {
+					atlasPage.mPaths.push_back(image.mPath);
+					++packedCount;
+				}
+			}
+		}
+
+		spdlog::info("{} 将 {} 张图片打包进 {} 张图集页(共 {} 页)", mLogTag.data(), packedCount, pageNames.size(), mAtlasPages.size());
+		return packedCount;
 	}
 
 	void TextureManager::unloadTexture(std::string_view filePath) {
+		// 图集中的图片只移除区域记录, 图集页在引用它的范围全部释放后由资源管理器淘汰(或在clearTextures时释放)
+		auto regionIter = mRegions.find(std::string(filePath));
+		bool isPacked = regionIter != mRegions.end() && regionIter->second.mIsPacked;
+		if (regionIter != mRegions.end()) {
+			mRegions.erase(regionIter);
+		}
+
 		auto iter = mTextures.find(std::string(filePath));
 		if (iter != mTextures.end()) {
 			spdlog::debug("{} 卸载纹理: {}", mLogTag.data(), filePath.data());
 			mTextures.erase(iter);
 		}
-		else {
+		else if (!isPacked) {
 			spdlog::warn("{} 尝试卸载不存在的纹理: {}", mLogTag.data(), filePath.data());
 		}
 	}
 
+	SDL_Texture* TextureManager::releaseTexture(std::string_view filePath) {
+		auto iter = mTextures.find(std::string(filePath));
+		if (iter == mTextures.end()) {
+			auto pageIter = mAtlasPages.find(std::string(filePath));
+			if (pageIter == mAtlasPages.end()) {
+				return nullptr;
+			}
+			// 图集页中的图片之后按需单独加载
+			for (const auto& path : pageIter->second.mPaths) {
+				mRegions.erase(path);
+			}
+			SDL_Texture* texture = pageIter->second.mTexture.release();
+			mAtlasPages.erase(pageIter);
+			spdlog::debug("{} 移交图集页: {}", mLogTag.data(), filePath.data());
+			return texture;
+		}
+		mRegions.erase(iter->first);
+		SDL_Texture* texture = iter->second.release();
+		mTextures.erase(iter);
+		spdlog::debug("{} 移交纹理: {}", mLogTag.data(), filePath.data());
+		return texture;
+	}
+
+	std::size_t TextureManager::getTextureBytes(std::string_view filePath) const {
+		if (auto iter = mTextures.find(std::string(filePath)); iter != mTextures.end()) {
+			return estimateBytes(iter->second.get());
+		}
+		auto pageIter = mAtlasPages.find(std::string(filePath));
+		return pageIter != mAtlasPages.end() ? estimateBytes(pageIter->second.mTexture.get()) : 0;
+	}
+
+	std::size_t TextureManager::estimateBytes(const SDL_Texture* texture) {
+		if (!texture) {
+			return 0;
+		}
+		return static_cast<std::size_t>(SDL_BYTESPERPIXEL(texture->format)) * static_cast<std::size_t>(texture->w) * static_cast<std::size_t>(texture->h);
+	}
+
+	void TextureManager::setAssetPack(const AssetPack* assetPack) {
+		mAssetPack = assetPack;
+	}
+
 	void TextureManager::clearTextures() {
+		mRegions.clear();
 		if (!mTextures.empty()) {
 			spdlog::debug("{} 正在清除所有{}个纹理", mLogTag.data(), mTextures.size());
 			mTextures.clear();
 		}
+		if (!mAtlasPages.empty()) {
+			spdlog::debug("{} 正在清除所有{}张图集页", mLogTag.data(), mAtlasPages.size());
+			mAtlasPages.clear();
+		}
 	}
 
 } // namespace engine::resource
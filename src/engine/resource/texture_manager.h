@@ -11,21 +11,28 @@
 #ifndef TEXTURE_MANAGER_H
 #define TEXTURE_MANAGER_H
 
+#include <cstddef>
 #include <memory>
 #include <stdexcept>
 #include <string>
 #include <string_view>
 #include <unordered_map>
+#include <vector>
 #include <SDL3/SDL_render.h>
 #include <glm/glm.hpp>
+#include "texture_region.h"
 
 namespace engine::resource {
+	class AssetPack;
 
 	/**
 	 * @brief 管理SDL_Texture资源加载,存储和检索.
 	 *
 	 * 在构造时初始化。使用文件路径作为键，确保纹理只加载一次并正确释放。
 	 * 依赖于一个有效的 SDL_Renderer，构造失败会抛出异常。
+	 * 
+	 * 可以把一组图片打包进共享的图集页(天际线装箱), 之后这些图片通过TextureRegion返回图集页和所在区域,
+	 * 同一图集页上的精灵绘制时不需要切换纹理. 每个图集页有一个名称, 资源管理器把它当作独立纹理跟踪和淘汰.
 	 */
 	class TextureManager final {
 		friend class ResourceManager;
@@ -39,6 +46,32 @@ namespace engine::resource {
 			}
 		};
 
+		/**
+		 * @brief 图集页及其中的图片.
+		 */
+		struct AtlasPage {
+			std::unique_ptr<SDL_Texture, SDLTextureDeleter> mTexture;								///< @brief 图集页纹理
+			std::vector<std::string> mPaths;														///< @brief 打包进该页的图片路径
+		};
+
+		// SDL_Surface的删除器函数对象
+		struct SDLSurfaceDeleter {
+			void operator()(SDL_Surface* surface) const {
+				SDL_DestroySurface(surface);
+			}
+		};
+
+		/**
+		 * @brief 待打包的图片: 已解码为RGBA32的表面和装箱后所在的图集页及区域.
+		 */
+		struct AtlasImage {
+			std::string mPath;																		///< @brief 图片路径
+			std::unique_ptr<SDL_Surface, SDLSurfaceDeleter> mSurface;								///< @brief 解码后的表面, 解码失败时为空
+			SDL_Rect mRect = { 0, 0, 0, 0 };														///< @brief 在图集页中的区域
+			std::size_t mPage = 0;																	///< @brief 所在图集页的序号(layoutAtlasPages返回的数组下标)
+		};
+		using AtlasPageSurface = std::unique_ptr<SDL_Surface, SDLSurfaceDeleter>;					///< @brief 拼接好的图集页表面
+
 	public:
 		/**
 		 * @brief 构造函数.
@@ -54,15 +87,53 @@ namespace engine::resource {
 
 	private:
 		SDL_Texture* loadTexture(std::string_view filePath);										///< @brief 载入纹理资源
+		SDL_Texture* addTexture(std::string_view filePath, SDL_Surface* surface);					///< @brief 用已解码的表面创建并缓存纹理(异步加载的上传步骤), 已加载时返回已有纹理
 		SDL_Texture* getTexture(std::string_view filePath);											///< @brief 尝试获取已加载的纹理
-		glm::vec2 getTextureSize(std::string_view filePath);										///< @brief 卸载指定的纹理资源
-		void unloadTexture(std::string_view filePath);												///< @brief 获取指定的纹理尺寸
-		void clearTextures();																		///< @brief 清空所有的纹理资源
+		SDL_Texture* findTexture(std::string_view filePath) const;									///< @brief 只查询缓存, 未加载时返回nullptr而不尝试加载
+		SDL_Texture* findAtlasPage(std::string_view pageName) const;								///< @brief 按名称查询图集页纹理, 不存在时返回nullptr
+		glm::vec2 getTextureSize(std::string_view filePath);										///< @brief 获取指定的纹理尺寸
+		void unloadTexture(std::string_view filePath);												///< @brief 卸载指定的纹理资源
+		void clearTextures();																		///< @brief 清空所有的纹理资源(包括图集页)
+		SDL_Texture* releaseTexture(std::string_view filePath);										///< @brief 从缓存中移除独立纹理或图集页(连同其中图片的区域)并交出所有权(用于延迟销毁), 不存在时返回nullptr
+		std::size_t getTextureBytes(std::string_view filePath) const;								///< @brief 独立纹理或图集页的显存估算(字节), 图集中的图片和未加载时返回0
+		static std::size_t estimateBytes(const SDL_Texture* texture);								///< @brief 纹理的显存估算: 每像素字节数 * 宽 * 高
+		void setAssetPack(const AssetPack* assetPack);												///< @brief 设置资源包, 为空时从散装文件加载
+
+		TextureRegion getTextureRegion(std::string_view filePath);									///< @brief 获取图片所在的纹理和区域, 未加载时尝试加载
+		const TextureRegion* findTextureRegion(std::string_view filePath) const;					///< @brief 只查询缓存, 未加载时返回nullptr而不尝试加载
+
+		/**
+		 * @brief 把已解码的图片装箱并拼接成图集页表面, 只做内存拷贝, 不需要渲染器.
+		 * 
+		 * 解码失败和超过图集页尺寸的图片会从images中移除, 之后按需单独加载.
+		 * 
+		 * @param images 待打包的图片, 返回时记录所在的图集页和区域
+		 * @return 图集页表面, 创建失败的页为空
+		 */
+		static std::vector<AtlasPageSurface> layoutAtlasPages(std::vector<AtlasImage>& images);
+
+		/**
+		 * @brief 把图集页表面上传为纹理并登记其中图片的区域(需要在渲染线程上调用).
+		 * 
+		 * 等待解码期间已经单独加载的图片保留原来的纹理, 不计入打包数量.
+		 * 
+		 * @param images layoutAtlasPages处理过的图片
+		 * @param pageSurfaces layoutAtlasPages返回的图集页表面
+		 * @param pageNames 输出新建图集页的名称(可以作为releaseTexture和getTextureBytes的路径)
+		 * @return 打包进图集的图片数量
+		 */
+		int addAtlasPages(const std::vector<AtlasImage>& images, const std::vector<AtlasPageSurface>& pageSurfaces, std::vector<std::string>& pageNames);
 
 	private:
 		static constexpr std::string_view mLogTag = "TextureManager";
 		std::unordered_map<std::string, std::unique_ptr<SDL_Texture, SDLTextureDeleter>> mTextures;	///< @brief 存储文件路径和指向管理纹理的unique_ptr的映射
+		std::unordered_map<std::string, TextureRegion> mRegions;									///< @brief 文件路径 -> 所在纹理和区域(独立纹理和图集中的图片都会记录)
+		std::unordered_map<std::string, AtlasPage> mAtlasPages;										///< @brief 图集页名称 -> 图集页
+		int mNextAtlasPage = 0;																		///< @brief 下一个图集页的编号(用于生成名称)
+		static constexpr int mAtlasPageSize = 2048;													///< @brief 图集页的边长(像素)
+		static constexpr int mAtlasPadding = 2;														///< @brief 图集中图片之间的间隔(像素), 避免采样到相邻图片
 		SDL_Renderer* mRenderer = nullptr;															///< @brief 指向主渲染器的非拥有指针
+		const AssetPack* mAssetPack = nullptr;														///< @brief 资源包(非拥有), 包中没有的文件从磁盘加载
 	}; // class TextureManager
 
 } // namespace engine::resource
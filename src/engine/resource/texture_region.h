@@ -0,0 +1,33 @@
+/*****************************************************************//**
+ * @file   texture_region.h
+ * @brief  纹理区域
+ * @version 1.0
+ *
+ * @author Shallowshades
+ * @date   2026.10.18
+ *********************************************************************/
+
+#pragma once
+#ifndef TEXTURE_REGION_H
+#define TEXTURE_REGION_H
+
+#include <SDL3/SDL_rect.h>
+
+struct SDL_Texture;
+
+namespace engine::resource {
+/**
+ * @brief 一张图片在实际纹理中的位置.
+ *
+ * 单独加载的图片占据整张纹理; 打包进图集页的图片只占据图集页中的一块区域,
+ * 绘制时精灵的源矩形需要加上区域的左上角偏移.
+ */
+struct TextureRegion {
+	SDL_Texture* mTexture = nullptr;										///< @brief 实际的纹理(独立纹理或图集页)
+	SDL_FRect mRect = { 0.f, 0.f, 0.f, 0.f };								///< @brief 图片在纹理中的区域
+	SDL_FPoint mTextureSize = { 0.f, 0.f };									///< @brief 实际纹理的尺寸, 用于把区域换算为纹理坐标(批量绘制)
+	bool mIsPacked = false;													///< @brief 是否位于图集页中
+};
+} // namespace engine::resource
+
+#endif // !TEXTURE_REGION_H
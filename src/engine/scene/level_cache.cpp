@@ -0,0 +1,80 @@
+#include "level_cache.h"
+#include "level_data.h"
+#include <spdlog/spdlog.h>
+
+namespace engine::scene {
+LevelCache::~LevelCache() {
+	spdlog::trace("{} 析构成功, 缓存了 {} 个关卡, {} 个瓦片集", mLogTag.data(), mLevels.size(), mTilesets.size());
+}
+
+std::shared_ptr<const LevelData> LevelCache::findLevel(std::string_view mapPath) {
+	auto iter = mLevels.find(std::string(mapPath));
+	if (iter == mLevels.end()) {
+		return nullptr;
+	}
+	if (!isUpToDate(iter->second.mDependencies)) {
+		spdlog::info("{} : 关卡 '{}' 的文件已修改, 重新加载", mLogTag.data(), mapPath);
+		mLevels.erase(iter);
+		return nullptr;
+	}
+	return iter->second.mData;
+}
+
+void LevelCache::addLevel(std::string_view mapPath, std::shared_ptr<const LevelData> level) {
+	Entry<LevelData> entry;
+	for (const auto& source : level->mSourceFiles) {
+		entry.mDependencies.push_back(makeDependency(source));
+	}
+	// 之后生成或更新了预处理文件同样需要重新加载
+	entry.mDependencies.push_back(makeDependency(getCookedLevelPath(mapPath)));
+	entry.mData = std::move(level);
+	mLevels.insert_or_assign(std::string(mapPath), std::move(entry));
+}
+
+std::shared_ptr<const LevelTileset> LevelCache::findTileset(std::string_view tilesetPath, glm::ivec2 tileSize) {
+	auto iter = mTilesets.find(std::string(tilesetPath));
+	if (iter == mTilesets.end() || iter->second.mData->mTileSize != tileSize) {
+		return nullptr;
+	}
+	if (!isUpToDate(iter->second.mDependencies)) {
+		spdlog::info("{} : 瓦片集 '{}' 已修改, 重新解析", mLogTag.data(), tilesetPath);
+		mTilesets.erase(iter);
+		return nullptr;
+	}
+	return iter->second.mData;
+}
+
+void LevelCache::addTileset(std::string_view tilesetPath, std::shared_ptr<const LevelTileset> tileset) {
+	Entry<LevelTileset> entry;
+	entry.mDependencies.push_back(makeDependency(tilesetPath));
+	entry.mData = std::move(tileset);
+	mTilesets.insert_or_assign(std::string(tilesetPath), std::move(entry));
+}
+
+void LevelCache::clear() {
+	mLevels.clear();
+	mTilesets.clear();
+}
+
+std::optional<std::filesystem::file_time_type> LevelCache::getWriteTime(std::string_view filePath) {
+	std::error_code error;
+	auto writeTime = std::filesystem::last_write_time(std::filesystem::path(filePath), error);
+	if (error) {
+		return std::nullopt;
+	}
+	return writeTime;
+}
+
+LevelCache::Dependency LevelCache::makeDependency(std::string_view filePath) {
+	return Dependency{ std::string(filePath), getWriteTime(filePath) };
+}
+
+bool LevelCache::isUpToDate(const std::vector<Dependency>& dependencies) {
+	for (const auto& dependency : dependencies) {
+		if (getWriteTime(dependency.mPath) != dependency.mWriteTime) {
+			return false;
+		}
+	}
+	return true;
+}
+} // namespace engine::scene
@@ -0,0 +1,98 @@
+/*****************************************************************//**
+ * @file   level_cache.h
+ * @brief  进程内的关卡和瓦片集缓存
+ * @version 1.0
+ *
+ * @author Shallowshades
+ * @date   2026.10.18
+ *********************************************************************/
+
+#pragma once
+#ifndef LEVEL_CACHE_H
+#define LEVEL_CACHE_H
+
+#include <filesystem>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include <glm/vec2.hpp>
+
+namespace engine::scene {
+struct LevelData;
+struct LevelTileset;
+
+/**
+ * @brief 缓存解析好的瓦片集和关卡数据, 由SceneManager持有, 所有LevelLoader共享.
+ *
+ * 重新开始, 切换关卡或回到标题时只需要根据缓存的数据重建游戏对象, 不再读取和解析文件.
+ * 每个条目记录它依赖的文件及其修改时间, 查找时任一文件被修改(或出现, 消失)即视为过期并重新加载.
+ * 只在游戏线程上使用.
+ */
+class LevelCache final {
+public:
+	LevelCache() = default;
+	~LevelCache();															///< @brief 析构函数
+
+	// 禁用拷贝和移动语义
+	LevelCache(const LevelCache&) = delete;									///< @brief 删除拷贝构造
+	LevelCache& operator=(const LevelCache&) = delete;						///< @brief 删除拷贝赋值构造
+	LevelCache(LevelCache&&) = delete;										///< @brief 删除移动构造
+	LevelCache& operator=(LevelCache&&) = delete;							///< @brief 删除移动赋值构造
+
+	/**
+	 * @brief 查找关卡数据.
+	 * @param mapPath 地图路径
+	 * @return 缓存的关卡数据, 不存在或已过期时返回nullptr
+	 */
+	std::shared_ptr<const LevelData> findLevel(std::string_view mapPath);
+
+	/**
+	 * @brief 缓存关卡数据. 依赖的文件为关卡的源文件(地图和瓦片集)以及地图的预处理文件.
+	 */
+	void addLevel(std::string_view mapPath, std::shared_ptr<const LevelData> level);
+
+	/**
+	 * @brief 查找瓦片集.
+	 * @param tilesetPath 瓦片集路径
+	 * @param tileSize 地图的瓦片尺寸, 与解析时使用的尺寸不同时视为未命中
+	 * @return 缓存的瓦片集, 不存在或已过期时返回nullptr
+	 */
+	std::shared_ptr<const LevelTileset> findTileset(std::string_view tilesetPath, glm::ivec2 tileSize);
+
+	/**
+	 * @brief 缓存瓦片集. 依赖的文件为瓦片集文件本身.
+	 */
+	void addTileset(std::string_view tilesetPath, std::shared_ptr<const LevelTileset> tileset);
+
+	void clear();															///< @brief 清空缓存
+
+private:
+	/**
+	 * @brief 依赖的文件及其修改时间, 文件不存在(如只在资源包中)时为空.
+	 */
+	struct Dependency {
+		std::string mPath;
+		std::optional<std::filesystem::file_time_type> mWriteTime;
+	};
+
+	template<typename T>
+	struct Entry {
+		std::shared_ptr<const T> mData;
+		std::vector<Dependency> mDependencies;
+	};
+
+	static std::optional<std::filesystem::file_time_type> getWriteTime(std::string_view filePath);		///< @brief 获取文件修改时间, 不存在时返回空
+	static Dependency makeDependency(std::string_view filePath);										///< @brief 记录文件当前的修改时间
+	static bool isUpToDate(const std::vector<Dependency>& dependencies);								///< @brief 依赖的文件是否都未改变
+
+private:
+	static constexpr std::string_view mLogTag = "LevelCache";
+	std::unordered_map<std::string, Entry<LevelData>> mLevels;				///< @brief 地图路径 -> 关卡数据
+	std::unordered_map<std::string, Entry<LevelTileset>> mTilesets;			///< @brief 瓦片集路径 -> 瓦片集
+};
+} // namespace engine::scene
+
+#endif // !LEVEL_CACHE_H
@@ -0,0 +1,563 @@
+#include "level_data.h"
+#include <spdlog/spdlog.h>
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <type_traits>
+#include <unordered_map>
+
+namespace engine::scene {
+namespace {
+constexpr std::string_view mLogTag = "LevelData";
+
+/**
+ * @brief 预处理文件头.
+ *
+ * 文件布局: [CookedHeader][图层数据: gid数组或对象记录][CookedTile * mTileCount][CookedAnimation * mAnimationCount]
+ *          [帧的列 * mFrameCount][CookedSound * mSoundCount][CookedLayer * mLayerCount]
+ *          [源文件的字符串下标 * mSourceCount][CookedString * mStringCount][字符串数据]
+ * 各段按8字节对齐, 所有整数按小端存储. 字符串下标0固定为空字符串.
+ */
+struct CookedHeader {
+	static constexpr std::array<char, 4> mMagicValue = { 'S', 'L', 'V', 'L' };
+	static constexpr std::uint32_t mCurrentVersion = 2;
+
+	std::array<char, 4> mMagic = mMagicValue;				///< @brief 文件标识
+	std::uint32_t mVersion = mCurrentVersion;				///< @brief 格式版本
+	std::int32_t mMapWidth = 0;								///< @brief 地图宽度(瓦片数量)
+	std::int32_t mMapHeight = 0;							///< @brief 地图高度(瓦片数量)
+	std::int32_t mTileWidth = 0;							///< @brief 瓦片宽度(像素)
+	std::int32_t mTileHeight = 0;							///< @brief 瓦片高度(像素)
+	std::uint32_t mTileCount = 0;							///< @brief 瓦片表长度(最大全局id + 1)
+	std::uint32_t mLayerCount = 0;							///< @brief 图层数量
+	std::uint32_t mStringCount = 0;							///< @brief 字符串数量
+	std::uint32_t mSourceCount = 0;							///< @brief 源文件数量
+	std::uint32_t mAnimationCount = 0;						///< @brief 动画片段数量
+	std::uint32_t mFrameCount = 0;							///< @brief 动画帧数量
+	std::uint32_t mSoundCount = 0;							///< @brief 音效数量
+	std::uint32_t mReserved = 0;							///< @brief 保留
+	std::uint64_t mTileOffset = 0;							///< @brief 瓦片表偏移
+	std::uint64_t mLayerOffset = 0;							///< @brief 图层表偏移
+	std::uint64_t mSourceOffset = 0;						///< @brief 源文件表偏移
+	std::uint64_t mStringOffset = 0;						///< @brief 字符串表偏移
+	std::uint64_t mAnimationOffset = 0;						///< @brief 动画片段表偏移
+	std::uint64_t mFrameOffset = 0;							///< @brief 动画帧表偏移
+	std::uint64_t mSoundOffset = 0;							///< @brief 音效表偏移
+};
+
+/**
+ * @brief 字符串表条目.
+ */
+struct CookedString {
+	std::uint64_t mOffset = 0;								///< @brief 字符串数据在文件中的偏移
+	std::uint64_t mSize = 0;								///< @brief 字符串长度(字节)
+};
+
+/**
+ * @brief 瓦片记录, 字符串字段为字符串表下标, 动画片段和音效为各自表中的一段.
+ */
+struct CookedTile {
+	enum Flags : std::uint8_t {
+		HasTileData = 1 << 0,
+		HasCollider = 1 << 1,
+		HasGravity = 1 << 2,
+		Gravity = 1 << 3,
+		HasHealth = 1 << 4,
+	};
+
+	std::uint32_t mTexture = 0;								///< @brief 纹理路径
+	std::uint32_t mTag = 0;									///< @brief 标签
+	std::uint32_t mFirstAnimation = 0;						///< @brief 第一个动画片段在片段表中的下标
+	std::uint32_t mAnimationCount = 0;						///< @brief 动画片段数量
+	std::uint32_t mFirstSound = 0;							///< @brief 第一个音效在音效表中的下标
+	std::uint32_t mSoundCount = 0;							///< @brief 音效数量
+	std::array<float, 4> mSourceRect = {};					///< @brief 源矩形 x, y, w, h
+	std::array<float, 4> mColliderRect = {};				///< @brief 碰撞盒 x, y, w, h
+	std::int32_t mHealth = 0;								///< @brief 生命值
+	std::uint8_t mType = 0;									///< @brief TileType
+	std::uint8_t mFlags = 0;								///< @brief Flags
+	std::uint16_t mReserved = 0;							///< @brief 保留
+};
+
+/**
+ * @brief 动画片段记录, 帧为帧表中的一段.
+ */
+struct CookedAnimation {
+	std::uint32_t mName = 0;								///< @brief 片段名称
+	std::int32_t mDurationMs = 0;							///< @brief 每帧持续时间(毫秒)
+	std::int32_t mRow = 0;									///< @brief 帧所在的行
+	std::uint32_t mFirstFrame = 0;							///< @brief 第一帧在帧表中的下标
+	std::uint32_t mFrameCount = 0;							///< @brief 帧数量
+};
+
+/**
+ * @brief 音效记录.
+ */
+struct CookedSound {
+	std::uint32_t mId = 0;									///< @brief 音效ID
+	std::uint32_t mPath = 0;								///< @brief 音效路径
+};
+
+/**
+ * @brief 图层记录. 瓦片图层的数据为uint16 gid数组, 对象图层的数据为CookedObject数组.
+ */
+struct CookedLayer {
+	enum Flags : std::uint8_t {
+		RepeatX = 1 << 0,
+		RepeatY = 1 << 1,
+	};
+
+	std::uint64_t mDataOffset = 0;							///< @brief 图层数据偏移
+	std::uint32_t mDataCount = 0;							///< @brief 图层数据元素个数
+	std::uint32_t mName = 0;								///< @brief 图层名称
+	std::uint32_t mImage = 0;								///< @brief 图片路径
+	std::array<float, 2> mOffset = {};						///< @brief 偏移量
+	std::array<float, 2> mScrollFactor = {};				///< @brief 视差因子
+	std::uint8_t mType = 0;									///< @brief LevelLayerType
+	std::uint8_t mFlags = 0;								///< @brief Flags
+	std::uint16_t mReserved = 0;							///< @brief 保留
+};
+
+/**
+ * @brief 对象记录.
+ */
+struct CookedObject {
+	enum Flags : std::uint8_t {
+		IsTrigger = 1 << 0,
+	};
+
+	std::uint32_t mName = 0;								///< @brief 对象名称
+	std::uint32_t mGid = 0;									///< @brief 瓦片全局id
+	std::uint32_t mTag = 0;									///< @brief 标签
+	std::array<float, 2> mPosition = {};					///< @brief 位置
+	std::array<float, 2> mSize = {};						///< @brief 尺寸
+	float mRotation = 0.f;									///< @brief 旋转角度
+	std::uint8_t mFlags = 0;								///< @brief Flags
+	std::array<std::uint8_t, 3> mReserved = {};				///< @brief 保留
+};
+
+static_assert(sizeof(CookedHeader) == 112, "CookedHeader 的布局必须与预处理文件一致");
+static_assert(sizeof(CookedString) == 16, "CookedString 的布局必须与预处理文件一致");
+static_assert(sizeof(CookedTile) == 64, "CookedTile 的布局必须与预处理文件一致");
+static_assert(sizeof(CookedAnimation) == 20, "CookedAnimation 的布局必须与预处理文件一致");
+static_assert(sizeof(CookedSound) == 8, "CookedSound 的布局必须与预处理文件一致");
+static_assert(sizeof(CookedLayer) == 40, "CookedLayer 的布局必须与预处理文件一致");
+static_assert(sizeof(CookedObject) == 36, "CookedObject 的布局必须与预处理文件一致");
+
+constexpr std::size_t mSectionAlignment = 8;
+
+/**
+ * @brief 按边界检查读取预处理文件中的记录和字符串.
+ */
+class CookedReader {
+public:
+	explicit CookedReader(std::span<const std::byte> bytes) : mBytes(bytes) {}
+
+	/**
+	 * @brief 拷贝从offset开始的count个记录, 越界时返回false. 使用memcpy, 不要求数据对齐.
+	 */
+	template<typename T>
+	bool read(std::uint64_t offset, std::uint64_t count, std::vector<T>& out) const {
+		static_assert(std::is_trivially_copyable_v<T>);
+		if (offset > mBytes.size() || count > (mBytes.size() - offset) / sizeof(T)) {
+			return false;
+		}
+		mEnd = std::max(mEnd, offset + count * sizeof(T));
+		out.resize(static_cast<std::size_t>(count));
+		if (count > 0) {
+			std::memcpy(out.data(), mBytes.data() + offset, static_cast<std::size_t>(count) * sizeof(T));
+		}
+		return true;
+	}
+
+	bool readStrings(const CookedHeader& header) {
+		std::vector<CookedString> entries;
+		if (header.mStringCount == 0 || !read(header.mStringOffset, header.mStringCount, entries)) {
+			return false;
+		}
+		mStrings.reserve(entries.size());
+		for (const auto& entry : entries) {
+			if (entry.mOffset > mBytes.size() || entry.mSize > mBytes.size() - entry.mOffset) {
+				return false;
+			}
+			mEnd = std::max(mEnd, entry.mOffset + entry.mSize);
+			mStrings.emplace_back(reinterpret_cast<const char*>(mBytes.data() + entry.mOffset), static_cast<std::size_t>(entry.mSize));
+		}
+		return true;
+	}
+
+	bool getString(std::uint32_t index, std::string& out) const {
+		if (index >= mStrings.size()) {
+			return false;
+		}
+		out.assign(mStrings[index]);
+		return true;
+	}
+
+	/**
+	 * @brief 检查[first, first + count)是否在长度为size的表内.
+	 */
+	static bool isRangeValid(std::uint32_t first, std::uint32_t count, std::size_t size) {
+		return static_cast<std::uint64_t>(first) + count <= size;
+	}
+
+	/**
+	 * @brief 已读取的数据末尾(所有记录和字符串结束位置的最大值). 完整的文件以字符串数据结束, 应等于文件大小.
+	 */
+	std::uint64_t getEnd() const {
+		return mEnd;
+	}
+
+private:
+	std::span<const std::byte> mBytes;
+	std::vector<std::string_view> mStrings;
+	mutable std::uint64_t mEnd = sizeof(CookedHeader);
+};
+
+/**
+ * @brief 写入预处理文件: 先在内存中组装, 再一次写出.
+ */
+class CookedWriter {
+public:
+	CookedWriter() {
+		intern("");
+	}
+
+	std::uint32_t intern(const std::string& value) {
+		auto [iter, isInserted] = mStringIndices.emplace(value, static_cast<std::uint32_t>(mStrings.size()));
+		if (isInserted) {
+			mStrings.push_back(value);
+		}
+		return iter->second;
+	}
+
+	std::uint64_t append(const void* data, std::size_t size) {
+		std::uint64_t offset = mBuffer.size();
+		const std::byte* begin = static_cast<const std::byte*>(data);
+		mBuffer.insert(mBuffer.end(), begin, begin + size);
+		return offset;
+	}
+
+	void align() {
+		mBuffer.resize((mBuffer.size() + mSectionAlignment - 1) / mSectionAlignment * mSectionAlignment);
+	}
+
+	std::uint64_t size() const {
+		return mBuffer.size();
+	}
+
+	void writeStrings(CookedHeader& header) {
+		align();
+		header.mStringCount = static_cast<std::uint32_t>(mStrings.size());
+		header.mStringOffset = size();
+		std::uint64_t dataOffset = header.mStringOffset + mStrings.size() * sizeof(CookedString);
+		for (const auto& value : mStrings) {
+			CookedString entry{ dataOffset, value.size() };
+			append(&entry, sizeof(entry));
+			dataOffset += value.size();
+		}
+		for (const auto& value : mStrings) {
+			append(value.data(), value.size());
+		}
+	}
+
+	void patch(std::uint64_t offset, const void* data, std::size_t size) {
+		std::memcpy(mBuffer.data() + offset, data, size);
+	}
+
+	const std::vector<std::byte>& getBuffer() const {
+		return mBuffer;
+	}
+
+private:
+	std::vector<std::byte> mBuffer;
+	std::vector<std::string> mStrings;
+	std::unordered_map<std::string, std::uint32_t> mStringIndices;
+};
+} // namespace
+
+const LevelTile& LevelData::getTile(std::uint32_t gid) const {
+	static const LevelTile empty;
+	return gid < mTiles.size() ? mTiles[gid] : empty;
+}
+
+std::string getCookedLevelPath(std::string_view mapPath) {
+	return std::filesystem::path(mapPath).replace_extension(".lvl").generic_string();
+}
+
+bool readCookedLevel(std::span<const std::byte> bytes, std::string_view mapPath, LevelData& level) {
+	CookedHeader header;
+	if (bytes.size() < sizeof(CookedHeader)) {
+		spdlog::error("{} : 预处理关卡 '{}' 的文件头不完整", mLogTag.data(), mapPath);
+		return false;
+	}
+	std::memcpy(&header, bytes.data(), sizeof(CookedHeader));
+	if (header.mMagic != CookedHeader::mMagicValue) {
+		spdlog::error("{} : '{}' 不是有效的预处理关卡", mLogTag.data(), mapPath);
+		return false;
+	}
+	if (header.mVersion != CookedHeader::mCurrentVersion) {
+		spdlog::warn("{} : 预处理关卡 '{}' 的版本不匹配 ({}), 需要重新生成", mLogTag.data(), mapPath, header.mVersion);
+		return false;
+	}
+	if (header.mMapWidth < 0 || header.mMapHeight < 0) {
+		spdlog::error("{} : 预处理关卡 '{}' 的地图尺寸无效", mLogTag.data(), mapPath);
+		return false;
+	}
+	const auto tileCount = static_cast<std::uint64_t>(header.mMapWidth) * static_cast<std::uint64_t>(header.mMapHeight);
+
+	CookedReader reader(bytes);
+	std::vector<CookedTile> tiles;
+	std::vector<CookedAnimation> animations;
+	std::vector<std::int32_t> frames;
+	std::vector<CookedSound> sounds;
+	std::vector<CookedLayer> layers;
+	std::vector<std::uint32_t> sources;
+	if (!reader.readStrings(header)
+		|| !reader.read(header.mTileOffset, header.mTileCount, tiles)
+		|| !reader.read(header.mAnimationOffset, header.mAnimationCount, animations)
+		|| !reader.read(header.mFrameOffset, header.mFrameCount, frames)
+		|| !reader.read(header.mSoundOffset, header.mSoundCount, sounds)
+		|| !reader.read(header.mLayerOffset, header.mLayerCount, layers)
+		|| !reader.read(header.mSourceOffset, header.mSourceCount, sources)) {
+		spdlog::error("{} : 预处理关卡 '{}' 的数据越界", mLogTag.data(), mapPath);
+		return false;
+	}
+
+	LevelData result;
+	result.mMapPath = std::string(mapPath);
+	result.mMapSize = glm::ivec2(header.mMapWidth, header.mMapHeight);
+	result.mTileSize = glm::ivec2(header.mTileWidth, header.mTileHeight);
+	bool isValid = true;
+
+	result.mTiles.resize(tiles.size());
+	for (std::size_t i = 0; i < tiles.size() && isValid; ++i) {
+		const CookedTile& record = tiles[i];
+		LevelTile& tile = result.mTiles[i];
+		isValid = record.mType <= static_cast<std::uint8_t>(engine::component::TileType::LADDER)
+			&& reader.getString(record.mTexture, tile.mTextureId)
+			&& reader.getString(record.mTag, tile.mTag)
+			&& CookedReader::isRangeValid(record.mFirstAnimation, record.mAnimationCount, animations.size())
+			&& CookedReader::isRangeValid(record.mFirstSound, record.mSoundCount, sounds.size());
+		if (!isValid) {
+			break;
+		}
+		tile.mAnimations.resize(record.mAnimationCount);
+		for (std::uint32_t j = 0; j < record.mAnimationCount && isValid; ++j) {
+			const CookedAnimation& source = animations[record.mFirstAnimation + j];
+			LevelAnimation& animation = tile.mAnimations[j];
+			isValid = reader.getString(source.mName, animation.mName)
+				&& CookedReader::isRangeValid(source.mFirstFrame, source.mFrameCount, frames.size());
+			if (isValid) {
+				animation.mDurationMs = source.mDurationMs;
+				animation.mRow = source.mRow;
+				animation.mFrames.assign(frames.begin() + source.mFirstFrame, frames.begin() + source.mFirstFrame + source.mFrameCount);
+			}
+		}
+		tile.mSounds.resize(record.mSoundCount);
+		for (std::uint32_t j = 0; j < record.mSoundCount && isValid; ++j) {
+			const CookedSound& source = sounds[record.mFirstSound + j];
+			isValid = reader.getString(source.mId, tile.mSounds[j].mId) && reader.getString(source.mPath, tile.mSounds[j].mPath);
+		}
+		tile.mType = static_cast<engine::component::TileType>(record.mType);
+		tile.mSourceRect = engine::utils::Rect(glm::vec2(record.mSourceRect[0], record.mSourceRect[1]), glm::vec2(record.mSourceRect[2], record.mSourceRect[3]));
+		tile.mHasTileData = (record.mFlags & CookedTile::HasTileData) != 0;
+		if (record.mFlags & CookedTile::HasCollider) {
+			tile.mColliderRect = engine::utils::Rect(glm::vec2(record.mColliderRect[0], record.mColliderRect[1]), glm::vec2(record.mColliderRect[2], record.mColliderRect[3]));
+		}
+		if (record.mFlags & CookedTile::HasGravity) {
+			tile.mGravity = (record.mFlags & CookedTile::Gravity) != 0;
+		}
+		if (record.mFlags & CookedTile::HasHealth) {
+			tile.mHealth = record.mHealth;
+		}
+	}
+
+	result.mLayers.resize(layers.size());
+	for (std::size_t i = 0; i < layers.size() && isValid; ++i) {
+		const CookedLayer& record = layers[i];
+		LevelLayer& layer = result.mLayers[i];
+		isValid = record.mType <= static_cast<std::uint8_t>(LevelLayerType::Object)
+			&& reader.getString(record.mName, layer.mName)
+			&& reader.getString(record.mImage, layer.mImage);
+		layer.mType = static_cast<LevelLayerType>(record.mType);
+		layer.mOffset = glm::vec2(record.mOffset[0], record.mOffset[1]);
+		layer.mScrollFactor = glm::vec2(record.mScrollFactor[0], record.mScrollFactor[1]);
+		layer.mRepeat = glm::bvec2((record.mFlags & CookedLayer::RepeatX) != 0, (record.mFlags & CookedLayer::RepeatY) != 0);
+		if (!isValid) {
+			break;
+		}
+		if (layer.mType == LevelLayerType::Tile) {
+			// 截断或过期的文件中gid数量可能与地图尺寸不一致, 瓦片图层会变为空, 视为无效
+			isValid = record.mDataCount == tileCount && reader.read(record.mDataOffset, record.mDataCount, layer.mGids);
+			if (!isValid) {
+				spdlog::error("{} : 预处理关卡 '{}' 的图层 '{}' 有 {} 个瓦片, 地图需要 {} 个", mLogTag.data(), mapPath, layer.mName, record.mDataCount, tileCount);
+				return false;
+			}
+		}
+		else if (layer.mType == LevelLayerType::Object) {
+			std::vector<CookedObject> objects;
+			isValid = reader.read(record.mDataOffset, record.mDataCount, objects);
+			layer.mObjects.resize(objects.size());
+			for (std::size_t j = 0; j < objects.size() && isValid; ++j) {
+				const CookedObject& source = objects[j];
+				LevelObject& object = layer.mObjects[j];
+				isValid = reader.getString(source.mName, object.mName) && reader.getString(source.mTag, object.mTag);
+				object.mGid = source.mGid;
+				object.mPosition = glm::vec2(source.mPosition[0], source.mPosition[1]);
+				object.mSize = glm::vec2(source.mSize[0], source.mSize[1]);
+				object.mRotation = source.mRotation;
+				object.mIsTrigger = (source.mFlags & CookedObject::IsTrigger) != 0;
+			}
+		}
+	}
+
+	result.mSourceFiles.resize(sources.size());
+	for (std::size_t i = 0; i < sources.size() && isValid; ++i) {
+		isValid = reader.getString(sources[i], result.mSourceFiles[i]);
+	}
+
+	if (!isValid) {
+		spdlog::error("{} : 预处理关卡 '{}' 的记录无效", mLogTag.data(), mapPath);
+		return false;
+	}
+	// 文件以字符串数据结束, 末尾多出或缺少数据说明文件损坏或被截断
+	if (reader.getEnd() != bytes.size()) {
+		spdlog::error("{} : 预处理关卡 '{}' 的大小不符: 数据结束于 {} 字节, 文件有 {} 字节", mLogTag.data(), mapPath, reader.getEnd(), bytes.size());
+		return false;
+	}
+	level = std::move(result);
+	return true;
+}
+
+bool writeCookedLevel(const LevelData& level, std::string_view filePath) {
+	CookedWriter writer;
+	CookedHeader header;
+	header.mMapWidth = level.mMapSize.x;
+	header.mMapHeight = level.mMapSize.y;
+	header.mTileWidth = level.mTileSize.x;
+	header.mTileHeight = level.mTileSize.y;
+	writer.append(&header, sizeof(CookedHeader));
+
+	// 1. 图层数据
+	std::vector<CookedLayer> layers;
+	layers.reserve(level.mLayers.size());
+	for (const auto& layer : level.mLayers) {
+		CookedLayer record;
+		record.mType = static_cast<std::uint8_t>(layer.mType);
+		record.mName = writer.intern(layer.mName);
+		record.mImage = writer.intern(layer.mImage);
+		record.mOffset = { layer.mOffset.x, layer.mOffset.y };
+		record.mScrollFactor = { layer.mScrollFactor.x, layer.mScrollFactor.y };
+		record.mFlags = static_cast<std::uint8_t>((layer.mRepeat.x ? CookedLayer::RepeatX : 0) | (layer.mRepeat.y ? CookedLayer::RepeatY : 0));
+		writer.align();
+		if (layer.mType == LevelLayerType::Tile) {
+			record.mDataCount = static_cast<std::uint32_t>(layer.mGids.size());
+			record.mDataOffset = writer.append(layer.mGids.data(), layer.mGids.size() * sizeof(std::uint16_t));
+		}
+		else if (layer.mType == LevelLayerType::Object) {
+			record.mDataCount = static_cast<std::uint32_t>(layer.mObjects.size());
+			record.mDataOffset = writer.size();
+			for (const auto& object : layer.mObjects) {
+				CookedObject objectRecord;
+				objectRecord.mName = writer.intern(object.mName);
+				objectRecord.mGid = object.mGid;
+				objectRecord.mTag = writer.intern(object.mTag);
+				objectRecord.mPosition = { object.mPosition.x, object.mPosition.y };
+				objectRecord.mSize = { object.mSize.x, object.mSize.y };
+				objectRecord.mRotation = object.mRotation;
+				objectRecord.mFlags = object.mIsTrigger ? CookedObject::IsTrigger : 0;
+				writer.append(&objectRecord, sizeof(CookedObject));
+			}
+		}
+		layers.push_back(record);
+	}
+
+	// 2. 瓦片表, 动画片段和音效展开到各自的表中
+	std::vector<CookedAnimation> animations;
+	std::vector<std::int32_t> frames;
+	std::vector<CookedSound> sounds;
+	writer.align();
+	header.mTileCount = static_cast<std::uint32_t>(level.mTiles.size());
+	header.mTileOffset = writer.size();
+	for (const auto& tile : level.mTiles) {
+		CookedTile record;
+		record.mTexture = writer.intern(tile.mTextureId);
+		record.mTag = writer.intern(tile.mTag);
+		record.mFirstAnimation = static_cast<std::uint32_t>(animations.size());
+		record.mAnimationCount = static_cast<std::uint32_t>(tile.mAnimations.size());
+		for (const auto& animation : tile.mAnimations) {
+			CookedAnimation animationRecord;
+			animationRecord.mName = writer.intern(animation.mName);
+			animationRecord.mDurationMs = animation.mDurationMs;
+			animationRecord.mRow = animation.mRow;
+			animationRecord.mFirstFrame = static_cast<std::uint32_t>(frames.size());
+			animationRecord.mFrameCount = static_cast<std::uint32_t>(animation.mFrames.size());
+			frames.insert(frames.end(), animation.mFrames.begin(), animation.mFrames.end());
+			animations.push_back(animationRecord);
+		}
+		record.mFirstSound = static_cast<std::uint32_t>(sounds.size());
+		record.mSoundCount = static_cast<std::uint32_t>(tile.mSounds.size());
+		for (const auto& sound : tile.mSounds) {
+			sounds.push_back({ writer.intern(sound.mId), writer.intern(sound.mPath) });
+		}
+		record.mSourceRect = { tile.mSourceRect.position.x, tile.mSourceRect.position.y, tile.mSourceRect.size.x, tile.mSourceRect.size.y };
+		record.mType = static_cast<std::uint8_t>(tile.mType);
+		record.mFlags = tile.mHasTileData ? CookedTile::HasTileData : 0;
+		if (tile.mColliderRect) {
+			record.mColliderRect = { tile.mColliderRect->position.x, tile.mColliderRect->position.y, tile.mColliderRect->size.x, tile.mColliderRect->size.y };
+			record.mFlags |= CookedTile::HasCollider;
+		}
+		if (tile.mGravity) {
+			record.mFlags |= CookedTile::HasGravity | (tile.mGravity.value() ? CookedTile::Gravity : 0);
+		}
+		if (tile.mHealth) {
+			record.mHealth = tile.mHealth.value();
+			record.mFlags |= CookedTile::HasHealth;
+		}
+		writer.append(&record, sizeof(CookedTile));
+	}
+
+	writer.align();
+	header.mAnimationCount = static_cast<std::uint32_t>(animations.size());
+	header.mAnimationOffset = writer.append(animations.data(), animations.size() * sizeof(CookedAnimation));
+	writer.align();
+	header.mFrameCount = static_cast<std::uint32_t>(frames.size());
+	header.mFrameOffset = writer.append(frames.data(), frames.size() * sizeof(std::int32_t));
+	writer.align();
+	header.mSoundCount = static_cast<std::uint32_t>(sounds.size());
+	header.mSoundOffset = writer.append(sounds.data(), sounds.size() * sizeof(CookedSound));
+
+	// 3. 图层表
+	writer.align();
+	header.mLayerCount = static_cast<std::uint32_t>(layers.size());
+	header.mLayerOffset = writer.append(layers.data(), layers.size() * sizeof(CookedLayer));
+
+	// 4. 源文件表和字符串表
+	std::vector<std::uint32_t> sources;
+	for (const auto& source : level.mSourceFiles) {
+		sources.push_back(writer.intern(source));
+	}
+	writer.align();
+	header.mSourceCount = static_cast<std::uint32_t>(sources.size());
+	header.mSourceOffset = writer.append(sources.data(), sources.size() * sizeof(std::uint32_t));
+	writer.writeStrings(header);
+	writer.patch(0, &header, sizeof(CookedHeader));
+
+	std::ofstream output(std::filesystem::path(filePath), std::ios::binary | std::ios::trunc);
+	if (!output.is_open()) {
+		spdlog::error("{} : 无法创建预处理关卡文件: {}", mLogTag.data(), filePath);
+		return false;
+	}
+	const auto& buffer = writer.getBuffer();
+	output.write(reinterpret_cast<const char*>(buffer.data()), static_cast<std::streamsize>(buffer.size()));
+	output.close();
+	if (!output) {
+		spdlog::error("{} : 写入预处理关卡文件失败: {}", mLogTag.data(), filePath);
+		return false;
+	}
+	return true;
+}
+} // namespace engine::scene
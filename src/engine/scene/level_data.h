@@ -0,0 +1,155 @@
+/*****************************************************************//**
+ * @file   level_data.h
+ * @brief  关卡的中间表示及其预处理(cooked)二进制格式
+ * @version 1.0
+ *
+ * @author Shallowshades
+ * @date   2026.10.18
+ *********************************************************************/
+
+#pragma once
+#ifndef LEVEL_DATA_H
+#define LEVEL_DATA_H
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <glm/vec2.hpp>
+#include "../utils/math.h"
+#include "../component/tilelayer_component.h"
+
+namespace engine::scene {
+/**
+ * @brief 瓦片"animation"属性中的一个动画片段. 帧的源矩形在创建对象时按瓦片图片的尺寸计算.
+ */
+struct LevelAnimation {
+	std::string mName;														///< @brief 片段名称
+	int mDurationMs = 100;													///< @brief 每帧持续时间(毫秒)
+	int mRow = 0;															///< @brief 帧所在的行
+	std::vector<int> mFrames;												///< @brief 每一帧所在的列
+
+	bool operator==(const LevelAnimation&) const = default;
+};
+
+/**
+ * @brief 瓦片"sound"属性中的一个音效.
+ */
+struct LevelSound {
+	std::string mId;														///< @brief 音效ID
+	std::string mPath;														///< @brief 音效路径
+
+	bool operator==(const LevelSound&) const = default;
+};
+
+/**
+ * @brief 按全局id预先解析好的瓦片: 图片, 源矩形, 类型以及对象层用到的自定义属性.
+ */
+struct LevelTile {
+	std::string mTextureId;													///< @brief 纹理路径, 为空表示无效瓦片
+	engine::utils::Rect mSourceRect{};										///< @brief 纹理中的源矩形
+	engine::component::TileType mType = engine::component::TileType::EMPTY;	///< @brief 瓦片类型
+	bool mHasTileData = false;												///< @brief 瓦片集中是否有该瓦片的描述(对象层只接受有描述的瓦片)
+	std::optional<engine::utils::Rect> mColliderRect;						///< @brief 自定义碰撞盒(相对于图片)
+	std::string mTag;														///< @brief "tag"属性, 为空表示未设置
+	std::optional<bool> mGravity;											///< @brief "gravity"属性
+	std::optional<int> mHealth;												///< @brief "health"属性
+	std::vector<LevelAnimation> mAnimations;								///< @brief "animation"属性解析后的动画片段, 为空表示未设置
+	std::vector<LevelSound> mSounds;										///< @brief "sound"属性解析后的音效, 为空表示未设置
+};
+
+/**
+ * @brief 解析后的瓦片集, 与firstgid无关, 可以在引用它的地图之间共享.
+ */
+struct LevelTileset {
+	glm::ivec2 mTileSize{};													///< @brief 解析时使用的瓦片尺寸(单一图片的图块集按它切分源矩形)
+	std::vector<LevelTile> mTiles;											///< @brief 按图块集中的局部id索引的瓦片
+};
+
+/**
+ * @brief 对象层中的对象. 只记录矩形和瓦片对象, 其他形状在解析时跳过.
+ */
+struct LevelObject {
+	std::string mName;														///< @brief 对象名称
+	std::uint32_t mGid = 0;													///< @brief 瓦片全局id, 0表示自定义矩形
+	glm::vec2 mPosition{};													///< @brief 位置(Tiled坐标, 瓦片对象为左下角)
+	glm::vec2 mSize{};														///< @brief 尺寸
+	float mRotation = 0.f;													///< @brief 旋转角度
+	bool mIsTrigger = true;													///< @brief 自定义矩形是否为触发器
+	std::string mTag;														///< @brief 自定义矩形的"tag"属性, 为空表示未设置
+};
+
+/**
+ * @brief 图层类型.
+ */
+enum class LevelLayerType : std::uint8_t {
+	Image = 0,																///< @brief 图片图层
+	Tile = 1,																///< @brief 瓦片图层
+	Object = 2,																///< @brief 对象图层
+};
+
+/**
+ * @brief 可见图层, 按地图中的顺序排列.
+ */
+struct LevelLayer {
+	LevelLayerType mType = LevelLayerType::Tile;							///< @brief 图层类型
+	std::string mName;														///< @brief 图层名称
+	std::string mImage;														///< @brief 图片图层: 解析后的图片路径
+	glm::vec2 mOffset{};													///< @brief 图片图层: 偏移量
+	glm::vec2 mScrollFactor{ 1.f };											///< @brief 图片图层: 视差因子
+	glm::bvec2 mRepeat{ false };											///< @brief 图片图层: 是否重复
+	std::vector<std::uint16_t> mGids;										///< @brief 瓦片图层: 按行排列的全局id
+	std::vector<LevelObject> mObjects;										///< @brief 对象图层: 对象列表
+};
+
+/**
+ * @brief 关卡数据: Tiled地图和它引用的瓦片集解析后的结果, 与JSON无关.
+ *
+ * 由TiledMapParser从JSON生成, 或者从预处理的二进制文件直接读取.
+ */
+struct LevelData {
+	std::string mMapPath;													///< @brief 地图路径
+	glm::ivec2 mMapSize{};													///< @brief 地图尺寸(瓦片数量)
+	glm::ivec2 mTileSize{};													///< @brief 瓦片尺寸(像素)
+	std::vector<LevelTile> mTiles;											///< @brief 按全局id索引的瓦片表, 下标0为空瓦片
+	std::vector<LevelLayer> mLayers;										///< @brief 可见图层
+	std::vector<std::string> mSourceFiles;									///< @brief 生成数据的源文件(地图和瓦片集), 用于判断预处理文件是否过期
+
+	/**
+	 * @brief 根据全局id获取瓦片, 越界时返回空瓦片.
+	 */
+	const LevelTile& getTile(std::uint32_t gid) const;
+};
+
+/**
+ * @brief 获取地图对应的预处理文件路径(扩展名替换为.lvl), 例如 "assets/maps/level1.tmj" -> "assets/maps/level1.lvl".
+ */
+std::string getCookedLevelPath(std::string_view mapPath);
+
+/**
+ * @brief 从预处理的二进制数据读取关卡.
+ *
+ * 二进制数据通常来自映射的文件或资源包, 只校验边界并拷贝定长记录和gid数组, 不做文本解析
+ * (瓦片的动画和音效属性也已展开为定长记录).
+ *
+ * @param bytes 二进制数据
+ * @param mapPath 地图路径(记录在结果中)
+ * @param level 读取结果
+ * @return 是否成功(失败时已输出错误日志)
+ */
+bool readCookedLevel(std::span<const std::byte> bytes, std::string_view mapPath, LevelData& level);
+
+/**
+ * @brief 把关卡写入预处理的二进制文件.
+ *
+ * @param level 关卡数据
+ * @param filePath 输出路径
+ * @return 是否成功(失败时已输出错误日志)
+ */
+bool writeCookedLevel(const LevelData& level, std::string_view filePath);
+} // namespace engine::scene
+
+#endif // !LEVEL_DATA_H
@@ -11,25 +11,29 @@
 #ifndef LEVEL_LOADER_H
 #define LEVEL_LOADER_H
 
-#include <map>
+#include <memory>
 #include <string>
 #include <string_view>
-#include <optional>
+#include <vector>
 #include <glm/vec2.hpp>
-#include <nlohmann/json.hpp>
-#include "../utils/math.h"
+#include "level_data.h"
 
 namespace engine::component { 
-	struct TileInfo; 
-	enum class TileType;
 	class AnimationComponent;
 	class AudioComponent;
+	class TileLayerComponent;
 }
 
+namespace engine::resource { class ResourceManager; class AssetPack; }
+namespace engine::object { class GameObject; }
+
 namespace engine::scene {
 class Scene;
 /**
  * @brief 关卡载入器类.
+ *
+ * 优先使用场景管理器的关卡缓存, 其次读取地图对应的预处理文件(.lvl, 由level_cooker生成), 不存在或已过期时解析Tiled JSON,
+ * 然后根据LevelData创建游戏对象. 流式关卡(LevelStreamer)只用它读取数据和创建图片图层, 瓦片和对象按块创建.
  */
 class LevelLoader final {
 public:
@@ -44,122 +48,79 @@ public:
 	 */
 	[[nodiscard]] bool loadLevel(std::string_view mapPath, Scene& scene);
 
-private:
-	void loadImageLayer(const nlohmann::json& layerJson, Scene& scene);		///< @brief 加载图片图层
-	void loadTileLayer(const nlohmann::json& layerJson, Scene& scene);		///< @brief 加载瓦片图层
-	void loadObjectLayer(const nlohmann::json& layerJson, Scene& scene);	///< @brief 加载对象图层
-	
 	/**
-	 * @brief 添加动画到指定的AnimationComponent.
-	 * 
-	 * @param animationJson 动画Json数据(自定义)
-	 * @param ac 动画组件指针 (动画添加到此组件)
-	 * @param spriteSize 每一帧动画的尺寸
-	 */
-	void addAnimation(const nlohmann::json& animationJson, engine::component::AnimationComponent* ac, const glm::vec2& spriteSize);
-
-	/**
-	 * @brief 添加音效到指定的AudioComponent.
+	 * @brief 为流式关卡加载数据: 读取关卡数据, 打包和预加载资源, 按地图顺序创建图片图层和空的按块存储的瓦片图层, 不创建对象.
 	 *
-	 * @param soundJson 音效JSON
-	 * @param audioComponent 音频组件指针
-	 */
-	void addSound(const nlohmann::json& soundJson, engine::component::AudioComponent* audioComponent);
-
-	/**
-	 * @brief 获取瓦片属性.
-	 * 
-	 * @param tileJson 瓦片json数据
-	 * @param propertyName 属性名称
-	 * @return 属性值, 如果属性不存在则返回 std::nullopt
+	 * @param mapPath Tiled JSON地图文件的路径
+	 * @param scene 要加载数据的目标 Scene 对象
+	 * @param chunkSize 块的边长(瓦片数)
+	 * @param tileLayers 输出创建的瓦片图层组件, 与LevelData中的瓦片图层一一对应
+	 * @return bool 是否加载成功
 	 */
-	template<typename T>
-	std::optional<T> getTileProperty(const nlohmann::json& tileJson, std::string_view propertyName);
+	[[nodiscard]] bool loadLevelForStreaming(std::string_view mapPath, Scene& scene, int chunkSize, std::vector<engine::component::TileLayerComponent*>& tileLayers);
 
 	/**
-	 * @brief 获取瓦片碰撞器矩形.
-	 * @param tileJson 瓦片json数据
-	 * @return 碰撞器矩形, 如果碰撞器不存在则返回std::nullopt
+	 * @brief 根据对象层中的对象创建游戏对象(不加入场景).
+	 *
+	 * @param object 对象数据
+	 * @param scene 对象所属的场景(物理引擎, 动画系统, 资源)
+	 * @return 游戏对象, 数据无效时返回nullptr(已输出错误日志)
 	 */
-	std::optional<engine::utils::Rect> getColliderRect(const nlohmann::json& tileJson);
+	std::unique_ptr<engine::object::GameObject> createObject(const LevelObject& object, Scene& scene);
 
-	/**
-	 * @brief 根据瓦片json对象获取瓦片类型.
-	 * 
-	 * @param tileJson瓦片json数据
-	 * @return 瓦片类型
-	 */
-	engine::component::TileType getTileType(const nlohmann::json& tileJson);
+	static engine::component::TileInfo createTileInfo(const LevelTile& tile);	///< @brief 根据瓦片表中的瓦片创建瓦片信息
+	const std::shared_ptr<const LevelData>& getLevel() const;				///< @brief 获取已加载的关卡数据
 
+private:
 	/**
-	 * @brief 根据(单一图片)图块集中的id获取瓦片类型.
-	 * 
-	 * @param tilesetJson 图块集json数据
-	 * @param localId 图块集中的id
-	 * @return 瓦片类型
+	 * @brief 读取关卡数据(缓存, 预处理文件或JSON), 然后打包和预加载关卡引用的资源.
+	 *
+	 * @param mapPath 地图路径
+	 * @param scene 目标场景
+	 * @return 是否成功
 	 */
-	engine::component::TileType getTileTypeById(const nlohmann::json& tilesetJson, int localId);
+	bool loadLevelData(std::string_view mapPath, Scene& scene);
 
 	/**
-	 * @brief 根据全局Id, 获取瓦片信息.
-	 * 
-	 * @param gid 全局id
-	 * @return engine::component::TileInfo 瓦片信息
+	 * @brief 读取地图的预处理文件: 资源包中存在(启用散装文件检查时还要求散装文件不比它新)时使用资源包, 否则映射散装文件; 源文件比预处理文件(或资源包)新时视为过期.
+	 *
+	 * @param mapPath 地图路径
+	 * @param level 读取结果
+	 * @return 是否成功, 失败时回退到解析JSON
 	 */
-	engine::component::TileInfo getTileInfoByGid(int gid);
+	bool loadCookedLevel(std::string_view mapPath, LevelData& level) const;
 
+	void loadImageLayer(const LevelLayer& layer, Scene& scene);				///< @brief 加载图片图层
+	void loadTileLayer(const LevelLayer& layer, Scene& scene);				///< @brief 加载瓦片图层
+	void loadObjectLayer(const LevelLayer& layer, Scene& scene);			///< @brief 加载对象图层
+	void packLevelTextures(Scene& scene);									///< @brief 将关卡引用的图片(图片图层, 瓦片集)打包进纹理图集
+	void preloadLevelAssets(Scene& scene);									///< @brief 把关卡引用的资源(图片, 瓦片音效)加入场景的资源清单并批量预加载
+	
 	/**
-	 * @brief 根据全局ID获取瓦片json对象 (用于对象层获取瓦片信息).
+	 * @brief 添加动画到指定的AnimationComponent.
 	 * 
-	 * @param gid 全局 ID
-	 * @return 瓦片 json 对象
+	 * @param animations 瓦片"animation"属性解析后的动画片段
+	 * @param ac 动画组件指针 (动画添加到此组件)
+	 * @param spriteSize 每一帧动画的尺寸
+	 * @param sheetId 精灵图ID, 与帧尺寸, 行, 帧时长和动画名称一起作为共享片段的键
+	 * @param resourceManager 资源管理器, 同一精灵图中定义相同的片段只构建一次并在对象间共享(命中时校验帧)
 	 */
-	std::optional<nlohmann::json> getTileJsonByGid(int gid) const;
+	void addAnimation(const std::vector<LevelAnimation>& animations, engine::component::AnimationComponent* ac, const glm::vec2& spriteSize, std::string_view sheetId, engine::resource::ResourceManager& resourceManager);
 
 	/**
-	 * @brief 加载Tiled tileset 文件 (.tsj).
-	 * 
-	 * @param tilesetPath Tileset 文件路径
-	 * @param firstGid 此tileset的第一个全局id
+	 * @brief 添加音效到指定的AudioComponent.
+	 *
+	 * @param sounds 瓦片"sound"属性解析后的音效
+	 * @param audioComponent 音频组件指针
 	 */
-	void loadTileset(std::string_view tilesetPath, int firstGid);
+	void addSound(const std::vector<LevelSound>& sounds, engine::component::AudioComponent* audioComponent);
 
-	/**
-	 * @brief 解析图片路径, 合并地图路径和相对路径. 例如
-	 *	- 1. 文件路径: "assets/maps/level1.tmj"
-	 *	- 2. 相对路径: "../textures/Layers/back.png"
-	 *  - 3. 最终路径: "assets/textures/Layers/back.png"
-	 * 
-	 * @param relative 相对路径
-	 * @param filePath 文件路径
-	 * @return std::string 解析后的完整路径
-	 */
-	std::string resolvePath(std::string_view relativePath, std::string_view filePath);
 private:
 	static constexpr std::string_view mLogTag = "LevelLoader";				///< @brief 日志标记		
 
-	std::string mMapPath;													///< @brief 地图路径
-	glm::ivec2 mMapSize;													///< @brief 地图尺寸(瓦片数量)
-	glm::ivec2 mTileSize;													///< @brief 瓦片尺寸(像素)
-	std::map<int, nlohmann::json> mTilesetData;								///< @brief 瓦片集数据
+	std::shared_ptr<const LevelData> mLevel;								///< @brief 关卡数据(与关卡缓存共享)
+	const engine::resource::AssetPack* mAssetPack = nullptr;				///< @brief 资源包(非拥有, 来自场景的资源管理器), 可以为空
 };
-
-template<typename T>
-inline std::optional<T> scene::LevelLoader::getTileProperty(const nlohmann::json& tileJson, std::string_view propertyName) {
-	if (!tileJson.contains("properties")) {
-		return std::nullopt;
-	}
-	const auto& properties = tileJson["properties"];
-	for (const auto& property : properties) {
-		if (property.contains("name") && property["name"] == std::string(propertyName)) {
-			if (property.contains("value")) {
-				return property["value"].get<T>();
-			}
-		}
-	}
-	return std::nullopt;
-}
 } // namespace engine::scene
 
 #endif // !LEVEL_LOADER_H
-
@@ -0,0 +1,301 @@
+#include "level_streamer.h"
+#include "scene.h"
+#include "../component/tilelayer_component.h"
+#include "../component/transform_component.h"
+#include "../object/game_object.h"
+#include "../core/context.h"
+#include "../render/camera.h"
+#include "../resource/resource_manager.h"
+#include <spdlog/spdlog.h>
+#include <glm/common.hpp>
+#include <algorithm>
+#include <cmath>
+
+namespace engine::scene {
+namespace {
+/**
+ * @brief 根据gid生成块内每个瓦片图层的瓦片. 只读取LevelData, 可以在工作线程上调用.
+ *
+ * @param level 关卡数据
+ * @param layers 瓦片图层数据
+ * @param chunk 块坐标
+ * @param chunkSize 块的边长(瓦片数)
+ */
+std::vector<std::vector<engine::component::TileInfo>> buildChunkTiles(const LevelData& level, const std::vector<const LevelLayer*>& layers, glm::ivec2 chunk, int chunkSize) {
+	glm::ivec2 origin = chunk * chunkSize;
+	glm::ivec2 extent = glm::clamp(level.mMapSize - origin, glm::ivec2(0), glm::ivec2(chunkSize));
+	std::vector<std::vector<engine::component::TileInfo>> chunkTiles(layers.size());
+	for (std::size_t i = 0; i < layers.size(); ++i) {
+		auto& tiles = chunkTiles[i];
+		tiles.reserve(static_cast<std::size_t>(extent.x) * extent.y);
+		for (int y = origin.y; y < origin.y + extent.y; ++y) {
+			for (int x = origin.x; x < origin.x + extent.x; ++x) {
+				std::size_t index = static_cast<std::size_t>(y) * level.mMapSize.x + x;
+				std::uint16_t gid = index < layers[i]->mGids.size() ? layers[i]->mGids[index] : 0;
+				tiles.push_back(LevelLoader::createTileInfo(level.getTile(gid)));
+			}
+		}
+	}
+	return chunkTiles;
+}
+} // namespace
+
+bool LevelStreamer::ChunkRange::contains(glm::ivec2 chunk) const {
+	return chunk.x >= mMin.x && chunk.x <= mMax.x && chunk.y >= mMin.y && chunk.y <= mMax.y;
+}
+
+LevelStreamer::LevelStreamer(Scene& scene, const LevelStreamingSettings& settings)
+	: mScene(scene)
+	, mSettings(settings)
+	, mLifetimeToken(std::make_shared<bool>(true))
+{
+	mSettings.mChunkSize = std::max(1, mSettings.mChunkSize);
+	mSettings.mRadius = std::max(0, mSettings.mRadius);
+	spdlog::trace("{} 构造完成", mLogTag.data());
+}
+
+LevelStreamer::~LevelStreamer() {
+	spdlog::trace("{} 析构完成", mLogTag.data());
+}
+
+bool LevelStreamer::load(std::string_view mapPath) {
+	if (!mLevelLoader.loadLevelForStreaming(mapPath, mScene, mSettings.mChunkSize, mTileLayers)) {
+		return false;
+	}
+	mLevel = mLevelLoader.getLevel();
+	if (mLevel->mMapSize.x <= 0 || mLevel->mMapSize.y <= 0) {
+		spdlog::error("{} : 地图 '{}' 尺寸无效, 无法按块加载", mLogTag.data(), mLevel->mMapPath);
+		return false;
+	}
+	mChunkCount = (mLevel->mMapSize + mSettings.mChunkSize - 1) / mSettings.mChunkSize;
+
+	// 瓦片图层的数据与LevelLoader创建的组件顺序一致; 对象按出生位置覆盖的块建立索引
+	for (const auto& layer : mLevel->mLayers) {
+		if (layer.mType == LevelLayerType::Tile) {
+			mTileLayerData.push_back(&layer);
+		}
+		else if (layer.mType == LevelLayerType::Object) {
+			for (const auto& object : layer.mObjects) {
+				// 瓦片对象的对齐点为左下角, 与LevelLoader创建的变换组件位置一致
+				glm::vec2 position = object.mGid == 0 ? object.mPosition : glm::vec2(object.mPosition.x, object.mPosition.y - object.mSize.y);
+				mObjects.push_back(StreamedObject{ &object, position });
+			}
+		}
+	}
+	for (std::size_t index = 0; index < mObjects.size(); ++index) {
+		auto range = getRectChunkRange(mObjects[index].mPosition, mObjects[index].mObject->mSize);
+		for (int y = range.mMin.y; y <= range.mMax.y; ++y) {
+			for (int x = range.mMin.x; x <= range.mMax.x; ++x) {
+				mChunkObjects[getChunkKey(glm::ivec2(x, y))].push_back(index);
+			}
+		}
+	}
+
+	spdlog::info("{} : 流式关卡 '{}': {}x{} 个瓦片, {}x{} 个块(边长 {}), {} 个对象",
+		mLogTag.data(), mLevel->mMapPath, mLevel->mMapSize.x, mLevel->mMapSize.y, mChunkCount.x, mChunkCount.y, mSettings.mChunkSize, mObjects.size());
+	return true;
+}
+
+void LevelStreamer::loadAround(const glm::vec2& position) {
+	if (!mLevel) {
+		return;
+	}
+	auto range = getViewChunkRange(position - mScene.getContext().getCamera().getViewPortSize() / 2.f);
+	for (int y = range.mMin.y; y <= range.mMax.y; ++y) {
+		for (int x = range.mMin.x; x <= range.mMax.x; ++x) {
+			glm::ivec2 chunk(x, y);
+			auto& state = mChunks[getChunkKey(chunk)];
+			if (state.mIsActive) {
+				continue;
+			}
+			// 重新编号使可能正在进行的异步请求失效
+			state.mRequestId = mNextRequestId++;
+			activateChunk(chunk, buildChunkTiles(*mLevel, mTileLayerData, chunk, mSettings.mChunkSize), false);
+		}
+	}
+	spdlog::info("{} : 同步激活 {} 个块, {} 个对象", mLogTag.data(), getActiveChunkCount(), mActiveObjects.size());
+}
+
+void LevelStreamer::update() {
+	if (!mLevel) {
+		return;
+	}
+
+	auto range = getViewChunkRange(mScene.getContext().getCamera().getPosition());
+	if (!mChunkRange || *mChunkRange != range) {
+		mChunkRange = range;
+		// 丢弃离开范围的块(包括尚未完成的请求, 其上传步骤会因为找不到请求而被忽略)
+		for (auto iter = mChunks.begin(); iter != mChunks.end();) {
+			glm::ivec2 chunk(static_cast<int>(iter->first % mChunkCount.x), static_cast<int>(iter->first / mChunkCount.x));
+			if (range.contains(chunk)) {
+				++iter;
+				continue;
+			}
+			if (iter->second.mIsActive) {
+				deactivateChunk(chunk);
+			}
+			iter = mChunks.erase(iter);
+		}
+		// 请求进入范围的块
+		for (int y = range.mMin.y; y <= range.mMax.y; ++y) {
+			for (int x = range.mMin.x; x <= range.mMax.x; ++x) {
+				if (!mChunks.contains(getChunkKey(glm::ivec2(x, y)))) {
+					requestChunk(glm::ivec2(x, y));
+				}
+			}
+		}
+	}
+
+	updateObjects();
+}
+
+std::optional<glm::vec2> LevelStreamer::findObjectPosition(std::string_view name) const {
+	for (const auto& streamed : mObjects) {
+		if (streamed.mObject->mName == name) {
+			return streamed.mPosition;
+		}
+	}
+	return std::nullopt;
+}
+
+void LevelStreamer::detachObject(const engine::object::GameObject* gameObject) {
+	std::erase_if(mActiveObjects, [this, gameObject](std::size_t index) {
+		auto& streamed = mObjects[index];
+		if (streamed.mGameObject != gameObject) {
+			return false;
+		}
+		streamed.mState = ObjectState::Removed;
+		streamed.mGameObject = nullptr;
+		return true;
+	});
+}
+
+void LevelStreamer::setObjectCallback(std::function<void(engine::object::GameObject&)> callback) {
+	mObjectCallback = std::move(callback);
+}
+
+std::size_t LevelStreamer::getActiveChunkCount() const {
+	return static_cast<std::size_t>(std::count_if(mChunks.begin(), mChunks.end(), [](const auto& pair) { return pair.second.mIsActive; }));
+}
+
+std::size_t LevelStreamer::getActiveObjectCount() const {
+	return mActiveObjects.size();
+}
+
+LevelStreamer::ChunkRange LevelStreamer::getViewChunkRange(const glm::vec2& viewPosition) const {
+	auto range = getRectChunkRange(viewPosition, mScene.getContext().getCamera().getViewPortSize());
+	range.mMin = glm::max(range.mMin - mSettings.mRadius, glm::ivec2(0));
+	range.mMax = glm::min(range.mMax + mSettings.mRadius, mChunkCount - 1);
+	return range;
+}
+
+LevelStreamer::ChunkRange LevelStreamer::getRectChunkRange(const glm::vec2& position, const glm::vec2& size) const {
+	// 地图之外的部分归入边缘的块, 保证每个对象至少属于一个块
+	glm::vec2 chunkPixelSize = glm::vec2(mLevel->mTileSize * mSettings.mChunkSize);
+	ChunkRange range;
+	range.mMin = glm::clamp(glm::ivec2(glm::floor(position / chunkPixelSize)), glm::ivec2(0), mChunkCount - 1);
+	range.mMax = glm::clamp(glm::ivec2(glm::floor((position + size) / chunkPixelSize)), glm::ivec2(0), mChunkCount - 1);
+	return range;
+}
+
+std::int64_t LevelStreamer::getChunkKey(glm::ivec2 chunk) const {
+	return static_cast<std::int64_t>(chunk.y) * mChunkCount.x + chunk.x;
+}
+
+void LevelStreamer::requestChunk(glm::ivec2 chunk) {
+	auto requestId = mNextRequestId++;
+	mChunks[getChunkKey(chunk)] = ChunkState{ requestId, false };
+
+	// 工作线程只读取共享的关卡数据; 上传时流式加载器可能已被销毁, 或者块已被丢弃和重新请求
+	auto tiles = std::make_shared<ChunkTiles>();
+	mScene.getContext().getResourceManager().submitTask(
+		[tiles, level = mLevel, layers = mTileLayerData, chunk, chunkSize = mSettings.mChunkSize] {
+			*tiles = buildChunkTiles(*level, layers, chunk, chunkSize);
+		},
+		[this, token = std::weak_ptr<bool>(mLifetimeToken), tiles, chunk, requestId] {
+			if (token.expired()) {
+				return;
+			}
+			auto iter = mChunks.find(getChunkKey(chunk));
+			if (iter == mChunks.end() || iter->second.mRequestId != requestId) {
+				return;
+			}
+			activateChunk(chunk, std::move(*tiles), true);
+		});
+}
+
+void LevelStreamer::activateChunk(glm::ivec2 chunk, ChunkTiles&& tiles, bool isDeferred) {
+	auto key = getChunkKey(chunk);
+	mChunks[key].mIsActive = true;
+	for (std::size_t i = 0; i < mTileLayers.size() && i < tiles.size(); ++i) {
+		mTileLayers[i]->setChunk(chunk, std::move(tiles[i]));
+	}
+	if (auto iter = mChunkObjects.find(key); iter != mChunkObjects.end()) {
+		for (auto index : iter->second) {
+			if (mObjects[index].mState == ObjectState::Unloaded) {
+				spawnObject(index, isDeferred);
+			}
+		}
+	}
+	spdlog::debug("{} : 激活块 ({}, {})", mLogTag.data(), chunk.x, chunk.y);
+}
+
+void LevelStreamer::deactivateChunk(glm::ivec2 chunk) {
+	for (auto* tileLayer : mTileLayers) {
+		tileLayer->removeChunk(chunk);
+	}
+	spdlog::debug("{} : 丢弃块 ({}, {})", mLogTag.data(), chunk.x, chunk.y);
+}
+
+void LevelStreamer::spawnObject(std::size_t index, bool isDeferred) {
+	auto& streamed = mObjects[index];
+	auto gameObject = mLevelLoader.createObject(*streamed.mObject, mScene);
+	if (!gameObject) {
+		// 数据无效的对象不再尝试创建
+		streamed.mState = ObjectState::Removed;
+		return;
+	}
+	if (mObjectCallback) {
+		mObjectCallback(*gameObject);
+	}
+	streamed.mState = ObjectState::Active;
+	streamed.mGameObject = gameObject.get();
+	mActiveObjects.push_back(index);
+	// 游戏运行中(上传步骤)不能直接修改场景的对象列表
+	if (isDeferred) {
+		mScene.safeAddGameObject(std::move(gameObject));
+	}
+	else {
+		mScene.addGameObject(std::move(gameObject));
+	}
+}
+
+void LevelStreamer::updateObjects() {
+	std::erase_if(mActiveObjects, [this](std::size_t index) {
+		auto& streamed = mObjects[index];
+		auto* gameObject = streamed.mGameObject;
+		// 游戏逻辑移除的对象(被消灭的敌人, 拾取的道具)不再生成
+		if (gameObject->isNeedRemove()) {
+			streamed.mState = ObjectState::Removed;
+			streamed.mGameObject = nullptr;
+			return true;
+		}
+		// 对象当前覆盖的块中仍有激活的块时保留
+		auto* transform = gameObject->getComponent<engine::component::TransformComponent>();
+		auto range = getRectChunkRange(transform ? transform->getPosition() : streamed.mPosition, streamed.mObject->mSize);
+		for (int y = range.mMin.y; y <= range.mMax.y; ++y) {
+			for (int x = range.mMin.x; x <= range.mMax.x; ++x) {
+				auto iter = mChunks.find(getChunkKey(glm::ivec2(x, y)));
+				if (iter != mChunks.end() && iter->second.mIsActive) {
+					return false;
+				}
+			}
+		}
+		// 离开激活范围: 从场景中移除(连同物理体), 出生点所在的块再次激活时重新生成
+		gameObject->setNeedRemove(true);
+		streamed.mState = ObjectState::Unloaded;
+		streamed.mGameObject = nullptr;
+		return true;
+	});
+}
+} // namespace engine::scene
@@ -0,0 +1,168 @@
+/*****************************************************************//**
+ * @file   level_streamer.h
+ * @brief  按块流式加载超大关卡
+ * @version 1.0
+ *
+ * @author Shallowshades
+ * @date   2026.10.18
+ *********************************************************************/
+
+#pragma once
+#ifndef LEVEL_STREAMER_H
+#define LEVEL_STREAMER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include <glm/vec2.hpp>
+#include "level_loader.h"
+
+namespace engine::object { class GameObject; }
+namespace engine::component { class TileLayerComponent; }
+
+namespace engine::scene {
+class Scene;
+
+/**
+ * @brief 流式关卡的设置.
+ */
+struct LevelStreamingSettings {
+	bool mIsEnabled = false;												///< @brief 是否启用流式关卡
+	int mChunkSize = 32;													///< @brief 块的边长(瓦片数)
+	int mRadius = 1;														///< @brief 相机视野之外额外保持加载的块数(每个方向)
+};
+
+/**
+ * @brief 按相机位置流式加载关卡的瓦片和对象.
+ *
+ * 地图划分为正方形的块, 只有相机视野(向外扩展mRadius个块)内的块被激活: 瓦片加入按块存储的瓦片图层,
+ * 出生点在块内的对象被创建并加入场景(参与物理模拟). 新的块在资源加载的工作线程上生成瓦片信息,
+ * 在每帧的上传预算内激活; 离开范围的块直接丢弃, 需要时再从LevelData重新生成.
+ * 常驻内存的只有LevelData(每个瓦片一个gid和对象列表), 瓦片信息, 游戏对象和物理体的数量与地图大小无关.
+ * 被游戏逻辑移除的对象(被消灭的敌人, 拾取的道具)会被记住, 再次进入范围时不再生成.
+ * 只在游戏线程上使用.
+ */
+class LevelStreamer final {
+public:
+	/**
+	 * @brief 构造函数.
+	 *
+	 * @param scene 目标场景(非拥有), 生命周期必须长于流式加载器
+	 * @param settings 流式关卡设置
+	 */
+	LevelStreamer(Scene& scene, const LevelStreamingSettings& settings);
+	~LevelStreamer();														///< @brief 析构函数, 尚未完成的块在上传时被忽略
+
+	// 禁用拷贝和移动语义
+	LevelStreamer(const LevelStreamer&) = delete;							///< @brief 删除拷贝构造
+	LevelStreamer& operator=(const LevelStreamer&) = delete;				///< @brief 删除拷贝赋值构造
+	LevelStreamer(LevelStreamer&&) = delete;								///< @brief 删除移动构造
+	LevelStreamer& operator=(LevelStreamer&&) = delete;						///< @brief 删除移动赋值构造
+
+	/**
+	 * @brief 加载关卡数据, 创建图片图层和空的瓦片图层, 不激活任何块.
+	 *
+	 * @param mapPath Tiled JSON地图文件的路径
+	 * @return 是否成功
+	 */
+	[[nodiscard]] bool load(std::string_view mapPath);
+
+	/**
+	 * @brief 同步激活以某个位置为中心的视野范围内的块(用于场景初始化, 对象直接加入场景).
+	 *
+	 * @param position 视野中心(世界坐标)
+	 */
+	void loadAround(const glm::vec2& position);
+
+	void update();															///< @brief 根据相机位置请求新的块, 丢弃离开范围的块和对象; 每帧在场景更新之前调用
+
+	/**
+	 * @brief 查找对象的出生位置(左上角, 世界坐标), 用于在激活块之前定位玩家.
+	 *
+	 * @param name 对象名称
+	 * @return 第一个同名对象的位置, 不存在时返回std::nullopt
+	 */
+	std::optional<glm::vec2> findObjectPosition(std::string_view name) const;
+
+	void detachObject(const engine::object::GameObject* gameObject);		///< @brief 不再管理一个已创建的对象(例如玩家), 它不会被丢弃或重新生成
+	void setObjectCallback(std::function<void(engine::object::GameObject&)> callback);	///< @brief 设置对象创建后, 加入场景前的回调(添加游戏逻辑组件)
+	std::size_t getActiveChunkCount() const;								///< @brief 获取已激活的块数量
+	std::size_t getActiveObjectCount() const;								///< @brief 获取由流式加载器创建且仍在场景中的对象数量
+
+private:
+	/**
+	 * @brief 块坐标的闭区间.
+	 */
+	struct ChunkRange {
+		glm::ivec2 mMin{ 0 };												///< @brief 最小块坐标
+		glm::ivec2 mMax{ -1 };												///< @brief 最大块坐标(包含)
+
+		bool contains(glm::ivec2 chunk) const;								///< @brief 是否包含块
+		bool operator==(const ChunkRange&) const = default;
+	};
+
+	/**
+	 * @brief 对象的状态.
+	 */
+	enum class ObjectState : std::uint8_t {
+		Unloaded,															///< @brief 未创建, 所在的块激活时创建
+		Active,																///< @brief 已创建并加入场景
+		Removed,															///< @brief 已被游戏逻辑移除或不再管理, 不再创建
+	};
+
+	/**
+	 * @brief 对象层中的对象及其在流式加载器中的状态.
+	 */
+	struct StreamedObject {
+		const LevelObject* mObject = nullptr;								///< @brief 对象数据(属于LevelData)
+		glm::vec2 mPosition{};												///< @brief 出生位置(左上角, 世界坐标)
+		ObjectState mState = ObjectState::Unloaded;							///< @brief 状态
+		engine::object::GameObject* mGameObject = nullptr;					///< @brief 已创建的游戏对象(非拥有), 只在Active状态下有效
+	};
+
+	/**
+	 * @brief 已请求的块.
+	 */
+	struct ChunkState {
+		std::uint64_t mRequestId = 0;										///< @brief 请求编号, 上传时不一致说明块已被丢弃或重新请求
+		bool mIsActive = false;												///< @brief 是否已激活(瓦片已加入图层)
+	};
+
+	using ChunkTiles = std::vector<std::vector<engine::component::TileInfo>>;	///< @brief 块内每个瓦片图层的瓦片
+
+	ChunkRange getViewChunkRange(const glm::vec2& viewPosition) const;		///< @brief 获取视野(左上角为viewPosition)扩展mRadius后的块范围
+	ChunkRange getRectChunkRange(const glm::vec2& position, const glm::vec2& size) const;	///< @brief 获取矩形(世界坐标)覆盖的块范围
+	std::int64_t getChunkKey(glm::ivec2 chunk) const;						///< @brief 块坐标对应的键
+	void requestChunk(glm::ivec2 chunk);									///< @brief 提交块的生成任务
+	void activateChunk(glm::ivec2 chunk, ChunkTiles&& tiles, bool isDeferred);	///< @brief 激活块: 加入瓦片并创建块内的对象
+	void deactivateChunk(glm::ivec2 chunk);									///< @brief 丢弃块的瓦片(对象在update中按位置丢弃)
+	void spawnObject(std::size_t index, bool isDeferred);					///< @brief 创建对象并加入场景, isDeferred为true时通过safeAddGameObject加入
+	void updateObjects();													///< @brief 记录被游戏逻辑移除的对象, 丢弃离开激活范围的对象
+
+private:
+	static constexpr std::string_view mLogTag = "LevelStreamer";			///< @brief 日志标记
+
+	Scene& mScene;															///< @brief 目标场景(非拥有)
+	LevelStreamingSettings mSettings;										///< @brief 流式关卡设置
+	LevelLoader mLevelLoader;												///< @brief 关卡载入器, 持有关卡数据并负责创建对象
+	std::shared_ptr<const LevelData> mLevel;								///< @brief 关卡数据(与关卡缓存共享)
+	std::vector<const LevelLayer*> mTileLayerData;							///< @brief 瓦片图层的数据, 与mTileLayers一一对应
+	std::vector<engine::component::TileLayerComponent*> mTileLayers;		///< @brief 按块存储的瓦片图层组件(非拥有)
+	glm::ivec2 mChunkCount{ 0 };											///< @brief 地图的块数量
+	std::vector<StreamedObject> mObjects;									///< @brief 对象层中的所有对象
+	std::unordered_map<std::int64_t, std::vector<std::size_t>> mChunkObjects;	///< @brief 块 -> 出生时覆盖该块的对象下标
+	std::vector<std::size_t> mActiveObjects;								///< @brief Active状态的对象下标
+	std::unordered_map<std::int64_t, ChunkState> mChunks;					///< @brief 已请求或已激活的块
+	std::optional<ChunkRange> mChunkRange;									///< @brief 上一次更新时的块范围
+	std::uint64_t mNextRequestId = 1;										///< @brief 下一个块请求编号
+	std::shared_ptr<bool> mLifetimeToken;									///< @brief 上传步骤通过它的weak_ptr判断流式加载器是否仍然存在
+	std::function<void(engine::object::GameObject&)> mObjectCallback;		///< @brief 对象创建后的回调
+};
+} // namespace engine::scene
+
+#endif // !LEVEL_STREAMER_H
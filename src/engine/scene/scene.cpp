@@ -6,6 +6,16 @@
 #include "../physics/physics_engine.h"
 #include "../render/camera.h"
 #include "../ui/ui_manager.h"
+#include "../render/animation_system.h"
+#include "../render/renderer.h"
+#include "../component/transform_component.h"
+#include "../component/sprite_component.h"
+#include "../component/tilelayer_component.h"
+#include "../component/parallax_component.h"
+#include "../resource/resource_manager.h"
+#include "../resource/asset_manifest.h"
+#include "../resource/resource_scope.h"
+#include "spatial_grid.h"
 #include <algorithm>
 #include <spdlog/spdlog.h>
 
@@ -14,7 +24,11 @@ engine::scene::Scene::Scene(std::string_view name, engine::core::Context& contex
 	: mSceneName(name)
 	, mContext(context)
 	, mSceneManager(sceneManager)
+	, mResourceScope(std::make_unique<engine::resource::ResourceScope>(context.getResourceManager(), name))
 	, mUIManager(std::make_unique<engine::ui::UIManager>())
+	, mAnimationSystem(std::make_unique<engine::render::AnimationSystem>())
+	, mSpatialGrid(std::make_unique<engine::scene::SpatialGrid>())
+	, mAssetManifest(std::make_unique<engine::resource::AssetManifest>())
 	, mIsInitialized(false)
 {
 	spdlog::trace("{} : {} 构造完成", mLogTag.data(), mSceneName);
@@ -22,6 +36,10 @@ engine::scene::Scene::Scene(std::string_view name, engine::core::Context& contex
 Scene::~Scene() = default;
 
 void Scene::init() {
+	// 预加载清单中尚未加载的资源(关卡资源已在LevelLoader中加载), 避免游戏中首次使用时卡顿
+	if (!mAssetManifest->isEmpty()) {
+		mContext.getResourceManager().preload(*mAssetManifest);
+	}
 	mIsInitialized = true;
 	spdlog::trace("{} : {} 初始化完成", mLogTag.data(), mSceneName);
 }
@@ -41,6 +59,7 @@ void Scene::update(float deltaTime) {
 		}
 		if (obj->isNeedRemove()) {
 			needRemove = true;
+			unregisterRenderable(obj.get());
 			obj->clean();
 		}
 	}
@@ -71,6 +90,9 @@ void Scene::update(float deltaTime) {
 		}
 	}
 
+	// 统一推进所有动画
+	mAnimationSystem->update(deltaTime);
+
 	// 更新UI管理器
 	mUIManager->update(deltaTime, mContext);
 
@@ -82,12 +104,25 @@ void Scene::render() {
 		return;
 	}
 
-	// 渲染所有游戏对象
-	for (const auto& obj : mGameObjects) {
-		if (obj) {
-			obj->render(mContext);
-		}
+	// 只渲染与相机视口(向四周扩展一定距离)相交的游戏对象, 顺序与加入场景的顺序一致
+	const auto& camera = mContext.getCamera();
+	engine::utils::Rect viewRect = {
+		camera.getPosition() - glm::vec2(mCullingMargin),
+		camera.getViewPortSize() + glm::vec2(mCullingMargin * 2.f)
+	};
+	mSpatialGrid->query(viewRect, mRenderQueue);
+
+	// 游戏对象属于世界层, 动态分辨率开启时以较低分辨率渲染后放大; UI始终以逻辑分辨率绘制
+	auto& renderer = mContext.getRenderer();
+	bool isWorldLayer = !mRenderQueue.empty() && renderer.beginWorldLayer(camera);
+	for (auto* obj : mRenderQueue) {
+		obj->render(mContext);
+	}
+	if (isWorldLayer) {
+		renderer.endWorldLayer();
 	}
+	int visibleCount = static_cast<int>(mRenderQueue.size());
+	renderer.recordCulling(visibleCount, static_cast<int>(mSpatialGrid->getProxyCount()) - visibleCount);
 
 	mUIManager->render(mContext);
 }
@@ -120,6 +155,8 @@ void Scene::clean() {
 		}
 	}
 	mGameObjects.clear();
+	mSpatialGrid->clear();
+	mRenderQueue.clear();
 
 	mIsInitialized = false;
 	spdlog::trace("{} : {} 清理完成.", mLogTag.data(), mSceneName);
@@ -127,6 +164,7 @@ void Scene::clean() {
 
 void Scene::addGameObject(std::unique_ptr<engine::object::GameObject>&& gameObject) {
 	if (gameObject) {
+		registerRenderable(gameObject.get());
 		mGameObjects.push_back(std::move(gameObject));
 	}
 	else {
@@ -155,6 +193,7 @@ void Scene::removeGameObject(engine::object::GameObject* gameObjectPtr) {
 		return p.get() == gameObjectPtr;
 		});
 	if (iter != mGameObjects.end()) {
+		unregisterRenderable(iter->get());
 		(*iter)->clean();
 		mGameObjects.erase(iter, mGameObjects.end());
 		spdlog::trace("{} : {} 移除游戏对象.", mLogTag.data(), mSceneName);
@@ -198,6 +237,22 @@ bool Scene::getIsInitialized() const {
 	return mIsInitialized;
 }
 
+void Scene::setFreezesScenesBelow(bool freezes) {
+	mFreezesScenesBelow = freezes;
+}
+
+bool Scene::getFreezesScenesBelow() const {
+	return mFreezesScenesBelow;
+}
+
+void Scene::setIsOpaque(bool isOpaque) {
+	mIsOpaque = isOpaque;
+}
+
+bool Scene::getIsOpaque() const {
+	return mIsOpaque;
+}
+
 engine::core::Context& Scene::getContext() const {
 	return mContext;
 }
@@ -206,10 +261,26 @@ engine::scene::SceneManager& Scene::getSceneManager() const {
 	return mSceneManager;
 }
 
+engine::render::AnimationSystem& Scene::getAnimationSystem() const {
+	return *mAnimationSystem;
+}
+
 std::vector<std::unique_ptr<engine::object::GameObject>>& Scene::getGameObjects() {
 	return mGameObjects;
 }
 
+engine::resource::AssetManifest& Scene::getAssetManifest() const {
+	return *mAssetManifest;
+}
+
+const engine::resource::ResourceScope& Scene::getResourceScope() const {
+	return *mResourceScope;
+}
+
+std::uint64_t Scene::getRenderVersion() const {
+	return mUIManager->getRenderVersion() + mAnimationSystem->getFrameChangeCount() + mSpatialGrid->getVersion();
+}
+
 void Scene::processPendingAdditions() {
 	// 处理待添加的游戏对象
 	for (auto& gameObject : mPendingAdditions) {
@@ -217,4 +288,26 @@ void Scene::processPendingAdditions() {
 	}
 	mPendingAdditions.clear();
 }
+
+void Scene::registerRenderable(engine::object::GameObject* gameObject) {
+	// 瓦片层和视差背景覆盖整个视口, 没有精灵的对象无法给出包围盒, 都作为始终可见处理
+	auto* sprite = gameObject->getComponent<engine::component::SpriteComponent>();
+	if (!sprite || gameObject->hasComponent<engine::component::TileLayerComponent>() || gameObject->hasComponent<engine::component::ParallaxComponent>()
+		|| !gameObject->hasComponent<engine::component::TransformComponent>()) {
+		mSpatialGrid->insertAlwaysVisible(gameObject);
+		return;
+	}
+
+	std::size_t proxy = mSpatialGrid->insert(gameObject, sprite->getRenderBounds());
+	if (proxy != engine::scene::SpatialGrid::mInvalidProxy) {
+		sprite->setSpatialProxy(mSpatialGrid.get(), proxy);
+	}
+}
+
+void Scene::unregisterRenderable(engine::object::GameObject* gameObject) {
+	if (auto* sprite = gameObject->getComponent<engine::component::SpriteComponent>()) {
+		sprite->setSpatialProxy(nullptr, engine::scene::SpatialGrid::mInvalidProxy);
+	}
+	mSpatialGrid->remove(gameObject);
+}
 }
@@ -10,6 +10,7 @@
 #pragma once
 #ifndef SCENE_H
 #define SCENE_H
+#include <cstdint>
 #include <vector>
 #include <memory>
 #include <string>
@@ -17,8 +18,10 @@
 
 namespace engine::core { class Context; }
 namespace engine::ui { class UIManager; }
+namespace engine::render { class AnimationSystem; }
 namespace engine::object { class GameObject; }
-namespace engine::scene { class SceneManager; }
+namespace engine::scene { class SceneManager; class SpatialGrid; }
+namespace engine::resource { class AssetManifest; class ResourceScope; }
 
 namespace engine::scene {
 
@@ -87,22 +90,47 @@ public:
 	std::string_view getName() const;													///< @brief 获取场景名称
 	void setIsInitialized(bool initialized);											///< @brief 设置场景是否已初始化
 	bool getIsInitialized() const;														///< @brief 获取场景是否已初始化
+	void setFreezesScenesBelow(bool freezes);											///< @brief 设置是否冻结下层场景(下层只渲染一次到缓存纹理, 之后直接绘制缓存)
+	bool getFreezesScenesBelow() const;													///< @brief 获取是否冻结下层场景
+	void setIsOpaque(bool isOpaque);													///< @brief 设置场景是否完全不透明(完全遮挡下层场景, 下层不再渲染)
+	bool getIsOpaque() const;															///< @brief 获取场景是否完全不透明
 
 	engine::core::Context& getContext() const;											///< @brief 获取上下文引用
 	engine::scene::SceneManager& getSceneManager() const;								///< @brief 获取场景管理器
+	engine::render::AnimationSystem& getAnimationSystem() const;						///< @brief 获取场景的动画系统
 	std::vector<std::unique_ptr<engine::object::GameObject>>& getGameObjects();			///< @brief 获取场景中的游戏对象
+	engine::resource::AssetManifest& getAssetManifest() const;							///< @brief 获取场景的资源清单(关卡资源和场景额外登记的资源, 在init()时预加载)
+	const engine::resource::ResourceScope& getResourceScope() const;					///< @brief 获取场景的资源归属范围(场景激活时加载的资源由它引用)
+
+	/**
+	 * @brief 获取场景的绘制版本号, 与上次渲染时相同说明场景的绘制结果没有变化(帧缓存据此跳过录制).
+	 *
+	 * 默认为UI树, 动画切帧和空间网格(游戏对象加入, 移除, 移动和外观变化)的计数之和, 这些计数只增不减,
+	 * 任何一个变化都会使和变化. 派生类绘制了其他随时间变化的内容时应重写并加上自己的计数.
+	 */
+	virtual std::uint64_t getRenderVersion() const;
 
 protected:
 	void processPendingAdditions();														///< @brief 处理待添加的游戏对象
+	void registerRenderable(engine::object::GameObject* gameObject);					///< @brief 将游戏对象加入空间网格(有精灵的按包围盒, 其余始终可见)
+	void unregisterRenderable(engine::object::GameObject* gameObject);					///< @brief 将游戏对象从空间网格中移除
 
 protected:
 	constexpr static std::string_view mLogTag = "Scene";								///< @brief 日志标识
+	constexpr static float mCullingMargin = 64.f;										///< @brief 视口裁剪时向四周扩展的距离(像素)
 
 	std::string mSceneName;																///< @brief 场景名称
 	engine::core::Context& mContext;													///< @brief 上下文引用
 	engine::scene::SceneManager& mSceneManager;											///< @brief 场景管理器引用
+	std::unique_ptr<engine::resource::ResourceScope> mResourceScope;					///< @brief 资源归属范围(最先构造, 最后析构, 场景销毁时释放对资源的引用)
 	std::unique_ptr<engine::ui::UIManager> mUIManager;									///< @brief UI管理器(初始化时自动创建)
+	std::unique_ptr<engine::render::AnimationSystem> mAnimationSystem;					///< @brief 动画系统(初始化时自动创建, 需要比游戏对象活得更久)
+	std::unique_ptr<engine::scene::SpatialGrid> mSpatialGrid;							///< @brief 渲染包围盒的空间网格(需要比游戏对象活得更久)
+	std::unique_ptr<engine::resource::AssetManifest> mAssetManifest;					///< @brief 场景的资源清单
+	std::vector<engine::object::GameObject*> mRenderQueue;								///< @brief 每帧视口查询得到的待渲染对象(复用内存)
 	bool mIsInitialized;																///< @brief 场景是否已被初始化
+	bool mFreezesScenesBelow = false;													///< @brief 作为覆盖层时是否冻结下层场景(下层不再更新, 画面不会变化)
+	bool mIsOpaque = false;																///< @brief 是否完全覆盖整个屏幕
 	std::vector<std::unique_ptr<engine::object::GameObject>> mGameObjects;				///< @brief 场景中的游戏对象
 	std::vector<std::unique_ptr<engine::object::GameObject>> mPendingAdditions;			///< @brief 待添加的游戏对象
 };
@@ -1,11 +1,19 @@
 #include "scene_manager.h"
 #include "scene.h"
+#include "level_cache.h"
+#include "level_streamer.h"
 #include "../core/context.h"
+#include "../render/renderer.h"
+#include "../render/camera.h"
+#include "../resource/resource_manager.h"
+#include "../resource/resource_scope.h"
 #include <spdlog/spdlog.h>
 
 namespace engine::scene {
 engine::scene::SceneManager::SceneManager(engine::core::Context& context) 
 	: mContext(context)
+	, mLevelCache(std::make_unique<LevelCache>())
+	, mLevelStreamingSettings(std::make_unique<LevelStreamingSettings>())
 {
 	spdlog::trace("{} 构造完成", mLogTag.data());
 }
@@ -40,10 +48,24 @@ engine::core::Context& SceneManager::getContext() const {
 	return mContext;
 }
 
+LevelCache& SceneManager::getLevelCache() const {
+	return *mLevelCache;
+}
+
+const LevelStreamingSettings& SceneManager::getLevelStreamingSettings() const {
+	return *mLevelStreamingSettings;
+}
+
+void SceneManager::setLevelStreamingSettings(const LevelStreamingSettings& settings) {
+	*mLevelStreamingSettings = settings;
+}
+
 void SceneManager::update(float deltaTime) {
 	// 只更新栈顶元素
 	Scene* currentScene = getCurrentScene();
 	if (currentScene) {
+		// 场景更新期间加载的资源归属于该场景
+		engine::resource::ActiveResourceScope activeScope(currentScene->getResourceScope());
 		currentScene->update(deltaTime);
 	}
 	// 执行可能的切换场景操作
@@ -51,17 +73,67 @@ void SceneManager::update(float deltaTime) {
 }
 
 void SceneManager::render() {
-	// 渲染时需要叠加渲染所有场景, 而不只是栈顶
-	for (const auto& scene : mSceneStack) {
-		if (scene) {
-			scene->render();
+	// 渲染时需要叠加渲染所有场景, 而不只是栈顶; 完全不透明的场景之下的场景无需渲染
+	std::size_t firstIndex = 0;
+	std::size_t freezeIndex = 0;
+	for (std::size_t index = 0; index < mSceneStack.size(); ++index) {
+		const auto& scene = mSceneStack[index];
+		if (!scene) {
+			continue;
+		}
+		if (scene->getIsOpaque()) {
+			firstIndex = index;
+			freezeIndex = 0;
+		}
+		if (scene->getFreezesScenesBelow() && index > firstIndex) {
+			freezeIndex = index;
 		}
 	}
+
+	if (freezeIndex == 0) {
+		renderScenes(firstIndex, mSceneStack.size());
+	}
+	else {
+		// 下层场景被冻结: 只捕获一次到缓存纹理, 之后直接绘制缓存, 直到场景栈变化
+		auto& renderer = mContext.getRenderer();
+		if (renderer.isFrameCaptureReady()) {
+			renderer.drawFrameCapture();
+		}
+		else if (renderer.beginFrameCapture()) {
+			renderScenes(firstIndex, freezeIndex);
+			renderer.endFrameCapture();
+			renderer.drawFrameCapture();
+		}
+		else {
+			renderScenes(firstIndex, freezeIndex);
+		}
+		renderScenes(freezeIndex, mSceneStack.size());
+	}
+
+	// 渲染过程中的变化(如绘制时提交的异步加载)已经反映在本帧中, 在渲染结束后记录
+	const auto& camera = mContext.getCamera();
+	mRenderedStackVersion = mStackVersion;
+	mRenderedVersion = getRenderVersion();
+	mRenderedCameraPosition = camera.getPosition();
+	mRenderedViewPortSize = camera.getViewPortSize();
+	mIsRendered = true;
+}
+
+bool SceneManager::isRenderDirty() const {
+	if (!mIsRendered) {
+		return true;
+	}
+	const auto& camera = mContext.getCamera();
+	return mStackVersion != mRenderedStackVersion
+		|| getRenderVersion() != mRenderedVersion
+		|| camera.getPosition() != mRenderedCameraPosition
+		|| camera.getViewPortSize() != mRenderedViewPortSize;
 }
 
 void SceneManager::handleInput() {
 	Scene* currentScene = getCurrentScene();
 	if (currentScene) {
+		engine::resource::ActiveResourceScope activeScope(currentScene->getResourceScope());
 		currentScene->handleInput();
 	}
 }
@@ -75,6 +147,29 @@ void SceneManager::clean() {
 		}
 		mSceneStack.pop_back();
 	}
+	// 待处理的场景同样持有资源范围, 需要在资源管理器之前销毁
+	mPendingScene.reset();
+	mPendingAction = PendingAction::None;
+}
+
+void SceneManager::renderScenes(std::size_t begin, std::size_t end) {
+	for (std::size_t index = begin; index < end; ++index) {
+		if (mSceneStack[index]) {
+			engine::resource::ActiveResourceScope activeScope(mSceneStack[index]->getResourceScope());
+			mSceneStack[index]->render();
+		}
+	}
+}
+
+std::uint64_t SceneManager::getRenderVersion() const {
+	// 场景栈不变时各个计数都只增不减, 和不变说明都没有变化(场景栈变化由isRenderDirty单独比较)
+	std::uint64_t version = mContext.getResourceManager().getAsyncTextureCount();
+	for (const auto& scene : mSceneStack) {
+		if (scene) {
+			version += scene->getRenderVersion();
+		}
+	}
+	return version;
 }
 
 void SceneManager::processPendingActions() {
@@ -106,11 +201,14 @@ void SceneManager::pushScene(std::unique_ptr<Scene>&& scene) {
 
 	// 初始化新场景
 	if (!scene->getIsInitialized()) {
+		engine::resource::ActiveResourceScope activeScope(scene->getResourceScope());
 		scene->init();
 	}
 
 	// 将新场景移入栈顶
 	mSceneStack.push_back(std::move(scene));
+	++mStackVersion;
+	mContext.getRenderer().invalidateFrameCapture();
 }
 
 void SceneManager::popScene() {
@@ -125,6 +223,8 @@ void SceneManager::popScene() {
 		mSceneStack.back()->clean();
 	}
 	mSceneStack.pop_back();
+	++mStackVersion;
+	mContext.getRenderer().invalidateFrameCapture();
 }
 
 void SceneManager::replaceScene(std::unique_ptr<Scene>&& scene) {
@@ -134,19 +234,28 @@ void SceneManager::replaceScene(std::unique_ptr<Scene>&& scene) {
 	}
 
 	spdlog::debug("{} 正在用场景 '{}' 替换场景 '{}'", mLogTag.data(), scene->getName(), mSceneStack.back()->getName());
-	while (!mSceneStack.empty()) {
-		if (mSceneStack.back()) {
-			mSceneStack.back()->clean();
+	// 旧场景先清理, 但在新场景初始化(预加载)完成之前不销毁: 它们的资源范围仍然持有引用,
+	// 两个场景共用的资源不会在切换期间进入LRU池被淘汰后又重新加载
+	std::vector<std::unique_ptr<Scene>> oldScenes = std::move(mSceneStack);
+	mSceneStack.clear();
+	for (auto iter = oldScenes.rbegin(); iter != oldScenes.rend(); ++iter) {
+		if (*iter) {
+			(*iter)->clean();
 		}
-		mSceneStack.pop_back();
 	}
 
 	// 初始化新场景
 	if (!scene->getIsInitialized()) {
+		engine::resource::ActiveResourceScope activeScope(scene->getResourceScope());
 		scene->init();
 	}
 
-	// 将新场景移入栈顶
+	// 将新场景移入栈顶, 之后再按栈顶到栈底的顺序销毁旧场景, 释放它们的资源范围
 	mSceneStack.push_back(std::move(scene));
+	while (!oldScenes.empty()) {
+		oldScenes.pop_back();
+	}
+	++mStackVersion;
+	mContext.getRenderer().invalidateFrameCapture();
 }
 }
@@ -11,12 +11,15 @@
 #ifndef SCENE_MANAGER_H
 #define SCENE_MANAGER_H
 
+#include <cstddef>
+#include <cstdint>
 #include <memory>
 #include <string>
 #include <vector>
+#include <glm/vec2.hpp>
 
 namespace engine::core { class Context; }
-namespace engine::scene { class Scene; }
+namespace engine::scene { class Scene; class LevelCache; struct LevelStreamingSettings; }
 
 namespace engine::scene {
 
@@ -42,10 +45,20 @@ public:
 
 	Scene* getCurrentScene() const;										///< @brief 获取当前活动场景
 	engine::core::Context& getContext() const;							///< @brief 获取引擎上下文引用
+	LevelCache& getLevelCache() const;									///< @brief 获取关卡缓存(所有场景的LevelLoader共享)
+	const LevelStreamingSettings& getLevelStreamingSettings() const;	///< @brief 获取流式关卡设置
+	void setLevelStreamingSettings(const LevelStreamingSettings& settings);	///< @brief 设置流式关卡设置(来自配置)
 
 	// 核心循环函数
 	void update(float deltaTime);										///< @brief 更新
 	void render();														///< @brief 渲染
+
+	/**
+	 * @brief 自上次render()以来是否有任何脏信号: 场景栈变化, 相机移动或缩放视口, 异步纹理上传完成, 或者任一场景的绘制版本号变化.
+	 *
+	 * 帧缓存模式下没有脏信号时GameApp不调用render(), 屏幕保持显示上一帧.
+	 */
+	bool isRenderDirty() const;
 	void handleInput();													///< @brief 处理输入
 	void clean();														///< @brief 清理
 
@@ -54,6 +67,8 @@ private:
 	void pushScene(std::unique_ptr<Scene>&& scene);						///< @brief 将一个新场景压入栈顶, 使其成为活动场景
 	void popScene();													///< @brief 移除栈顶场景
 	void replaceScene(std::unique_ptr<Scene>&& scene);					///< @brief 清理场景栈所有场景, 将此场景设为栈顶场景
+	void renderScenes(std::size_t begin, std::size_t end);				///< @brief 按顺序渲染场景栈中[begin, end)的场景
+	std::uint64_t getRenderVersion() const;								///< @brief 异步纹理数量和各场景绘制版本号之和
 
 private:
 	constexpr static std::string_view mLogTag = "SceneManager";			///< @brief 日志标识
@@ -63,6 +78,14 @@ private:
 	enum class PendingAction {None, Push, Pop, Replace };				///< @brief 待处理的动作
 	PendingAction mPendingAction = PendingAction::None;					///< @brief 待处理的动作
 	std::unique_ptr<Scene> mPendingScene;								///< @brief 待处理的场景
+	std::unique_ptr<LevelCache> mLevelCache;							///< @brief 关卡缓存, 生命周期与场景管理器相同
+	std::unique_ptr<LevelStreamingSettings> mLevelStreamingSettings;	///< @brief 流式关卡设置(GameScene据此选择LevelLoader或LevelStreamer)
+	std::uint64_t mStackVersion = 0;									///< @brief 场景栈版本号(压入, 弹出, 替换时递增)
+	bool mIsRendered = false;											///< @brief 是否已经渲染过(之后的记录才有效)
+	std::uint64_t mRenderedStackVersion = 0;							///< @brief 上次渲染时的场景栈版本号
+	std::uint64_t mRenderedVersion = 0;									///< @brief 上次渲染结束时的绘制版本号
+	glm::vec2 mRenderedCameraPosition = glm::vec2(0.f);					///< @brief 上次渲染时的相机位置
+	glm::vec2 mRenderedViewPortSize = glm::vec2(0.f);					///< @brief 上次渲染时的相机视口尺寸
 };
 } // namespace engine::scene
 
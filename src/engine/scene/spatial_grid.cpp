@@ -0,0 +1,218 @@
+#include "spatial_grid.h"
+#include <algorithm>
+#include <cmath>
+#include <spdlog/spdlog.h>
+
+namespace engine::scene {
+SpatialGrid::SpatialGrid(float cellSize)
+	: mCellSize(cellSize > 0.f ? cellSize : 256.f)
+{
+	if (cellSize <= 0.f) {
+		spdlog::warn("{} : 格子边长 {} 无效, 使用默认值 {}", mLogTag.data(), cellSize, mCellSize);
+	}
+}
+
+std::size_t SpatialGrid::insert(engine::object::GameObject* object, const engine::utils::Rect& bounds) {
+	std::size_t proxy = allocateProxy(object);
+	if (proxy == mInvalidProxy) {
+		return mInvalidProxy;
+	}
+	mProxies[proxy].mBounds = bounds;
+	addToCells(proxy);
+	++mVersion;
+	return proxy;
+}
+
+std::size_t SpatialGrid::insertAlwaysVisible(engine::object::GameObject* object) {
+	std::size_t proxy = allocateProxy(object);
+	if (proxy == mInvalidProxy) {
+		return mInvalidProxy;
+	}
+	mProxies[proxy].mIsAlwaysVisible = true;
+	mAlwaysVisible.push_back(proxy);
+	++mVersion;
+	return proxy;
+}
+
+void SpatialGrid::update(std::size_t proxy, const engine::utils::Rect& bounds) {
+	if (proxy >= mProxies.size() || !mProxies[proxy].mObject || mProxies[proxy].mIsAlwaysVisible) {
+		return;
+	}
+
+	auto& entry = mProxies[proxy];
+	if (entry.mBounds.position == bounds.position && entry.mBounds.size == bounds.size) {
+		return;
+	}
+	entry.mBounds = bounds;
+	++mVersion;
+
+	// 覆盖的格子范围不变时只需更新包围盒
+	glm::ivec2 minCell = toCell(bounds.position);
+	glm::ivec2 maxCell = toCell(bounds.position + bounds.size);
+	if (minCell == entry.mMinCell && maxCell == entry.mMaxCell) {
+		return;
+	}
+
+	removeFromCells(proxy);
+	addToCells(proxy);
+}
+
+void SpatialGrid::remove(engine::object::GameObject* object) {
+	auto iter = mObjectProxies.find(object);
+	if (iter == mObjectProxies.end()) {
+		return;
+	}
+
+	std::size_t proxy = iter->second;
+	mObjectProxies.erase(iter);
+	++mVersion;
+
+	auto& entry = mProxies[proxy];
+	if (entry.mIsAlwaysVisible) {
+		std::erase(mAlwaysVisible, proxy);
+	}
+	else {
+		removeFromCells(proxy);
+	}
+	entry = Proxy{};
+	mFreeProxies.push_back(proxy);
+}
+
+void SpatialGrid::clear() {
+	mProxies.clear();
+	mFreeProxies.clear();
+	mAlwaysVisible.clear();
+	mCells.clear();
+	mObjectProxies.clear();
+	mQueryResult.clear();
+	mNextOrder = 0;
+	++mVersion;
+}
+
+void SpatialGrid::query(const engine::utils::Rect& area, std::vector<engine::object::GameObject*>& out) {
+	out.clear();
+	mQueryResult.clear();
+
+	// 标记回绕时重置所有代理的标记, 避免误判为已查询过
+	if (++mQueryStamp == 0) {
+		for (auto& proxy : mProxies) {
+			proxy.mQueryStamp = 0;
+		}
+		mQueryStamp = 1;
+	}
+
+	const glm::vec2 areaMax = area.position + area.size;
+	glm::ivec2 minCell = toCell(area.position);
+	glm::ivec2 maxCell = toCell(areaMax);
+	for (int y = minCell.y; y <= maxCell.y; ++y) {
+		for (int x = minCell.x; x <= maxCell.x; ++x) {
+			auto cellIter = mCells.find(cellKey(x, y));
+			if (cellIter == mCells.end()) {
+				continue;
+			}
+			for (std::size_t proxy : cellIter->second) {
+				auto& entry = mProxies[proxy];
+				if (entry.mQueryStamp == mQueryStamp) {
+					continue;
+				}
+				entry.mQueryStamp = mQueryStamp;
+
+				// 格子只是粗筛, 仍需与实际包围盒做相交测试
+				const glm::vec2 boundsMax = entry.mBounds.position + entry.mBounds.size;
+				if (entry.mBounds.position.x <= areaMax.x && boundsMax.x >= area.position.x &&
+					entry.mBounds.position.y <= areaMax.y && boundsMax.y >= area.position.y) {
+					mQueryResult.push_back(proxy);
+				}
+			}
+		}
+	}
+	mQueryResult.insert(mQueryResult.end(), mAlwaysVisible.begin(), mAlwaysVisible.end());
+
+	// 恢复加入顺序, 保证绘制顺序与不裁剪时一致
+	std::sort(mQueryResult.begin(), mQueryResult.end(), [this](std::size_t lhs, std::size_t rhs) {
+		return mProxies[lhs].mOrder < mProxies[rhs].mOrder;
+	});
+
+	out.reserve(mQueryResult.size());
+	for (std::size_t proxy : mQueryResult) {
+		out.push_back(mProxies[proxy].mObject);
+	}
+}
+
+std::size_t SpatialGrid::getProxyCount() const {
+	return mObjectProxies.size();
+}
+
+std::uint64_t SpatialGrid::getVersion() const {
+	return mVersion;
+}
+
+void SpatialGrid::markChanged() {
+	++mVersion;
+}
+
+std::size_t SpatialGrid::allocateProxy(engine::object::GameObject* object) {
+	if (!object) {
+		spdlog::warn("{} : 尝试加入空对象", mLogTag.data());
+		return mInvalidProxy;
+	}
+	if (mObjectProxies.contains(object)) {
+		spdlog::warn("{} : 对象已在网格中, 忽略重复加入", mLogTag.data());
+		return mInvalidProxy;
+	}
+
+	std::size_t proxy;
+	if (!mFreeProxies.empty()) {
+		proxy = mFreeProxies.back();
+		mFreeProxies.pop_back();
+	}
+	else {
+		proxy = mProxies.size();
+		mProxies.emplace_back();
+	}
+
+	auto& entry = mProxies[proxy];
+	entry = Proxy{};
+	entry.mObject = object;
+	entry.mOrder = mNextOrder++;
+	mObjectProxies[object] = proxy;
+	return proxy;
+}
+
+void SpatialGrid::addToCells(std::size_t proxy) {
+	auto& entry = mProxies[proxy];
+	entry.mMinCell = toCell(entry.mBounds.position);
+	entry.mMaxCell = toCell(entry.mBounds.position + entry.mBounds.size);
+	for (int y = entry.mMinCell.y; y <= entry.mMaxCell.y; ++y) {
+		for (int x = entry.mMinCell.x; x <= entry.mMaxCell.x; ++x) {
+			mCells[cellKey(x, y)].push_back(proxy);
+		}
+	}
+}
+
+void SpatialGrid::removeFromCells(std::size_t proxy) {
+	auto& entry = mProxies[proxy];
+	for (int y = entry.mMinCell.y; y <= entry.mMaxCell.y; ++y) {
+		for (int x = entry.mMinCell.x; x <= entry.mMaxCell.x; ++x) {
+			auto iter = mCells.find(cellKey(x, y));
+			if (iter == mCells.end()) {
+				continue;
+			}
+			std::erase(iter->second, proxy);
+			if (iter->second.empty()) {
+				mCells.erase(iter);
+			}
+		}
+	}
+	entry.mMinCell = { 0, 0 };
+	entry.mMaxCell = { -1, -1 };
+}
+
+glm::ivec2 SpatialGrid::toCell(const glm::vec2& position) const {
+	return glm::ivec2(static_cast<int>(std::floor(position.x / mCellSize)), static_cast<int>(std::floor(position.y / mCellSize)));
+}
+
+std::int64_t SpatialGrid::cellKey(int x, int y) {
+	return (static_cast<std::int64_t>(x) << 32) | static_cast<std::uint32_t>(y);
+}
+} // namespace engine::scene
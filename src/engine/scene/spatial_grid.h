@@ -0,0 +1,98 @@
+/*****************************************************************//**
+ * @file   spatial_grid.h
+ * @brief  渲染包围盒的空间网格
+ * @version 1.0
+ *
+ * @author Shallowshades
+ * @date   2026.10.18
+ *********************************************************************/
+
+#pragma once
+#ifndef SPATIAL_GRID_H
+#define SPATIAL_GRID_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include <glm/vec2.hpp>
+#include "../utils/math.h"
+
+namespace engine::object { class GameObject; }
+
+namespace engine::scene {
+/**
+ * @brief 按固定大小的格子索引游戏对象的渲染包围盒, 用于视口裁剪.
+ *
+ * 每个对象对应一个代理(proxy), 代理记录包围盒和所覆盖的格子范围; 包围盒变化但格子范围不变时只更新包围盒.
+ * 无法给出包围盒的对象(瓦片层, 视差背景等)作为"始终可见"代理加入, 每次查询都会返回.
+ * 查询结果按加入顺序排序, 与场景中游戏对象的绘制顺序一致.
+ * 网格同时记录版本号: 代理加入, 移除, 包围盒变化或精灵外观变化时递增, 帧缓存据此判断世界层是否需要重绘.
+ */
+class SpatialGrid final {
+public:
+	static constexpr std::size_t mInvalidProxy = static_cast<std::size_t>(-1);	///< @brief 无效的代理ID
+
+	explicit SpatialGrid(float cellSize = 256.f);							///< @brief 构造函数, 指定格子边长(像素)
+
+	// 禁用拷贝和移动语义
+	SpatialGrid(const SpatialGrid&) = delete;								///< @brief 删除拷贝构造
+	SpatialGrid& operator=(const SpatialGrid&) = delete;					///< @brief 删除拷贝赋值构造
+	SpatialGrid(SpatialGrid&&) = delete;									///< @brief 删除移动构造
+	SpatialGrid& operator=(SpatialGrid&&) = delete;							///< @brief 删除移动赋值构造
+
+	std::size_t insert(engine::object::GameObject* object, const engine::utils::Rect& bounds);	///< @brief 加入带包围盒的对象, 返回代理ID
+	std::size_t insertAlwaysVisible(engine::object::GameObject* object);	///< @brief 加入始终可见的对象, 返回代理ID
+	void update(std::size_t proxy, const engine::utils::Rect& bounds);		///< @brief 更新代理的包围盒
+	void remove(engine::object::GameObject* object);						///< @brief 移除对象的代理
+	void clear();															///< @brief 清空所有代理
+
+	/**
+	 * @brief 查询与区域相交的对象(含始终可见的对象), 按加入顺序输出.
+	 *
+	 * @param area 查询区域(世界坐标)
+	 * @param out 输出: 会被清空后填充
+	 */
+	void query(const engine::utils::Rect& area, std::vector<engine::object::GameObject*>& out);
+
+	std::size_t getProxyCount() const;										///< @brief 获取代理数量
+	std::uint64_t getVersion() const;										///< @brief 获取网格的版本号, 没有变化时其中对象的绘制结果与上次相同
+	void markChanged();														///< @brief 对象的外观(源矩形, 翻转, 隐藏等)变化但包围盒不变时递增版本号
+
+private:
+	/**
+	 * @brief 对象在网格中的代理.
+	 */
+	struct Proxy {
+		engine::object::GameObject* mObject = nullptr;						///< @brief 对应的游戏对象, 为空表示空闲
+		engine::utils::Rect mBounds = {};									///< @brief 渲染包围盒(世界坐标)
+		glm::ivec2 mMinCell = { 0, 0 };										///< @brief 覆盖的最小格子
+		glm::ivec2 mMaxCell = { -1, -1 };									///< @brief 覆盖的最大格子(小于最小格子表示不在任何格子中)
+		std::uint64_t mOrder = 0;											///< @brief 加入顺序, 用于保持绘制顺序
+		std::uint32_t mQueryStamp = 0;										///< @brief 最近一次被查询到的标记, 用于去重
+		bool mIsAlwaysVisible = false;										///< @brief 是否始终可见
+	};
+
+	std::size_t allocateProxy(engine::object::GameObject* object);			///< @brief 分配代理(优先复用空闲代理)
+	void addToCells(std::size_t proxy);										///< @brief 将代理加入其覆盖的格子
+	void removeFromCells(std::size_t proxy);								///< @brief 将代理从其覆盖的格子中移除
+	glm::ivec2 toCell(const glm::vec2& position) const;						///< @brief 世界坐标转格子坐标
+	static std::int64_t cellKey(int x, int y);								///< @brief 格子坐标转哈希键
+
+private:
+	static constexpr std::string_view mLogTag = "SpatialGrid";				///< @brief 日志标识
+	float mCellSize = 256.f;												///< @brief 格子边长
+	std::vector<Proxy> mProxies;											///< @brief 所有代理
+	std::vector<std::size_t> mFreeProxies;									///< @brief 空闲代理ID
+	std::vector<std::size_t> mAlwaysVisible;								///< @brief 始终可见的代理ID
+	std::unordered_map<std::int64_t, std::vector<std::size_t>> mCells;		///< @brief 格子 -> 代理ID列表
+	std::unordered_map<const engine::object::GameObject*, std::size_t> mObjectProxies;	///< @brief 对象 -> 代理ID
+	std::vector<std::size_t> mQueryResult;									///< @brief 查询时复用的代理ID数组
+	std::uint64_t mNextOrder = 0;											///< @brief 下一个加入顺序
+	std::uint32_t mQueryStamp = 0;											///< @brief 当前查询标记
+	std::uint64_t mVersion = 0;												///< @brief 版本号
+};
+} // namespace engine::scene
+
+#endif // !SPATIAL_GRID_H
@@ -0,0 +1,293 @@
+#include "tiled_layer_data.h"
+#include <spdlog/spdlog.h>
+#include <zlib.h>
+#ifdef SUNNYLAND_HAS_ZSTD
+#include <zstd.h>
+#endif
+#include <array>
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <optional>
+
+namespace engine::scene {
+namespace {
+constexpr std::string_view mLogTag = "TiledLayerData";
+constexpr std::size_t mInputBufferSize = 16 * 1024;						///< @brief base64分段解码缓冲区大小
+constexpr std::size_t mOutputBufferSize = 16 * 1024;						///< @brief 解压缩输出缓冲区大小
+
+/**
+ * @brief 把uint32小端gid字节流转换为uint16写入gid数组. 字节可以分多次写入, 不要求按4字节对齐.
+ */
+class GidWriter final {
+public:
+	GidWriter(std::span<std::uint16_t> gids, int& invalidGidCount)
+		: mGids(gids)
+		, mInvalidGidCount(invalidGidCount)
+	{
+	}
+
+	/**
+	 * @brief 写入一段字节.
+	 * @return 是否成功, 瓦片数量超出gid数组大小时返回false, 之后不再接受写入
+	 */
+	bool write(std::span<const std::byte> bytes) {
+		if (mIsOverflowed) {
+			return false;
+		}
+		std::size_t index = 0;
+		// 先补齐上次剩下的不完整gid
+		while (mPendingBytes > 0 && index < bytes.size()) {
+			mPending[mPendingBytes++] = bytes[index++];
+			if (mPendingBytes == mPending.size()) {
+				mPendingBytes = 0;
+				if (!push(mPending.data())) {
+					return false;
+				}
+			}
+		}
+		for (; index + 4 <= bytes.size(); index += 4) {
+			if (!push(bytes.data() + index)) {
+				return false;
+			}
+		}
+		while (index < bytes.size()) {
+			mPending[mPendingBytes++] = bytes[index++];
+		}
+		return true;
+	}
+
+	bool isComplete() const { return !mIsOverflowed && mCount == mGids.size() && mPendingBytes == 0; }
+	bool isOverflowed() const { return mIsOverflowed; }
+	std::size_t getCount() const { return mCount; }
+
+private:
+	bool push(const std::byte* bytes) {
+		if (mCount == mGids.size()) {
+			mIsOverflowed = true;
+			return false;
+		}
+		std::uint32_t gid = static_cast<std::uint32_t>(bytes[0])
+			| static_cast<std::uint32_t>(bytes[1]) << 8
+			| static_cast<std::uint32_t>(bytes[2]) << 16
+			| static_cast<std::uint32_t>(bytes[3]) << 24;
+		if (gid > std::numeric_limits<std::uint16_t>::max()) {
+			++mInvalidGidCount;
+			gid = 0;
+		}
+		mGids[mCount++] = static_cast<std::uint16_t>(gid);
+		return true;
+	}
+
+private:
+	std::span<std::uint16_t> mGids;											///< @brief 输出的gid数组
+	int& mInvalidGidCount;													///< @brief 超出范围的gid数量
+	std::size_t mCount = 0;													///< @brief 已写入的gid数量
+	std::array<std::byte, 4> mPending{};									///< @brief 不完整的gid字节
+	std::size_t mPendingBytes = 0;											///< @brief 不完整的gid字节数
+	bool mIsOverflowed = false;												///< @brief 瓦片数量是否超出gid数组大小
+};
+
+int getBase64Value(char c) {
+	if (c >= 'A' && c <= 'Z') return c - 'A';
+	if (c >= 'a' && c <= 'z') return c - 'a' + 26;
+	if (c >= '0' && c <= '9') return c - '0' + 52;
+	if (c == '+') return 62;
+	if (c == '/') return 63;
+	return -1;
+}
+
+/**
+ * @brief 分段解码base64字符串, 跳过空白字符, 遇到'='结束. 每次最多解码一个缓冲区, 不保存完整的解码结果.
+ */
+class Base64Reader final {
+public:
+	explicit Base64Reader(std::string_view text)
+		: mText(text)
+	{
+	}
+
+	/**
+	 * @brief 解码下一段数据.
+	 * @return 解码得到的字节(指向内部缓冲区, 下一次调用前有效), 数据结束时为空; 有无效字符时返回std::nullopt(已输出错误日志)
+	 */
+	std::optional<std::span<const std::byte>> read() {
+		std::size_t count = 0;
+		while (count < mBuffer.size() && mPosition < mText.size()) {
+			char c = mText[mPosition++];
+			if (c == '=') {
+				mPosition = mText.size();
+				break;
+			}
+			if (c == ' ' || c == '\n' || c == '\r' || c == '\t') {
+				continue;
+			}
+			int value = getBase64Value(c);
+			if (value < 0) {
+				spdlog::error("{} : base64数据中有无效字符 '{}'", mLogTag.data(), c);
+				return std::nullopt;
+			}
+			mBits = (mBits << 6) | static_cast<std::uint32_t>(value);
+			mBitCount += 6;
+			if (mBitCount >= 8) {
+				mBitCount -= 8;
+				mBuffer[count++] = static_cast<std::byte>((mBits >> mBitCount) & 0xFF);
+			}
+		}
+		return std::span<const std::byte>(mBuffer.data(), count);
+	}
+
+private:
+	std::string_view mText;													///< @brief base64字符串
+	std::size_t mPosition = 0;												///< @brief 下一个读取的字符位置
+	std::uint32_t mBits = 0;												///< @brief 尚未输出的位
+	int mBitCount = 0;														///< @brief 尚未输出的位数
+	std::array<std::byte, mInputBufferSize> mBuffer;						///< @brief 解码输出缓冲区
+};
+
+/**
+ * @brief 把未压缩的数据直接写入writer. 瓦片数量超出图层大小时提前结束, 由调用者检查writer.
+ * @return 数据是否有效(无效时已输出错误日志)
+ */
+bool copyData(Base64Reader& reader, GidWriter& writer) {
+	while (true) {
+		auto input = reader.read();
+		if (!input) {
+			return false;
+		}
+		if (input->empty() || !writer.write(*input)) {
+			return true;
+		}
+	}
+}
+
+/**
+ * @brief 解压zlib或gzip数据, 输入按段从reader读取. 瓦片数量超出图层大小时提前结束, 由调用者检查writer.
+ * @param isGzip 是否为gzip格式
+ * @return 数据是否有效(无效时已输出错误日志)
+ */
+bool inflateData(Base64Reader& reader, bool isGzip, GidWriter& writer) {
+	z_stream stream{};
+	if (inflateInit2(&stream, isGzip ? MAX_WBITS + 16 : MAX_WBITS) != Z_OK) {
+		spdlog::error("{} : 初始化zlib失败", mLogTag.data());
+		return false;
+	}
+
+	std::array<std::byte, mOutputBufferSize> buffer;
+	int result = Z_OK;
+	bool isWritten = true;
+	bool isInputEnd = false;
+	// 输入用完时inflate返回Z_BUF_ERROR, 还有base64数据时读取下一段继续
+	while (isWritten && (result == Z_OK || (result == Z_BUF_ERROR && stream.avail_in == 0 && !isInputEnd))) {
+		if (stream.avail_in == 0 && !isInputEnd) {
+			auto input = reader.read();
+			if (!input) {
+				inflateEnd(&stream);
+				return false;
+			}
+			isInputEnd = input->empty();
+			stream.next_in = reinterpret_cast<Bytef*>(const_cast<std::byte*>(input->data()));
+			stream.avail_in = static_cast<uInt>(input->size());
+		}
+		stream.next_out = reinterpret_cast<Bytef*>(buffer.data());
+		stream.avail_out = static_cast<uInt>(buffer.size());
+		result = inflate(&stream, Z_NO_FLUSH);
+		isWritten = writer.write(std::span<const std::byte>(buffer.data(), buffer.size() - stream.avail_out));
+	}
+	std::string_view message = stream.msg ? stream.msg : "数据不完整";
+	inflateEnd(&stream);
+	if (isWritten && result != Z_STREAM_END) {
+		spdlog::error("{} : 解压{}数据失败: {}", mLogTag.data(), isGzip ? "gzip" : "zlib", message);
+		return false;
+	}
+	return true;
+}
+
+#ifdef SUNNYLAND_HAS_ZSTD
+/**
+ * @brief 解压zstd数据, 输入按段从reader读取. 瓦片数量超出图层大小时提前结束, 由调用者检查writer.
+ * @return 数据是否有效(无效时已输出错误日志)
+ */
+bool decompressZstd(Base64Reader& reader, GidWriter& writer) {
+	std::unique_ptr<ZSTD_DCtx, decltype(&ZSTD_freeDCtx)> context(ZSTD_createDCtx(), &ZSTD_freeDCtx);
+	if (!context) {
+		spdlog::error("{} : 初始化zstd失败", mLogTag.data());
+		return false;
+	}
+	ZSTD_inBuffer in{ nullptr, 0, 0 };
+	bool isInputEnd = false;
+	std::array<std::byte, mOutputBufferSize> buffer;
+	std::size_t result = 1;
+	while (result != 0) {
+		if (in.pos == in.size && !isInputEnd) {
+			auto input = reader.read();
+			if (!input) {
+				return false;
+			}
+			isInputEnd = input->empty();
+			in = ZSTD_inBuffer{ input->data(), input->size(), 0 };
+		}
+		ZSTD_outBuffer out{ buffer.data(), buffer.size(), 0 };
+		result = ZSTD_decompressStream(context.get(), &out, &in);
+		if (ZSTD_isError(result)) {
+			spdlog::error("{} : 解压zstd数据失败: {}", mLogTag.data(), ZSTD_getErrorName(result));
+			return false;
+		}
+		if (!writer.write(std::span<const std::byte>(buffer.data(), out.pos))) {
+			return true;
+		}
+		// 输入已读完且没有输出, 但帧还没有结束
+		if (result != 0 && isInputEnd && in.pos == in.size && out.pos < out.size) {
+			spdlog::error("{} : 解压zstd数据失败: 数据不完整", mLogTag.data());
+			return false;
+		}
+	}
+	return true;
+}
+#endif
+} // namespace
+
+bool isTiledCompressionSupported(std::string_view compression) {
+#ifdef SUNNYLAND_HAS_ZSTD
+	if (compression == "zstd") {
+		return true;
+	}
+#endif
+	return compression.empty() || compression == "zlib" || compression == "gzip";
+}
+
+bool decodeTiledLayerData(std::string_view data, std::string_view compression, std::span<std::uint16_t> gids, int& invalidGidCount) {
+	if (!isTiledCompressionSupported(compression)) {
+		spdlog::error("{} : 不支持的压缩方式 '{}'", mLogTag.data(), compression);
+		return false;
+	}
+
+	Base64Reader reader(data);
+	GidWriter writer(gids, invalidGidCount);
+	bool isDecoded = true;
+	if (compression.empty()) {
+		isDecoded = copyData(reader, writer);
+	}
+	else if (compression == "zlib" || compression == "gzip") {
+		isDecoded = inflateData(reader, compression == "gzip", writer);
+	}
+#ifdef SUNNYLAND_HAS_ZSTD
+	else if (compression == "zstd") {
+		isDecoded = decompressZstd(reader, writer);
+	}
+#endif
+	if (!isDecoded) {
+		return false;
+	}
+	if (!writer.isComplete()) {
+		if (writer.isOverflowed()) {
+			spdlog::error("{} : 瓦片数据超出图层大小 ({} 个瓦片)", mLogTag.data(), gids.size());
+		}
+		else {
+			spdlog::error("{} : 瓦片数据不完整: 需要 {} 个瓦片, 解码得到 {} 个", mLogTag.data(), gids.size(), writer.getCount());
+		}
+		return false;
+	}
+	return true;
+}
+} // namespace engine::scene
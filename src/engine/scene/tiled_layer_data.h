@@ -0,0 +1,39 @@
+/*****************************************************************//**
+ * @file   tiled_layer_data.h
+ * @brief  Tiled瓦片图层的base64编码数据解码(可选zlib, gzip, zstd压缩)
+ * @version 1.0
+ *
+ * @author Shallowshades
+ * @date   2026.10.18
+ *********************************************************************/
+
+#pragma once
+#ifndef TILED_LAYER_DATA_H
+#define TILED_LAYER_DATA_H
+
+#include <cstdint>
+#include <span>
+#include <string_view>
+
+namespace engine::scene {
+/**
+ * @brief 当前构建是否支持某种压缩方式. 空字符串表示不压缩, 总是支持.
+ */
+bool isTiledCompressionSupported(std::string_view compression);
+
+/**
+ * @brief 解码Tiled瓦片图层的base64数据, 写入gid数组.
+ *
+ * 解码后的数据是按行排列的uint32小端gid. 解压缩输出到一个小缓冲区, 每次转换为uint16直接写入gids,
+ * 不生成完整的中间数组; gid超出uint16范围(包括Tiled的翻转标志位)时按空瓦片处理并计数.
+ *
+ * @param data base64字符串
+ * @param compression 压缩方式: ""(不压缩), "zlib", "gzip" 或 "zstd"
+ * @param gids 输出的gid数组, 大小必须等于瓦片数量
+ * @param invalidGidCount 累加超出范围的gid数量
+ * @return 是否成功; 数据无效, 解码后的瓦片数量与gids大小不一致或不支持该压缩方式时返回false(已输出错误日志)
+ */
+bool decodeTiledLayerData(std::string_view data, std::string_view compression, std::span<std::uint16_t> gids, int& invalidGidCount);
+} // namespace engine::scene
+
+#endif // !TILED_LAYER_DATA_H
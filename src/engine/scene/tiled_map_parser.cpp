@@ -0,0 +1,815 @@
+#include "tiled_map_parser.h"
+#include "level_cache.h"
+#include "tiled_layer_data.h"
+#include "../resource/asset_pack.h"
+#include "../resource/mapped_file.h"
+#include <spdlog/spdlog.h>
+#include <algorithm>
+#include <filesystem>
+#include <glm/common.hpp>
+#include <limits>
+#include <memory>
+
+namespace engine::scene {
+TiledMapParser::TiledMapParser(const engine::resource::AssetPack* assetPack, LevelCache* levelCache)
+	: mAssetPack(assetPack)
+	, mLevelCache(levelCache)
+{
+}
+
+/**
+ * @brief 流式解析得到的单个图层: 除"data"数组外的内容组成的小json对象, 以及直接写入的gid.
+ */
+struct TiledMapParser::StreamedLayer {
+	nlohmann::json mJson;													///< @brief 图层json(不含"data"数组)
+	std::vector<std::uint16_t> mGids;										///< @brief "data"数组中的gid
+	bool mHasGids = false;													///< @brief 是否有"data"数组
+	int mInvalidGidCount = 0;												///< @brief 超出uint16范围或不是整数的gid数量
+	std::optional<ChunkedLayer> mChunkedLayer;								///< @brief 按块存储(无限地图)时图层的范围
+};
+
+/**
+ * @brief 地图的SAX解析器.
+ *
+ * 除"layers"数组外的内容(尺寸, 瓦片集等, 数据量很小)照常组成json对象; "layers"中的每个图层单独组成json对象,
+ * 在图层结束时交给回调处理后丢弃, 图层的"data"数组不生成json节点, 数字直接写入预留好容量的gid数组.
+ * 因此峰值内存只有最大的一个图层(不含瓦片数据)和gid数组本身.
+ */
+class TiledMapParser::MapSaxHandler final : public nlohmann::json_sax<nlohmann::json> {
+public:
+	using LayerCallback = std::function<void(StreamedLayer&)>;
+
+	explicit MapSaxHandler(LayerCallback onLayer) : mOnLayer(std::move(onLayer)) {}
+
+	const nlohmann::json& getRoot() const { return mRoot; }
+	bool hasLayers() const { return mHasLayers; }
+	const std::string& getError() const { return mError; }
+	std::size_t getErrorByte() const { return mErrorByte; }
+
+	bool null() override { return mInGids ? addGid(std::nullopt) : addScalar(nullptr); }
+	bool boolean(bool value) override { return mInGids ? addGid(std::nullopt) : addScalar(value); }
+	bool number_integer(number_integer_t value) override {
+		return mInGids ? addGid(value >= 0 ? std::optional<std::uint64_t>(static_cast<std::uint64_t>(value)) : std::nullopt) : addScalar(value);
+	}
+	bool number_unsigned(number_unsigned_t value) override { return mInGids ? addGid(value) : addScalar(value); }
+	bool number_float(number_float_t value, const string_t&) override { return mInGids ? addGid(std::nullopt) : addScalar(value); }
+	bool string(string_t& value) override { return mInGids ? addGid(std::nullopt) : addScalar(std::move(value)); }
+	bool binary(binary_t& value) override { return mInGids ? addGid(std::nullopt) : addScalar(nlohmann::json::binary(std::move(value))); }
+
+	bool start_object(std::size_t) override {
+		if (mInGids) {
+			return fail("瓦片图层的 'data' 数组中只能是整数");
+		}
+		// "layers"数组中的元素: 开始一个新图层
+		if (mInLayers && !mInLayer) {
+			mInLayer = true;
+			mLayer = StreamedLayer();
+			mLayer.mJson = nlohmann::json::object();
+			mLayer.mGids.reserve(mGidCapacity);
+			mStack.push_back(&mLayer.mJson);
+		}
+		else {
+			mStack.push_back(addContainer(nlohmann::json::object()));
+		}
+		++mDepth;
+		return true;
+	}
+
+	bool end_object() override {
+		--mDepth;
+		mStack.pop_back();
+		// 图层结束: 交给回调处理, 后续图层按本图层的瓦片数量预留容量(有限地图的瓦片图层尺寸相同)
+		if (mInLayer && mDepth == 2) {
+			mInLayer = false;
+			mGidCapacity = std::max(mGidCapacity, mLayer.mGids.size());
+			mOnLayer(mLayer);
+		}
+		return true;
+	}
+
+	bool start_array(std::size_t) override {
+		if (mInGids) {
+			return fail("瓦片图层的 'data' 数组中只能是整数");
+		}
+		if (mDepth == 1 && !mInLayers && mKey == "layers") {
+			mInLayers = true;
+			mHasLayers = true;
+		}
+		else if (mInLayers && !mInLayer) {
+			return fail("'layers' 数组中的元素必须是对象");
+		}
+		else if (mInLayer && mDepth == 3 && mKey == "data") {
+			mInGids = true;
+			mLayer.mHasGids = true;
+		}
+		else {
+			mStack.push_back(addContainer(nlohmann::json::array()));
+		}
+		++mDepth;
+		return true;
+	}
+
+	bool end_array() override {
+		--mDepth;
+		if (mInGids) {
+			mInGids = false;
+		}
+		else if (mInLayers && !mInLayer) {
+			mInLayers = false;
+		}
+		else {
+			mStack.pop_back();
+		}
+		return true;
+	}
+
+	bool key(string_t& value) override {
+		mKey = std::move(value);
+		return true;
+	}
+
+	bool parse_error(std::size_t position, const std::string&, const nlohmann::json::exception& e) override {
+		mError = e.what();
+		mErrorByte = position;
+		return false;
+	}
+
+private:
+	bool fail(std::string_view message) {
+		mError = std::string(message);
+		return false;
+	}
+
+	/**
+	 * @brief 写入一个gid. gid按uint16存储, 超出范围(包括Tiled的翻转标志位)或不是非负整数的按空瓦片处理.
+	 */
+	bool addGid(std::optional<std::uint64_t> value) {
+		if (!value || value.value() > std::numeric_limits<std::uint16_t>::max()) {
+			++mLayer.mInvalidGidCount;
+			value = 0;
+		}
+		mLayer.mGids.push_back(static_cast<std::uint16_t>(value.value()));
+		return true;
+	}
+
+	bool addScalar(nlohmann::json&& value) {
+		if (mInLayers && !mInLayer) {
+			return fail("'layers' 数组中的元素必须是对象");
+		}
+		addContainer(std::move(value));
+		return true;
+	}
+
+	/**
+	 * @brief 把值加入当前打开的对象或数组, 返回加入后的节点.
+	 */
+	nlohmann::json* addContainer(nlohmann::json&& value) {
+		if (mStack.empty()) {
+			mRoot = std::move(value);
+			return &mRoot;
+		}
+		nlohmann::json* parent = mStack.back();
+		if (parent->is_array()) {
+			parent->push_back(std::move(value));
+			return &parent->back();
+		}
+		auto& slot = (*parent)[mKey];
+		slot = std::move(value);
+		return &slot;
+	}
+
+private:
+	LayerCallback mOnLayer;													///< @brief 图层结束时的回调
+	nlohmann::json mRoot;													///< @brief 地图json(不含"layers")
+	StreamedLayer mLayer;													///< @brief 正在解析的图层
+	std::vector<nlohmann::json*> mStack;									///< @brief 当前打开的json对象或数组
+	std::string mKey;														///< @brief 最近读取的键
+	int mDepth = 0;															///< @brief 嵌套深度(地图对象为1, 图层对象为3)
+	bool mInLayers = false;													///< @brief 是否在"layers"数组中
+	bool mInLayer = false;													///< @brief 是否在某个图层对象中
+	bool mInGids = false;													///< @brief 是否在图层的"data"数组中
+	bool mHasLayers = false;												///< @brief 是否读到了"layers"数组
+	std::size_t mGidCapacity = 0;											///< @brief 为下一个图层预留的gid容量
+	std::string mError;														///< @brief 错误信息
+	std::size_t mErrorByte = 0;												///< @brief 错误位置
+};
+
+bool TiledMapParser::parse(std::string_view mapPath, LevelData& level) {
+	mMapPath = std::string(mapPath);
+	mChunkedLayers.clear();
+	level = LevelData();
+	level.mMapPath = mMapPath;
+	level.mSourceFiles.push_back(mMapPath);
+
+	// 1. 流式解析json文件(优先从资源包读取), 图层在读到时立即转换为LevelLayer
+	MapSaxHandler handler([this, &level](StreamedLayer& streamedLayer) { parseLayer(streamedLayer, level); });
+	bool isParsed = readFileBytes(mapPath, [this, &handler](std::span<const std::byte> bytes) {
+		const char* begin = reinterpret_cast<const char*>(bytes.data());
+		try {
+			if (!nlohmann::json::sax_parse(begin, begin + bytes.size(), &handler)) {
+				spdlog::error("{} : 解析 JSON 文件 '{}' 失败: {} (at byte {})", mLogTag.data(), mMapPath, handler.getError(), handler.getErrorByte());
+				return false;
+			}
+		}
+		catch (const nlohmann::json::exception& e) {
+			spdlog::error("{} : 解析地图 '{}' 失败: {}", mLogTag.data(), mMapPath, e.what());
+			return false;
+		}
+		return true;
+	});
+	if (!isParsed) {
+		return false;
+	}
+	const auto& data = handler.getRoot();
+	if (!data.is_object()) {
+		spdlog::error("{} : 地图文件 {} 不是 JSON 对象.", mLogTag.data(), mMapPath);
+		return false;
+	}
+
+	// 2.获取基本地图信息 (名称, 地图尺寸, 瓦片尺寸)
+	mTileSize = glm::ivec2(data.value("tilewidth", 0), data.value("tileheight", 0));
+	level.mMapSize = glm::ivec2(data.value("width", 0), data.value("height", 0));
+	level.mTileSize = mTileSize;
+
+	// 3.加载tileset数据
+	if (data.contains("tilesets") && data["tilesets"].is_array()) {
+		for (const auto& tileset : data["tilesets"]) {
+			if (!tileset.contains("source") || !tileset["source"].is_string() || !tileset.contains("firstgid") || !tileset["firstgid"].is_number_integer()) {
+				spdlog::error("{} : tilesets 对象中缺少有效 'source' 或 'firstgid' 字段", mLogTag.data());
+				continue;
+			}
+			auto tilesetPath = resolvePath(tileset["source"].get<std::string>(), mMapPath);
+			int firstGid = tileset["firstgid"];
+			if (loadTileset(tilesetPath, firstGid, level)) {
+				level.mSourceFiles.push_back(tilesetPath);
+			}
+		}
+	}
+
+	// 4.图层已在解析时加入, 无限地图的图层按块拼接后再对齐到整张地图
+	if (!handler.hasLayers()) {
+		spdlog::error("{} : 地图文件 {} 缺少或者无效的 'layers' 数组.", mLogTag.data(), mMapPath);
+		return false;
+	}
+	if (!mChunkedLayers.empty()) {
+		alignChunkedLayers(level);
+	}
+
+	spdlog::info("{} : 地图解析完成: {}", mLogTag.data(), mMapPath);
+	return true;
+}
+
+void TiledMapParser::parseLayer(StreamedLayer& streamedLayer, LevelData& level) {
+	const auto& layerData = streamedLayer.mJson;
+	// 获取各图层对象中的类型type字段
+	std::string layerType = layerData.value("type", "none");
+	if (!layerData.value("visible", true)) {
+		spdlog::info("{} : 图层 '{}' 不可见, 跳过加载.", mLogTag.data(), layerData.value("name", "Unnamed"));
+		return;
+	}
+
+	// 根据图层类型决定解析方法
+	LevelLayer layer;
+	layer.mName = layerData.value("name", "Unnamed");
+	bool isParsed = false;
+	if (layerType == "imagelayer") {
+		isParsed = parseImageLayer(layerData, layer);
+	}
+	else if (layerType == "tilelayer") {
+		isParsed = parseTileLayer(streamedLayer, layer);
+	}
+	else if (layerType == "objectgroup") {
+		isParsed = parseObjectLayer(layerData, layer);
+	}
+	else {
+		spdlog::warn("{} : 不支持的图层类型: {}", mLogTag.data(), layerType);
+	}
+	if (isParsed) {
+		if (streamedLayer.mChunkedLayer) {
+			streamedLayer.mChunkedLayer->mLayerIndex = level.mLayers.size();
+			mChunkedLayers.push_back(streamedLayer.mChunkedLayer.value());
+		}
+		level.mLayers.push_back(std::move(layer));
+	}
+}
+
+bool TiledMapParser::parseImageLayer(const nlohmann::json& layerJson, LevelLayer& layer) {
+	// 获取纹理相对路径 (会自动处理'\/'符号)
+	std::string imagePath = layerJson.value("image", ""); // json.value() 返回的是一个临时对象
+	if (imagePath.empty()) {
+		spdlog::error("{} : 图层 '{}' 缺少 'image' 属性.", mLogTag.data(), layer.mName);
+		return false;
+	}
+
+	layer.mType = LevelLayerType::Image;
+	// 解析图片路径
+	layer.mImage = resolvePath(imagePath, mMapPath);
+	// 获取图层偏移量
+	layer.mOffset = glm::vec2(layerJson.value("offsetx", 0.f), layerJson.value("offsety", 0.f));
+	// 获取视差因子及重复标志
+	layer.mScrollFactor = glm::vec2(layerJson.value("parallaxx", 1.f), layerJson.value("parallaxy", 1.f));
+	layer.mRepeat = glm::bvec2(layerJson.value("repeatx", false), layerJson.value("repeaty", false));
+
+	/// TODO: 待获取其他属性
+	return true;
+}
+
+bool TiledMapParser::parseTileLayer(StreamedLayer& streamedLayer, LevelLayer& layer) {
+	const auto& layerJson = streamedLayer.mJson;
+	layer.mType = LevelLayerType::Tile;
+	if (streamedLayer.mHasGids) {
+		// 图层数据 (瓦片id列表) 已在解析时写入
+		layer.mGids = std::move(streamedLayer.mGids);
+	}
+	else if (layerJson.contains("data") && layerJson["data"].is_string()) {
+		// base64编码(可选压缩)的图层数据, 解码后直接写入gid数组
+		int width = layerJson.value("width", 0);
+		int height = layerJson.value("height", 0);
+		if (width <= 0 || height <= 0) {
+			spdlog::error("{} : 瓦片图层 '{}' 缺少有效的 'width' 或 'height' 属性.", mLogTag.data(), layer.mName);
+			return false;
+		}
+		layer.mGids.assign(static_cast<std::size_t>(width) * height, 0);
+		if (!readTileData(layerJson, layerJson["data"], layer.mGids, streamedLayer.mInvalidGidCount)) {
+			spdlog::error("{} : 瓦片图层 '{}' 的数据无效.", mLogTag.data(), layer.mName);
+			return false;
+		}
+	}
+	else if (layerJson.contains("chunks") && layerJson["chunks"].is_array()) {
+		// 无限地图: 按块存储, 先拼接为图层自身范围的数组, 解析结束后再对齐到整张地图
+		ChunkedLayer chunkedLayer;
+		if (!parseChunks(layerJson, layer, chunkedLayer, streamedLayer.mInvalidGidCount)) {
+			return false;
+		}
+		streamedLayer.mChunkedLayer = chunkedLayer;
+	}
+	else {
+		spdlog::error("{} 图层 '{}' 缺少 'data' 属性.", mLogTag.data(), layer.mName);
+		return false;
+	}
+
+	if (streamedLayer.mInvalidGidCount > 0) {
+		spdlog::error("{} : 瓦片图层 '{}' 中有 {} 个gid超出支持范围, 已按空瓦片处理.", mLogTag.data(), layer.mName, streamedLayer.mInvalidGidCount);
+	}
+	return true;
+}
+
+bool TiledMapParser::parseChunks(const nlohmann::json& layerJson, LevelLayer& layer, ChunkedLayer& chunkedLayer, int& invalidGidCount) {
+	chunkedLayer.mStart = glm::ivec2(layerJson.value("startx", 0), layerJson.value("starty", 0));
+	chunkedLayer.mSize = glm::ivec2(layerJson.value("width", 0), layerJson.value("height", 0));
+	if (chunkedLayer.mSize.x < 0 || chunkedLayer.mSize.y < 0) {
+		spdlog::error("{} : 瓦片图层 '{}' 的尺寸无效.", mLogTag.data(), layer.mName);
+		return false;
+	}
+	layer.mGids.assign(static_cast<std::size_t>(chunkedLayer.mSize.x) * chunkedLayer.mSize.y, 0);
+
+	// 块通常很小(默认16x16), 复用同一个缓冲区解码后按行拷贝
+	std::vector<std::uint16_t> chunkGids;
+	for (const auto& chunk : layerJson["chunks"]) {
+		if (!chunk.is_object() || !chunk.contains("data")) {
+			spdlog::error("{} : 瓦片图层 '{}' 中有无效的块.", mLogTag.data(), layer.mName);
+			return false;
+		}
+		glm::ivec2 position(chunk.value("x", 0), chunk.value("y", 0));
+		glm::ivec2 size(chunk.value("width", 0), chunk.value("height", 0));
+		glm::ivec2 offset = position - chunkedLayer.mStart;
+		if (size.x <= 0 || size.y <= 0 || offset.x < 0 || offset.y < 0
+			|| offset.x + size.x > chunkedLayer.mSize.x || offset.y + size.y > chunkedLayer.mSize.y) {
+			spdlog::error("{} : 瓦片图层 '{}' 中的块 ({}, {}) 超出图层范围.", mLogTag.data(), layer.mName, position.x, position.y);
+			return false;
+		}
+		chunkGids.assign(static_cast<std::size_t>(size.x) * size.y, 0);
+		if (!readTileData(layerJson, chunk["data"], chunkGids, invalidGidCount)) {
+			spdlog::error("{} : 瓦片图层 '{}' 中块 ({}, {}) 的数据无效.", mLogTag.data(), layer.mName, position.x, position.y);
+			return false;
+		}
+		for (int y = 0; y < size.y; ++y) {
+			std::copy_n(chunkGids.begin() + static_cast<std::ptrdiff_t>(y) * size.x, size.x,
+				layer.mGids.begin() + static_cast<std::ptrdiff_t>(offset.y + y) * chunkedLayer.mSize.x + offset.x);
+		}
+	}
+	return true;
+}
+
+bool TiledMapParser::readTileData(const nlohmann::json& layerJson, const nlohmann::json& dataJson, std::span<std::uint16_t> gids, int& invalidGidCount) {
+	if (dataJson.is_string()) {
+		std::string encoding = layerJson.value("encoding", "csv");
+		if (encoding != "base64") {
+			spdlog::error("{} : 不支持的图层数据编码 '{}'", mLogTag.data(), encoding);
+			return false;
+		}
+		return decodeTiledLayerData(dataJson.get_ref<const std::string&>(), layerJson.value("compression", ""), gids, invalidGidCount);
+	}
+	if (!dataJson.is_array() || dataJson.size() != gids.size()) {
+		spdlog::error("{} : 图层数据与图层大小不一致: 需要 {} 个瓦片", mLogTag.data(), gids.size());
+		return false;
+	}
+	for (std::size_t i = 0; i < gids.size(); ++i) {
+		const auto& gid = dataJson[i];
+		if (gid.is_number_unsigned() && gid.get<std::uint64_t>() <= std::numeric_limits<std::uint16_t>::max()) {
+			gids[i] = gid.get<std::uint16_t>();
+		}
+		else {
+			gids[i] = 0;
+			++invalidGidCount;
+		}
+	}
+	return true;
+}
+
+void TiledMapParser::alignChunkedLayers(LevelData& level) {
+	// 所有按块存储的图层的并集作为地图范围, 左上角移动到原点
+	glm::ivec2 minTile(std::numeric_limits<int>::max());
+	glm::ivec2 maxTile(std::numeric_limits<int>::min());
+	for (const auto& chunkedLayer : mChunkedLayers) {
+		if (chunkedLayer.mSize.x > 0 && chunkedLayer.mSize.y > 0) {
+			minTile = glm::min(minTile, chunkedLayer.mStart);
+			maxTile = glm::max(maxTile, chunkedLayer.mStart + chunkedLayer.mSize);
+		}
+	}
+	if (minTile.x > maxTile.x) {
+		minTile = maxTile = glm::ivec2(0);
+	}
+	const glm::ivec2 mapSize = maxTile - minTile;
+
+	for (const auto& chunkedLayer : mChunkedLayers) {
+		auto& gids = level.mLayers[chunkedLayer.mLayerIndex].mGids;
+		if (chunkedLayer.mStart == minTile && chunkedLayer.mSize == mapSize) {
+			continue;
+		}
+		std::vector<std::uint16_t> alignedGids(static_cast<std::size_t>(mapSize.x) * mapSize.y, 0);
+		glm::ivec2 offset = chunkedLayer.mStart - minTile;
+		for (int y = 0; y < chunkedLayer.mSize.y; ++y) {
+			std::copy_n(gids.begin() + static_cast<std::ptrdiff_t>(y) * chunkedLayer.mSize.x, chunkedLayer.mSize.x,
+				alignedGids.begin() + static_cast<std::ptrdiff_t>(offset.y + y) * mapSize.x + offset.x);
+		}
+		gids = std::move(alignedGids);
+	}
+
+	// 对象和图片图层使用像素坐标, 随原点一起移动
+	glm::vec2 pixelOffset = glm::vec2(minTile * mTileSize);
+	for (auto& layer : level.mLayers) {
+		if (layer.mType == LevelLayerType::Image) {
+			layer.mOffset -= pixelOffset;
+		}
+		for (auto& object : layer.mObjects) {
+			object.mPosition -= pixelOffset;
+		}
+	}
+	level.mMapSize = mapSize;
+	spdlog::info("{} : 无限地图 '{}' 的瓦片范围为 ({}, {}) - ({}, {}), 已移动到原点.", mLogTag.data(), mMapPath, minTile.x, minTile.y, maxTile.x, maxTile.y);
+}
+
+bool TiledMapParser::parseObjectLayer(const nlohmann::json& layerJson, LevelLayer& layer) {
+	if (!layerJson.contains("objects") || !layerJson["objects"].is_array()) {
+		spdlog::error("{} 对象图层 '{}' 缺少 'objects' 属性", mLogTag.data(), layer.mName);
+		return false;
+	}
+
+	layer.mType = LevelLayerType::Object;
+	// 遍历对象数据
+	for (const auto& object : layerJson["objects"]) {
+		LevelObject levelObject;
+		// gid为0,代表不存在,则代表自己绘制的形状(碰撞盒,触发器等)
+		levelObject.mGid = object.value("gid", 0u);
+		if (levelObject.mGid == 0) {
+			// 非矩形对象会有额外标识
+			if (object.value("point", false)) {
+				continue;	// TODO: 点对象的处理方式
+			} else if (object.value("ellipse", false)) {
+				continue;	// TODO: 椭圆对象的处理方式
+			} else if (object.value("polygon", false)) {
+				continue;	// TODO: 多边形对象的处理方式
+			}
+			// 没有这些标识则默认是矩形对象
+			// 自定义形状通常是trigger类型, 除非显示指定 (因此默认为真)
+			levelObject.mIsTrigger = object.value("trigger", true);
+			levelObject.mTag = getTileProperty<std::string>(object, "tag").value_or("");
+		}
+		levelObject.mName = object.value("name", "Unnamed");
+		levelObject.mPosition = glm::vec2(object.value("x", 0.f), object.value("y", 0.f));
+		levelObject.mSize = glm::vec2(object.value("width", 0.f), object.value("height", 0.f));
+		levelObject.mRotation = object.value("rotation", 0.f);
+		layer.mObjects.push_back(std::move(levelObject));
+	}
+	return true;
+}
+
+void TiledMapParser::applyTileProperties(const nlohmann::json& tileJson, LevelTile& tile) {
+	tile.mType = getTileType(tileJson);
+	tile.mHasTileData = true;
+	tile.mColliderRect = getColliderRect(tileJson);
+	tile.mTag = getTileProperty<std::string>(tileJson, "tag").value_or("");
+	tile.mGravity = getTileProperty<bool>(tileJson, "gravity");
+	tile.mHealth = getTileProperty<int>(tileJson, "health");
+	if (auto animation = getTileProperty<std::string>(tileJson, "animation"); animation && !animation->empty()) {
+		tile.mAnimations = parseAnimations(*animation);
+	}
+	if (auto sound = getTileProperty<std::string>(tileJson, "sound"); sound && !sound->empty()) {
+		tile.mSounds = parseSounds(*sound);
+	}
+}
+
+std::vector<LevelAnimation> TiledMapParser::parseAnimations(std::string_view text) {
+	nlohmann::json animationJson;
+	try {
+		animationJson = nlohmann::json::parse(text);
+	}
+	catch (const nlohmann::json::parse_error& e) {
+		spdlog::error("{} : 解析动画json字符串失败: {}", mLogTag.data(), e.what());
+		return {};
+	}
+	// 检查动画json必须是一个对象
+	if (!animationJson.is_object()) {
+		spdlog::error("{} : 无效的动画json", mLogTag.data());
+		return {};
+	}
+
+	std::vector<LevelAnimation> animations;
+	// 遍历动画json对象中的每个键值对 (动画名称 : 动画信息)
+	for (const auto& keyValue : animationJson.items()) {
+		const std::string& animationName = keyValue.key();
+		const auto& animationInfo = keyValue.value();
+		if (!animationInfo.is_object()) {
+			spdlog::warn("{} : 动画 '{}' 的信息无效或为空.", mLogTag.data(), animationName);
+			continue;
+		}
+		// 帧信息(数组)是必须存在的
+		if (!animationInfo.contains("frames") || !animationInfo["frames"].is_array()) {
+			spdlog::warn("{} : 动画 '{}' 缺少 'frames' 数组", mLogTag.data(), animationName);
+			continue;
+		}
+
+		LevelAnimation animation;
+		animation.mName = animationName;
+		animation.mDurationMs = animationInfo.value("duration", 100);		// 默认持续时间为100ms
+		animation.mRow = animationInfo.value("row", 0);						// 默认行数为0
+		for (const auto& frame : animationInfo["frames"]) {
+			if (!frame.is_number_integer()) {
+				spdlog::warn("{} : 动画 '{}' 中 frames 数组格式错误!", mLogTag.data(), animationName);
+				continue;
+			}
+			animation.mFrames.push_back(frame.get<int>());
+		}
+		animations.push_back(std::move(animation));
+	}
+	return animations;
+}
+
+std::vector<LevelSound> TiledMapParser::parseSounds(std::string_view text) {
+	nlohmann::json soundJson;
+	try {
+		soundJson = nlohmann::json::parse(text);
+	}
+	catch (const nlohmann::json::parse_error& e) {
+		spdlog::error("{} : 解析音效JSON字符串失败: {}", mLogTag.data(), e.what());
+		return {};
+	}
+	if (!soundJson.is_object()) {
+		spdlog::error("{} : 无效的音效JSON", mLogTag.data());
+		return {};
+	}
+
+	std::vector<LevelSound> sounds;
+	// 遍历音效JSON对象中的每个键值对 (音效id : 音效路径)
+	for (const auto& sound : soundJson.items()) {
+		const std::string& soundId = sound.key();
+		if (soundId.empty() || !sound.value().is_string() || sound.value().get_ref<const std::string&>().empty()) {
+			spdlog::warn("{} : 音效 '{}' 缺少必要信息.", mLogTag.data(), soundId);
+			continue;
+		}
+		sounds.push_back({ soundId, sound.value().get<std::string>() });
+	}
+	return sounds;
+}
+
+std::optional<engine::utils::Rect> TiledMapParser::getColliderRect(const nlohmann::json& tileJson) {
+	if (!tileJson.contains("objectgroup")) {
+		return std::nullopt;
+	}
+
+	auto& objectgroup = tileJson["objectgroup"];
+	if (!objectgroup.contains("objects")) {
+		return std::nullopt;
+	}
+
+	auto& objects = objectgroup["objects"];
+	for (const auto& object : objects) {
+		auto rect = engine::utils::Rect(
+			glm::vec2(object.value("x", 0.f), object.value("y", 0.f)),
+			glm::vec2(object.value("width", 0.f), object.value("height", 0.f))
+		);
+
+		if (rect.size.x > 0 && rect.size.y > 0) {
+			return rect;
+		}
+	}
+	return std::nullopt;
+}
+
+engine::component::TileType TiledMapParser::getTileType(const nlohmann::json& tileJson) {
+	if (tileJson.contains("properties")) {
+		auto& properties = tileJson["properties"];
+		for (auto& property : properties) {
+			if (property.contains("name") && property["name"] == "solid") {
+				auto isSolid = property.value("value", false);
+				return isSolid ? engine::component::TileType::SOLID : engine::component::TileType::NORMAL;
+			}
+			else if (property.contains("name") && property["name"] == "slope") {
+				auto slopeType = property.value("value", "");
+				if (slopeType == "0_1") {
+					return engine::component::TileType::SLOPE_0_1;
+				}
+				else if (slopeType == "1_0") {
+					return engine::component::TileType::SLOPE_1_0;
+				}
+				else if (slopeType == "0_2") {
+					return engine::component::TileType::SLOPE_0_2;
+				}
+				else if (slopeType == "2_0") {
+					return engine::component::TileType::SLOPE_2_0;
+				}
+				else if (slopeType == "2_1") {
+					return engine::component::TileType::SLOPE_2_1;
+				}
+				else if (slopeType == "1_2") {
+					return engine::component::TileType::SLOPE_1_2;
+				}
+				else {
+					spdlog::error("{} : 未知的斜坡类型: {}", mLogTag.data(), slopeType);
+					return engine::component::TileType::NORMAL;
+				}
+			}
+			else if (property.contains("name") && property["name"] == "unisolid") {
+				auto isUnisolid = property.value("value", false);
+				return isUnisolid ? engine::component::TileType::UNISOLID : engine::component::TileType::NORMAL;
+			}
+			else if (property.contains("name") && property["name"] == "hazard") {
+				auto isHazard = property.value("value", false);
+				return isHazard ? engine::component::TileType::HAZARD : engine::component::TileType::NORMAL;
+			}
+			else if (property.contains("name") && property["name"] == "ladder") {
+				auto isLadder = property.value("value", false);
+				return isLadder ? engine::component::TileType::LADDER : engine::component::TileType::NORMAL;
+			}
+			// TODO: 更多的自定义逻辑处理
+		}
+	}
+	return engine::component::TileType::NORMAL;
+}
+
+bool TiledMapParser::loadTileset(std::string_view tilesetPath, int firstGid, LevelData& level) {
+	// 1. 优先使用缓存的瓦片集, 否则解析并加入缓存
+	std::shared_ptr<const LevelTileset> tileset = mLevelCache ? mLevelCache->findTileset(tilesetPath, mTileSize) : nullptr;
+	if (tileset) {
+		spdlog::debug("{} : 使用缓存的 Tileset '{}'", mLogTag.data(), tilesetPath);
+	}
+	else {
+		auto parsedTileset = std::make_shared<LevelTileset>();
+		if (!parseTileset(tilesetPath, *parsedTileset)) {
+			return false;
+		}
+		if (mLevelCache) {
+			mLevelCache->addTileset(tilesetPath, parsedTileset);
+		}
+		tileset = std::move(parsedTileset);
+	}
+
+	// 2. 拷贝到瓦片表的[firstGid, firstGid + 瓦片数量), gid按uint16存储
+	int tileCount = static_cast<int>(tileset->mTiles.size());
+	int maxGid = firstGid + tileCount - 1;
+	if (firstGid <= 0 || maxGid > std::numeric_limits<std::uint16_t>::max()) {
+		spdlog::error("{} : Tileset 文件 '{}' 的gid范围 [{}, {}] 超出支持范围.", mLogTag.data(), tilesetPath, firstGid, maxGid);
+		return false;
+	}
+	if (level.mTiles.size() < static_cast<std::size_t>(maxGid) + 1) {
+		level.mTiles.resize(static_cast<std::size_t>(maxGid) + 1);
+	}
+	std::copy(tileset->mTiles.begin(), tileset->mTiles.end(), level.mTiles.begin() + firstGid);
+	spdlog::info("{} : Tileset 文件 '{}' 加载完成, firstgid: {}", mLogTag.data(), tilesetPath, firstGid);
+	return true;
+}
+
+bool TiledMapParser::parseTileset(std::string_view tilesetPath, LevelTileset& tileset) {
+	nlohmann::json tilesetJson;
+	if (!readJsonFile(tilesetPath, tilesetJson)) {
+		return false;
+	}
+	const nlohmann::json emptyTiles = nlohmann::json::array();
+	const auto& tilesJson = tilesetJson.contains("tiles") && tilesetJson["tiles"].is_array() ? tilesetJson["tiles"] : emptyTiles;
+	tileset.mTileSize = mTileSize;
+
+	// 图块集分为两种情况, 需要分别考虑
+	// 单一图片: 图片路径只解析一次, 瓦片按网格计算源矩形, 有描述的瓦片先按id建立索引, 避免逐个瓦片线性查找
+	if (tilesetJson.contains("image")) {
+		auto textureId = resolvePath(tilesetJson["image"].get<std::string>(), tilesetPath);
+		int columns = tilesetJson.value("columns", 0);
+		int tileCount = std::max(0, tilesetJson.value("tilecount", 0));
+		if (columns <= 0) {
+			spdlog::error("{} : Tileset 文件 '{}' 缺少有效的 'columns' 属性.", mLogTag.data(), tilesetPath);
+			return false;
+		}
+		std::vector<const nlohmann::json*> tileJsonById(static_cast<std::size_t>(tileCount), nullptr);
+		for (const auto& tileJson : tilesJson) {
+			int tileId = tileJson.value("id", -1);
+			if (tileId >= 0 && tileId < tileCount) {
+				tileJsonById[tileId] = &tileJson;
+			}
+		}
+		tileset.mTiles.resize(static_cast<std::size_t>(tileCount));
+		for (int localId = 0; localId < tileCount; ++localId) {
+			LevelTile& tile = tileset.mTiles[localId];
+			tile.mTextureId = textureId;
+			// 计算瓦片在图片网格中的坐标, 并确定源矩阵
+			tile.mSourceRect = engine::utils::Rect(
+				glm::vec2(static_cast<float>(localId % columns * mTileSize.x), static_cast<float>(localId / columns * mTileSize.y)),
+				glm::vec2(static_cast<float>(mTileSize.x), static_cast<float>(mTileSize.y))
+			);
+			// 无具体描述的瓦片为普通类型
+			tile.mType = engine::component::TileType::NORMAL;
+			if (tileJsonById[localId]) {
+				applyTileProperties(*tileJsonById[localId], tile);
+			}
+		}
+	}
+	// 多图片: 每个瓦片有自己的图片和尺寸
+	else {
+		int tileCount = 0;
+		for (const auto& tileJson : tilesJson) {
+			tileCount = std::max(tileCount, tileJson.value("id", 0) + 1);
+		}
+		tileset.mTiles.resize(static_cast<std::size_t>(tileCount));
+		for (const auto& tileJson : tilesJson) {
+			auto tileId = tileJson.value("id", 0);
+			if (tileId < 0) {
+				continue;
+			}
+			if (!tileJson.contains("image")) {
+				spdlog::error("{} : Tileset 文件 '{}' 中瓦片 {} 缺少 'image' 属性.", mLogTag.data(), tilesetPath, tileId);
+				continue;
+			}
+			LevelTile& tile = tileset.mTiles[tileId];
+			// 获取图片路径
+			tile.mTextureId = resolvePath(tileJson["image"].get<std::string>(), tilesetPath);
+			// 确认图片尺寸
+			auto imageWidth = tileJson.value("imagewidth", 0);
+			auto imageHeight = tileJson.value("imageheight", 0);
+			// 从Json中获取源矩阵信息
+			tile.mSourceRect = engine::utils::Rect(
+				glm::vec2(static_cast<float>(tileJson.value("x", 0)), static_cast<float>(tileJson.value("y", 0))),
+				glm::vec2(static_cast<float>(tileJson.value("width", imageWidth)), static_cast<float>(tileJson.value("height", imageHeight)))
+			);
+			// 有具体的json, 直接解析自定义属性
+			applyTileProperties(tileJson, tile);
+		}
+	}
+	return true;
+}
+
+bool TiledMapParser::readJsonFile(std::string_view filePath, nlohmann::json& json) const {
+	return readFileBytes(filePath, [&](std::span<const std::byte> bytes) {
+		try {
+			const char* begin = reinterpret_cast<const char*>(bytes.data());
+			json = nlohmann::json::parse(begin, begin + bytes.size());
+			return true;
+		}
+		catch (const nlohmann::json::parse_error& e) {
+			spdlog::error("{} : 解析 JSON 文件 '{}' 失败: {} (at byte {})", mLogTag.data(), filePath, e.what(), e.byte);
+			return false;
+		}
+	});
+}
+
+bool TiledMapParser::readFileBytes(std::string_view filePath, const std::function<bool(std::span<const std::byte>)>& reader) const {
+	if (mAssetPack && mAssetPack->contains(filePath)) {
+		return reader(mAssetPack->find(filePath));
+	}
+
+	// 散装文件映射到内存后直接解析, 不经过流和中间缓冲区
+	std::unique_ptr<engine::resource::MappedFile> file;
+	try {
+		file = std::make_unique<engine::resource::MappedFile>(filePath);
+	}
+	catch (const std::exception& e) {
+		spdlog::error("{} : 无法打开文件: {} ({})", mLogTag.data(), filePath, e.what());
+		return false;
+	}
+	return reader(file->getData());
+}
+
+std::string TiledMapParser::resolvePath(std::string_view relativePath, std::string_view filePath) {
+	try {
+		// 获取地图文件的父目录（相对于可执行文件） “assets/maps/level1.tmj” -> “assets/maps”
+		auto mapDir = std::filesystem::path(filePath).parent_path();
+		// 合并路径（相对于可执行文件）并返回。
+		// lexically_normal：只在字符串上消除当前目录（.）和上级目录（..）导航符，不访问文件系统，
+		// 文件只存在于资源包中时同样有效，得到的相对路径也与资源包的索引和其他代码使用的路径一致
+		auto finalPath = (mapDir / relativePath).lexically_normal();
+		return finalPath.generic_string();
+	}
+	catch (const std::exception& e) {
+		spdlog::error("{} : 路径解析失败: {}", mLogTag.data(), e.what());
+		return std::string(relativePath);
+	}
+}
+} // namespace engine::scene
@@ -0,0 +1,207 @@
+/*****************************************************************//**
+ * @file   tiled_map_parser.h
+ * @brief  Tiled JSON地图解析器
+ * @version 1.0
+ *
+ * @author Shallowshades
+ * @date   2026.10.18
+ *********************************************************************/
+
+#pragma once
+#ifndef TILED_MAP_PARSER_H
+#define TILED_MAP_PARSER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <glm/vec2.hpp>
+#include <nlohmann/json.hpp>
+#include "level_data.h"
+
+namespace engine::resource { class AssetPack; }
+
+namespace engine::scene {
+class LevelCache;
+
+/**
+ * @brief 把Tiled JSON地图(.tmj)和它引用的瓦片集(.tsj)解析为LevelData.
+ *
+ * 游戏在没有预处理文件时使用它, level_cooker也用它生成预处理文件.
+ * 地图以SAX方式流式解析, 瓦片图层的gid直接写入数组, 不生成完整的json树; 瓦片集较小且会被缓存, 仍按json树解析.
+ * 瓦片图层支持json数组和base64编码(可选zlib, gzip, zstd压缩)的数据, 以及无限地图中按块(chunks)存储的图层.
+ */
+class TiledMapParser final {
+public:
+	/**
+	 * @brief 构造函数.
+	 * @param assetPack 资源包(非拥有), 可以为空; 文件在资源包中存在时直接从映射区域解析
+	 * @param levelCache 关卡缓存(非拥有), 可以为空; 瓦片集优先从缓存中获取, 解析后加入缓存
+	 */
+	explicit TiledMapParser(const engine::resource::AssetPack* assetPack = nullptr, LevelCache* levelCache = nullptr);
+
+	/**
+	 * @brief 解析地图及其瓦片集.
+	 *
+	 * @param mapPath 地图文件路径
+	 * @param level 解析结果
+	 * @return 是否成功(失败时已输出错误日志)
+	 */
+	[[nodiscard]] bool parse(std::string_view mapPath, LevelData& level);
+
+	/**
+	 * @brief 解析图片路径, 合并地图路径和相对路径. 例如
+	 *	- 1. 文件路径: "assets/maps/level1.tmj"
+	 *	- 2. 相对路径: "../textures/Layers/back.png"
+	 *  - 3. 最终路径: "assets/textures/Layers/back.png"
+	 *
+	 * @param relative 相对路径
+	 * @param filePath 文件路径
+	 * @return std::string 解析后的完整路径
+	 */
+	static std::string resolvePath(std::string_view relativePath, std::string_view filePath);
+
+private:
+	struct StreamedLayer;
+	class MapSaxHandler;
+
+	/**
+	 * @brief 无限地图中按块(chunks)存储的瓦片图层: 在关卡中的下标和图层范围(瓦片坐标).
+	 */
+	struct ChunkedLayer {
+		std::size_t mLayerIndex = 0;										///< @brief 在LevelData::mLayers中的下标
+		glm::ivec2 mStart{};												///< @brief 图层左上角(瓦片坐标, 可以为负)
+		glm::ivec2 mSize{};													///< @brief 图层尺寸(瓦片数量)
+	};
+
+	void parseLayer(StreamedLayer& streamedLayer, LevelData& level);			///< @brief 解析流式读取的一个图层, 可见时加入关卡
+	bool parseImageLayer(const nlohmann::json& layerJson, LevelLayer& layer);	///< @brief 解析图片图层
+	bool parseTileLayer(StreamedLayer& streamedLayer, LevelLayer& layer);		///< @brief 解析瓦片图层
+	bool parseObjectLayer(const nlohmann::json& layerJson, LevelLayer& layer);	///< @brief 解析对象图层
+
+	/**
+	 * @brief 解析无限地图中按块存储的瓦片图层, 拼接为图层自身范围的gid数组.
+	 *
+	 * @param layerJson 图层json数据
+	 * @param layer 写入gid的图层
+	 * @param chunkedLayer 图层范围
+	 * @param invalidGidCount 累加超出范围的gid数量
+	 * @return 是否成功
+	 */
+	bool parseChunks(const nlohmann::json& layerJson, LevelLayer& layer, ChunkedLayer& chunkedLayer, int& invalidGidCount);
+
+	/**
+	 * @brief 读取图层或块的"data": base64字符串(按图层的"encoding"和"compression"解码)或gid数组.
+	 *
+	 * @param layerJson 图层json数据
+	 * @param dataJson "data"字段
+	 * @param gids 输出的gid数组, 大小必须等于瓦片数量
+	 * @param invalidGidCount 累加超出范围的gid数量
+	 * @return 是否成功
+	 */
+	bool readTileData(const nlohmann::json& layerJson, const nlohmann::json& dataJson, std::span<std::uint16_t> gids, int& invalidGidCount);
+
+	/**
+	 * @brief 把无限地图中按块存储的图层对齐到所有图层范围的并集, 并把并集的左上角移动到原点(对象和图片图层一起移动).
+	 */
+	void alignChunkedLayers(LevelData& level);
+	void applyTileProperties(const nlohmann::json& tileJson, LevelTile& tile);	///< @brief 从瓦片描述中解析类型和自定义属性
+	std::vector<LevelAnimation> parseAnimations(std::string_view text);		///< @brief 解析"animation"属性(JSON字符串: 片段名称 -> {duration, row, frames})
+	std::vector<LevelSound> parseSounds(std::string_view text);				///< @brief 解析"sound"属性(JSON字符串: 音效ID -> 路径)
+
+	/**
+	 * @brief 获取瓦片属性.
+	 *
+	 * @param tileJson 瓦片json数据
+	 * @param propertyName 属性名称
+	 * @return 属性值, 如果属性不存在则返回 std::nullopt
+	 */
+	template<typename T>
+	std::optional<T> getTileProperty(const nlohmann::json& tileJson, std::string_view propertyName);
+
+	/**
+	 * @brief 获取瓦片碰撞器矩形.
+	 * @param tileJson 瓦片json数据
+	 * @return 碰撞器矩形, 如果碰撞器不存在则返回std::nullopt
+	 */
+	std::optional<engine::utils::Rect> getColliderRect(const nlohmann::json& tileJson);
+
+	/**
+	 * @brief 根据瓦片json对象获取瓦片类型.
+	 *
+	 * @param tileJson瓦片json数据
+	 * @return 瓦片类型
+	 */
+	engine::component::TileType getTileType(const nlohmann::json& tileJson);
+
+	/**
+	 * @brief 加载瓦片集并填充它在瓦片表中的全部瓦片. 瓦片集优先从缓存中获取.
+	 *
+	 * @param tilesetPath Tileset 文件路径
+	 * @param firstGid 此tileset的第一个全局id
+	 * @param level 写入瓦片表的关卡数据
+	 * @return 是否成功
+	 */
+	bool loadTileset(std::string_view tilesetPath, int firstGid, LevelData& level);
+
+	/**
+	 * @brief 解析Tiled tileset 文件 (.tsj), 按局部id生成瓦片.
+	 *
+	 * 图片路径, 网格列数和有描述的瓦片索引在每个瓦片集中只计算一次, 之后按gid取瓦片只是数组下标.
+	 *
+	 * @param tilesetPath Tileset 文件路径
+	 * @param tileset 解析结果
+	 * @return 是否成功
+	 */
+	bool parseTileset(std::string_view tilesetPath, LevelTileset& tileset);
+
+	/**
+	 * @brief 读取并解析JSON文件: 资源包中存在时直接从映射区域解析, 否则从散装文件读取.
+	 *
+	 * @param filePath 文件路径
+	 * @param json 解析结果
+	 * @return 是否成功(失败时已输出错误日志)
+	 */
+	bool readJsonFile(std::string_view filePath, nlohmann::json& json) const;
+
+	/**
+	 * @brief 读取文件的全部字节: 资源包中存在时直接使用映射区域, 否则映射散装文件.
+	 *
+	 * @param filePath 文件路径
+	 * @param reader 处理字节的函数, 字节只在调用期间有效
+	 * @return reader的返回值, 文件无法打开时返回false(已输出错误日志)
+	 */
+	bool readFileBytes(std::string_view filePath, const std::function<bool(std::span<const std::byte>)>& reader) const;
+
+private:
+	static constexpr std::string_view mLogTag = "TiledMapParser";			///< @brief 日志标记
+
+	const engine::resource::AssetPack* mAssetPack = nullptr;				///< @brief 资源包(非拥有), 可以为空
+	LevelCache* mLevelCache = nullptr;										///< @brief 关卡缓存(非拥有), 可以为空
+	std::string mMapPath;													///< @brief 地图路径
+	glm::ivec2 mTileSize;													///< @brief 瓦片尺寸(像素)
+	std::vector<ChunkedLayer> mChunkedLayers;								///< @brief 当前地图中按块存储的瓦片图层
+};
+
+template<typename T>
+inline std::optional<T> TiledMapParser::getTileProperty(const nlohmann::json& tileJson, std::string_view propertyName) {
+	if (!tileJson.contains("properties")) {
+		return std::nullopt;
+	}
+	const auto& properties = tileJson["properties"];
+	for (const auto& property : properties) {
+		if (property.contains("name") && property["name"] == std::string(propertyName)) {
+			if (property.contains("value")) {
+				return property["value"].get<T>();
+			}
+		}
+	}
+	return std::nullopt;
+}
+} // namespace engine::scene
+
+#endif // !TILED_MAP_PARSER_H
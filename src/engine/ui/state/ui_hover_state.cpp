@@ -2,8 +2,6 @@
 #include "ui_normal_state.h"
 #include "ui_pressed_state.h"
 #include "../ui_interactive.h"
-#include "../../input/input_manager.h"
-#include "../../core/context.h"
 #include <spdlog/spdlog.h>
 
 namespace engine::ui::state {
@@ -12,13 +10,11 @@ void UIHoverState::enter() {
 	spdlog::debug("切换到悬停状态");
 }
 
-std::unique_ptr<UIState> UIHoverState::handleInput(engine::core::Context& context) {
-	auto& inputManager = context.getInputManager();
-	auto mousePosition = inputManager.getLogicalMousePosition();
-	if (!mOwner->isPointInside(mousePosition)) {					// 如果鼠标不在UI元素内，则返回正常状态
+std::unique_ptr<UIState> UIHoverState::handlePointerEvent(UIPointerEvent event) {
+	if (event == UIPointerEvent::Leave) {						// 如果鼠标移出UI元素，则返回正常状态
 		return std::make_unique<UINormalState>(mOwner);
 	}
-	if (inputManager.isActionPressed("MouseLeftClick")) {			// 如果鼠标按下，则返回按下状态
+	if (event == UIPointerEvent::Press) {						// 如果鼠标按下，则返回按下状态
 		return std::make_unique<UIPressedState>(mOwner);
 	}
 	return nullptr;
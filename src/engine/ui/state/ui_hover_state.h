@@ -27,7 +27,7 @@ public:
 
 private:
 	void enter() override;
-	std::unique_ptr<UIState> handleInput(engine::core::Context& context) override;
+	std::unique_ptr<UIState> handlePointerEvent(UIPointerEvent event) override;
 };
 
 } // namespace engine::ui::state
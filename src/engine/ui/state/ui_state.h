@@ -14,16 +14,23 @@
 
 #include <memory>
 
-namespace engine::core {
-    class Context;
-}
-
 namespace engine::ui {
     class UIInteractive;
 }
 
 namespace engine::ui::state {
 
+/**
+* @brief UIManager的输入路由投递给可交互元素的鼠标事件。
+*/
+enum class UIPointerEvent {
+    Enter,              ///< @brief 鼠标移入元素
+    Leave,              ///< @brief 鼠标移出元素
+    Press,              ///< @brief 在元素上按下鼠标左键
+    Release,            ///< @brief 在按下时所在的元素上松开鼠标左键
+    ReleaseOutside,     ///< @brief 按下后移出元素再松开鼠标左键
+};
+
 /**
 * @brief 可交互UI元素在特定状态下的行为接口。
 *
@@ -48,7 +55,7 @@ public:
 protected:
     // --- 核心方法 --- 
     virtual void enter();
-    virtual std::unique_ptr<UIState> handleInput(engine::core::Context& context) = 0;
+    virtual std::unique_ptr<UIState> handlePointerEvent(UIPointerEvent event) = 0;  ///< @brief 处理鼠标事件, 需要切换状态时返回新状态
 protected:
 	engine::ui::UIInteractive* mOwner = nullptr;            ///< @brief 指向父节点
 };
@@ -9,37 +9,20 @@ UIElement::UIElement(const glm::vec2& position, const glm::vec2& size)
 	: mPosition(position), mSize(size) {
 }
 
-bool UIElement::handleInput(engine::core::Context& context) {
-	// 如果元素不可见，直接返回 false
-	if (!mVisible) return false;
-
-	// 遍历所有子节点，并删除标记了移除的元素
-	for (auto it = mChildren.begin(); it != mChildren.end();) {
-		if (*it && !(*it)->isNeedRemove()) {
-			if ((*it)->handleInput(context)) return true;
-			++it;
-		}
-		else {
-			it = mChildren.erase(it);
-		}
-	}
-	// 事件未被消耗，返回假
-	return false;
-}
-
 void UIElement::update(float deltaTime, engine::core::Context& context) {
-	if (!mVisible) return;
+	// 隐藏的子树也要移除已标记的子元素, 否则它们的内存要等到子树重新显示时才释放
+	if (!mVisible) {
+		compactChildren();
+		return;
+	}
 
-	// 遍历所有子节点，并删除标记了移除的元素
-	for (auto it = mChildren.begin(); it != mChildren.end();) {
-		if (*it && !(*it)->isNeedRemove()) {
-			(*it)->update(deltaTime, context);
-			++it;
-		}
-		else {
-			it = mChildren.erase(it);
+	// 遍历所有子节点, 结束后一次性移除标记了移除的元素
+	for (std::size_t i = 0; i < mChildren.size(); ++i) {
+		if (mChildren[i] && !mChildren[i]->isNeedRemove()) {
+			mChildren[i]->update(deltaTime, context);
 		}
 	}
+	compactChildren();
 }
 
 void UIElement::render(engine::core::Context& context) {
@@ -47,7 +30,7 @@ void UIElement::render(engine::core::Context& context) {
 
 	// 渲染子元素
 	for (const auto& child : mChildren) {
-		if (child) child->render(context);
+		if (child && !child->isNeedRemove()) child->render(context);
 	}
 }
 
@@ -55,7 +38,83 @@ void UIElement::addChild(std::unique_ptr<UIElement> child) {
 	if (child) {
 		child->setParent(this); // 设置父指针
 		mChildren.push_back(std::move(child));
+		notifyTreeChanged();
+	}
+}
+
+void UIElement::setParent(UIElement* parent) {
+	mParent = parent;
+	markScreenPositionDirty();
+}
+
+void UIElement::setPosition(const glm::vec2& position) {
+	if (mPosition == position) {
+		return;
+	}
+	mPosition = position;
+	markScreenPositionDirty();
+	notifyTreeChanged();
+}
+
+void UIElement::setSize(const glm::vec2& size) {
+	if (mSize == size) {
+		return;
+	}
+	mSize = size;
+	notifyTreeChanged();
+}
+
+void UIElement::setVisible(bool visible) {
+	if (mVisible == visible) {
+		return;
+	}
+	mVisible = visible;
+	notifyTreeChanged();
+}
+
+void UIElement::setNeedRemove(bool needRemove) {
+	if (mNeedRemove == needRemove) {
+		return;
+	}
+	mNeedRemove = needRemove;
+	notifyTreeChanged();
+}
+
+void UIElement::markScreenPositionDirty() {
+	// 已经失效的元素, 其子元素也一定已经失效(子元素重新计算时会先计算父元素), 无需继续向下传播
+	if (mIsScreenPositionDirty) {
+		return;
+	}
+	mIsScreenPositionDirty = true;
+	for (const auto& child : mChildren) {
+		if (child) child->markScreenPositionDirty();
+	}
+}
+
+void UIElement::compactChildren() {
+	auto removedCount = std::erase_if(mChildren, [](const std::unique_ptr<UIElement>& child) {
+		return !child || child->isNeedRemove();
+	});
+	if (removedCount > 0) {
+		notifyTreeChanged();
+	}
+}
+
+void UIElement::notifyTreeChanged() {
+	UIElement* root = this;
+	while (root->mParent) {
+		root = root->mParent;
+	}
+	++root->mTreeVersion;
+	++root->mRenderVersion;
+}
+
+void UIElement::notifyRenderChanged() {
+	UIElement* root = this;
+	while (root->mParent) {
+		root = root->mParent;
 	}
+	++root->mRenderVersion;
 }
 
 std::unique_ptr<UIElement> UIElement::removeChild(UIElement* child_ptr) {
@@ -66,6 +125,7 @@ std::unique_ptr<UIElement> UIElement::removeChild(UIElement* child_ptr) {
 		});
 
 	if (it != mChildren.end()) {
+		notifyTreeChanged();
 		std::unique_ptr<UIElement> removedChild = std::move(*it);
 		mChildren.erase(it);
 		removedChild->setParent(nullptr);      // 清除父指针
@@ -79,13 +139,16 @@ void UIElement::removeAllChildren() {
 		child->setParent(nullptr); // 清除父指针
 	}
 	mChildren.clear();
+	notifyTreeChanged();
 }
 
 glm::vec2 UIElement::getScreenPosition() const {
-	if (mParent) {
-		return mParent->getScreenPosition() + mPosition;
+	if (mIsScreenPositionDirty) {
+		// 根元素的位置已经是相对屏幕的绝对位置
+		mScreenPosition = mParent ? mParent->getScreenPosition() + mPosition : mPosition;
+		mIsScreenPositionDirty = false;
 	}
-	return mPosition; // 根元素的位置已经是相对屏幕的绝对位置
+	return mScreenPosition;
 }
 
 engine::utils::Rect UIElement::getBounds() const {
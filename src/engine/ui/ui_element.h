@@ -13,6 +13,7 @@
 #define UI_ELEMENT_H
 
 #include <SDL3/SDL_rect.h>
+#include <cstdint>
 #include <memory>
 #include <vector>
 #include "../utils/math.h"
@@ -45,7 +46,7 @@ public:
     virtual ~UIElement() = default;
 
     // --- 核心虚循环方法 --- (没有使用init和clean，注意构造函数和析构函数的使用)
-    virtual bool handleInput(engine::core::Context& context);
+    // 输入不再逐元素分发, 由UIManager命中测试后直接投递给鼠标下的可交互元素
     virtual void update(float deltaTime, engine::core::Context& context);
     virtual void render(engine::core::Context& context);
 
@@ -62,15 +63,17 @@ public:
     UIElement* getParent() const { return mParent; }                ///< @brief 获取父元素
     const std::vector<std::unique_ptr<UIElement>>& getChildren() const { return mChildren; } ///< @brief 获取子元素列表
 
-    void setSize(const glm::vec2& size) { mSize = size; }           ///< @brief 设置元素大小
-    void setVisible(bool visible) { mVisible = visible; }           ///< @brief 设置元素的可见性
-    void setParent(UIElement* parent) { mParent = parent; }         ///< @brief 设置父节点
-    void setPosition(const glm::vec2& position) { mPosition = position; }   ///< @brief 设置元素位置(相对于父节点)
-    void setNeedRemove(bool needRemove) { mNeedRemove = needRemove; }    ///< @brief 设置元素是否需要移除
+    void setSize(const glm::vec2& size);                            ///< @brief 设置元素大小
+    void setVisible(bool visible);                                  ///< @brief 设置元素的可见性
+    void setParent(UIElement* parent);                              ///< @brief 设置父节点(屏幕位置随之失效)
+    void setPosition(const glm::vec2& position);                    ///< @brief 设置元素位置(相对于父节点, 自身及子元素的屏幕位置随之失效)
+    void setNeedRemove(bool needRemove);                            ///< @brief 设置元素是否需要移除
+    std::uint64_t getTreeVersion() const { return mTreeVersion; }   ///< @brief 获取以该元素为根的树的版本号(结构, 可见性或布局变化时递增)
+    std::uint64_t getRenderVersion() const { return mRenderVersion; } ///< @brief 获取以该元素为根的树的绘制版本号(树变化, 状态, 文字或外观变化时递增)
 
     // --- 辅助方法 ---
     engine::utils::Rect getBounds() const;                          ///< @brief 获取(计算)元素的边界(屏幕坐标)
-    glm::vec2 getScreenPosition() const;                            ///< @brief 获取(计算)元素在屏幕上位置
+    glm::vec2 getScreenPosition() const;                            ///< @brief 获取元素在屏幕上位置(缓存, 失效时沿父节点重新计算一次)
     bool isPointInside(const glm::vec2& point) const;               ///< @brief 检查给定点是否在元素的边界内
 
     // --- 禁用拷贝和移动语义 ---
@@ -78,6 +81,12 @@ public:
     UIElement& operator=(const UIElement&) = delete;
     UIElement(UIElement&&) = delete;
     UIElement& operator=(UIElement&&) = delete;
+protected:
+    void markScreenPositionDirty();                                 ///< @brief 使自身及所有子元素缓存的屏幕位置失效
+    void compactChildren();                                         ///< @brief 统一移除标记了需要移除的子元素(每帧在update中调用一次)
+    void notifyTreeChanged();                                       ///< @brief 递增根元素的树版本号, 使UIManager重建命中测试列表(同时递增绘制版本号)
+    void notifyRenderChanged();                                     ///< @brief 递增根元素的绘制版本号, 只影响绘制结果的变化(状态, 文字, 颜色, 精灵)调用
+
 protected:
 	glm::vec2 mPosition;                                    ///< @brief 相对于父元素的局部位置
 	glm::vec2 mSize;                                        ///< @brief 元素大小
@@ -85,6 +94,10 @@ protected:
 	bool mNeedRemove = false;                              ///< @brief 是否需要移除(延迟删除)
 
 	UIElement* mParent = nullptr;                           ///< @brief 指向父节点的非拥有指针
+	mutable glm::vec2 mScreenPosition = { 0.0f, 0.0f };     ///< @brief 缓存的屏幕位置
+	mutable bool mIsScreenPositionDirty = true;             ///< @brief 缓存的屏幕位置是否失效(失效的元素其子元素也一定失效)
+	std::uint64_t mTreeVersion = 0;                         ///< @brief 树版本号(只有根元素的有意义)
+	std::uint64_t mRenderVersion = 0;                       ///< @brief 绘制版本号(只有根元素的有意义), 帧缓存据此判断UI是否需要重绘
 	std::vector<std::unique_ptr<UIElement>> mChildren;      ///< @brief 子元素列表(容器)
 };
 }
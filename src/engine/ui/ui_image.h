@@ -48,16 +48,16 @@ public:
 
     // --- Setters & Getters ---
     const engine::render::Sprite& getSprite() const { return mSprite; }
-    void setSprite(const engine::render::Sprite& sprite) { mSprite = sprite; }
+    void setSprite(const engine::render::Sprite& sprite) { mSprite = sprite; notifyRenderChanged(); }
 
     std::string_view getTextureId() const { return mSprite.getTextureId(); }
-    void setTextureId(std::string_view textureId) { mSprite.setTextureId(textureId); }
+    void setTextureId(std::string_view textureId) { mSprite.setTextureId(textureId); notifyRenderChanged(); }
 
     const std::optional<SDL_FRect>& getSourceRect() const { return mSprite.getSourceRect(); }
-    void setSourceRect(const std::optional<SDL_FRect>& sourceRect) { mSprite.setSourceRect(sourceRect); }
+    void setSourceRect(const std::optional<SDL_FRect>& sourceRect) { mSprite.setSourceRect(sourceRect); notifyRenderChanged(); }
 
     bool isFlipped() const { return mSprite.isFlipped(); }
-    void setFlipped(bool flipped) { mSprite.setFlipped(flipped); }
+    void setFlipped(bool flipped) { mSprite.setFlipped(flipped); notifyRenderChanged(); }
 
 protected:
     engine::render::Sprite mSprite;
@@ -1,5 +1,6 @@
 #include "ui_interactive.h"
 #include "state/ui_state.h"
+#include "state/ui_normal_state.h"
 #include "../core/context.h"
 #include "../render/renderer.h"
 #include "../resource/resource_manager.h"
@@ -24,12 +25,13 @@ void UIInteractive::setState(std::unique_ptr<engine::ui::state::UIState> state)
 
 	mState = std::move(state);
 	mState->enter();
+	notifyRenderChanged();
 }
 
 void UIInteractive::addSprite(std::string_view name, std::unique_ptr<engine::render::Sprite> sprite) {
 	// 可交互UI元素必须有一个size用于交互检测，因此如果参数列表中没有指定，则用图片大小作为size
 	if (mSize.x == 0.0f && mSize.y == 0.0f) {
-		mSize = mContext.getResourceManager().getTextureSize(sprite->getTextureId());
+		setSize(mContext.getResourceManager().getTextureSize(sprite->getTextureId()));
 	}
 	// 添加精灵
 	mSprites[std::string(name)] = std::move(sprite);
@@ -38,6 +40,7 @@ void UIInteractive::addSprite(std::string_view name, std::unique_ptr<engine::ren
 void UIInteractive::setSprite(std::string_view name) {
 	if (mSprites.find(std::string(name)) != mSprites.end()) {
 		mCurrentSprite = mSprites[std::string(name)].get();
+		notifyRenderChanged();
 	}
 	else {
 		spdlog::warn("Sprite '{}' 未找到", name.data());
@@ -57,17 +60,25 @@ void UIInteractive::playSound(std::string_view name) {
 	}
 }
 
-bool UIInteractive::handleInput(engine::core::Context& context) {
-	if (UIElement::handleInput(context)) {
-		return true;
+void UIInteractive::setInteractive(bool interactive) {
+	if (mInteractive == interactive) {
+		return;
+	}
+	mInteractive = interactive;
+	// 禁用后不再接收指针事件, 悬停或按下状态需要在这里回到正常状态, 否则会停留在对应的精灵上
+	if (!mInteractive && mState && !dynamic_cast<engine::ui::state::UINormalState*>(mState.get())) {
+		setState(std::make_unique<engine::ui::state::UINormalState>(this));
 	}
+	notifyTreeChanged();
+}
 
-	// 先更新子节点，再更新自己（状态）
-	if (mState && mInteractive) {
-		if (auto nextState = mState->handleInput(context); nextState) {
-			setState(std::move(nextState));
-			return true;
-		}
+bool UIInteractive::handlePointerEvent(engine::ui::state::UIPointerEvent event) {
+	if (!mState || !mInteractive) {
+		return false;
+	}
+	if (auto nextState = mState->handlePointerEvent(event); nextState) {
+		setState(std::move(nextState));
+		return true;
 	}
 	return false;
 }
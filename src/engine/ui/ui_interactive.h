@@ -47,11 +47,11 @@ public:
     void setState(std::unique_ptr<engine::ui::state::UIState> state);                       ///< @brief 设置当前状态
     engine::ui::state::UIState* getState() const { return mState.get(); }                   ///< @brief 获取当前状态
 
-    void setInteractive(bool interactive) { mInteractive = interactive; }                   ///< @brief 设置是否可交互
+    void setInteractive(bool interactive);                                                  ///< @brief 设置是否可交互, 禁用时回到正常状态
     bool isInteractive() const { return mInteractive; }                                     ///< @brief 获取是否可交互
 
     // --- 核心方法 ---
-    bool handleInput(engine::core::Context& context) override;
+    bool handlePointerEvent(engine::ui::state::UIPointerEvent event);                       ///< @brief 由UIManager投递鼠标事件, 状态发生切换时返回true
     void render(engine::core::Context& context) override;
 
 protected:
@@ -31,22 +31,30 @@ void UILabel::render(engine::core::Context& context) {
 }
 
 void UILabel::setText(std::string_view text) {
+	/* 文本未变化时无需重新计算尺寸 */
+	if (mText == text) return;
 	mText = text;
 	mSize = mTextRenderer.getTextSize(mText, mFontId, mFontSize);
+	notifyRenderChanged();
 }
 
 void UILabel::setFontId(std::string_view font_id) {
+	if (mFontId == font_id) return;
 	mFontId = font_id;
 	mSize = mTextRenderer.getTextSize(mText, mFontId, mFontSize);
+	notifyRenderChanged();
 }
 
 void UILabel::setFontSize(int font_size) {
+	if (mFontSize == font_size) return;
 	mFontSize = font_size;
 	mSize = mTextRenderer.getTextSize(mText, mFontId, mFontSize);
+	notifyRenderChanged();
 }
 
 void UILabel::setTextFColor(const engine::utils::FColor& text_fcolor) {
 	mTextFcolor = text_fcolor;
 	/* 颜色变化不影响尺寸 */
+	notifyRenderChanged();
 }
 } // namespace engine::ui
\ No newline at end of file
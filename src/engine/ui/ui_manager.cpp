@@ -1,6 +1,10 @@
 #include "ui_manager.h"
 #include "ui_panel.h"
 #include "ui_element.h"
+#include "ui_interactive.h"
+#include "../core/context.h"
+#include "../input/input_manager.h"
+#include <algorithm>
 #include <spdlog/spdlog.h>
 
 namespace engine::ui {
@@ -35,11 +39,40 @@ void UIManager::clearElements() {
 }
 
 bool UIManager::handleInput(engine::core::Context& context) {
-	if (mRootElement && mRootElement->isVisible()) {
-		// 从根元素开始向下分发事件
-		if (mRootElement->handleInput(context)) return true;
+	if (!mRootElement || !mRootElement->isVisible()) {
+		return false;
+	}
+
+	// 鼠标没有变化且UI树没有变化时, 命中结果不会改变, 无需处理
+	auto& inputManager = context.getInputManager();
+	bool isRebuilt = rebuildHitTargets();
+	if (!isRebuilt && !inputManager.hasMouseChanged()) {
+		return false;
+	}
+
+	using engine::ui::state::UIPointerEvent;
+	bool isHandled = false;
+	UIInteractive* hitElement = hitTest(inputManager.getLogicalMousePosition());
+	if (hitElement != mHoveredElement) {
+		if (mHoveredElement) {
+			isHandled |= mHoveredElement->handlePointerEvent(UIPointerEvent::Leave);
+		}
+		if (hitElement) {
+			isHandled |= hitElement->handlePointerEvent(UIPointerEvent::Enter);
+		}
+		mHoveredElement = hitElement;
+	}
+
+	if (mHoveredElement && inputManager.isActionPressed("MouseLeftClick")) {
+		isHandled |= mHoveredElement->handlePointerEvent(UIPointerEvent::Press);
+		mPressedElement = mHoveredElement;
+	}
+	if (mPressedElement && inputManager.isActionReleased("MouseLeftClick")) {
+		UIInteractive* pressedElement = mPressedElement;
+		mPressedElement = nullptr;
+		isHandled |= pressedElement->handlePointerEvent(pressedElement == mHoveredElement ? UIPointerEvent::Release : UIPointerEvent::ReleaseOutside);
 	}
-	return false;
+	return isHandled;
 }
 
 void UIManager::update(float deltaTime, engine::core::Context& context) {
@@ -60,4 +93,79 @@ UIPanel* UIManager::getRootElement() const {
 	return mRootElement.get();
 }
 
+std::uint64_t UIManager::getRenderVersion() const {
+	return mRootElement->getRenderVersion();
+}
+
+bool UIManager::rebuildHitTargets() {
+	if (mIsHitTargetsBuilt && mRootElement->getTreeVersion() == mHitTargetsVersion) {
+		return false;
+	}
+
+	mHitTargets.clear();
+	collectHitTargets(mRootElement.get());
+	mHitTargetsVersion = mRootElement->getTreeVersion();
+	mIsHitTargetsBuilt = true;
+
+	// 不在列表中的元素如果仍在树中(被隐藏或移除标记尚未生效), 先投递正常指针路径会发送的事件再丢弃;
+	// 被禁用的元素不再接收事件, 由setInteractive(false)回到正常状态; 已从树中移除的元素可能已被销毁, 直接丢弃
+	using engine::ui::state::UIPointerEvent;
+	if (mHoveredElement && !containsHitTarget(mHoveredElement)) {
+		if (containsElement(mRootElement.get(), mHoveredElement)) {
+			mHoveredElement->handlePointerEvent(UIPointerEvent::Leave);
+		}
+		mHoveredElement = nullptr;
+	}
+	if (mPressedElement && !containsHitTarget(mPressedElement)) {
+		if (containsElement(mRootElement.get(), mPressedElement)) {
+			mPressedElement->handlePointerEvent(UIPointerEvent::ReleaseOutside);
+		}
+		mPressedElement = nullptr;
+	}
+	spdlog::trace("UI命中测试列表已重建, 共 {} 个可交互元素", mHitTargets.size());
+	return true;
+}
+
+void UIManager::collectHitTargets(UIElement* element) {
+	if (!element || !element->isVisible() || element->isNeedRemove()) {
+		return;
+	}
+	if (auto* interactive = dynamic_cast<UIInteractive*>(element); interactive && interactive->isInteractive()) {
+		mHitTargets.push_back({ interactive->getBounds(), interactive });
+	}
+	// 子元素绘制在父元素之上, 排在父元素之后
+	for (const auto& child : element->getChildren()) {
+		collectHitTargets(child.get());
+	}
+}
+
+UIInteractive* UIManager::hitTest(const glm::vec2& point) const {
+	for (auto iter = mHitTargets.rbegin(); iter != mHitTargets.rend(); ++iter) {
+		const auto& bounds = iter->mBounds;
+		if (point.x >= bounds.position.x && point.x < bounds.position.x + bounds.size.x &&
+			point.y >= bounds.position.y && point.y < bounds.position.y + bounds.size.y) {
+			return iter->mElement;
+		}
+	}
+	return nullptr;
+}
+
+bool UIManager::containsElement(const UIElement* root, const UIElement* element) const {
+	if (!root) {
+		return false;
+	}
+	if (root == element) {
+		return true;
+	}
+	return std::any_of(root->getChildren().begin(), root->getChildren().end(), [this, element](const std::unique_ptr<UIElement>& child) {
+		return containsElement(child.get(), element);
+	});
+}
+
+bool UIManager::containsHitTarget(const UIInteractive* element) const {
+	return element && std::any_of(mHitTargets.begin(), mHitTargets.end(), [element](const HitTarget& target) {
+		return target.mElement == element;
+	});
+}
+
 } // namespace engine::ui
@@ -12,9 +12,11 @@
 #ifndef UI_MANAGER_H
 #define UI_MANAGER_H
 
+#include <cstdint>
 #include <memory>
 #include <vector>
 #include <glm/vec2.hpp>
+#include "../utils/math.h"
 
 namespace engine::core {
 	class Context;
@@ -23,6 +25,7 @@ namespace engine::core {
 namespace engine::ui {
 	class UIElement;
 	class UIPanel;
+	class UIInteractive;
 }
 
 namespace engine::ui {
@@ -32,6 +35,9 @@ namespace engine::ui {
  * 
  * 负责UI元素的生命周期管理(通过根元素), 渲染调用和输入事件分发.
  * 每个需要UI的场景(如菜单, 游戏HUD), 应该拥有一个UIManager实例
+ *
+ * 输入路由: UI树发生变化(树版本号变化)时, 按绘制顺序把可见且可交互的元素展平为命中测试列表;
+ * 只有鼠标移动, 按键变化或UI树变化时才重新命中测试, 并把移入, 移出, 按下, 松开事件直接投递给鼠标下最上层的元素.
  */
 class UIManager final {
 public:
@@ -41,6 +47,7 @@ public:
 	[[nodiscard]] bool init(const glm::vec2& windowSize);  ///< @brief 初始化UI管理器，设置根元素的大小。
 	void addElement(std::unique_ptr<UIElement> element);    ///< @brief 添加一个UI元素到根节点的child_容器中。
 	UIPanel* getRootElement() const;                        ///< @brief 获取根UIPanel元素的指针。
+	std::uint64_t getRenderVersion() const;                 ///< @brief 获取UI树的绘制版本号, 没有变化时UI的绘制结果与上次相同
 	void clearElements();                                   ///< @brief 清除所有UI元素，通常用于重置UI状态。
 
 	// --- 核心循环方法 ---
@@ -54,8 +61,28 @@ public:
 	UIManager(UIManager&&) = delete;
 	UIManager& operator=(UIManager&&) = delete;
 
+private:
+	/**
+	 * @brief 命中测试列表中的一项.
+	 */
+	struct HitTarget {
+		engine::utils::Rect mBounds;						///< @brief 元素的屏幕区域
+		UIInteractive* mElement = nullptr;					///< @brief 可交互元素
+	};
+
+	bool rebuildHitTargets();								///< @brief UI树变化时重建命中测试列表, 返回是否进行了重建
+	void collectHitTargets(UIElement* element);				///< @brief 按绘制顺序递归收集可见的可交互元素
+	UIInteractive* hitTest(const glm::vec2& point) const;	///< @brief 返回包含该点的最上层元素
+	bool containsHitTarget(const UIInteractive* element) const;	///< @brief 元素是否仍在命中测试列表中
+	bool containsElement(const UIElement* root, const UIElement* element) const;	///< @brief 元素是否仍在以root为根的树中(包括隐藏的子树), 不在树中的元素可能已被销毁
+
 private:
 	std::unique_ptr<UIPanel> mRootElement;					///< @brief 一个UIPanel作为根节点(UI元素)
+	std::vector<HitTarget> mHitTargets;						///< @brief 按绘制顺序排列的命中测试列表(越靠后越在上层)
+	std::uint64_t mHitTargetsVersion = 0;					///< @brief 命中测试列表对应的树版本号
+	bool mIsHitTargetsBuilt = false;						///< @brief 命中测试列表是否已经建立
+	UIInteractive* mHoveredElement = nullptr;				///< @brief 当前鼠标下的元素
+	UIInteractive* mPressedElement = nullptr;				///< @brief 按下鼠标时所在的元素, 松开时收到Release/ReleaseOutside
 };
 } // namespace engine::ui
 
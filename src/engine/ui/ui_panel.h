@@ -37,7 +37,7 @@ public:
         const glm::vec2& size = { 0.0f, 0.0f },
         const std::optional<engine::utils::FColor>& backgroundColor = std::nullopt);
 
-    void setBackgroundColor(const std::optional<engine::utils::FColor>& backgroundColor) { mBackgroundColor = backgroundColor; }
+    void setBackgroundColor(const std::optional<engine::utils::FColor>& backgroundColor) { mBackgroundColor = backgroundColor; notifyRenderChanged(); }
     const std::optional<engine::utils::FColor>& getBackgroundColor() const { return mBackgroundColor; }
 
 	void render(engine::core::Context& context) override;
@@ -0,0 +1,73 @@
+/*****************************************************************//**
+ * @file   triple_buffer.h
+ * @brief  无锁三缓冲交换
+ * @version 1.0
+ *
+ * @author Shallowshades
+ * @date   2026.10.18
+ *********************************************************************/
+
+#pragma once
+#ifndef TRIPLE_BUFFER_H
+#define TRIPLE_BUFFER_H
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+namespace engine::utils {
+/**
+ * @brief 单生产者/单消费者的无锁三缓冲.
+ *
+ * 生产者始终独占写缓冲, 消费者始终独占读缓冲, 第三个缓冲作为中转槽.
+ * publish()把写缓冲与中转槽交换并打上"新数据"标记; consume()在有新数据时把读缓冲与中转槽交换.
+ * 双方都不会等待对方, 消费者跟不上时旧帧会被直接覆盖(丢帧而非阻塞).
+ */
+template<typename T>
+class TripleBuffer final {
+public:
+	TripleBuffer() = default;
+
+	T& getWriteBuffer() { return mBuffers[mWriteIndex]; }					///< @brief 获取生产者的写缓冲(仅生产者线程调用)
+	const T& getReadBuffer() const { return mBuffers[mReadIndex]; }			///< @brief 获取消费者的读缓冲(仅消费者线程调用)
+
+	/**
+	 * @brief 发布写缓冲中的数据, 并换得一块新的写缓冲(仅生产者线程调用).
+	 */
+	void publish() {
+		std::uint8_t previous = mMiddle.exchange(static_cast<std::uint8_t>(mWriteIndex | mFreshBit), std::memory_order_acq_rel);
+		mWriteIndex = previous & mIndexMask;
+	}
+
+	/**
+	 * @brief 如果有新发布的数据, 将其交换到读缓冲(仅消费者线程调用).
+	 *
+	 * @return 读缓冲是否被更新
+	 */
+	bool consume() {
+		if ((mMiddle.load(std::memory_order_acquire) & mFreshBit) == 0) {
+			return false;
+		}
+		std::uint8_t previous = mMiddle.exchange(mReadIndex, std::memory_order_acq_rel);
+		mReadIndex = previous & mIndexMask;
+		return true;
+	}
+
+	// 禁用拷贝和移动语义
+	TripleBuffer(const TripleBuffer&) = delete;								///< @brief 删除拷贝构造
+	TripleBuffer& operator=(const TripleBuffer&) = delete;					///< @brief 删除拷贝赋值构造
+	TripleBuffer(TripleBuffer&&) = delete;									///< @brief 删除移动构造
+	TripleBuffer& operator=(TripleBuffer&&) = delete;						///< @brief 删除移动赋值构造
+
+private:
+	static constexpr std::uint8_t mIndexMask = 0x3;							///< @brief 中转槽中缓冲索引所占的位
+	static constexpr std::uint8_t mFreshBit = 0x4;							///< @brief 中转槽中"有新数据"的标记位
+
+	std::array<T, 3> mBuffers;												///< @brief 三块缓冲
+	std::uint8_t mWriteIndex = 0;											///< @brief 生产者独占的缓冲索引
+	std::uint8_t mReadIndex = 1;											///< @brief 消费者独占的缓冲索引
+	std::atomic<std::uint8_t> mMiddle = 2;									///< @brief 中转槽的缓冲索引与新数据标记
+};
+} // namespace engine::utils
+
+#endif // !TRIPLE_BUFFER_H
@@ -34,7 +34,7 @@ void ClimbState::exit() {
 }
 
 std::unique_ptr<PlayerState> ClimbState::handleInput(engine::core::Context& context) {
-	auto inputManager = context.getInputManager();
+	auto& inputManager = context.getInputManager();
 	auto pc = mPlayerComponent->getPhysicsComponent();
 	auto ac = mPlayerComponent->getAnimationComponent();
 
@@ -26,7 +26,7 @@ void FallState::exit() {
 }
 
 std::unique_ptr<PlayerState> FallState::handleInput(engine::core::Context& context) {
-	auto inputManager = context.getInputManager();
+	auto& inputManager = context.getInputManager();
 	auto physicsComponent = mPlayerComponent->getPhysicsComponent();
 	auto spriteComponent = mPlayerComponent->getSpriteComponent();
 
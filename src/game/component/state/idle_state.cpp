@@ -25,7 +25,7 @@ void IdleState::exit() {
 }
 
 std::unique_ptr<PlayerState> IdleState::handleInput(engine::core::Context& context) {
-	auto inputManager = context.getInputManager();
+	auto& inputManager = context.getInputManager();
 	auto physicsComponent = mPlayerComponent->getPhysicsComponent();
 
 	// 如果按下上键, 且与梯子重合, 则切换到ClimbState
@@ -37,7 +37,7 @@ void JumpState::exit() {
 }
 
 std::unique_ptr<PlayerState> JumpState::handleInput(engine::core::Context& context) {
-	auto inputManager = context.getInputManager();
+	auto& inputManager = context.getInputManager();
 	auto physicsComponent = mPlayerComponent->getPhysicsComponent();
 	auto spriteComponent = mPlayerComponent->getSpriteComponent();
 
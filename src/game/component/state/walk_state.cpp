@@ -27,7 +27,7 @@ void WalkState::exit() {
 }
 
 std::unique_ptr<PlayerState> WalkState::handleInput(engine::core::Context& context) {
-	auto inputManager = context.getInputManager();
+	auto& inputManager = context.getInputManager();
 	auto physicsComponent = mPlayerComponent->getPhysicsComponent();
 	auto spriteComponent = mPlayerComponent->getSpriteComponent();
 
@@ -20,6 +20,8 @@ EndScene::EndScene(engine::core::Context& context, engine::scene::SceneManager&
 	if (!mSessionData) {
 		spdlog::error("error : 结束场景收到了空的游戏数据");
 	}
+	// 结束界面覆盖在游戏场景之上, 游戏场景不再更新, 只需捕获一次画面
+	setFreezesScenesBelow(true);
 	spdlog::trace("EndScene : {} 创建.", mSessionData->getIsWin() ? "Win" : "Lose");
 }
 
@@ -18,11 +18,14 @@
 #include "../../engine/component/health_component.h"
 #include "../../engine/physics/physics_engine.h"
 #include "../../engine/scene/level_loader.h"
+#include "../../engine/scene/level_streamer.h"
 #include "../../engine/scene/scene_manager.h"
 #include "../../engine/input/input_manager.h"
 #include "../../engine/render/camera.h"
 #include "../../engine/render/text_renderer.h"
 #include "../../engine/render/animation.h"
+#include "../../engine/resource/resource_manager.h"
+#include "../../engine/resource/asset_manifest.h"
 #include "../../engine/audio/audio_player.h"
 #include "../../engine/ui/ui_manager.h"
 #include "../../engine/ui/ui_panel.h"
@@ -34,6 +37,19 @@
 #include <spdlog/spdlog.h>
 
 namespace game::scene {
+namespace {
+// 场景代码直接使用的资源, 资源清单和播放/绘制处共用同一路径
+constexpr std::string_view mEnemyEffectTexture = "assets/textures/FX/enemy-deadth.png";		///< @brief 敌人死亡特效
+constexpr std::string_view mItemEffectTexture = "assets/textures/FX/item-feedback.png";		///< @brief 拾取道具特效
+constexpr std::string_view mFullHeartTexture = "assets/textures/UI/Heart.png";				///< @brief 生命值图标
+constexpr std::string_view mEmptyHeartTexture = "assets/textures/UI/Heart-bg.png";			///< @brief 生命值图标背景
+constexpr std::string_view mStompSound = "assets/audio/punch2a.mp3";						///< @brief 踩踏敌人音效
+constexpr std::string_view mItemSound = "assets/audio/poka01.mp3";							///< @brief 拾取道具音效
+constexpr std::string_view mLevelMusic = "assets/audio/hurry_up_and_run.ogg";				///< @brief 关卡背景音乐
+constexpr std::string_view mUIFont = "assets/fonts/VonwaonBitmap-16px.ttf";					///< @brief UI字体
+constexpr int mUIFontSize = 16;																///< @brief UI字号
+} // namespace
+
 game::scene::GameScene::GameScene(engine::core::Context& context, engine::scene::SceneManager& sceneManager, std::shared_ptr<game::data::SessionData> data)
 	: Scene("GameScene", context, sceneManager)
 	, mGameSessionData(std::move(data))
@@ -45,6 +61,8 @@ game::scene::GameScene::GameScene(engine::core::Context& context, engine::scene:
 	spdlog::trace("{} 构造完成", mLogTag.data());
 }
 
+GameScene::~GameScene() = default;
+
 void GameScene::init() {
 	if (mIsInitialized) {
 		spdlog::warn("{} : 已经初始化过了, 重复调用 init", mLogTag.data());
@@ -79,13 +97,17 @@ void GameScene::init() {
 	}
 
 	// 播放背景音乐
-	mContext.getAudioPlayer().playMusic("assets/audio/hurry_up_and_run.ogg", true, 1000);
+	mContext.getAudioPlayer().playMusic(mLevelMusic, true, 1000);
 
 	Scene::init();
 	spdlog::trace("{} : 初始化完成", mLogTag.data());
 }
 
 void GameScene::update(float deltaTime){
+	// 流式关卡: 在场景更新(移除对象, 物理模拟)之前根据相机位置调整激活的块
+	if (mLevelStreamer) {
+		mLevelStreamer->update();
+	}
 	Scene::update(deltaTime);
 	handleObjectCollisions();
 	handleTileTriggers();
@@ -116,17 +138,42 @@ void GameScene::handleInput(){
 }
 
 void GameScene::clean(){
+	// 先销毁流式加载器, 尚未完成的块在上传时被忽略
+	mLevelStreamer.reset();
 	Scene::clean();
 }
 
 bool GameScene::initLevel() {
 	// 加载关卡(LevelLoader加载后即可销毁)
 	spdlog::info("{} 加载关卡", mLogTag.data());
-	engine::scene::LevelLoader levelLoader;
+	// 登记关卡文件之外由场景代码直接使用的资源, 与关卡资源一起预加载
+	auto& manifest = getAssetManifest();
+	manifest.addTexture(mEnemyEffectTexture);
+	manifest.addTexture(mItemEffectTexture);
+	manifest.addTexture(mFullHeartTexture);
+	manifest.addTexture(mEmptyHeartTexture);
+	manifest.addSound(mStompSound);
+	manifest.addSound(mItemSound);
+	manifest.addMusic(mLevelMusic);
+	manifest.addFont(mUIFont, mUIFontSize);
+
 	auto levelPath = mGameSessionData->getMapPath();
-	if (!levelLoader.loadLevel(levelPath, *this)) {
-		spdlog::error("{} : 关卡加载失败", mLogTag.data());
-		return false;
+	const auto& streamingSettings = mSceneManager.getLevelStreamingSettings();
+	if (streamingSettings.mIsEnabled) {
+		// 流式关卡: 瓦片和对象按相机附近的块创建, 对象每次生成时添加游戏逻辑组件
+		mLevelStreamer = std::make_unique<engine::scene::LevelStreamer>(*this, streamingSettings);
+		if (!mLevelStreamer->load(levelPath)) {
+			spdlog::error("{} : 关卡加载失败", mLogTag.data());
+			return false;
+		}
+		mLevelStreamer->setObjectCallback([this](engine::object::GameObject& gameObject) { setupEnemyAndItem(gameObject); });
+	}
+	else {
+		engine::scene::LevelLoader levelLoader;
+		if (!levelLoader.loadLevel(levelPath, *this)) {
+			spdlog::error("{} : 关卡加载失败", mLogTag.data());
+			return false;
+		}
 	}
 
 	// 注册"main"层到物理引擎
@@ -149,6 +196,13 @@ bool GameScene::initLevel() {
 	mContext.getCamera().setPosition(glm::vec2(0.f));
 	// 设置世界边界
 	mContext.getPhysicsEngine().setWorldBound(engine::utils::Rect(glm::vec2(0.f), worldSize));
+
+	// 流式关卡: 同步激活玩家出生点附近的块(包括玩家), 相机从玩家位置开始, 避免第一帧丢弃这些块
+	if (mLevelStreamer) {
+		auto playerPosition = mLevelStreamer->findObjectPosition("player").value_or(glm::vec2(0.f));
+		mContext.getCamera().setPosition(playerPosition - mContext.getCamera().getViewPortSize() / 2.f);
+		mLevelStreamer->loadAround(playerPosition);
+	}
 	
 	spdlog::trace("{} : 关卡初始化完成", mLogTag.data());
 	return true;
@@ -161,6 +215,10 @@ bool GameScene::initPlayer() {
 		spdlog::error("{} : 未找到玩家对象", mLogTag.data());
 		return false;
 	}
+	// 玩家由场景管理, 不随块丢弃和重新生成
+	if (mLevelStreamer) {
+		mLevelStreamer->detachObject(mPlayer);
+	}
 
 	// 添加PlayerComponent到玩家对象
 	auto* playerComponent = mPlayer->addComponent<game::component::PlayerComponent>();
@@ -191,43 +249,52 @@ bool GameScene::initPlayer() {
 }
 
 bool GameScene::initEnemyAndItem() {
+	// 流式关卡的对象在生成时已经通过回调设置
+	if (mLevelStreamer) {
+		return true;
+	}
 	bool success = true;
 	for (auto& gameObject : mGameObjects) {
-		if (gameObject->getName() == "eagle") {
-			if (auto aic = gameObject->addComponent<game::component::AIComponent>(); aic) {
-				auto maxY = gameObject->getComponent<engine::component::TransformComponent>()->getPosition().y;
-				auto minY = maxY - 80.f;
-				aic->setBehavior(std::make_unique<game::component::ai::UpdownBehavior>(minY, maxY));
-			}
+		success = setupEnemyAndItem(*gameObject) && success;
+	}
+	return success;
+}
+
+bool GameScene::setupEnemyAndItem(engine::object::GameObject& gameObject) {
+	if (gameObject.getName() == "eagle") {
+		if (auto aic = gameObject.addComponent<game::component::AIComponent>(); aic) {
+			auto maxY = gameObject.getComponent<engine::component::TransformComponent>()->getPosition().y;
+			auto minY = maxY - 80.f;
+			aic->setBehavior(std::make_unique<game::component::ai::UpdownBehavior>(minY, maxY));
 		}
+	}
 
-		if (gameObject->getName() == "frog") {
-			if (auto aic = gameObject->addComponent<game::component::AIComponent>(); aic) {
-				auto maxX = gameObject->getComponent<engine::component::TransformComponent>()->getPosition().x - 10.f;
-				auto minX = maxX - 90.f;
-				aic->setBehavior(std::make_unique<game::component::ai::JumpBehavior>(minX, maxX));
-			}
+	if (gameObject.getName() == "frog") {
+		if (auto aic = gameObject.addComponent<game::component::AIComponent>(); aic) {
+			auto maxX = gameObject.getComponent<engine::component::TransformComponent>()->getPosition().x - 10.f;
+			auto minX = maxX - 90.f;
+			aic->setBehavior(std::make_unique<game::component::ai::JumpBehavior>(minX, maxX));
 		}
+	}
 
-		if (gameObject->getName() == "opossum") {
-			if (auto aic = gameObject->addComponent<game::component::AIComponent>(); aic) {
-				auto maxX = gameObject->getComponent<engine::component::TransformComponent>()->getPosition().x;
-				auto minX = maxX - 200.f;
-				aic->setBehavior(std::make_unique<game::component::ai::PatrolBehavior>(minX, maxX));
-			}
+	if (gameObject.getName() == "opossum") {
+		if (auto aic = gameObject.addComponent<game::component::AIComponent>(); aic) {
+			auto maxX = gameObject.getComponent<engine::component::TransformComponent>()->getPosition().x;
+			auto minX = maxX - 200.f;
+			aic->setBehavior(std::make_unique<game::component::ai::PatrolBehavior>(minX, maxX));
 		}
+	}
 
-		if (gameObject->getTag() == "item") {
-			if (auto* ac = gameObject->getComponent<engine::component::AnimationComponent>(); ac) {
-				ac->playAnimation("idle");
-			}
-			else {
-				spdlog::error("{} : item 对象缺少动画组件, 无法播放动画", mLogTag.data());
-				success = false;
-			}
+	if (gameObject.getTag() == "item") {
+		if (auto* ac = gameObject.getComponent<engine::component::AnimationComponent>(); ac) {
+			ac->playAnimation("idle");
+		}
+		else {
+			spdlog::error("{} : item 对象缺少动画组件, 无法播放动画", mLogTag.data());
+			return false;
 		}
 	}
-	return success;
+	return true;
 }
 
 bool GameScene::initUI() {
@@ -353,7 +420,7 @@ void GameScene::playerVSEnemyCollision(engine::object::GameObject* player, engin
 		velocity.y = -300.f;
 		player->getComponent<engine::component::PhysicsComponent>()->setVelocity(velocity);
 		// 播放音效
-		mContext.getAudioPlayer().playSound("assets/audio/punch2a.mp3");
+		mContext.getAudioPlayer().playSound(mStompSound);
 		// 加分
 		addScoreWithUI(10);
 	}
@@ -374,7 +441,7 @@ void GameScene::playerVSItemCollision(engine::object::GameObject* player, engine
 	auto itemAABB = item->getComponent<engine::component::ColliderComponent>()->getWorldAABB();
 	createEffect(itemAABB.position + itemAABB.size / 2.f, item->getTag());
 	// 播放吃到道具音效
-	mContext.getAudioPlayer().playSound("assets/audio/poka01.mp3");
+	mContext.getAudioPlayer().playSound(mItemSound);
 }
 
 void GameScene::toNextLevel(engine::object::GameObject* trigger) {
@@ -401,20 +468,33 @@ void GameScene::createEffect(const glm::vec2& centerPosition, std::string_view t
 	auto effectObject = std::make_unique<engine::object::GameObject>("effect_" + std::string(tag));
 	effectObject->addComponent<engine::component::TransformComponent>(centerPosition);
 
-	// 根据标签创建不同的精灵组件和动画
-	auto animation = std::make_unique<engine::render::Animation>("effect", false);
+	// 根据标签创建不同的精灵组件和动画 (动画片段只在第一次使用时构建, 之后从资源管理器共享)
+	auto& resourceManager = mContext.getResourceManager();
+	std::shared_ptr<const engine::render::Animation> animation;
 	if (std::string(tag) == "enemy") {
-		effectObject->addComponent<engine::component::SpriteComponent>("assets/textures/FX/enemy-deadth.png", mContext.getResourceManager(), engine::utils::Alignment::CENTER);
-		for (auto i = 0; i < 6; ++i) {
-			animation->addFrame(SDL_FRect { static_cast<float>(i * 40), 0.f, 40.f, 41.f }, 0.1f);
+		constexpr std::string_view sheetId = mEnemyEffectTexture;
+		effectObject->addComponent<engine::component::SpriteComponent>(sheetId, resourceManager, engine::utils::Alignment::CENTER);
+		animation = resourceManager.getAnimation(sheetId, "effect");
+		if (!animation) {
+			auto clip = std::make_unique<engine::render::Animation>("effect", false);
+			for (auto i = 0; i < 6; ++i) {
+				clip->addFrame(SDL_FRect { static_cast<float>(i * 40), 0.f, 40.f, 41.f }, 0.1f);
+			}
+			animation = resourceManager.addAnimation(sheetId, std::move(clip));
 		}
 	}
 	else if (std::string(tag) == "item") {
-		effectObject->addComponent<engine::component::SpriteComponent>("assets/textures/FX/item-feedback.png",
-			mContext.getResourceManager(),
+		constexpr std::string_view sheetId = mItemEffectTexture;
+		effectObject->addComponent<engine::component::SpriteComponent>(sheetId,
+			resourceManager,
 			engine::utils::Alignment::CENTER);
-		for (auto i = 0; i < 4; ++i) {
-			animation->addFrame({ static_cast<float>(i * 32), 0.0f, 32.0f, 32.0f }, 0.1f);
+		animation = resourceManager.getAnimation(sheetId, "effect");
+		if (!animation) {
+			auto clip = std::make_unique<engine::render::Animation>("effect", false);
+			for (auto i = 0; i < 4; ++i) {
+				clip->addFrame({ static_cast<float>(i * 32), 0.0f, 32.0f, 32.0f }, 0.1f);
+			}
+			animation = resourceManager.addAnimation(sheetId, std::move(clip));
 		}
 	}
 	else {
@@ -423,7 +503,7 @@ void GameScene::createEffect(const glm::vec2& centerPosition, std::string_view t
 	}
 
 	// 根据创建的动画, 添加动画组件, 并设置为单次播放
-	auto ac = effectObject->addComponent<engine::component::AnimationComponent>();
+	auto ac = effectObject->addComponent<engine::component::AnimationComponent>(mAnimationSystem.get());
 	ac->addAnimation(std::move(animation));
 	ac->setOneShotRemoval(true);
 	ac->playAnimation("effect");
@@ -436,8 +516,8 @@ void GameScene::createScoreUI() {
 	auto scoreText = "Score: " + std::to_string(mGameSessionData->getCurrentScore());
 	auto score_label = std::make_unique<engine::ui::UILabel>(mContext.getTextRenderer(),
 		scoreText,
-		"assets/fonts/VonwaonBitmap-16px.ttf",
-		16);
+		mUIFont,
+		mUIFontSize);
 	mScoreLabel = score_label.get();									// 成员变量赋值（获取裸指针）
 	auto screen_size = mUIManager->getRootElement()->getSize();			// 获取屏幕尺寸
 	mScoreLabel->setPosition(glm::vec2(screen_size.x - 100.0f, 10.0f));
@@ -452,8 +532,6 @@ void GameScene::createHealthUI() {
 	float iconWidth = 20.0f;
 	float iconHeight = 18.0f;
 	float spacing = 5.0f;
-	std::string fullHeartTexture = "assets/textures/UI/Heart.png";
-	std::string emptyHeartTexture = "assets/textures/UI/Heart-bg.png";
 
 	// 创建一个默认的UIPanel (不需要背景色，因此大小无所谓，只用于定位)
 	auto healthPanel = std::make_unique<engine::ui::UIPanel>();
@@ -464,14 +542,14 @@ void GameScene::createHealthUI() {
 		glm::vec2 iconPosition = { startX + i * (iconWidth + spacing), startY };
 		glm::vec2 iconSize = { iconWidth, iconHeight };
 
-		auto bgIcon = std::make_unique<engine::ui::UIImage>(emptyHeartTexture, iconPosition, iconSize);
+		auto bgIcon = std::make_unique<engine::ui::UIImage>(mEmptyHeartTexture, iconPosition, iconSize);
 		mHealthPanel->addChild(std::move(bgIcon));
 	}
 	for (int i = 0; i < maxHealth; ++i) {			// 创建前景图标
 		glm::vec2 iconPosition = { startX + i * (iconWidth + spacing), startY };
 		glm::vec2 iconSize = { iconWidth, iconHeight };
 
-		auto fgIcon = std::make_unique<engine::ui::UIImage>(fullHeartTexture, iconPosition, iconSize);
+		auto fgIcon = std::make_unique<engine::ui::UIImage>(mFullHeartTexture, iconPosition, iconSize);
 		bool isVisible = (i < current_health);		// 前景图标的可见性取决于当前生命值
 		fgIcon->setVisible(isVisible);				// 设置前景图标的可见性
 		mHealthPanel->addChild(std::move(fgIcon));
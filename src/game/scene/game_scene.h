@@ -18,6 +18,7 @@
 #include <glm/vec2.hpp>
 
 namespace engine::object { class GameObject; }
+namespace engine::scene { class LevelStreamer; }
 namespace game::data { class SessionData; }
 namespace engine::ui {
 	class UIPanel;
@@ -39,6 +40,7 @@ public:
 	 * @param sceneManager 场景管理器引用
 	 */
 	GameScene(engine::core::Context& context, engine::scene::SceneManager& sceneManager, std::shared_ptr<game::data::SessionData> data = nullptr);
+	~GameScene() override;											///< @brief 析构函数
 
 	// 重写核心方法
 	void init() override;											///< @brief 初始化
@@ -52,6 +54,7 @@ private:
 	[[nodiscard]] bool initPlayer();								///< @brief 初始化玩家
 	[[nodiscard]] bool initEnemyAndItem();							///< @brief 初始化敌人和道具
 	[[nodiscard]] bool initUI();									///< @brief 初始化UI
+	bool setupEnemyAndItem(engine::object::GameObject& gameObject);	///< @brief 为敌人添加AI, 为道具播放动画(流式关卡中对象每次生成时调用)
 
 	///< @brief 处理游戏对象间的碰撞逻辑(从物理引擎获取信息).
 	void handleObjectCollisions();
@@ -92,6 +95,7 @@ private:
 	std::shared_ptr<game::data::SessionData> mGameSessionData;		///< @brief 场景间共享数据, 因此使用shared_ptr
 	engine::ui::UILabel* mScoreLabel;								///< @brief 场景间共享数据, 因此使用shared_ptr
 	engine::ui::UIPanel* mHealthPanel;								///< @brief 场景间共享数据, 因此使用shared_ptr
+	std::unique_ptr<engine::scene::LevelStreamer> mLevelStreamer;	///< @brief 流式关卡加载器, 未启用流式关卡时为空
 };
 } // namespace game::scene
 
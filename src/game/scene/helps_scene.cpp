@@ -10,6 +10,8 @@ namespace game::scene {
 
 HelpsScene::HelpsScene(engine::core::Context& context, engine::scene::SceneManager& sceneManager)
 	: engine::scene::Scene("HelpsScene", context, sceneManager) {
+	// 帮助图片带透明区域, 下层的标题场景仍需显示, 但不再更新
+	setFreezesScenesBelow(true);
 	spdlog::trace("HelpsScene 创建.");
 }
 
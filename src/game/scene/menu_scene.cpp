@@ -23,6 +23,8 @@ MenuScene::MenuScene(engine::core::Context& context,
 	if (!mSessionData) {
 		spdlog::error("菜单场景构造时 SessionData 为空。");
 	}
+	// 暂停菜单下的游戏场景不再更新, 只需捕获一次画面
+	setFreezesScenesBelow(true);
 	spdlog::trace("MenuScene 构造完成.");
 }
 
@@ -11,10 +11,11 @@
 void testSpdlog();
 void testJson();
 
-int main(int, char**) {
+int main(int argc, char* argv[]) {
 
 	spdlog::set_level(spdlog::level::trace);
 	engine::core::GameApp app;
+	app.setCommandLineArgs(argc, argv);
 	app.registerSceneSetup([](engine::scene::SceneManager& sceneManager) {
 		// GameApp 在调用 run 方法之前, 先创建并设置初始场景
 		auto titleScene = std::make_unique<game::scene::TitleScene>(sceneManager.getContext(), sceneManager);
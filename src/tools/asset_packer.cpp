@@ -0,0 +1,146 @@
+/*****************************************************************//**
+ * @file   asset_packer.cpp
+ * @brief  资源打包工具: 把资源目录中的文件合并成一个资源包
+ * @version 1.0
+ *
+ * 用法: asset_packer <资源目录> <输出文件> [--exclude=<文件名>]...
+ * 例如在项目根目录下执行 asset_packer assets assets.pak --exclude=config.json
+ * 包中记录的路径与游戏中使用的路径形式相同(相对于工作目录, 如 "assets/textures/a.png").
+ *
+ * @author Shallowshades
+ * @date   2026.10.18
+ *********************************************************************/
+
+#include <algorithm>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <set>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include <spdlog/spdlog.h>
+#include "../engine/resource/asset_pack_format.h"
+
+namespace {
+constexpr std::string_view mLogTag = "AssetPacker";
+
+struct SourceFile {
+	std::string mPackPath;									///< @brief 包中记录的规范化路径
+	std::filesystem::path mFilePath;						///< @brief 磁盘上的路径
+};
+
+void writePadding(std::ofstream& output, std::uint64_t& offset) {
+	static const char zeros[engine::resource::PackHeader::mDataAlignment] = {};
+	std::uint64_t padding = (engine::resource::PackHeader::mDataAlignment - offset % engine::resource::PackHeader::mDataAlignment) % engine::resource::PackHeader::mDataAlignment;
+	output.write(zeros, static_cast<std::streamsize>(padding));
+	offset += padding;
+}
+} // namespace
+
+int main(int argc, char* argv[]) {
+	using namespace engine::resource;
+
+	std::vector<std::string> positional;
+	std::set<std::string> excludes;
+	for (int i = 1; i < argc; ++i) {
+		std::string_view arg = argv[i];
+		if (arg.starts_with("--exclude=")) {
+			excludes.emplace(arg.substr(std::string_view("--exclude=").size()));
+		}
+		else {
+			positional.emplace_back(arg);
+		}
+	}
+	if (positional.size() != 2) {
+		spdlog::error("用法: asset_packer <资源目录> <输出文件> [--exclude=<文件名>]...");
+		return 1;
+	}
+	const std::filesystem::path inputDir = positional[0];
+	const std::filesystem::path outputPath = positional[1];
+	if (!std::filesystem::is_directory(inputDir)) {
+		spdlog::error("{} 资源目录不存在: {}", mLogTag.data(), inputDir.string());
+		return 1;
+	}
+
+	// 1. 收集文件, 按路径排序保证每次打包的结果相同
+	std::vector<SourceFile> files;
+	std::error_code error;
+	auto outputAbsolute = std::filesystem::weakly_canonical(outputPath, error);
+	for (const auto& entry : std::filesystem::recursive_directory_iterator(inputDir)) {
+		if (!entry.is_regular_file()) {
+			continue;
+		}
+		if (excludes.contains(entry.path().filename().string())) {
+			continue;
+		}
+		if (std::filesystem::weakly_canonical(entry.path(), error) == outputAbsolute) {
+			continue;
+		}
+		files.push_back(SourceFile{ normalizePackPath(entry.path().generic_string()), entry.path() });
+	}
+	std::sort(files.begin(), files.end(), [](const SourceFile& lhs, const SourceFile& rhs) { return lhs.mPackPath < rhs.mPackPath; });
+
+	// 2. 检查哈希冲突(运行时只按哈希查找)
+	std::unordered_map<std::uint64_t, std::string_view> hashes;
+	for (const auto& file : files) {
+		auto [iter, isInserted] = hashes.emplace(hashPackPath(file.mPackPath), file.mPackPath);
+		if (!isInserted) {
+			spdlog::error("{} 路径哈希冲突: '{}' 与 '{}', 请重命名其中一个文件", mLogTag.data(), iter->second, file.mPackPath);
+			return 1;
+		}
+	}
+
+	// 3. 写入文件头(占位), 数据区和索引
+	std::ofstream output(outputPath, std::ios::binary | std::ios::trunc);
+	if (!output.is_open()) {
+		spdlog::error("{} 无法创建输出文件: {}", mLogTag.data(), outputPath.string());
+		return 1;
+	}
+	PackHeader header;
+	output.write(reinterpret_cast<const char*>(&header), sizeof(PackHeader));
+	std::uint64_t offset = sizeof(PackHeader);
+
+	std::vector<PackEntry> entries;
+	entries.reserve(files.size());
+	for (const auto& file : files) {
+		std::ifstream input(file.mFilePath, std::ios::binary);
+		if (!input.is_open()) {
+			spdlog::error("{} 无法读取文件: {}", mLogTag.data(), file.mFilePath.string());
+			return 1;
+		}
+		std::vector<char> data((std::istreambuf_iterator<char>(input)), std::istreambuf_iterator<char>());
+
+		writePadding(output, offset);
+		PackEntry entry;
+		entry.mPathHash = hashPackPath(file.mPackPath);
+		entry.mOffset = offset;
+		entry.mSize = data.size();
+		entry.mType = getAssetType(file.mPackPath);
+		entries.push_back(entry);
+
+		output.write(data.data(), static_cast<std::streamsize>(data.size()));
+		offset += data.size();
+		spdlog::debug("{} {} ({} 字节)", mLogTag.data(), file.mPackPath, data.size());
+	}
+
+	writePadding(output, offset);
+	std::sort(entries.begin(), entries.end(), [](const PackEntry& lhs, const PackEntry& rhs) { return lhs.mPathHash < rhs.mPathHash; });
+	header.mEntryCount = static_cast<std::uint32_t>(entries.size());
+	header.mIndexOffset = offset;
+	output.write(reinterpret_cast<const char*>(entries.data()), static_cast<std::streamsize>(entries.size() * sizeof(PackEntry)));
+	offset += entries.size() * sizeof(PackEntry);
+
+	output.seekp(0);
+	output.write(reinterpret_cast<const char*>(&header), sizeof(PackHeader));
+	output.close();
+	if (!output) {
+		spdlog::error("{} 写入输出文件失败: {}", mLogTag.data(), outputPath.string());
+		return 1;
+	}
+
+	spdlog::info("{} 已打包 {} 个文件到 '{}': {:.2f} MB", mLogTag.data(), entries.size(), outputPath.string(), offset / (1024.0 * 1024.0));
+	return 0;
+}
@@ -0,0 +1,250 @@
+/*****************************************************************//**
+ * @file   level_cooker.cpp
+ * @brief  关卡预处理工具: 把Tiled地图和瓦片集转换为二进制关卡文件
+ * @version 1.0
+ *
+ * 用法: level_cooker <地图文件>...
+ * 例如在项目根目录下执行 level_cooker assets/maps/level1.tmj, 在地图旁边生成 assets/maps/level1.lvl.
+ * 游戏加载地图时优先读取同名的.lvl文件, 不存在或比地图/瓦片集旧时回退到解析JSON.
+ *
+ * 基准测试: level_cooker --benchmark[=<边长>] (默认1000)
+ * 在临时目录生成一张使用 assets/maps 中瓦片集的合成地图(两个边长x边长的瓦片图层), 输出解析JSON, 写入和读取预处理文件的耗时,
+ * 以及解析JSON时的内存分配(对比完整json树和TiledMapParser的流式解析).
+ *
+ * @author Shallowshades
+ * @date   2026.10.18
+ *********************************************************************/
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <new>
+#include <string>
+#include <string_view>
+#include <nlohmann/json.hpp>
+#include <spdlog/spdlog.h>
+#include "../engine/resource/asset_pack_format.h"
+#include "../engine/resource/mapped_file.h"
+#include "../engine/scene/level_data.h"
+#include "../engine/scene/tiled_map_parser.h"
+
+namespace {
+constexpr std::string_view mLogTag = "LevelCooker";
+
+/**
+ * @brief 全局operator new的统计, 只在本工具中替换, 用于基准测试.
+ */
+struct AllocationStats {
+	std::size_t mCurrentBytes = 0;											///< @brief 当前已分配的字节数
+	std::size_t mPeakBytes = 0;												///< @brief 已分配字节数的峰值
+	std::size_t mTotalBytes = 0;											///< @brief 累计分配的字节数
+	std::size_t mCount = 0;													///< @brief 累计分配次数
+};
+AllocationStats mAllocationStats;
+
+/**
+ * @brief 每次分配前面的头部, 记录分配的大小. 按max_align_t对齐, 不影响返回地址的对齐.
+ */
+constexpr std::size_t mAllocationHeaderSize = alignof(std::max_align_t);
+
+double elapsedMs(std::chrono::steady_clock::time_point start) {
+	return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+/**
+ * @brief 从当前状态开始重新统计, 峰值相对于当前已分配的字节数计算.
+ * @return 当前已分配的字节数
+ */
+std::size_t resetAllocationStats() {
+	mAllocationStats.mPeakBytes = mAllocationStats.mCurrentBytes;
+	mAllocationStats.mTotalBytes = 0;
+	mAllocationStats.mCount = 0;
+	return mAllocationStats.mCurrentBytes;
+}
+
+void logAllocationStats(std::string_view name, double ms, std::size_t baseBytes) {
+	spdlog::info("{} {}: {:.1f} ms, 峰值内存 {:.2f} MB, 累计分配 {:.2f} MB / {} 次", mLogTag.data(), name, ms,
+		(mAllocationStats.mPeakBytes - baseBytes) / (1024.0 * 1024.0), mAllocationStats.mTotalBytes / (1024.0 * 1024.0), mAllocationStats.mCount);
+}
+
+/**
+ * @brief 生成合成地图并测量加载耗时.
+ *
+ * @param mapSize 地图边长(瓦片数量)
+ * @return 进程退出码
+ */
+int runBenchmark(int mapSize) {
+	using namespace engine::scene;
+
+	// 1. 生成合成地图: 瓦片集与 level1 相同, 瓦片图层用固定种子的伪随机gid填充(约1/4为空)
+	const std::filesystem::path tilesetDir = "assets/maps";
+	if (!std::filesystem::exists(tilesetDir / "tileset.tsj")) {
+		spdlog::error("{} 找不到 {}, 请在项目根目录下运行", mLogTag.data(), (tilesetDir / "tileset.tsj").generic_string());
+		return 1;
+	}
+	nlohmann::json mapJson = {
+		{ "width", mapSize },
+		{ "height", mapSize },
+		{ "tilewidth", 16 },
+		{ "tileheight", 16 },
+		{ "tilesets", nlohmann::json::array({
+			{ { "firstgid", 1 }, { "source", std::filesystem::absolute(tilesetDir / "tileset.tsj").generic_string() } },
+			{ { "firstgid", 576 }, { "source", std::filesystem::absolute(tilesetDir / "prop.tsj").generic_string() } },
+			{ { "firstgid", 607 }, { "source", std::filesystem::absolute(tilesetDir / "actor.tsj").generic_string() } },
+		}) },
+		{ "layers", nlohmann::json::array() },
+	};
+	std::uint32_t seed = 12345;
+	for (std::string_view layerName : { "back", "main" }) {
+		nlohmann::json data = nlohmann::json::array();
+		for (std::int64_t i = 0; i < static_cast<std::int64_t>(mapSize) * mapSize; ++i) {
+			seed = seed * 1664525u + 1013904223u;
+			data.push_back((seed >> 16) % 4 == 0 ? 0u : 1u + (seed >> 8) % 575u);
+		}
+		mapJson["layers"].push_back({ { "type", "tilelayer" }, { "name", layerName }, { "visible", true }, { "data", std::move(data) } });
+	}
+	const auto benchmarkDir = std::filesystem::temp_directory_path() / "sunnyland_level_benchmark";
+	std::filesystem::create_directories(benchmarkDir);
+	const std::string mapPath = (benchmarkDir / "synthetic.tmj").generic_string();
+	std::ofstream(mapPath) << mapJson;
+	mapJson = nlohmann::json();
+
+	// 2. 对比: 把整个文件解析为json树(旧的加载方式, 不含瓦片集和转换)
+	spdlog::set_level(spdlog::level::warn);
+	std::size_t domBaseBytes = resetAllocationStats();
+	auto start = std::chrono::steady_clock::now();
+	{
+		engine::resource::MappedFile file(mapPath);
+		const char* begin = reinterpret_cast<const char*>(file.getData().data());
+		nlohmann::json document = nlohmann::json::parse(begin, begin + file.getData().size());
+	}
+	double domMs = elapsedMs(start);
+	AllocationStats domStats = mAllocationStats;
+
+	// 3. 解析JSON(流式读取文件, 瓦片集和瓦片表, gid数组)
+	LevelData level;
+	std::size_t parseBaseBytes = resetAllocationStats();
+	start = std::chrono::steady_clock::now();
+	TiledMapParser parser;
+	if (!parser.parse(mapPath, level)) {
+		return 1;
+	}
+	double parseMs = elapsedMs(start);
+	AllocationStats parseStats = mAllocationStats;
+
+	// 4. 写入和读取预处理文件
+	const std::string cookedPath = getCookedLevelPath(mapPath);
+	start = std::chrono::steady_clock::now();
+	if (!writeCookedLevel(level, cookedPath)) {
+		return 1;
+	}
+	double writeMs = elapsedMs(start);
+
+	start = std::chrono::steady_clock::now();
+	LevelData cookedLevel;
+	std::size_t cookedBytes = 0;
+	{
+		engine::resource::MappedFile file(cookedPath);
+		cookedBytes = file.getData().size();
+		if (!readCookedLevel(file.getData(), mapPath, cookedLevel)) {
+			return 1;
+		}
+	}
+	double readMs = elapsedMs(start);
+	spdlog::set_level(spdlog::level::info);
+
+	std::size_t tileCount = 0;
+	for (const auto& layer : cookedLevel.mLayers) {
+		tileCount += layer.mGids.size();
+	}
+	spdlog::info("{} 合成地图 {}x{}, {} 个瓦片, 瓦片表 {} 项", mLogTag.data(), mapSize, mapSize, tileCount, cookedLevel.mTiles.size());
+	spdlog::info("{} 地图文件: {:.2f} MB", mLogTag.data(), std::filesystem::file_size(mapPath) / (1024.0 * 1024.0));
+	mAllocationStats = domStats;
+	logAllocationStats("json树(nlohmann::json::parse)", domMs, domBaseBytes);
+	mAllocationStats = parseStats;
+	logAllocationStats("解析JSON(TiledMapParser)", parseMs, parseBaseBytes);
+	spdlog::info("{} 写入预处理文件: {:.1f} ms", mLogTag.data(), writeMs);
+	spdlog::info("{} 读取预处理文件: {:.1f} ms ({:.2f} MB)", mLogTag.data(), readMs, cookedBytes / (1024.0 * 1024.0));
+
+	std::error_code error;
+	std::filesystem::remove_all(benchmarkDir, error);
+	return 0;
+}
+} // namespace
+
+void* operator new(std::size_t size) {
+	void* block = std::malloc(size + mAllocationHeaderSize);
+	if (!block) {
+		throw std::bad_alloc();
+	}
+	*static_cast<std::size_t*>(block) = size;
+	mAllocationStats.mCurrentBytes += size;
+	mAllocationStats.mPeakBytes = std::max(mAllocationStats.mPeakBytes, mAllocationStats.mCurrentBytes);
+	mAllocationStats.mTotalBytes += size;
+	++mAllocationStats.mCount;
+	return static_cast<std::byte*>(block) + mAllocationHeaderSize;
+}
+
+void operator delete(void* pointer) noexcept {
+	if (!pointer) {
+		return;
+	}
+	void* block = static_cast<std::byte*>(pointer) - mAllocationHeaderSize;
+	mAllocationStats.mCurrentBytes -= *static_cast<std::size_t*>(block);
+	std::free(block);
+}
+
+void operator delete(void* pointer, std::size_t) noexcept {
+	operator delete(pointer);
+}
+
+int main(int argc, char* argv[]) {
+	using namespace engine::scene;
+
+	if (argc < 2) {
+		spdlog::error("用法: level_cooker <地图文件>... | level_cooker --benchmark[=<边长>]");
+		return 1;
+	}
+	std::string_view firstArg = argv[1];
+	if (firstArg == "--benchmark" || firstArg.starts_with("--benchmark=")) {
+		int mapSize = 1000;
+		if (firstArg.starts_with("--benchmark=")) {
+			try {
+				mapSize = std::max(1, std::stoi(std::string(firstArg.substr(std::string_view("--benchmark=").size()))));
+			}
+			catch (const std::exception& e) {
+				spdlog::error("{} 无法解析命令行参数 '{}': {}", mLogTag.data(), firstArg, e.what());
+				return 1;
+			}
+		}
+		return runBenchmark(mapSize);
+	}
+	int failedCount = 0;
+	for (int i = 1; i < argc; ++i) {
+		std::string mapPath = engine::resource::normalizePackPath(argv[i]);
+		LevelData level;
+		TiledMapParser parser;
+		if (!parser.parse(mapPath, level)) {
+			spdlog::error("{} 解析地图失败: {}", mLogTag.data(), mapPath);
+			++failedCount;
+			continue;
+		}
+		std::string cookedPath = getCookedLevelPath(mapPath);
+		if (!writeCookedLevel(level, cookedPath)) {
+			++failedCount;
+			continue;
+		}
+		std::size_t tileCount = 0;
+		std::size_t objectCount = 0;
+		for (const auto& layer : level.mLayers) {
+			tileCount += layer.mGids.size();
+			objectCount += layer.mObjects.size();
+		}
+		spdlog::info("{} '{}' -> '{}': {} 个图层, {} 个瓦片, {} 个对象, 瓦片表 {} 项", mLogTag.data(), mapPath, cookedPath, level.mLayers.size(), tileCount, objectCount, level.mTiles.size());
+	}
+	return failedCount == 0 ? 0 : 1;
+}